@@ -58,6 +58,16 @@ uint8_t ms5837_basic_init(ms5837_type_t type)
     DRIVER_MS5837_LINK_IIC_WRITE(&gs_handle, ms5837_interface_iic_write);
     DRIVER_MS5837_LINK_DELAY_MS(&gs_handle, ms5837_interface_delay_ms);
     DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    DRIVER_MS5837_LINK_TIMESTAMP_US(&gs_handle, ms5837_interface_timestamp_us);
+    
+    /* set the retry policy */
+    res = ms5837_set_retry(&gs_handle, MS5837_BASIC_DEFAULT_RETRY_TIMES, MS5837_BASIC_DEFAULT_RETRY_BUDGET_US);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: set retry failed.\n");
+
+        return 1;
+    }
     
     /* ms5837 init */
     res = ms5837_init(&gs_handle);
@@ -108,7 +118,7 @@ uint8_t ms5837_basic_init(ms5837_type_t type)
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       a failed read resyncs the sensor and reads once more before it gives up
  */
 uint8_t ms5837_basic_read(float *temperature_c, float *pressure_mbar)
 {
@@ -116,6 +126,16 @@ uint8_t ms5837_basic_read(float *temperature_c, float *pressure_mbar)
     uint32_t pressure_raw;
     
     /* read temperature and pressure */
+    if (ms5837_read_temperature_pressure(&gs_handle, &temperature_raw, temperature_c, &pressure_raw, pressure_mbar) == 0)
+    {
+        return 0;
+    }
+    
+    /* resync and read again */
+    if (ms5837_resync(&gs_handle) != 0)
+    {
+        return 1;
+    }
     if (ms5837_read_temperature_pressure(&gs_handle, &temperature_raw, temperature_c, &pressure_raw, pressure_mbar) != 0)
     {
         return 1;
@@ -55,6 +55,8 @@ extern "C"{
  */
 #define MS5837_BASIC_DEFAULT_TEMPERATURE_OSR        MS5837_OSR_4096        /**< 4096 */
 #define MS5837_BASIC_DEFAULT_PRESSURE_OSR           MS5837_OSR_4096        /**< 4096 */
+#define MS5837_BASIC_DEFAULT_RETRY_TIMES            2                      /**< 2 times */
+#define MS5837_BASIC_DEFAULT_RETRY_BUDGET_US        2000                   /**< 2ms */
 
 /**
  * @brief     basic example init
@@ -82,7 +84,7 @@ uint8_t ms5837_basic_deinit(void);
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       a failed read resyncs the sensor and reads once more before it gives up
  */
 uint8_t ms5837_basic_read(float *temperature_c, float *pressure_mbar);
 
@@ -101,6 +101,13 @@ uint8_t ms5837_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
  */
 void ms5837_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief  interface timestamp us
+ * @return free running time in us
+ * @note   only differences are used, so it may wrap around
+ */
+uint32_t ms5837_interface_timestamp_us(void);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -102,6 +102,16 @@ void ms5837_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return free running time in us
+ * @note   only differences are used, so it may wrap around
+ */
+uint32_t ms5837_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
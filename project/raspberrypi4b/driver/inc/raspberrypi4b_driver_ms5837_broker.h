@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_broker.h
+ * @brief     raspberrypi4b driver ms5837 broker header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MS5837_BROKER_H
+#define RASPBERRYPI4B_DRIVER_MS5837_BROKER_H
+
+#include "driver_ms5837_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_broker_driver ms5837 broker driver function
+ * @brief    ms5837 broker driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 broker max number definition
+ */
+#define MS5837_BROKER_MAX_SENSOR        4         /**< max sensor number */
+#define MS5837_BROKER_MAX_CLIENT        32        /**< max connected client number */
+
+/**
+ * @brief ms5837 broker request structure definition
+ * @note  the messages are sent in the host byte order over a local seqpacket socket
+ */
+typedef struct ms5837_broker_request_s
+{
+    uint32_t max_age_us;        /**< max age of a cached sample, 0 waits for a new conversion */
+    uint8_t index;              /**< sensor index */
+    uint8_t reserved[3];        /**< reserved */
+} ms5837_broker_request_t;
+
+/**
+ * @brief ms5837 broker response structure definition
+ */
+typedef struct ms5837_broker_response_s
+{
+    uint64_t timestamp_ns;           /**< time the sample was completed in CLOCK_MONOTONIC ns */
+    int32_t temperature;             /**< temperature from ms5837_compensate */
+    int32_t pressure;                /**< pressure from ms5837_compensate */
+    float temperature_c;             /**< converted temperature */
+    float pressure_mbar;             /**< converted pressure */
+    uint32_t age_us;                 /**< age of the sample when it was sent */
+    uint16_t shared;                 /**< requests served by the conversion of the sample so far */
+    uint8_t index;                   /**< sensor index */
+    uint8_t status;                  /**< 0 success, 1 conversion failed, 4 index is invalid */
+} ms5837_broker_response_t;
+
+/**
+ * @brief ms5837 broker statistics structure definition
+ */
+typedef struct ms5837_broker_stats_s
+{
+    uint64_t requests;           /**< received requests */
+    uint64_t conversions;        /**< started conversion cycles */
+    uint64_t cached;             /**< requests served from the cache */
+    uint64_t coalesced;          /**< requests that joined a running conversion */
+    uint64_t errors;             /**< failed conversion cycles */
+} ms5837_broker_stats_t;
+
+/**
+ * @brief ms5837 broker sensor structure definition
+ */
+typedef struct ms5837_broker_sensor_s
+{
+    ms5837_handle_t *handle;                   /**< ms5837 handle */
+    int convert_fd;                            /**< conversion timer */
+    uint32_t temperature_raw;                  /**< pending raw temperature */
+    uint32_t waiting;                          /**< mask of the clients waiting for the conversion */
+    uint8_t state;                             /**< conversion state */
+    uint8_t resync;                            /**< resync before the next cycle */
+    uint8_t valid;                             /**< cached sample valid flag */
+    ms5837_broker_response_t cache;            /**< last sample */
+    ms5837_broker_stats_t stats;               /**< statistics */
+} ms5837_broker_sensor_t;
+
+/**
+ * @brief ms5837 broker structure definition
+ */
+typedef struct ms5837_broker_s
+{
+    int epoll_fd;                                                /**< epoll handle */
+    int listen_fd;                                               /**< listening socket */
+    char path[108];                                              /**< socket path */
+    uint8_t num;                                                 /**< sensor number */
+    ms5837_broker_sensor_t sensor[MS5837_BROKER_MAX_SENSOR];     /**< sensors */
+    int client[MS5837_BROKER_MAX_CLIENT];                        /**< client sockets, -1 is free */
+} ms5837_broker_t;
+
+/**
+ * @brief     broker init
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] *path pointer to a unix socket path
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 broker is NULL
+ *            - 4 path is too long
+ * @note      a stale socket file of the path is removed
+ */
+uint8_t ms5837_broker_init(ms5837_broker_t *broker, const char *path);
+
+/**
+ * @brief     broker deinit
+ * @param[in] *broker pointer to a broker structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 broker is NULL
+ * @note      the clients are disconnected, the socket file is removed and the linked handles are not closed
+ */
+uint8_t ms5837_broker_deinit(ms5837_broker_t *broker);
+
+/**
+ * @brief      add an initialized sensor to the broker
+ * @param[in]  *broker pointer to a broker structure
+ * @param[in]  *handle pointer to an initialized ms5837 handle structure
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 broker is NULL
+ *             - 3 broker is full
+ * @note       each sensor must sit on its own bus
+ */
+uint8_t ms5837_broker_add(ms5837_broker_t *broker, ms5837_handle_t *handle, uint8_t *index);
+
+/**
+ * @brief     wait for clients and timer events and serve the requests
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] timeout_ms max wait time, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 broker is NULL
+ * @note      a request is served from the cache when the cached sample is young enough, else it joins the
+ *            running conversion of the sensor or starts one, so one conversion serves all waiting clients
+ */
+uint8_t ms5837_broker_poll(ms5837_broker_t *broker, int32_t timeout_ms);
+
+/**
+ * @brief      get the statistics of a sensor
+ * @param[in]  *broker pointer to a broker structure
+ * @param[in]  index sensor index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 broker is NULL
+ *             - 3 index is invalid
+ * @note       none
+ */
+uint8_t ms5837_broker_get_stats(ms5837_broker_t *broker, uint8_t index, ms5837_broker_stats_t *stats);
+
+/**
+ * @brief      request a sample from a broker
+ * @param[in]  *path pointer to the unix socket path of the broker
+ * @param[in]  index sensor index
+ * @param[in]  max_age_us max age of a cached sample, 0 waits for a new conversion
+ * @param[out] *response pointer to a response buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ *             - 2 path is NULL
+ *             - 4 response status is not 0
+ * @note       it connects, waits for the response and disconnects
+ */
+uint8_t ms5837_broker_request(const char *path, uint8_t index, uint32_t max_age_us, ms5837_broker_response_t *response);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_bus.h
+ * @brief     raspberrypi4b driver ms5837 bus header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MS5837_BUS_H
+#define RASPBERRYPI4B_DRIVER_MS5837_BUS_H
+
+#include "driver_ms5837_interface.h"
+#include "driver_ms5837_log.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_bus_driver ms5837 bus driver function
+ * @brief    ms5837 bus driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 bus max number definition
+ */
+#define MS5837_BUS_MAX_NUM        4        /**< max bus number */
+
+/**
+ * @brief     link a handle to an iic bus slot
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] index bus slot index
+ * @param[in] *name pointer to an iic device name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 link failed
+ *            - 2 handle is NULL
+ * @note      every ms5837 answers at the same address, so each sensor needs its own bus,
+ *            this links the handle to iic functions bound to the device of the slot,
+ *            the linked bus_recover only reopens the iic adapter, it doesn't clock scl or send a stop,
+ *            so it can't free a slave holding sda low, enable the recovery of the kernel iic adapter for that
+ */
+uint8_t ms5837_bus_link(ms5837_handle_t *handle, uint8_t index, const char *name);
+
+/**
+ * @brief     trace the events of a bus slot into a log
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] index bus slot index
+ * @param[in] *log pointer to a log structure, NULL restores the debug print
+ * @return    status code
+ *            - 0 success
+ *            - 1 trace failed
+ *            - 2 handle is NULL
+ * @note      call it after ms5837_bus_link, the events carry the slot index as the source
+ *            and the log must only be filled from one thread
+ */
+uint8_t ms5837_bus_trace(ms5837_handle_t *handle, uint8_t index, ms5837_log_t *log);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
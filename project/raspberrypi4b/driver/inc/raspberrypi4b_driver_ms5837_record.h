@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_record.h
+ * @brief     raspberrypi4b driver ms5837 record header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MS5837_RECORD_H
+#define RASPBERRYPI4B_DRIVER_MS5837_RECORD_H
+
+#include "driver_ms5837_interface.h"
+#include "driver_ms5837_replay.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_record_driver ms5837 record driver function
+ * @brief    ms5837 record driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 record file definition
+ */
+#define MS5837_RECORD_MAGIC          "MS5837TR"        /**< file magic */
+#define MS5837_RECORD_VERSION        1                 /**< file version */
+
+/**
+ * @brief ms5837 record file header structure definition
+ * @note  the header and the records are stored in the host byte order
+ */
+typedef struct ms5837_record_header_s
+{
+    char magic[8];               /**< file magic */
+    uint32_t version;            /**< file version */
+    uint32_t record_size;        /**< size of one record */
+} ms5837_record_header_t;
+
+/**
+ * @brief     start recording the iic transfers of a handle
+ * @param[in] *handle pointer to a linked ms5837 handle structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 3 a recording is running
+ * @note      it wraps the linked iic_read and iic_write, start it before ms5837_init so the prom is recorded,
+ *            only one handle can be recorded at a time
+ */
+uint8_t ms5837_record_start(ms5837_handle_t *handle, const char *path);
+
+/**
+ * @brief     stop recording
+ * @param[in] *handle pointer to the recorded ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 no recording is running
+ * @note      it restores the linked iic_read and iic_write
+ */
+uint8_t ms5837_record_stop(ms5837_handle_t *handle);
+
+/**
+ * @brief      load a recorded file
+ * @param[in]  *path pointer to a file path
+ * @param[out] **record pointer to a record array pointer
+ * @param[out] *num pointer to a record number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ *             - 4 file is invalid
+ * @note       free the records with ms5837_record_free
+ */
+uint8_t ms5837_record_load(const char *path, ms5837_replay_record_t **record, uint32_t *num);
+
+/**
+ * @brief     free the loaded records
+ * @param[in] *record pointer to a record array
+ * @note      none
+ */
+void ms5837_record_free(ms5837_replay_record_t *record);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_rt.h
+ * @brief     raspberrypi4b driver ms5837 real time header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MS5837_RT_H
+#define RASPBERRYPI4B_DRIVER_MS5837_RT_H
+
+#include "raspberrypi4b_driver_ms5837_sampler.h"
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_rt_driver ms5837 real time driver function
+ * @brief    ms5837 real time driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 rt config structure definition
+ */
+typedef struct ms5837_rt_config_s
+{
+    uint32_t period_us;            /**< sampling period */
+    int32_t priority;              /**< SCHED_FIFO priority, 0 keeps the default scheduler */
+    int32_t cpu;                   /**< pinned cpu, -1 keeps the default affinity */
+    uint8_t lock_memory;           /**< lock all current and future pages */
+    uint32_t spin_us;              /**< spin window before each deadline, 0 calibrates it */
+    uint32_t prefault_kb;          /**< stack size touched before sampling */
+} ms5837_rt_config_t;
+
+/**
+ * @brief ms5837 rt statistics structure definition
+ */
+typedef struct ms5837_rt_stats_s
+{
+    uint64_t samples;                    /**< completed samples */
+    uint64_t missed;                     /**< skipped periods */
+    uint64_t errors;                     /**< failed samples */
+    uint64_t resyncs;                    /**< resyncs after a failed sample */
+    int64_t jitter_min_ns;               /**< min wakeup error of the period deadline */
+    int64_t jitter_max_ns;               /**< max wakeup error of the period deadline */
+    double jitter_mean_ns;               /**< mean wakeup error of the period deadline */
+    double jitter_m2;                    /**< sum of squared deviations */
+    int64_t convert_max_ns;              /**< max wakeup error of the conversion deadlines */
+    uint32_t spin_ns;                    /**< spin window in use */
+} ms5837_rt_stats_t;
+
+/**
+ * @brief ms5837 rt structure definition
+ */
+typedef struct ms5837_rt_s
+{
+    ms5837_handle_t *handle;                                                    /**< ms5837 handle */
+    void (*receive)(ms5837_sampler_sample_t *sample);                          /**< sample callback */
+    ms5837_rt_config_t config;                                                  /**< config */
+    ms5837_sampler_sample_t *buffer;                                            /**< sample buffer */
+    uint32_t buffer_len;                                                        /**< sample buffer length */
+    uint32_t buffer_count;                                                      /**< stored samples */
+    uint64_t times;                                                             /**< sample times, 0 runs until stop */
+    pthread_t thread;                                                           /**< sampling thread */
+    uint8_t stop;                                                               /**< stop flag */
+    uint8_t running;                                                            /**< running flag */
+    ms5837_rt_stats_t stats;                                                    /**< statistics */
+} ms5837_rt_t;
+
+/**
+ * @brief      get the default rt config
+ * @param[out] *config pointer to a config structure
+ * @note       none
+ */
+void ms5837_rt_default_config(ms5837_rt_config_t *config);
+
+/**
+ * @brief     start the real time sampling thread
+ * @param[in] *rt pointer to an rt structure
+ * @param[in] *handle pointer to an initialized ms5837 handle structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] *buffer pointer to a sample buffer, can be NULL
+ * @param[in] len sample buffer length
+ * @param[in] times sample times, 0 runs until stop
+ * @param[in] *receive pointer to a sample callback, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 rt is NULL
+ *            - 3 lock memory failed
+ *            - 4 thread create failed
+ * @note      the callback runs in the sampling thread and must not block
+ */
+uint8_t ms5837_rt_start(ms5837_rt_t *rt, ms5837_handle_t *handle, const ms5837_rt_config_t *config,
+                        ms5837_sampler_sample_t *buffer, uint32_t len, uint64_t times,
+                        void (*receive)(ms5837_sampler_sample_t *sample));
+
+/**
+ * @brief     wait for the sampling thread to finish the sample times
+ * @param[in] *rt pointer to an rt structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 rt is NULL
+ *            - 3 rt is not running
+ * @note      none
+ */
+uint8_t ms5837_rt_wait(ms5837_rt_t *rt);
+
+/**
+ * @brief     stop the sampling thread and report the jitter statistics
+ * @param[in] *rt pointer to an rt structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 rt is NULL
+ *            - 3 rt is not running
+ * @note      none
+ */
+uint8_t ms5837_rt_stop(ms5837_rt_t *rt);
+
+/**
+ * @brief      get the rt statistics
+ * @param[in]  *rt pointer to an rt structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rt is NULL
+ * @note       read it after the thread has stopped
+ */
+uint8_t ms5837_rt_get_stats(ms5837_rt_t *rt, ms5837_rt_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_sampler.h
+ * @brief     raspberrypi4b driver ms5837 sampler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MS5837_SAMPLER_H
+#define RASPBERRYPI4B_DRIVER_MS5837_SAMPLER_H
+
+#include "driver_ms5837_interface.h"
+#include "driver_ms5837_deadband.h"
+#include "driver_ms5837_kalman.h"
+#include "driver_ms5837_predict.h"
+#include "driver_ms5837_trigger.h"
+#include "driver_ms5837_wave.h"
+#include "driver_ms5837_window.h"
+#include "raspberrypi4b_driver_ms5837_shm.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_sampler_driver ms5837 sampler driver function
+ * @brief    ms5837 sampler driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 sampler max sensor number definition
+ */
+#define MS5837_SAMPLER_MAX_SENSOR        4        /**< max sensor number */
+
+/**
+ * @brief ms5837 sampler sample structure definition
+ */
+typedef struct ms5837_sampler_sample_s
+{
+    uint64_t deadline_ns;            /**< scheduled sampling time in CLOCK_MONOTONIC ns */
+    uint64_t timestamp_ns;           /**< time the sample was completed in CLOCK_MONOTONIC ns */
+    uint32_t temperature_raw;        /**< raw temperature */
+    uint32_t pressure_raw;           /**< raw pressure */
+    float temperature_c;             /**< converted temperature */
+    float pressure_mbar;             /**< converted pressure */
+    uint8_t reason;                  /**< deadband report reason mask, 0 without a deadband */
+} ms5837_sampler_sample_t;
+
+/**
+ * @brief ms5837 sampler statistics structure definition
+ */
+typedef struct ms5837_sampler_stats_s
+{
+    uint64_t samples;                /**< completed samples */
+    uint64_t missed;                 /**< deadlines passed without starting a sample */
+    uint64_t errors;                 /**< failed samples */
+    uint64_t resyncs;                /**< resyncs after a failed sample */
+    uint64_t max_lateness_ns;        /**< max delay from deadline to conversion start */
+} ms5837_sampler_stats_t;
+
+/**
+ * @brief ms5837 sampler sensor structure definition
+ */
+typedef struct ms5837_sampler_sensor_s
+{
+    ms5837_handle_t *handle;                                                    /**< ms5837 handle */
+    void (*receive)(uint8_t index, ms5837_sampler_sample_t *sample);           /**< sample callback */
+    uint64_t period_ns;                                                         /**< sampling period */
+    uint64_t deadline_ns;                                                       /**< current deadline */
+    int period_fd;                                                              /**< period timer */
+    int convert_fd;                                                             /**< conversion timer */
+    uint32_t temperature_raw;                                                   /**< pending raw temperature */
+    uint8_t state;                                                              /**< conversion state */
+    uint8_t resync;                                                             /**< resync before the next cycle */
+    ms5837_sampler_stats_t stats;                                               /**< statistics */
+    ms5837_sampler_sample_t latest;                                             /**< latest completed sample */
+    volatile uint32_t latest_seq;                                               /**< odd while latest is written */
+    volatile uint8_t latest_valid;                                              /**< latest sample valid flag */
+    ms5837_window_t *window;                                                    /**< window statistics of the samples */
+    ms5837_trigger_t *trigger;                                                  /**< event rules of the samples */
+    int trigger_fd;                                                             /**< eventfd signaled on events */
+    ms5837_deadband_t *deadband;                                                /**< report by exception filter of the samples */
+    ms5837_shm_publisher_t *publisher;                                          /**< shared memory ring of the samples */
+    ms5837_predict_t *predict;                                                  /**< pressure predictor of the samples */
+    ms5837_kalman_t *kalman;                                                    /**< depth estimator of the samples */
+    ms5837_wave_t *wave;                                                        /**< wave analyser of the samples */
+} ms5837_sampler_sensor_t;
+
+/**
+ * @brief ms5837 sampler structure definition
+ */
+typedef struct ms5837_sampler_s
+{
+    int epoll_fd;                                                  /**< epoll handle */
+    uint8_t num;                                                   /**< sensor number */
+    uint8_t running;                                               /**< running flag */
+    ms5837_sampler_sensor_t sensor[MS5837_SAMPLER_MAX_SENSOR];     /**< sensors */
+} ms5837_sampler_t;
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 sampler is NULL
+ * @note      none
+ */
+uint8_t ms5837_sampler_init(ms5837_sampler_t *sampler);
+
+/**
+ * @brief     sampler deinit
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ * @note      the linked handles are not closed
+ */
+uint8_t ms5837_sampler_deinit(ms5837_sampler_t *sampler);
+
+/**
+ * @brief      add an initialized sensor to the sampler
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  *handle pointer to an initialized ms5837 handle structure
+ * @param[in]  period_us sampling period in us
+ * @param[in]  *receive pointer to a sample callback
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 sampler is NULL
+ *             - 3 sampler is full
+ *             - 4 period is shorter than a conversion cycle
+ * @note       each sensor must sit on its own bus
+ */
+uint8_t ms5837_sampler_add(ms5837_sampler_t *sampler, ms5837_handle_t *handle, uint32_t period_us,
+                           void (*receive)(uint8_t index, ms5837_sampler_sample_t *sample), uint8_t *index);
+
+/**
+ * @brief     start sampling
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 sampler is NULL
+ * @note      all sensors share the same absolute start time
+ */
+uint8_t ms5837_sampler_start(ms5837_sampler_t *sampler);
+
+/**
+ * @brief     stop sampling
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 sampler is NULL
+ * @note      a conversion in flight is dropped
+ */
+uint8_t ms5837_sampler_stop(ms5837_sampler_t *sampler);
+
+/**
+ * @brief     wait for timer events and run the sampling state machines
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] timeout_ms max wait time, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 sampler is NULL
+ *            - 3 sampler is not running
+ * @note      the sample callbacks run inside this function
+ */
+uint8_t ms5837_sampler_poll(ms5837_sampler_t *sampler, int32_t timeout_ms);
+
+/**
+ * @brief      get the sampler statistics of a sensor
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index sensor index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sampler is NULL
+ *             - 3 index is invalid
+ * @note       none
+ */
+uint8_t ms5837_sampler_get_stats(ms5837_sampler_t *sampler, uint8_t index, ms5837_sampler_stats_t *stats);
+
+/**
+ * @brief      get the latest completed sample of a sensor
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @param[out] *age_ns pointer to a sample age buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sampler is NULL
+ *             - 3 index is invalid
+ *             - 4 no sample is completed
+ * @note       it never waits for a conversion and can be called from any thread while another one polls,
+ *             the sample is kept whether a deadband reports it or not
+ */
+uint8_t ms5837_sampler_get_latest(ms5837_sampler_t *sampler, uint8_t index, ms5837_sampler_sample_t *sample, uint64_t *age_ns);
+
+/**
+ * @brief      wait for the next completed sample of a sensor
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @param[in]  timeout_ms max wait time, -1 waits forever
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ *             - 2 sampler is NULL
+ *             - 3 index is invalid
+ *             - 4 timeout
+ *             - 5 sampler is not running
+ * @note       it polls the sampler until the conversion in flight or the next scheduled one completes,
+ *             no extra conversion is started, call it from the thread that polls the sampler
+ */
+uint8_t ms5837_sampler_get_fresh(ms5837_sampler_t *sampler, uint8_t index, ms5837_sampler_sample_t *sample, int32_t timeout_ms);
+
+/**
+ * @brief     attach a window to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *window pointer to an initialized window structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is compensated in integers and added to the window in the sampler thread,
+ *            read the summary with ms5837_window_get from the receive callback or between polls
+ */
+uint8_t ms5837_sampler_set_window(ms5837_sampler_t *sampler, uint8_t index, ms5837_window_t *window);
+
+/**
+ * @brief     attach a trigger to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *trigger pointer to an initialized trigger structure, NULL to detach
+ * @param[in] fd eventfd written when a sample fires events, -1 for none
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is evaluated in the sampler thread, the trigger callback runs there too,
+ *            a consumer can sleep in read or poll on the eventfd and pop the events after it wakes
+ */
+uint8_t ms5837_sampler_set_trigger(ms5837_sampler_t *sampler, uint8_t index, ms5837_trigger_t *trigger, int fd);
+
+/**
+ * @brief     attach a deadband to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *deadband pointer to an initialized deadband structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is compensated in integers and checked in the sampler thread,
+ *            the receive callback only gets the reported samples, the window and the trigger still get all
+ */
+uint8_t ms5837_sampler_set_deadband(ms5837_sampler_t *sampler, uint8_t index, ms5837_deadband_t *deadband);
+
+/**
+ * @brief     attach a shared memory publisher to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *publisher pointer to an opened publisher structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every reported sample is published in the sampler thread before the receive callback,
+ *            several sensors can share one publisher and the index of the sample tells them apart
+ */
+uint8_t ms5837_sampler_set_publisher(ms5837_sampler_t *sampler, uint8_t index, ms5837_shm_publisher_t *publisher);
+
+/**
+ * @brief     attach a pressure predictor to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *predict pointer to an initialized predict structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample updates the predictor in the sampler thread with its timestamp in CLOCK_MONOTONIC us,
+ *            query it with ms5837_predict_get from any thread on the same clock
+ */
+uint8_t ms5837_sampler_set_predict(ms5837_sampler_t *sampler, uint8_t index, ms5837_predict_t *predict);
+
+/**
+ * @brief     attach a depth estimator to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *kalman pointer to an initialized kalman structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample updates the estimator in the sampler thread with its timestamp in CLOCK_MONOTONIC us,
+ *            query it with ms5837_kalman_get from any thread on the same clock
+ */
+uint8_t ms5837_sampler_set_kalman(ms5837_sampler_t *sampler, uint8_t index, ms5837_kalman_t *kalman);
+
+/**
+ * @brief     attach a wave analyser to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *wave pointer to an initialized wave structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is added to the analyser in the sampler thread with its timestamp in CLOCK_MONOTONIC us,
+ *            the ffts run in the sampler thread, read the summaries with ms5837_wave_get_summary from any thread
+ */
+uint8_t ms5837_sampler_set_wave(ms5837_sampler_t *sampler, uint8_t index, ms5837_wave_t *wave);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
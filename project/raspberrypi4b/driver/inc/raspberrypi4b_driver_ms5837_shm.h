@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_shm.h
+ * @brief     raspberrypi4b driver ms5837 shm header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MS5837_SHM_H
+#define RASPBERRYPI4B_DRIVER_MS5837_SHM_H
+
+#include "driver_ms5837_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_shm_driver ms5837 shm driver function
+ * @brief    ms5837 shm driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 shm ring definition
+ */
+#define MS5837_SHM_MAGIC          0x4D533537U        /**< ring magic */
+#define MS5837_SHM_VERSION        1                  /**< ring version */
+
+/**
+ * @brief ms5837 shm sample structure definition
+ * @note  one slot of the ring, it fills a cache line
+ */
+typedef struct ms5837_shm_sample_s
+{
+    uint64_t seq;                    /**< sequence number from 1, it is 0 while the slot is written */
+    uint64_t deadline_ns;            /**< scheduled sampling time in CLOCK_MONOTONIC ns */
+    uint64_t timestamp_ns;           /**< time the sample was completed in CLOCK_MONOTONIC ns */
+    int32_t temperature;             /**< temperature from ms5837_compensate */
+    int32_t pressure;                /**< pressure from ms5837_compensate */
+    uint32_t temperature_raw;        /**< raw temperature */
+    uint32_t pressure_raw;           /**< raw pressure */
+    float temperature_c;             /**< converted temperature */
+    float pressure_mbar;             /**< converted pressure */
+    uint8_t index;                   /**< sensor index */
+    uint8_t reason;                  /**< deadband report reason mask */
+    uint8_t reserved[10];            /**< reserved */
+} ms5837_shm_sample_t;
+
+/**
+ * @brief ms5837 shm header structure definition
+ * @note  the header is followed by size slots
+ */
+typedef struct ms5837_shm_header_s
+{
+    uint32_t magic;                  /**< ring magic, written last */
+    uint32_t version;                /**< ring version */
+    uint32_t size;                   /**< slot number */
+    uint32_t slot_size;              /**< size of one slot */
+    volatile uint64_t epoch;         /**< publisher start time, it changes when the publisher restarts */
+    volatile uint64_t head;          /**< published samples */
+    uint8_t reserved[32];            /**< reserved */
+} ms5837_shm_header_t;
+
+/**
+ * @brief ms5837 shm publisher structure definition
+ */
+typedef struct ms5837_shm_publisher_s
+{
+    ms5837_shm_header_t *header;        /**< mapped header */
+    ms5837_shm_sample_t *slot;          /**< mapped slots */
+    size_t len;                         /**< mapped length */
+    uint64_t head;                      /**< published samples */
+} ms5837_shm_publisher_t;
+
+/**
+ * @brief ms5837 shm subscriber structure definition
+ */
+typedef struct ms5837_shm_subscriber_s
+{
+    const ms5837_shm_header_t *header;        /**< mapped header */
+    const ms5837_shm_sample_t *slot;          /**< mapped slots */
+    size_t len;                               /**< mapped length */
+    uint64_t epoch;                           /**< epoch of the publisher */
+    uint64_t next;                            /**< next sequence number to read */
+    uint64_t lost;                            /**< samples overwritten before they were read */
+    uint32_t decimation;                      /**< read every decimation sample */
+    uint32_t size;                            /**< slot number checked at open */
+} ms5837_shm_subscriber_t;
+
+/**
+ * @brief     open a publisher
+ * @param[in] *publisher pointer to a publisher structure
+ * @param[in] *name pointer to a shared memory name like "/ms5837"
+ * @param[in] size slot number
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 publisher is NULL
+ *            - 4 size is invalid
+ * @note      an existing ring of the name is reset and reused, so attached subscribers follow a restarted publisher,
+ *            it is never shrunk so the mappings of the attached subscribers stay valid
+ */
+uint8_t ms5837_shm_publisher_open(ms5837_shm_publisher_t *publisher, const char *name, uint32_t size);
+
+/**
+ * @brief     close a publisher
+ * @param[in] *publisher pointer to a publisher structure
+ * @param[in] *name pointer to the shared memory name to remove, NULL keeps it
+ * @return    status code
+ *            - 0 success
+ *            - 2 publisher is NULL
+ *            - 3 publisher is not opened
+ * @note      keep the name when the publisher restarts, mapped subscribers can't see a removed name
+ */
+uint8_t ms5837_shm_publisher_close(ms5837_shm_publisher_t *publisher, const char *name);
+
+/**
+ * @brief     publish a sample
+ * @param[in] *publisher pointer to a publisher structure
+ * @param[in] *sample pointer to a sample structure, seq is filled by the publisher
+ * @return    status code
+ *            - 0 success
+ *            - 2 publisher is NULL
+ *            - 3 publisher is not opened
+ * @note      only one thread can publish, it never waits for the subscribers
+ */
+uint8_t ms5837_shm_publish(ms5837_shm_publisher_t *publisher, const ms5837_shm_sample_t *sample);
+
+/**
+ * @brief     open a subscriber
+ * @param[in] *subscriber pointer to a subscriber structure
+ * @param[in] *name pointer to the shared memory name of the publisher
+ * @param[in] decimation read every decimation sample, 1 reads all
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 subscriber is NULL
+ *            - 4 decimation is invalid
+ *            - 5 ring is invalid
+ * @note      the subscriber starts with the next published sample
+ */
+uint8_t ms5837_shm_subscriber_open(ms5837_shm_subscriber_t *subscriber, const char *name, uint32_t decimation);
+
+/**
+ * @brief     close a subscriber
+ * @param[in] *subscriber pointer to a subscriber structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 subscriber is NULL
+ *            - 3 subscriber is not opened
+ * @note      none
+ */
+uint8_t ms5837_shm_subscriber_close(ms5837_shm_subscriber_t *subscriber);
+
+/**
+ * @brief      read the next sample
+ * @param[in]  *subscriber pointer to a subscriber structure
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no new sample
+ *             - 2 subscriber is NULL
+ *             - 3 subscriber is not opened
+ *             - 4 ring is resized, reopen the subscriber
+ *             - 5 ring is invalid
+ * @note       it reads the mapped ring without locks or syscalls, a slow subscriber skips to the oldest
+ *             sample and counts the overwritten samples as lost, a gap in seq shows it,
+ *             it only trusts the slot number checked at open, never the live header
+ */
+uint8_t ms5837_shm_subscriber_read(ms5837_shm_subscriber_t *subscriber, ms5837_shm_sample_t *sample);
+
+/**
+ * @brief      get the lost samples
+ * @param[in]  *subscriber pointer to a subscriber structure
+ * @param[out] *lost pointer to a lost sample number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 subscriber is NULL
+ *             - 3 subscriber is not opened
+ * @note       decimated samples are not lost
+ */
+uint8_t ms5837_shm_subscriber_get_lost(ms5837_shm_subscriber_t *subscriber, uint64_t *lost);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
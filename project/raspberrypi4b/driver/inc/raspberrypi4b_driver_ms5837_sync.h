@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_sync.h
+ * @brief     raspberrypi4b driver ms5837 sync header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_MS5837_SYNC_H
+#define RASPBERRYPI4B_DRIVER_MS5837_SYNC_H
+
+#include "driver_ms5837_fusion.h"
+#include "raspberrypi4b_driver_ms5837_bus.h"
+#include "raspberrypi4b_driver_ms5837_sampler.h"
+#include <pthread.h>
+#include <semaphore.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_sync_driver ms5837 sync driver function
+ * @brief    ms5837 sync driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 sync set structure definition
+ */
+typedef struct ms5837_sync_set_s
+{
+    uint64_t deadline_ns;                                    /**< common conversion start deadline */
+    uint64_t skew_ns;                                        /**< spread of the conversion start times */
+    uint8_t num;                                             /**< sensor number */
+    uint8_t valid;                                           /**< valid sample bit mask */
+    ms5837_sampler_sample_t sample[MS5837_BUS_MAX_NUM];      /**< samples of each bus */
+} ms5837_sync_set_t;
+
+/**
+ * @brief ms5837 sync statistics structure definition
+ */
+typedef struct ms5837_sync_stats_s
+{
+    uint64_t sets;                 /**< delivered sets */
+    uint64_t missed;               /**< skipped periods */
+    uint64_t errors;               /**< failed samples */
+    uint64_t resyncs;              /**< resyncs after a failed sample */
+    uint64_t max_skew_ns;          /**< max spread of the conversion start times */
+    uint64_t skew_sum_ns;          /**< sum of the spreads */
+} ms5837_sync_stats_t;
+
+/**
+ * @brief ms5837 sync worker structure definition
+ */
+typedef struct ms5837_sync_worker_s
+{
+    struct ms5837_sync_s *sync;                  /**< owner */
+    ms5837_handle_t *handle;                     /**< ms5837 handle */
+    pthread_t thread;                            /**< worker thread */
+    uint64_t start_ns;                           /**< conversion start time */
+    uint8_t ok;                                  /**< sample valid flag */
+    ms5837_sampler_sample_t sample;              /**< last sample */
+} ms5837_sync_worker_t;
+
+/**
+ * @brief ms5837 sync structure definition
+ */
+typedef struct ms5837_sync_s
+{
+    ms5837_sync_worker_t worker[MS5837_BUS_MAX_NUM];        /**< one worker per bus */
+    uint8_t num;                                            /**< worker number */
+    uint32_t period_us;                                     /**< sampling period */
+    uint64_t times;                                         /**< set times, 0 runs until stop */
+    void (*receive)(ms5837_sync_set_t *set);                /**< set callback */
+    pthread_t thread;                                       /**< controller thread */
+    pthread_barrier_t start;                                /**< start barrier */
+    pthread_barrier_t done;                                 /**< done barrier */
+    sem_t launch;                                           /**< launch gate of the workers */
+    uint64_t deadline_ns;                                   /**< deadline of the current set */
+    uint8_t quit;                                           /**< worker quit flag */
+    uint8_t stop;                                           /**< stop flag */
+    uint8_t running;                                        /**< running flag */
+    ms5837_sync_stats_t stats;                              /**< statistics */
+    ms5837_fusion_t *fusion;                                /**< fusion stage of the sets */
+} ms5837_sync_t;
+
+/**
+ * @brief     start the synchronized sampling
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] **handle pointer to an array of initialized handles, each on its own bus
+ * @param[in] num handle number
+ * @param[in] period_us sampling period
+ * @param[in] times set times, 0 runs until stop
+ * @param[in] *fusion pointer to an initialized fusion structure with one sensor per handle, can be NULL
+ * @param[in] *receive pointer to a set callback, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 sync is NULL
+ *            - 4 thread create failed
+ * @note      every period all workers leave a barrier and start the conversions at the same deadline,
+ *            the fusion votes every set from the first one and the callback runs after it in the controller thread,
+ *            a failed worker reports its set at once and resyncs before the next one,
+ *            the pressure unit of each sensor comes from the applied type of its handle
+ */
+uint8_t ms5837_sync_start(ms5837_sync_t *sync, ms5837_handle_t **handle, uint8_t num, uint32_t period_us,
+                          uint64_t times, ms5837_fusion_t *fusion, void (*receive)(ms5837_sync_set_t *set));
+
+/**
+ * @brief     wait for the synchronized sampling to finish the set times
+ * @param[in] *sync pointer to a sync structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sync is NULL
+ *            - 3 sync is not running
+ * @note      none
+ */
+uint8_t ms5837_sync_wait(ms5837_sync_t *sync);
+
+/**
+ * @brief     stop the synchronized sampling
+ * @param[in] *sync pointer to a sync structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sync is NULL
+ *            - 3 sync is not running
+ * @note      the current set is finished first
+ */
+uint8_t ms5837_sync_stop(ms5837_sync_t *sync);
+
+/**
+ * @brief      get the sync statistics
+ * @param[in]  *sync pointer to a sync structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sync is NULL
+ * @note       read it after the threads have stopped
+ */
+uint8_t ms5837_sync_get_stats(ms5837_sync_t *sync, ms5837_sync_stats_t *stats);
+
+/**
+ * @brief     attach a fusion stage to the synchronized sampling
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] *fusion pointer to an initialized fusion structure with one sensor per handle, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sync is NULL
+ *            - 3 sync is not running
+ *            - 4 fusion sensor number is not the handle number
+ * @note      it swaps the fusion of ms5837_sync_start while running, every later set is voted in the controller thread
+ *            as soon as the last worker is done and before the callback, read it with ms5837_fusion_get
+ */
+uint8_t ms5837_sync_set_fusion(ms5837_sync_t *sync, ms5837_fusion_t *fusion);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
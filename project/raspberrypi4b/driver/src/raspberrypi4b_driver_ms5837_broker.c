@@ -0,0 +1,730 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_broker.c
+ * @brief     raspberrypi4b driver ms5837 broker source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "raspberrypi4b_driver_ms5837_broker.h"
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief broker state definition
+ */
+#define BROKER_STATE_IDLE                0        /**< no conversion in flight */
+#define BROKER_STATE_WAIT_TEMPERATURE    1        /**< d2 conversion in flight */
+#define BROKER_STATE_WAIT_PRESSURE       2        /**< d1 conversion in flight */
+
+/**
+ * @brief broker event definition
+ */
+#define BROKER_EVENT_LISTEN     0        /**< listening socket event */
+#define BROKER_EVENT_CONVERT    1        /**< conversion timer event */
+#define BROKER_EVENT_CLIENT     2        /**< client socket event */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_broker_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     arm the conversion timer
+ * @param[in] *sensor pointer to a broker sensor structure
+ * @param[in] osr conversion osr
+ * @return    status code
+ *            - 0 success
+ *            - 1 arm failed
+ * @note      none
+ */
+static uint8_t a_broker_arm_convert(ms5837_broker_sensor_t *sensor, ms5837_osr_t osr)
+{
+    struct itimerspec its;
+    uint32_t us;
+    
+    if (ms5837_get_convert_time(sensor->handle, osr, &us) != 0)
+    {
+        return 1;
+    }
+    memset(&its, 0, sizeof(struct itimerspec));
+    its.it_value.tv_sec = (time_t)(us / 1000000U);
+    its.it_value.tv_nsec = (long)(us % 1000000U) * 1000L;
+    if (timerfd_settime(sensor->convert_fd, 0, &its, NULL) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     set the events of a client
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] slot client slot
+ * @param[in] events epoll events, 0 stops reading while the client waits
+ * @note      none
+ */
+static void a_broker_watch(ms5837_broker_t *broker, uint8_t slot, uint32_t events)
+{
+    struct epoll_event event;
+    
+    memset(&event, 0, sizeof(struct epoll_event));
+    event.events = events;
+    event.data.u32 = ((uint32_t)BROKER_EVENT_CLIENT << 8) | slot;
+    (void)epoll_ctl(broker->epoll_fd, EPOLL_CTL_MOD, broker->client[slot], &event);
+}
+
+/**
+ * @brief     close a client
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] slot client slot
+ * @note      none
+ */
+static void a_broker_close(ms5837_broker_t *broker, uint8_t slot)
+{
+    uint8_t i;
+    
+    (void)epoll_ctl(broker->epoll_fd, EPOLL_CTL_DEL, broker->client[slot], NULL);
+    (void)close(broker->client[slot]);
+    broker->client[slot] = -1;
+    for (i = 0; i < broker->num; i++)
+    {
+        broker->sensor[i].waiting &= ~(1U << slot);
+    }
+}
+
+/**
+ * @brief     send a response to a client
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] slot client slot
+ * @param[in] *response pointer to a response structure
+ * @note      a client that can't take the response is closed
+ */
+static void a_broker_send(ms5837_broker_t *broker, uint8_t slot, const ms5837_broker_response_t *response)
+{
+    if (send(broker->client[slot], response, sizeof(ms5837_broker_response_t), MSG_NOSIGNAL | MSG_DONTWAIT) !=
+        (ssize_t)sizeof(ms5837_broker_response_t))
+    {
+        a_broker_close(broker, slot);
+    }
+}
+
+/**
+ * @brief     send the cached sample to a client
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] slot client slot
+ * @param[in] *sensor pointer to a broker sensor structure
+ * @param[in] now current time in ns
+ * @note      none
+ */
+static void a_broker_send_cache(ms5837_broker_t *broker, uint8_t slot, ms5837_broker_sensor_t *sensor, uint64_t now)
+{
+    uint64_t age_us;
+    
+    age_us = (now - sensor->cache.timestamp_ns) / 1000ULL;
+    sensor->cache.age_us = (age_us > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32_t)age_us;
+    sensor->cache.shared++;
+    a_broker_send(broker, slot, &sensor->cache);
+}
+
+/**
+ * @brief     answer all clients waiting for a sensor
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] *sensor pointer to a broker sensor structure
+ * @param[in] index sensor index
+ * @param[in] status 0 sends the cached sample, else an error response
+ * @note      the clients are read again after the response
+ */
+static void a_broker_reply(ms5837_broker_t *broker, ms5837_broker_sensor_t *sensor, uint8_t index, uint8_t status)
+{
+    ms5837_broker_response_t response;
+    uint32_t waiting;
+    uint64_t now;
+    uint8_t slot;
+    
+    now = a_broker_now_ns();
+    waiting = sensor->waiting;
+    sensor->waiting = 0;
+    memset(&response, 0, sizeof(ms5837_broker_response_t));
+    response.index = index;
+    response.status = status;
+    for (slot = 0; slot < MS5837_BROKER_MAX_CLIENT; slot++)
+    {
+        if ((waiting & (1U << slot)) == 0)
+        {
+            continue;
+        }
+        a_broker_watch(broker, slot, EPOLLIN);
+        if (status == 0)
+        {
+            a_broker_send_cache(broker, slot, sensor, now);
+        }
+        else
+        {
+            a_broker_send(broker, slot, &response);
+        }
+    }
+}
+
+/**
+ * @brief     start a conversion cycle
+ * @param[in] *sensor pointer to a broker sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      none
+ */
+static uint8_t a_broker_start(ms5837_broker_sensor_t *sensor)
+{
+    ms5837_osr_t osr;
+    
+    /* resync the sensor after a failed cycle */
+    if (sensor->resync != 0)
+    {
+        if (ms5837_resync(sensor->handle) != 0)
+        {
+            return 1;
+        }
+        sensor->resync = 0;
+    }
+    
+    /* start the temperature conversion, a staged configuration takes effect here */
+    if ((ms5837_start_temperature_convert(sensor->handle) != 0) ||
+        (ms5837_get_temperature_osr(sensor->handle, &osr) != 0) ||
+        (a_broker_arm_convert(sensor, osr) != 0))
+    {
+        sensor->resync = 1;
+        
+        return 1;
+    }
+    sensor->state = BROKER_STATE_WAIT_TEMPERATURE;
+    sensor->stats.conversions++;
+    
+    return 0;
+}
+
+/**
+ * @brief     handle a conversion timer event
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] index sensor index
+ * @note      none
+ */
+static void a_broker_convert(ms5837_broker_t *broker, uint8_t index)
+{
+    ms5837_broker_sensor_t *sensor = &broker->sensor[index];
+    ms5837_broker_response_t *cache = &sensor->cache;
+    uint64_t expirations;
+    uint32_t pressure_raw;
+    ms5837_osr_t osr;
+    
+    /* clear the timer */
+    if (read(sensor->convert_fd, &expirations, sizeof(uint64_t)) != (ssize_t)sizeof(uint64_t))
+    {
+        return;
+    }
+    
+    if (sensor->state == BROKER_STATE_WAIT_TEMPERATURE)
+    {
+        /* read the temperature and start the pressure conversion */
+        (void)ms5837_get_pressure_osr(sensor->handle, &osr);
+        if ((ms5837_read_adc(sensor->handle, &sensor->temperature_raw) != 0) ||
+            (ms5837_start_pressure_convert(sensor->handle) != 0) ||
+            (a_broker_arm_convert(sensor, osr) != 0))
+        {
+            goto failed;
+        }
+        sensor->state = BROKER_STATE_WAIT_PRESSURE;
+    }
+    else if (sensor->state == BROKER_STATE_WAIT_PRESSURE)
+    {
+        /* read the pressure and serve every waiting client */
+        sensor->state = BROKER_STATE_IDLE;
+        if (ms5837_read_adc(sensor->handle, &pressure_raw) != 0)
+        {
+            goto failed;
+        }
+        memset(cache, 0, sizeof(ms5837_broker_response_t));
+        cache->timestamp_ns = a_broker_now_ns();
+        (void)ms5837_compensate(sensor->handle, sensor->temperature_raw, &cache->temperature, pressure_raw, &cache->pressure);
+        (void)ms5837_calculate_temperature_pressure(sensor->handle, sensor->temperature_raw, &cache->temperature_c,
+                                                    pressure_raw, &cache->pressure_mbar);
+        cache->index = index;
+        sensor->valid = 1;
+        a_broker_reply(broker, sensor, index, 0);
+    }
+    else
+    {
+        /* stale event */
+    }
+    
+    return;
+    
+    failed:
+    sensor->stats.errors++;
+    sensor->resync = 1;
+    sensor->state = BROKER_STATE_IDLE;
+    a_broker_reply(broker, sensor, index, 1);
+}
+
+/**
+ * @brief     accept the pending clients
+ * @param[in] *broker pointer to a broker structure
+ * @note      a client over MS5837_BROKER_MAX_CLIENT is closed at once
+ */
+static void a_broker_accept(ms5837_broker_t *broker)
+{
+    struct epoll_event event;
+    uint8_t slot;
+    int fd;
+    
+    while ((fd = accept4(broker->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+    {
+        for (slot = 0; slot < MS5837_BROKER_MAX_CLIENT; slot++)
+        {
+            if (broker->client[slot] < 0)
+            {
+                break;
+            }
+        }
+        if (slot >= MS5837_BROKER_MAX_CLIENT)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        memset(&event, 0, sizeof(struct epoll_event));
+        event.events = EPOLLIN;
+        event.data.u32 = ((uint32_t)BROKER_EVENT_CLIENT << 8) | slot;
+        if (epoll_ctl(broker->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        broker->client[slot] = fd;
+    }
+}
+
+/**
+ * @brief     handle a client event
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] slot client slot
+ * @param[in] events epoll events
+ * @note      none
+ */
+static void a_broker_client(ms5837_broker_t *broker, uint8_t slot, uint32_t events)
+{
+    ms5837_broker_request_t request;
+    ms5837_broker_response_t response;
+    ms5837_broker_sensor_t *sensor;
+    uint64_t now;
+    ssize_t n;
+    
+    if ((events & EPOLLIN) == 0)
+    {
+        a_broker_close(broker, slot);
+        
+        return;
+    }
+    n = recv(broker->client[slot], &request, sizeof(ms5837_broker_request_t), 0);
+    if ((n < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+    {
+        return;
+    }
+    if (n != (ssize_t)sizeof(ms5837_broker_request_t))
+    {
+        a_broker_close(broker, slot);
+        
+        return;
+    }
+    if (request.index >= broker->num)
+    {
+        memset(&response, 0, sizeof(ms5837_broker_response_t));
+        response.index = request.index;
+        response.status = 4;
+        a_broker_send(broker, slot, &response);
+        
+        return;
+    }
+    
+    /* serve a young enough cached sample at once */
+    sensor = &broker->sensor[request.index];
+    sensor->stats.requests++;
+    now = a_broker_now_ns();
+    if ((sensor->valid != 0) && (request.max_age_us != 0) &&
+        ((now - sensor->cache.timestamp_ns) <= (uint64_t)request.max_age_us * 1000ULL))
+    {
+        sensor->stats.cached++;
+        a_broker_send_cache(broker, slot, sensor, now);
+        
+        return;
+    }
+    
+    /* wait for the running conversion or start one, the client is not read until it is answered */
+    sensor->waiting |= 1U << slot;
+    a_broker_watch(broker, slot, 0);
+    if (sensor->state != BROKER_STATE_IDLE)
+    {
+        sensor->stats.coalesced++;
+        
+        return;
+    }
+    if (a_broker_start(sensor) != 0)
+    {
+        sensor->stats.errors++;
+        a_broker_reply(broker, sensor, request.index, 1);
+    }
+}
+
+/**
+ * @brief     broker init
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] *path pointer to a unix socket path
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 broker is NULL
+ *            - 4 path is too long
+ * @note      a stale socket file of the path is removed
+ */
+uint8_t ms5837_broker_init(ms5837_broker_t *broker, const char *path)
+{
+    struct sockaddr_un addr;
+    struct epoll_event event;
+    uint8_t i;
+    
+    if ((broker == NULL) || (path == NULL))
+    {
+        return 2;
+    }
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return 4;
+    }
+    
+    memset(broker, 0, sizeof(ms5837_broker_t));
+    for (i = 0; i < MS5837_BROKER_MAX_CLIENT; i++)
+    {
+        broker->client[i] = -1;
+    }
+    strncpy(broker->path, path, sizeof(broker->path) - 1);
+    broker->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    broker->listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if ((broker->epoll_fd < 0) || (broker->listen_fd < 0))
+    {
+        ms5837_interface_debug_print("ms5837: broker create failed.\n");
+        
+        goto failed;
+    }
+    
+    /* listen on the path */
+    memset(&addr, 0, sizeof(struct sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    (void)unlink(path);
+    if ((bind(broker->listen_fd, (struct sockaddr *)&addr, sizeof(struct sockaddr_un)) != 0) ||
+        (listen(broker->listen_fd, MS5837_BROKER_MAX_CLIENT) != 0))
+    {
+        ms5837_interface_debug_print("ms5837: broker listen failed.\n");
+        
+        goto failed;
+    }
+    memset(&event, 0, sizeof(struct epoll_event));
+    event.events = EPOLLIN;
+    event.data.u32 = (uint32_t)BROKER_EVENT_LISTEN << 8;
+    if (epoll_ctl(broker->epoll_fd, EPOLL_CTL_ADD, broker->listen_fd, &event) != 0)
+    {
+        ms5837_interface_debug_print("ms5837: epoll add failed.\n");
+        
+        goto failed;
+    }
+    
+    return 0;
+    
+    failed:
+    if (broker->listen_fd >= 0)
+    {
+        (void)close(broker->listen_fd);
+    }
+    if (broker->epoll_fd >= 0)
+    {
+        (void)close(broker->epoll_fd);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     broker deinit
+ * @param[in] *broker pointer to a broker structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 broker is NULL
+ * @note      the clients are disconnected, the socket file is removed and the linked handles are not closed
+ */
+uint8_t ms5837_broker_deinit(ms5837_broker_t *broker)
+{
+    uint8_t i;
+    
+    if (broker == NULL)
+    {
+        return 2;
+    }
+    
+    for (i = 0; i < MS5837_BROKER_MAX_CLIENT; i++)
+    {
+        if (broker->client[i] >= 0)
+        {
+            a_broker_close(broker, i);
+        }
+    }
+    for (i = 0; i < broker->num; i++)
+    {
+        (void)close(broker->sensor[i].convert_fd);
+    }
+    (void)close(broker->listen_fd);
+    (void)close(broker->epoll_fd);
+    (void)unlink(broker->path);
+    broker->num = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      add an initialized sensor to the broker
+ * @param[in]  *broker pointer to a broker structure
+ * @param[in]  *handle pointer to an initialized ms5837 handle structure
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 broker is NULL
+ *             - 3 broker is full
+ * @note       each sensor must sit on its own bus
+ */
+uint8_t ms5837_broker_add(ms5837_broker_t *broker, ms5837_handle_t *handle, uint8_t *index)
+{
+    ms5837_broker_sensor_t *sensor;
+    struct epoll_event event;
+    
+    if (broker == NULL)
+    {
+        return 2;
+    }
+    if (broker->num >= MS5837_BROKER_MAX_SENSOR)
+    {
+        ms5837_interface_debug_print("ms5837: broker is full.\n");
+        
+        return 3;
+    }
+    
+    /* create the conversion timer */
+    sensor = &broker->sensor[broker->num];
+    memset(sensor, 0, sizeof(ms5837_broker_sensor_t));
+    sensor->handle = handle;
+    sensor->convert_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (sensor->convert_fd < 0)
+    {
+        ms5837_interface_debug_print("ms5837: timer create failed.\n");
+        
+        return 1;
+    }
+    memset(&event, 0, sizeof(struct epoll_event));
+    event.events = EPOLLIN;
+    event.data.u32 = ((uint32_t)BROKER_EVENT_CONVERT << 8) | broker->num;
+    if (epoll_ctl(broker->epoll_fd, EPOLL_CTL_ADD, sensor->convert_fd, &event) != 0)
+    {
+        ms5837_interface_debug_print("ms5837: epoll add failed.\n");
+        (void)close(sensor->convert_fd);
+        
+        return 1;
+    }
+    *index = broker->num;
+    broker->num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     wait for clients and timer events and serve the requests
+ * @param[in] *broker pointer to a broker structure
+ * @param[in] timeout_ms max wait time, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 broker is NULL
+ * @note      a request is served from the cache when the cached sample is young enough, else it joins the
+ *            running conversion of the sensor or starts one, so one conversion serves all waiting clients
+ */
+uint8_t ms5837_broker_poll(ms5837_broker_t *broker, int32_t timeout_ms)
+{
+    struct epoll_event events[MS5837_BROKER_MAX_SENSOR + MS5837_BROKER_MAX_CLIENT + 1];
+    int n;
+    int i;
+    
+    if (broker == NULL)
+    {
+        return 2;
+    }
+    
+    n = epoll_wait(broker->epoll_fd, events, MS5837_BROKER_MAX_SENSOR + MS5837_BROKER_MAX_CLIENT + 1, timeout_ms);
+    if (n < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        ms5837_interface_debug_print("ms5837: epoll wait failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < n; i++)
+    {
+        uint8_t kind = (uint8_t)(events[i].data.u32 >> 8);
+        uint8_t index = (uint8_t)(events[i].data.u32 & 0xFF);
+        
+        if (kind == BROKER_EVENT_LISTEN)
+        {
+            a_broker_accept(broker);
+        }
+        else if (kind == BROKER_EVENT_CONVERT)
+        {
+            a_broker_convert(broker, index);
+        }
+        else if (broker->client[index] >= 0)
+        {
+            a_broker_client(broker, index, events[i].events);
+        }
+        else
+        {
+            /* closed earlier in this round */
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      get the statistics of a sensor
+ * @param[in]  *broker pointer to a broker structure
+ * @param[in]  index sensor index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 broker is NULL
+ *             - 3 index is invalid
+ * @note       none
+ */
+uint8_t ms5837_broker_get_stats(ms5837_broker_t *broker, uint8_t index, ms5837_broker_stats_t *stats)
+{
+    if (broker == NULL)
+    {
+        return 2;
+    }
+    if (index >= broker->num)
+    {
+        return 3;
+    }
+    
+    *stats = broker->sensor[index].stats;
+    
+    return 0;
+}
+
+/**
+ * @brief      request a sample from a broker
+ * @param[in]  *path pointer to the unix socket path of the broker
+ * @param[in]  index sensor index
+ * @param[in]  max_age_us max age of a cached sample, 0 waits for a new conversion
+ * @param[out] *response pointer to a response buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ *             - 2 path is NULL
+ *             - 4 response status is not 0
+ * @note       it connects, waits for the response and disconnects
+ */
+uint8_t ms5837_broker_request(const char *path, uint8_t index, uint32_t max_age_us, ms5837_broker_response_t *response)
+{
+    struct sockaddr_un addr;
+    ms5837_broker_request_t request;
+    uint8_t res;
+    int fd;
+    
+    if ((path == NULL) || (response == NULL))
+    {
+        return 2;
+    }
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return 1;
+    }
+    
+    memset(&addr, 0, sizeof(struct sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    memset(&request, 0, sizeof(ms5837_broker_request_t));
+    request.max_age_us = max_age_us;
+    request.index = index;
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    res = 1;
+    if ((connect(fd, (struct sockaddr *)&addr, sizeof(struct sockaddr_un)) == 0) &&
+        (send(fd, &request, sizeof(ms5837_broker_request_t), MSG_NOSIGNAL) == (ssize_t)sizeof(ms5837_broker_request_t)) &&
+        (recv(fd, response, sizeof(ms5837_broker_response_t), 0) == (ssize_t)sizeof(ms5837_broker_response_t)))
+    {
+        res = (response->status == 0) ? 0 : 4;
+    }
+    (void)close(fd);
+    
+    return res;
+}
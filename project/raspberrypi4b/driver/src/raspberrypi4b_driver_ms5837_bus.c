@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_bus.c
+ * @brief     raspberrypi4b driver ms5837 bus source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_ms5837_bus.h"
+#include "iic.h"
+
+/**
+ * @brief bus slot structure definition
+ */
+typedef struct bus_slot_s
+{
+    char name[32];            /**< iic device name */
+    int fd;                   /**< iic handle */
+    ms5837_log_t *log;        /**< event log */
+} bus_slot_t;
+
+/**
+ * @brief bus slot definition
+ */
+static bus_slot_t gs_bus[MS5837_BUS_MAX_NUM];        /**< bus slots */
+
+/**
+ * @brief     bus slot function definition
+ * @param[in] n bus slot index
+ * @note      the link functions carry no context, so each slot gets its own function set
+ */
+#define BUS_SLOT_FUNCTION(n)                                                                                            \
+static uint8_t a_bus##n##_iic_init(void)                                                                                \
+{                                                                                                                       \
+    return iic_init(gs_bus[n].name, &gs_bus[n].fd);                                                                     \
+}                                                                                                                       \
+static uint8_t a_bus##n##_iic_deinit(void)                                                                              \
+{                                                                                                                       \
+    return iic_deinit(gs_bus[n].fd);                                                                                    \
+}                                                                                                                       \
+static uint8_t a_bus##n##_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)                               \
+{                                                                                                                       \
+    return iic_read(gs_bus[n].fd, addr, reg, buf, len);                                                                 \
+}                                                                                                                       \
+static uint8_t a_bus##n##_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)                              \
+{                                                                                                                       \
+    return iic_write(gs_bus[n].fd, addr, reg, buf, len);                                                                \
+}                                                                                                                       \
+static void a_bus##n##_event(uint16_t id, uint32_t arg)                                                                 \
+{                                                                                                                       \
+    (void)ms5837_log_push(gs_bus[n].log, n, ms5837_interface_timestamp_us(), id, arg);                                  \
+}                                                                                                                       \
+static uint8_t a_bus##n##_reopen(void)                                                                                  \
+{                                                                                                                       \
+    (void)iic_deinit(gs_bus[n].fd);                                                                                     \
+    gs_bus[n].fd = -1;                                                                                                  \
+    return iic_init(gs_bus[n].name, &gs_bus[n].fd);                                                                     \
+}
+
+BUS_SLOT_FUNCTION(0)
+BUS_SLOT_FUNCTION(1)
+BUS_SLOT_FUNCTION(2)
+BUS_SLOT_FUNCTION(3)
+
+/**
+ * @brief bus slot function table definition
+ */
+static uint8_t (*const gs_iic_init[MS5837_BUS_MAX_NUM])(void) =
+{
+    a_bus0_iic_init, a_bus1_iic_init, a_bus2_iic_init, a_bus3_iic_init,
+};
+static uint8_t (*const gs_iic_deinit[MS5837_BUS_MAX_NUM])(void) =
+{
+    a_bus0_iic_deinit, a_bus1_iic_deinit, a_bus2_iic_deinit, a_bus3_iic_deinit,
+};
+static uint8_t (*const gs_iic_read[MS5837_BUS_MAX_NUM])(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len) =
+{
+    a_bus0_iic_read, a_bus1_iic_read, a_bus2_iic_read, a_bus3_iic_read,
+};
+static uint8_t (*const gs_iic_write[MS5837_BUS_MAX_NUM])(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len) =
+{
+    a_bus0_iic_write, a_bus1_iic_write, a_bus2_iic_write, a_bus3_iic_write,
+};
+static void (*const gs_event[MS5837_BUS_MAX_NUM])(uint16_t id, uint32_t arg) =
+{
+    a_bus0_event, a_bus1_event, a_bus2_event, a_bus3_event,
+};
+static uint8_t (*const gs_reopen[MS5837_BUS_MAX_NUM])(void) =
+{
+    a_bus0_reopen, a_bus1_reopen, a_bus2_reopen, a_bus3_reopen,
+};
+
+/**
+ * @brief     link a handle to an iic bus slot
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] index bus slot index
+ * @param[in] *name pointer to an iic device name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 link failed
+ *            - 2 handle is NULL
+ * @note      every ms5837 answers at the same address, so each sensor needs its own bus,
+ *            this links the handle to iic functions bound to the device of the slot,
+ *            the linked bus_recover only reopens the iic adapter, it doesn't clock scl or send a stop,
+ *            so it can't free a slave holding sda low, enable the recovery of the kernel iic adapter for that
+ */
+uint8_t ms5837_bus_link(ms5837_handle_t *handle, uint8_t index, const char *name)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if ((index >= MS5837_BUS_MAX_NUM) || (name == NULL))
+    {
+        ms5837_interface_debug_print("ms5837: bus slot is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* save the device name */
+    memset(gs_bus[index].name, 0, sizeof(gs_bus[index].name));
+    strncpy(gs_bus[index].name, name, sizeof(gs_bus[index].name) - 1);
+    gs_bus[index].fd = -1;
+    gs_bus[index].log = NULL;
+    
+    /* link interface function */
+    DRIVER_MS5837_LINK_INIT(handle, ms5837_handle_t);
+    DRIVER_MS5837_LINK_IIC_INIT(handle, gs_iic_init[index]);
+    DRIVER_MS5837_LINK_IIC_DEINIT(handle, gs_iic_deinit[index]);
+    DRIVER_MS5837_LINK_IIC_READ(handle, gs_iic_read[index]);
+    DRIVER_MS5837_LINK_IIC_WRITE(handle, gs_iic_write[index]);
+    DRIVER_MS5837_LINK_DELAY_MS(handle, ms5837_interface_delay_ms);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(handle, ms5837_interface_debug_print);
+    DRIVER_MS5837_LINK_TIMESTAMP_US(handle, ms5837_interface_timestamp_us);
+    DRIVER_MS5837_LINK_BUS_RECOVER(handle, gs_reopen[index]);
+    
+    return 0;
+}
+
+/**
+ * @brief     trace the events of a bus slot into a log
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] index bus slot index
+ * @param[in] *log pointer to a log structure, NULL restores the debug print
+ * @return    status code
+ *            - 0 success
+ *            - 1 trace failed
+ *            - 2 handle is NULL
+ * @note      call it after ms5837_bus_link, the events carry the slot index as the source
+ *            and the log must only be filled from one thread
+ */
+uint8_t ms5837_bus_trace(ms5837_handle_t *handle, uint8_t index, ms5837_log_t *log)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if (index >= MS5837_BUS_MAX_NUM)
+    {
+        ms5837_interface_debug_print("ms5837: bus slot is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link the event function */
+    gs_bus[index].log = log;
+    if (log != NULL)
+    {
+        DRIVER_MS5837_LINK_EVENT(handle, gs_event[index]);
+    }
+    else
+    {
+        DRIVER_MS5837_LINK_EVENT(handle, NULL);
+    }
+    
+    return 0;
+}
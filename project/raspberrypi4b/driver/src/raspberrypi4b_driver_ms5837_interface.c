@@ -37,6 +37,7 @@
 #include "driver_ms5837_interface.h"
 #include "iic.h"
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -114,6 +115,20 @@ void ms5837_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return free running time in us
+ * @note   only differences are used, so it may wrap around
+ */
+uint32_t ms5837_interface_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -0,0 +1,318 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_record.c
+ * @brief     raspberrypi4b driver ms5837 record source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_ms5837_record.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief record structure definition
+ */
+typedef struct record_s
+{
+    FILE *fp;                                                                           /**< record file */
+    uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< wrapped iic_read */
+    uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< wrapped iic_write */
+    uint64_t start_ns;                                                                  /**< recording start time */
+    uint32_t count;                                                                     /**< record count */
+    uint8_t failed;                                                                     /**< write failed flag */
+    uint8_t running;                                                                    /**< running flag */
+} record_t;
+
+/**
+ * @brief record definition
+ */
+static record_t gs_record;        /**< the linked functions have no context */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_record_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     save one transfer
+ * @param[in] time_ns transfer start time
+ * @param[in] type transfer type
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to the read data
+ * @param[in] len data length
+ * @param[in] status transfer status
+ * @note      none
+ */
+static void a_record_save(uint64_t time_ns, uint8_t type, uint8_t reg, uint8_t *buf, uint16_t len, uint8_t status)
+{
+    ms5837_replay_record_t record;
+    
+    memset(&record, 0, sizeof(ms5837_replay_record_t));
+    record.time_us = (uint32_t)((time_ns - gs_record.start_ns) / 1000ULL);
+    record.type = type;
+    record.reg = reg;
+    record.len = (len > 0xFF) ? 0xFF : (uint8_t)len;
+    record.status = status;
+    if ((type == MS5837_REPLAY_TYPE_READ) && (buf != NULL))
+    {
+        memcpy(record.data, buf, (len > 4) ? 4 : len);
+    }
+    if (fwrite(&record, sizeof(ms5837_replay_record_t), 1, gs_record.fp) != 1)
+    {
+        gs_record.failed = 1;
+    }
+    gs_record.count++;
+}
+
+/**
+ * @brief      recorded iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_record_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint64_t now = a_record_now_ns();
+    uint8_t res;
+    
+    res = gs_record.iic_read(addr, reg, buf, len);
+    a_record_save(now, MS5837_REPLAY_TYPE_READ, reg, buf, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     recorded iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_record_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint64_t now = a_record_now_ns();
+    uint8_t res;
+    
+    res = gs_record.iic_write(addr, reg, buf, len);
+    a_record_save(now, MS5837_REPLAY_TYPE_WRITE, reg, NULL, len, res);
+    
+    return res;
+}
+
+/**
+ * @brief     start recording the iic transfers of a handle
+ * @param[in] *handle pointer to a linked ms5837 handle structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 3 a recording is running
+ * @note      it wraps the linked iic_read and iic_write, start it before ms5837_init so the prom is recorded,
+ *            only one handle can be recorded at a time
+ */
+uint8_t ms5837_record_start(ms5837_handle_t *handle, const char *path)
+{
+    ms5837_record_header_t header;
+    
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if (gs_record.running != 0)
+    {
+        return 3;
+    }
+    if ((path == NULL) || (handle->iic_read == NULL) || (handle->iic_write == NULL))
+    {
+        return 1;
+    }
+    
+    /* write the header */
+    memset(&gs_record, 0, sizeof(record_t));
+    gs_record.fp = fopen(path, "wb");
+    if (gs_record.fp == NULL)
+    {
+        ms5837_interface_debug_print("ms5837: open %s failed.\n", path);
+        
+        return 1;
+    }
+    memset(&header, 0, sizeof(ms5837_record_header_t));
+    memcpy(header.magic, MS5837_RECORD_MAGIC, 8);
+    header.version = MS5837_RECORD_VERSION;
+    header.record_size = sizeof(ms5837_replay_record_t);
+    if (fwrite(&header, sizeof(ms5837_record_header_t), 1, gs_record.fp) != 1)
+    {
+        (void)fclose(gs_record.fp);
+        
+        return 1;
+    }
+    
+    /* wrap the transfers */
+    gs_record.iic_read = handle->iic_read;
+    gs_record.iic_write = handle->iic_write;
+    gs_record.start_ns = a_record_now_ns();
+    gs_record.running = 1;
+    DRIVER_MS5837_LINK_IIC_READ(handle, a_record_iic_read);
+    DRIVER_MS5837_LINK_IIC_WRITE(handle, a_record_iic_write);
+    
+    return 0;
+}
+
+/**
+ * @brief     stop recording
+ * @param[in] *handle pointer to the recorded ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 no recording is running
+ * @note      it restores the linked iic_read and iic_write
+ */
+uint8_t ms5837_record_stop(ms5837_handle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if (gs_record.running == 0)
+    {
+        return 3;
+    }
+    
+    /* restore the transfers */
+    DRIVER_MS5837_LINK_IIC_READ(handle, gs_record.iic_read);
+    DRIVER_MS5837_LINK_IIC_WRITE(handle, gs_record.iic_write);
+    gs_record.running = 0;
+    if (fclose(gs_record.fp) != 0)
+    {
+        gs_record.failed = 1;
+    }
+    ms5837_interface_debug_print("ms5837: recorded %u transfers.\n", gs_record.count);
+    
+    return (gs_record.failed != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      load a recorded file
+ * @param[in]  *path pointer to a file path
+ * @param[out] **record pointer to a record array pointer
+ * @param[out] *num pointer to a record number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ *             - 4 file is invalid
+ * @note       free the records with ms5837_record_free
+ */
+uint8_t ms5837_record_load(const char *path, ms5837_replay_record_t **record, uint32_t *num)
+{
+    ms5837_record_header_t header;
+    FILE *fp;
+    long size;
+    
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        ms5837_interface_debug_print("ms5837: open %s failed.\n", path);
+        
+        return 1;
+    }
+    
+    /* check the header */
+    if ((fread(&header, sizeof(ms5837_record_header_t), 1, fp) != 1) ||
+        (memcmp(header.magic, MS5837_RECORD_MAGIC, 8) != 0) ||
+        (header.version != MS5837_RECORD_VERSION) ||
+        (header.record_size != sizeof(ms5837_replay_record_t)))
+    {
+        ms5837_interface_debug_print("ms5837: %s is not a record file.\n", path);
+        (void)fclose(fp);
+        
+        return 4;
+    }
+    
+    /* the record number comes from the file size, a cut tail is dropped */
+    if ((fseek(fp, 0, SEEK_END) != 0) || ((size = ftell(fp)) < 0) ||
+        (fseek(fp, sizeof(ms5837_record_header_t), SEEK_SET) != 0))
+    {
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    *num = (uint32_t)(((size_t)size - sizeof(ms5837_record_header_t)) / sizeof(ms5837_replay_record_t));
+    *record = (ms5837_replay_record_t *)malloc(sizeof(ms5837_replay_record_t) * ((*num == 0) ? 1 : *num));
+    if (*record == NULL)
+    {
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    if (fread(*record, sizeof(ms5837_replay_record_t), *num, fp) != *num)
+    {
+        free(*record);
+        *record = NULL;
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    (void)fclose(fp);
+    
+    return 0;
+}
+
+/**
+ * @brief     free the loaded records
+ * @param[in] *record pointer to a record array
+ * @note      none
+ */
+void ms5837_record_free(ms5837_replay_record_t *record)
+{
+    free(record);
+}
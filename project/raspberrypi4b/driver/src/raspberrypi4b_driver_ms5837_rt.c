@@ -0,0 +1,507 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_rt.c
+ * @brief     raspberrypi4b driver ms5837 real time source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "raspberrypi4b_driver_ms5837_rt.h"
+#include <errno.h>
+#include <math.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+/**
+ * @brief rt calibration definition
+ */
+#define RT_CALIBRATE_TIMES         200          /**< calibration sleeps */
+#define RT_CALIBRATE_SLEEP_NS      200000       /**< calibration sleep length */
+#define RT_SPIN_MARGIN_NS          10000        /**< spin margin over the measured overshoot */
+#define RT_SPIN_MAX_NS             500000       /**< max spin window */
+#define RT_START_MARGIN_NS         1000000      /**< first deadline 1ms after start */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_rt_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     sleep until shortly before the deadline and spin the rest
+ * @param[in] deadline deadline in CLOCK_MONOTONIC ns
+ * @param[in] spin_ns spin window
+ * @return    wakeup error in ns
+ * @note      none
+ */
+static int64_t a_rt_wait_until(uint64_t deadline, uint32_t spin_ns)
+{
+    struct timespec ts;
+    uint64_t now;
+    
+    /* sleep the coarse part */
+    if (deadline > spin_ns)
+    {
+        ts.tv_sec = (time_t)((deadline - spin_ns) / 1000000000ULL);
+        ts.tv_nsec = (long)((deadline - spin_ns) % 1000000000ULL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        {
+            /* sleep again */
+        }
+    }
+    
+    /* spin the fine part */
+    do
+    {
+        now = a_rt_now_ns();
+    } while (now < deadline);
+    
+    return (int64_t)(now - deadline);
+}
+
+/**
+ * @brief  measure the sleep overshoot of the current thread
+ * @return spin window in ns
+ * @note   none
+ */
+static uint32_t a_rt_calibrate(void)
+{
+    uint32_t i;
+    uint64_t max;
+    
+    max = 0;
+    for (i = 0; i < RT_CALIBRATE_TIMES; i++)
+    {
+        uint64_t deadline = a_rt_now_ns() + RT_CALIBRATE_SLEEP_NS;
+        int64_t error = a_rt_wait_until(deadline, 0);
+        
+        if ((uint64_t)error > max)
+        {
+            max = (uint64_t)error;
+        }
+    }
+    max += RT_SPIN_MARGIN_NS;
+    if (max > RT_SPIN_MAX_NS)
+    {
+        max = RT_SPIN_MAX_NS;
+    }
+    
+    return (uint32_t)max;
+}
+
+/**
+ * @brief     touch the stack so later calls never page fault
+ * @param[in] kb stack size in kb
+ * @note      none
+ */
+static void __attribute__((noinline)) a_rt_prefault_stack(uint32_t kb)
+{
+    volatile uint8_t stack[kb * 1024 + 1];
+    
+    memset((uint8_t *)stack, 0, sizeof(stack));
+}
+
+/**
+ * @brief     convert one sample with absolute conversion deadlines
+ * @param[in] *rt pointer to an rt structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample failed
+ * @note      none
+ */
+static uint8_t a_rt_sample(ms5837_rt_t *rt, ms5837_sampler_sample_t *sample)
+{
+    ms5837_osr_t osr;
+    uint32_t us;
+    int64_t error;
+    
+    /* temperature, a staged configuration takes effect at the start */
+    if (ms5837_start_temperature_convert(rt->handle) != 0)
+    {
+        return 1;
+    }
+    (void)ms5837_get_temperature_osr(rt->handle, &osr);
+    (void)ms5837_get_convert_time(rt->handle, osr, &us);
+    error = a_rt_wait_until(a_rt_now_ns() + (uint64_t)us * 1000ULL, rt->stats.spin_ns);
+    if (error > rt->stats.convert_max_ns)
+    {
+        rt->stats.convert_max_ns = error;
+    }
+    if (ms5837_read_adc(rt->handle, &sample->temperature_raw) != 0)
+    {
+        return 1;
+    }
+    
+    /* pressure */
+    (void)ms5837_get_pressure_osr(rt->handle, &osr);
+    (void)ms5837_get_convert_time(rt->handle, osr, &us);
+    if (ms5837_start_pressure_convert(rt->handle) != 0)
+    {
+        return 1;
+    }
+    error = a_rt_wait_until(a_rt_now_ns() + (uint64_t)us * 1000ULL, rt->stats.spin_ns);
+    if (error > rt->stats.convert_max_ns)
+    {
+        rt->stats.convert_max_ns = error;
+    }
+    if (ms5837_read_adc(rt->handle, &sample->pressure_raw) != 0)
+    {
+        return 1;
+    }
+    (void)ms5837_calculate_temperature_pressure(rt->handle, sample->temperature_raw, &sample->temperature_c,
+                                                sample->pressure_raw, &sample->pressure_mbar);
+    
+    return 0;
+}
+
+/**
+ * @brief     sampling thread
+ * @param[in] *arg pointer to an rt structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_rt_thread(void *arg)
+{
+    ms5837_rt_t *rt = (ms5837_rt_t *)arg;
+    uint64_t period;
+    uint64_t next;
+    uint64_t n;
+    
+    /* prepare the thread */
+    a_rt_prefault_stack(rt->config.prefault_kb);
+    if (rt->config.spin_us != 0)
+    {
+        rt->stats.spin_ns = rt->config.spin_us * 1000;
+    }
+    else
+    {
+        rt->stats.spin_ns = a_rt_calibrate();
+    }
+    
+    period = (uint64_t)rt->config.period_us * 1000ULL;
+    next = a_rt_now_ns() + RT_START_MARGIN_NS;
+    n = 0;
+    while ((__atomic_load_n(&rt->stop, __ATOMIC_ACQUIRE) == 0) &&
+           ((rt->times == 0) || ((rt->stats.samples + rt->stats.errors) < rt->times)))
+    {
+        ms5837_sampler_sample_t sample;
+        int64_t jitter;
+        double delta;
+        uint64_t now;
+        
+        /* wait for the period deadline */
+        jitter = a_rt_wait_until(next, rt->stats.spin_ns);
+        n++;
+        if (jitter < rt->stats.jitter_min_ns)
+        {
+            rt->stats.jitter_min_ns = jitter;
+        }
+        if (jitter > rt->stats.jitter_max_ns)
+        {
+            rt->stats.jitter_max_ns = jitter;
+        }
+        delta = (double)jitter - rt->stats.jitter_mean_ns;
+        rt->stats.jitter_mean_ns += delta / (double)n;
+        rt->stats.jitter_m2 += delta * ((double)jitter - rt->stats.jitter_mean_ns);
+        
+        /* run the conversions */
+        sample.deadline_ns = next;
+        if (a_rt_sample(rt, &sample) != 0)
+        {
+            /* resync at once, it keeps the calibration and takes about 3ms */
+            rt->stats.errors++;
+            if (ms5837_resync(rt->handle) == 0)
+            {
+                rt->stats.resyncs++;
+            }
+        }
+        else
+        {
+            sample.timestamp_ns = a_rt_now_ns();
+            rt->stats.samples++;
+            if (rt->buffer != NULL)
+            {
+                rt->buffer[rt->buffer_count % rt->buffer_len] = sample;
+                rt->buffer_count++;
+            }
+            if (rt->receive != NULL)
+            {
+                rt->receive(&sample);
+            }
+        }
+        
+        /* skip the periods already passed */
+        next += period;
+        now = a_rt_now_ns();
+        if (now > next)
+        {
+            uint64_t skipped = (now - next) / period + 1;
+            
+            rt->stats.missed += skipped;
+            next += skipped * period;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     join the thread and print the statistics
+ * @param[in] *rt pointer to an rt structure
+ * @note      none
+ */
+static void a_rt_join(ms5837_rt_t *rt)
+{
+    double std;
+    uint64_t n;
+    
+    (void)pthread_join(rt->thread, NULL);
+    rt->running = 0;
+    if (rt->config.lock_memory != 0)
+    {
+        (void)munlockall();
+    }
+    
+    n = rt->stats.samples + rt->stats.errors;
+    std = (n > 1) ? sqrt(rt->stats.jitter_m2 / (double)(n - 1)) : 0.0;
+    ms5837_interface_debug_print("ms5837: rt samples %llu missed %llu errors %llu resyncs %llu.\n",
+                                 (unsigned long long)rt->stats.samples, (unsigned long long)rt->stats.missed,
+                                 (unsigned long long)rt->stats.errors, (unsigned long long)rt->stats.resyncs);
+    if (n > 0)
+    {
+        ms5837_interface_debug_print("ms5837: rt jitter min %0.1fus max %0.1fus mean %0.1fus std %0.1fus.\n",
+                                     (double)rt->stats.jitter_min_ns / 1000.0, (double)rt->stats.jitter_max_ns / 1000.0,
+                                     rt->stats.jitter_mean_ns / 1000.0, std / 1000.0);
+    }
+    ms5837_interface_debug_print("ms5837: rt conversion wakeup max %0.1fus spin %0.1fus.\n",
+                                 (double)rt->stats.convert_max_ns / 1000.0, (double)rt->stats.spin_ns / 1000.0);
+}
+
+/**
+ * @brief      get the default rt config
+ * @param[out] *config pointer to a config structure
+ * @note       none
+ */
+void ms5837_rt_default_config(ms5837_rt_config_t *config)
+{
+    memset(config, 0, sizeof(ms5837_rt_config_t));
+    config->period_us = 100000;
+    config->priority = 0;
+    config->cpu = -1;
+    config->lock_memory = 0;
+    config->spin_us = 0;
+    config->prefault_kb = 64;
+}
+
+/**
+ * @brief     start the real time sampling thread
+ * @param[in] *rt pointer to an rt structure
+ * @param[in] *handle pointer to an initialized ms5837 handle structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] *buffer pointer to a sample buffer, can be NULL
+ * @param[in] len sample buffer length
+ * @param[in] times sample times, 0 runs until stop
+ * @param[in] *receive pointer to a sample callback, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 rt is NULL
+ *            - 3 lock memory failed
+ *            - 4 thread create failed
+ * @note      the callback runs in the sampling thread and must not block
+ */
+uint8_t ms5837_rt_start(ms5837_rt_t *rt, ms5837_handle_t *handle, const ms5837_rt_config_t *config,
+                        ms5837_sampler_sample_t *buffer, uint32_t len, uint64_t times,
+                        void (*receive)(ms5837_sampler_sample_t *sample))
+{
+    pthread_attr_t attr;
+    struct sched_param param;
+    int res;
+    
+    if (rt == NULL)
+    {
+        return 2;
+    }
+    if ((handle == NULL) || (config == NULL) || (config->period_us == 0) ||
+        ((buffer != NULL) && (len == 0)))
+    {
+        ms5837_interface_debug_print("ms5837: rt param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* save the params */
+    memset(rt, 0, sizeof(ms5837_rt_t));
+    rt->handle = handle;
+    rt->receive = receive;
+    rt->config = *config;
+    rt->buffer = buffer;
+    rt->buffer_len = len;
+    rt->times = times;
+    rt->stats.jitter_min_ns = INT64_MAX;
+    rt->stats.jitter_max_ns = INT64_MIN;
+    
+    /* lock the memory and pre-fault the sample buffer */
+    if (config->lock_memory != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: lock memory failed.\n");
+            
+            return 3;
+        }
+    }
+    if (buffer != NULL)
+    {
+        memset(buffer, 0, sizeof(ms5837_sampler_sample_t) * len);
+    }
+    
+    /* set the thread attributes */
+    (void)pthread_attr_init(&attr);
+    if (config->priority > 0)
+    {
+        memset(&param, 0, sizeof(struct sched_param));
+        param.sched_priority = config->priority;
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        (void)pthread_attr_setschedparam(&attr, &param);
+    }
+    if (config->cpu >= 0)
+    {
+        cpu_set_t set;
+        
+        CPU_ZERO(&set);
+        CPU_SET(config->cpu, &set);
+        (void)pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &set);
+    }
+    
+    /* create the thread */
+    res = pthread_create(&rt->thread, &attr, a_rt_thread, rt);
+    (void)pthread_attr_destroy(&attr);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: rt thread create failed, %s.\n", strerror(res));
+        if (config->lock_memory != 0)
+        {
+            (void)munlockall();
+        }
+        
+        return 4;
+    }
+    rt->running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     wait for the sampling thread to finish the sample times
+ * @param[in] *rt pointer to an rt structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 rt is NULL
+ *            - 3 rt is not running
+ * @note      none
+ */
+uint8_t ms5837_rt_wait(ms5837_rt_t *rt)
+{
+    if (rt == NULL)
+    {
+        return 2;
+    }
+    if (rt->running == 0)
+    {
+        return 3;
+    }
+    
+    a_rt_join(rt);
+    
+    return 0;
+}
+
+/**
+ * @brief     stop the sampling thread and report the jitter statistics
+ * @param[in] *rt pointer to an rt structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 rt is NULL
+ *            - 3 rt is not running
+ * @note      none
+ */
+uint8_t ms5837_rt_stop(ms5837_rt_t *rt)
+{
+    if (rt == NULL)
+    {
+        return 2;
+    }
+    if (rt->running == 0)
+    {
+        return 3;
+    }
+    
+    __atomic_store_n(&rt->stop, 1, __ATOMIC_RELEASE);
+    a_rt_join(rt);
+    
+    return 0;
+}
+
+/**
+ * @brief      get the rt statistics
+ * @param[in]  *rt pointer to an rt structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rt is NULL
+ * @note       read it after the thread has stopped
+ */
+uint8_t ms5837_rt_get_stats(ms5837_rt_t *rt, ms5837_rt_stats_t *stats)
+{
+    if (rt == NULL)
+    {
+        return 2;
+    }
+    
+    *stats = rt->stats;
+    
+    return 0;
+}
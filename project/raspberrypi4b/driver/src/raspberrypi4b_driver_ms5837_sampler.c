@@ -0,0 +1,957 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_sampler.c
+ * @brief     raspberrypi4b driver ms5837 sampler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_ms5837_sampler.h"
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief sampler state definition
+ */
+#define SAMPLER_STATE_IDLE                0        /**< no conversion in flight */
+#define SAMPLER_STATE_WAIT_TEMPERATURE    1        /**< d2 conversion in flight */
+#define SAMPLER_STATE_WAIT_PRESSURE       2        /**< d1 conversion in flight */
+
+/**
+ * @brief sampler event definition
+ */
+#define SAMPLER_EVENT_PERIOD     0        /**< period timer event */
+#define SAMPLER_EVENT_CONVERT    1        /**< conversion timer event */
+
+/**
+ * @brief sampler start margin definition
+ */
+#define SAMPLER_START_MARGIN_NS    1000000ULL        /**< first deadline 1ms after start */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_sampler_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief      convert ns to timespec
+ * @param[in]  ns time in ns
+ * @param[out] *ts pointer to a timespec structure
+ * @note       none
+ */
+static void a_sampler_ns_to_timespec(uint64_t ns, struct timespec *ts)
+{
+    ts->tv_sec = (time_t)(ns / 1000000000ULL);
+    ts->tv_nsec = (long)(ns % 1000000000ULL);
+}
+
+/**
+ * @brief     arm the conversion timer
+ * @param[in] *sensor pointer to a sampler sensor structure
+ * @param[in] osr conversion osr
+ * @return    status code
+ *            - 0 success
+ *            - 1 arm failed
+ * @note      none
+ */
+static uint8_t a_sampler_arm_convert(ms5837_sampler_sensor_t *sensor, ms5837_osr_t osr)
+{
+    struct itimerspec its;
+    uint32_t us;
+    
+    if (ms5837_get_convert_time(sensor->handle, osr, &us) != 0)
+    {
+        return 1;
+    }
+    memset(&its, 0, sizeof(struct itimerspec));
+    a_sampler_ns_to_timespec((uint64_t)us * 1000ULL, &its.it_value);
+    if (timerfd_settime(sensor->convert_fd, 0, &its, NULL) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     handle a period timer event
+ * @param[in] *sensor pointer to a sampler sensor structure
+ * @note      none
+ */
+static void a_sampler_period(ms5837_sampler_sensor_t *sensor)
+{
+    uint64_t expirations;
+    uint64_t now;
+    ms5837_osr_t osr;
+    
+    /* read the expirations, more than 1 means deadlines were skipped */
+    if (read(sensor->period_fd, &expirations, sizeof(uint64_t)) != (ssize_t)sizeof(uint64_t))
+    {
+        return;
+    }
+    sensor->deadline_ns += expirations * sensor->period_ns;
+    if (expirations > 1)
+    {
+        sensor->stats.missed += expirations - 1;
+    }
+    
+    /* the last cycle is still converting */
+    if (sensor->state != SAMPLER_STATE_IDLE)
+    {
+        sensor->stats.missed++;
+        
+        return;
+    }
+    
+    /* record the lateness */
+    now = a_sampler_now_ns();
+    if ((now > sensor->deadline_ns) && ((now - sensor->deadline_ns) > sensor->stats.max_lateness_ns))
+    {
+        sensor->stats.max_lateness_ns = now - sensor->deadline_ns;
+    }
+    
+    /* resync the sensor after a failed cycle, it keeps the calibration and takes about 3ms */
+    if (sensor->resync != 0)
+    {
+        if (ms5837_resync(sensor->handle) != 0)
+        {
+            sensor->stats.errors++;
+            
+            return;
+        }
+        sensor->resync = 0;
+        sensor->stats.resyncs++;
+    }
+    
+    /* start the temperature conversion, a staged configuration takes effect here */
+    if (ms5837_start_temperature_convert(sensor->handle) != 0)
+    {
+        sensor->stats.errors++;
+        sensor->resync = 1;
+        
+        return;
+    }
+    (void)ms5837_get_temperature_osr(sensor->handle, &osr);
+    if (a_sampler_arm_convert(sensor, osr) != 0)
+    {
+        sensor->stats.errors++;
+        sensor->resync = 1;
+        
+        return;
+    }
+    sensor->state = SAMPLER_STATE_WAIT_TEMPERATURE;
+}
+
+/**
+ * @brief     handle a conversion timer event
+ * @param[in] *sensor pointer to a sampler sensor structure
+ * @param[in] index sensor index
+ * @note      none
+ */
+static void a_sampler_convert(ms5837_sampler_sensor_t *sensor, uint8_t index)
+{
+    uint64_t expirations;
+    ms5837_osr_t osr;
+    ms5837_sampler_sample_t sample;
+    
+    /* clear the timer */
+    if (read(sensor->convert_fd, &expirations, sizeof(uint64_t)) != (ssize_t)sizeof(uint64_t))
+    {
+        return;
+    }
+    
+    if (sensor->state == SAMPLER_STATE_WAIT_TEMPERATURE)
+    {
+        /* read the temperature and start the pressure conversion */
+        if (ms5837_read_adc(sensor->handle, &sensor->temperature_raw) != 0)
+        {
+            sensor->stats.errors++;
+            sensor->resync = 1;
+            sensor->state = SAMPLER_STATE_IDLE;
+            
+            return;
+        }
+        (void)ms5837_get_pressure_osr(sensor->handle, &osr);
+        if (ms5837_start_pressure_convert(sensor->handle) != 0)
+        {
+            sensor->stats.errors++;
+            sensor->resync = 1;
+            sensor->state = SAMPLER_STATE_IDLE;
+            
+            return;
+        }
+        if (a_sampler_arm_convert(sensor, osr) != 0)
+        {
+            sensor->stats.errors++;
+            sensor->resync = 1;
+            sensor->state = SAMPLER_STATE_IDLE;
+            
+            return;
+        }
+        sensor->state = SAMPLER_STATE_WAIT_PRESSURE;
+    }
+    else if (sensor->state == SAMPLER_STATE_WAIT_PRESSURE)
+    {
+        /* read the pressure and finish the sample */
+        sensor->state = SAMPLER_STATE_IDLE;
+        if (ms5837_read_adc(sensor->handle, &sample.pressure_raw) != 0)
+        {
+            sensor->stats.errors++;
+            sensor->resync = 1;
+            
+            return;
+        }
+        sample.temperature_raw = sensor->temperature_raw;
+        (void)ms5837_calculate_temperature_pressure(sensor->handle, sample.temperature_raw, &sample.temperature_c,
+                                                    sample.pressure_raw, &sample.pressure_mbar);
+        sample.deadline_ns = sensor->deadline_ns;
+        sample.timestamp_ns = a_sampler_now_ns();
+        sample.reason = 0;
+        sensor->stats.samples++;
+        
+        /* keep the latest sample, readers retry while the sequence is odd or changed */
+        sensor->latest_seq++;
+        MS5837_BARRIER();
+        sensor->latest = sample;
+        MS5837_BARRIER();
+        sensor->latest_seq++;
+        MS5837_BARRIER();
+        sensor->latest_valid = 1;
+        if ((sensor->window != NULL) || (sensor->trigger != NULL) || (sensor->deadband != NULL) ||
+            (sensor->publisher != NULL) || (sensor->predict != NULL) || (sensor->kalman != NULL) ||
+            (sensor->wave != NULL))
+        {
+            int32_t temperature;
+            int32_t pressure;
+            uint64_t one = 1;
+            
+            (void)ms5837_compensate(sensor->handle, sample.temperature_raw, &temperature, sample.pressure_raw, &pressure);
+            if (sensor->window != NULL)
+            {
+                (void)ms5837_window_add(sensor->window, sample.timestamp_ns / 1000ULL, temperature, pressure);
+            }
+            if ((sensor->trigger != NULL) &&
+                (ms5837_trigger_evaluate(sensor->trigger, sample.timestamp_ns / 1000ULL, temperature, pressure) == 1) &&
+                (sensor->trigger_fd >= 0))
+            {
+                (void)write(sensor->trigger_fd, &one, sizeof(one));
+            }
+            if (sensor->predict != NULL)
+            {
+                (void)ms5837_predict_update(sensor->predict, sample.timestamp_ns / 1000ULL, pressure);
+            }
+            if (sensor->kalman != NULL)
+            {
+                (void)ms5837_kalman_update(sensor->kalman, sample.timestamp_ns / 1000ULL, pressure);
+            }
+            if (sensor->wave != NULL)
+            {
+                (void)ms5837_wave_add(sensor->wave, sample.timestamp_ns / 1000ULL, pressure);
+            }
+            if ((sensor->deadband != NULL) &&
+                (ms5837_deadband_check(sensor->deadband, sample.timestamp_ns / 1000ULL, temperature, pressure,
+                                       &sample.reason) == 1))
+            {
+                return;
+            }
+            if (sensor->publisher != NULL)
+            {
+                ms5837_shm_sample_t data;
+                
+                memset(&data, 0, sizeof(data));
+                data.deadline_ns = sample.deadline_ns;
+                data.timestamp_ns = sample.timestamp_ns;
+                data.temperature = temperature;
+                data.pressure = pressure;
+                data.temperature_raw = sample.temperature_raw;
+                data.pressure_raw = sample.pressure_raw;
+                data.temperature_c = sample.temperature_c;
+                data.pressure_mbar = sample.pressure_mbar;
+                data.index = index;
+                data.reason = sample.reason;
+                (void)ms5837_shm_publish(sensor->publisher, &data);
+            }
+        }
+        if (sensor->receive != NULL)
+        {
+            sensor->receive(index, &sample);
+        }
+    }
+    else
+    {
+        /* stale event after stop */
+    }
+}
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 sampler is NULL
+ * @note      none
+ */
+uint8_t ms5837_sampler_init(ms5837_sampler_t *sampler)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    
+    memset(sampler, 0, sizeof(ms5837_sampler_t));
+    sampler->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (sampler->epoll_fd < 0)
+    {
+        ms5837_interface_debug_print("ms5837: epoll create failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler deinit
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ * @note      the linked handles are not closed
+ */
+uint8_t ms5837_sampler_deinit(ms5837_sampler_t *sampler)
+{
+    uint8_t i;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    
+    (void)ms5837_sampler_stop(sampler);
+    for (i = 0; i < sampler->num; i++)
+    {
+        (void)close(sampler->sensor[i].period_fd);
+        (void)close(sampler->sensor[i].convert_fd);
+    }
+    (void)close(sampler->epoll_fd);
+    sampler->num = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      add an initialized sensor to the sampler
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  *handle pointer to an initialized ms5837 handle structure
+ * @param[in]  period_us sampling period in us
+ * @param[in]  *receive pointer to a sample callback
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 sampler is NULL
+ *             - 3 sampler is full
+ *             - 4 period is shorter than a conversion cycle
+ * @note       each sensor must sit on its own bus
+ */
+uint8_t ms5837_sampler_add(ms5837_sampler_t *sampler, ms5837_handle_t *handle, uint32_t period_us,
+                           void (*receive)(uint8_t index, ms5837_sampler_sample_t *sample), uint8_t *index)
+{
+    ms5837_sampler_sensor_t *sensor;
+    ms5837_osr_t temp_osr;
+    ms5837_osr_t press_osr;
+    uint32_t temp_us;
+    uint32_t press_us;
+    struct epoll_event event;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (sampler->num >= MS5837_SAMPLER_MAX_SENSOR)
+    {
+        ms5837_interface_debug_print("ms5837: sampler is full.\n");
+        
+        return 3;
+    }
+    
+    /* check the period against the conversion cycle */
+    if ((ms5837_get_temperature_osr(handle, &temp_osr) != 0) ||
+        (ms5837_get_pressure_osr(handle, &press_osr) != 0) ||
+        (ms5837_get_convert_time(handle, temp_osr, &temp_us) != 0) ||
+        (ms5837_get_convert_time(handle, press_osr, &press_us) != 0))
+    {
+        ms5837_interface_debug_print("ms5837: handle is invalid.\n");
+        
+        return 1;
+    }
+    if (period_us <= temp_us + press_us)
+    {
+        ms5837_interface_debug_print("ms5837: period is shorter than a conversion cycle.\n");
+        
+        return 4;
+    }
+    
+    /* create the timers */
+    sensor = &sampler->sensor[sampler->num];
+    memset(sensor, 0, sizeof(ms5837_sampler_sensor_t));
+    sensor->handle = handle;
+    sensor->receive = receive;
+    sensor->period_ns = (uint64_t)period_us * 1000ULL;
+    sensor->period_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    sensor->convert_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if ((sensor->period_fd < 0) || (sensor->convert_fd < 0))
+    {
+        ms5837_interface_debug_print("ms5837: timer create failed.\n");
+        
+        goto failed;
+    }
+    
+    /* register the timers, the event data holds the index and the timer kind */
+    memset(&event, 0, sizeof(struct epoll_event));
+    event.events = EPOLLIN;
+    event.data.u32 = ((uint32_t)sampler->num << 1) | SAMPLER_EVENT_PERIOD;
+    if (epoll_ctl(sampler->epoll_fd, EPOLL_CTL_ADD, sensor->period_fd, &event) != 0)
+    {
+        ms5837_interface_debug_print("ms5837: epoll add failed.\n");
+        
+        goto failed;
+    }
+    event.data.u32 = ((uint32_t)sampler->num << 1) | SAMPLER_EVENT_CONVERT;
+    if (epoll_ctl(sampler->epoll_fd, EPOLL_CTL_ADD, sensor->convert_fd, &event) != 0)
+    {
+        ms5837_interface_debug_print("ms5837: epoll add failed.\n");
+        
+        goto failed;
+    }
+    *index = sampler->num;
+    sampler->num++;
+    
+    return 0;
+    
+    failed:
+    if (sensor->period_fd >= 0)
+    {
+        (void)close(sensor->period_fd);
+    }
+    if (sensor->convert_fd >= 0)
+    {
+        (void)close(sensor->convert_fd);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     start sampling
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 sampler is NULL
+ * @note      all sensors share the same absolute start time
+ */
+uint8_t ms5837_sampler_start(ms5837_sampler_t *sampler)
+{
+    uint8_t i;
+    uint64_t start;
+    struct itimerspec its;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    
+    start = a_sampler_now_ns() + SAMPLER_START_MARGIN_NS;
+    for (i = 0; i < sampler->num; i++)
+    {
+        ms5837_sampler_sensor_t *sensor = &sampler->sensor[i];
+        
+        /* absolute deadlines never accumulate the processing time */
+        sensor->state = SAMPLER_STATE_IDLE;
+        sensor->deadline_ns = start - sensor->period_ns;
+        memset(&its, 0, sizeof(struct itimerspec));
+        a_sampler_ns_to_timespec(start, &its.it_value);
+        a_sampler_ns_to_timespec(sensor->period_ns, &its.it_interval);
+        if (timerfd_settime(sensor->period_fd, TFD_TIMER_ABSTIME, &its, NULL) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: timer set failed.\n");
+            (void)ms5837_sampler_stop(sampler);
+            
+            return 1;
+        }
+    }
+    sampler->running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     stop sampling
+ * @param[in] *sampler pointer to a sampler structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 sampler is NULL
+ * @note      a conversion in flight is dropped
+ */
+uint8_t ms5837_sampler_stop(ms5837_sampler_t *sampler)
+{
+    uint8_t i;
+    uint8_t res;
+    struct itimerspec its;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    
+    res = 0;
+    memset(&its, 0, sizeof(struct itimerspec));
+    for (i = 0; i < sampler->num; i++)
+    {
+        if (timerfd_settime(sampler->sensor[i].period_fd, 0, &its, NULL) != 0)
+        {
+            res = 1;
+        }
+        if (timerfd_settime(sampler->sensor[i].convert_fd, 0, &its, NULL) != 0)
+        {
+            res = 1;
+        }
+        sampler->sensor[i].state = SAMPLER_STATE_IDLE;
+    }
+    sampler->running = 0;
+    
+    return res;
+}
+
+/**
+ * @brief     wait for timer events and run the sampling state machines
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] timeout_ms max wait time, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 sampler is NULL
+ *            - 3 sampler is not running
+ * @note      the sample callbacks run inside this function
+ */
+uint8_t ms5837_sampler_poll(ms5837_sampler_t *sampler, int32_t timeout_ms)
+{
+    struct epoll_event events[MS5837_SAMPLER_MAX_SENSOR * 2];
+    int n;
+    int i;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (sampler->running == 0)
+    {
+        return 3;
+    }
+    
+    n = epoll_wait(sampler->epoll_fd, events, MS5837_SAMPLER_MAX_SENSOR * 2, timeout_ms);
+    if (n < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        ms5837_interface_debug_print("ms5837: epoll wait failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < n; i++)
+    {
+        uint8_t index = (uint8_t)(events[i].data.u32 >> 1);
+        
+        if ((events[i].data.u32 & 1) == SAMPLER_EVENT_PERIOD)
+        {
+            a_sampler_period(&sampler->sensor[index]);
+        }
+        else
+        {
+            a_sampler_convert(&sampler->sensor[index], index);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      get the sampler statistics of a sensor
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index sensor index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sampler is NULL
+ *             - 3 index is invalid
+ * @note       none
+ */
+uint8_t ms5837_sampler_get_stats(ms5837_sampler_t *sampler, uint8_t index, ms5837_sampler_stats_t *stats)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    *stats = sampler->sensor[index].stats;
+    
+    return 0;
+}
+
+/**
+ * @brief      get the latest completed sample of a sensor
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @param[out] *age_ns pointer to a sample age buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sampler is NULL
+ *             - 3 index is invalid
+ *             - 4 no sample is completed
+ * @note       it never waits for a conversion and can be called from any thread while another one polls,
+ *             the sample is kept whether a deadband reports it or not
+ */
+uint8_t ms5837_sampler_get_latest(ms5837_sampler_t *sampler, uint8_t index, ms5837_sampler_sample_t *sample, uint64_t *age_ns)
+{
+    ms5837_sampler_sensor_t *sensor;
+    uint32_t seq;
+    uint64_t now;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sensor = &sampler->sensor[index];
+    if (sensor->latest_valid == 0)
+    {
+        return 4;
+    }
+    MS5837_BARRIER();
+    do
+    {
+        seq = sensor->latest_seq;
+        MS5837_BARRIER();
+        *sample = sensor->latest;
+        MS5837_BARRIER();
+    } while (((seq & 1) != 0) || (seq != sensor->latest_seq));
+    now = a_sampler_now_ns();
+    *age_ns = (now > sample->timestamp_ns) ? (now - sample->timestamp_ns) : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      wait for the next completed sample of a sensor
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[in]  index sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @param[in]  timeout_ms max wait time, -1 waits forever
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ *             - 2 sampler is NULL
+ *             - 3 index is invalid
+ *             - 4 timeout
+ *             - 5 sampler is not running
+ * @note       it polls the sampler until the conversion in flight or the next scheduled one completes,
+ *             no extra conversion is started, call it from the thread that polls the sampler
+ */
+uint8_t ms5837_sampler_get_fresh(ms5837_sampler_t *sampler, uint8_t index, ms5837_sampler_sample_t *sample, int32_t timeout_ms)
+{
+    uint64_t age_ns;
+    uint64_t deadline;
+    uint64_t now;
+    uint32_t seq;
+    int32_t wait_ms;
+    uint8_t res;
+    
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    if (sampler->running == 0)
+    {
+        return 5;
+    }
+    
+    /* poll until the sequence of the latest sample moves */
+    seq = sampler->sensor[index].latest_seq;
+    deadline = a_sampler_now_ns() + (uint64_t)((timeout_ms < 0) ? 0 : timeout_ms) * 1000000ULL;
+    while (sampler->sensor[index].latest_seq == seq)
+    {
+        wait_ms = -1;
+        if (timeout_ms >= 0)
+        {
+            now = a_sampler_now_ns();
+            if (now >= deadline)
+            {
+                return 4;
+            }
+            wait_ms = (int32_t)((deadline - now + 999999ULL) / 1000000ULL);
+        }
+        res = ms5837_sampler_poll(sampler, wait_ms);
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return ms5837_sampler_get_latest(sampler, index, sample, &age_ns);
+}
+
+/**
+ * @brief     attach a window to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *window pointer to an initialized window structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is compensated in integers and added to the window in the sampler thread,
+ *            read the summary with ms5837_window_get from the receive callback or between polls
+ */
+uint8_t ms5837_sampler_set_window(ms5837_sampler_t *sampler, uint8_t index, ms5837_window_t *window)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sampler->sensor[index].window = window;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a trigger to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *trigger pointer to an initialized trigger structure, NULL to detach
+ * @param[in] fd eventfd written when a sample fires events, -1 for none
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is evaluated in the sampler thread, the trigger callback runs there too,
+ *            a consumer can sleep in read or poll on the eventfd and pop the events after it wakes
+ */
+uint8_t ms5837_sampler_set_trigger(ms5837_sampler_t *sampler, uint8_t index, ms5837_trigger_t *trigger, int fd)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sampler->sensor[index].trigger_fd = fd;
+    sampler->sensor[index].trigger = trigger;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a deadband to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *deadband pointer to an initialized deadband structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is compensated in integers and checked in the sampler thread,
+ *            the receive callback only gets the reported samples, the window and the trigger still get all
+ */
+uint8_t ms5837_sampler_set_deadband(ms5837_sampler_t *sampler, uint8_t index, ms5837_deadband_t *deadband)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sampler->sensor[index].deadband = deadband;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a shared memory publisher to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *publisher pointer to an opened publisher structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every reported sample is published in the sampler thread before the receive callback,
+ *            several sensors can share one publisher and the index of the sample tells them apart
+ */
+uint8_t ms5837_sampler_set_publisher(ms5837_sampler_t *sampler, uint8_t index, ms5837_shm_publisher_t *publisher)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sampler->sensor[index].publisher = publisher;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a pressure predictor to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *predict pointer to an initialized predict structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample updates the predictor in the sampler thread with its timestamp in CLOCK_MONOTONIC us,
+ *            query it with ms5837_predict_get from any thread on the same clock
+ */
+uint8_t ms5837_sampler_set_predict(ms5837_sampler_t *sampler, uint8_t index, ms5837_predict_t *predict)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sampler->sensor[index].predict = predict;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a depth estimator to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *kalman pointer to an initialized kalman structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample updates the estimator in the sampler thread with its timestamp in CLOCK_MONOTONIC us,
+ *            query it with ms5837_kalman_get from any thread on the same clock
+ */
+uint8_t ms5837_sampler_set_kalman(ms5837_sampler_t *sampler, uint8_t index, ms5837_kalman_t *kalman)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sampler->sensor[index].kalman = kalman;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a wave analyser to a sensor
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] index sensor index
+ * @param[in] *wave pointer to an initialized wave structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sampler is NULL
+ *            - 3 index is invalid
+ * @note      every sample is added to the analyser in the sampler thread with its timestamp in CLOCK_MONOTONIC us,
+ *            the ffts run in the sampler thread, read the summaries with ms5837_wave_get_summary from any thread
+ */
+uint8_t ms5837_sampler_set_wave(ms5837_sampler_t *sampler, uint8_t index, ms5837_wave_t *wave)
+{
+    if (sampler == NULL)
+    {
+        return 2;
+    }
+    if (index >= sampler->num)
+    {
+        return 3;
+    }
+    
+    sampler->sensor[index].wave = wave;
+    
+    return 0;
+}
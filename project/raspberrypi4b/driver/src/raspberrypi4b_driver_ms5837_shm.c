@@ -0,0 +1,407 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_shm.c
+ * @brief     raspberrypi4b driver ms5837 shm source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_ms5837_shm.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief     open a publisher
+ * @param[in] *publisher pointer to a publisher structure
+ * @param[in] *name pointer to a shared memory name like "/ms5837"
+ * @param[in] size slot number
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 publisher is NULL
+ *            - 4 size is invalid
+ * @note      an existing ring of the name is reset and reused, so attached subscribers follow a restarted publisher,
+ *            it is never shrunk so the mappings of the attached subscribers stay valid
+ */
+uint8_t ms5837_shm_publisher_open(ms5837_shm_publisher_t *publisher, const char *name, uint32_t size)
+{
+    int fd;
+    void *addr;
+    size_t len;
+    uint32_t i;
+    struct stat st;
+    struct timespec ts;
+    
+    if ((publisher == NULL) || (name == NULL))
+    {
+        return 2;
+    }
+    if ((size < 2) || (size > (1U << 24)))
+    {
+        return 4;
+    }
+    
+    len = sizeof(ms5837_shm_header_t) + (size_t)size * sizeof(ms5837_shm_sample_t);
+    fd = shm_open(name, O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    
+    /* only grow the file, a subscriber still maps the old length and a shrunk file faults it */
+    if ((fstat(fd, &st) != 0) || (((size_t)st.st_size < len) && (ftruncate(fd, (off_t)len) != 0)))
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    addr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return 1;
+    }
+    
+    /* reset the head before the epoch, subscribers of the old epoch see no sample until they resync */
+    publisher->header = (ms5837_shm_header_t *)addr;
+    publisher->slot = (ms5837_shm_sample_t *)((uint8_t *)addr + sizeof(ms5837_shm_header_t));
+    publisher->len = len;
+    publisher->head = 0;
+    publisher->header->head = 0;
+    for (i = 0; i < size; i++)
+    {
+        publisher->slot[i].seq = 0;
+    }
+    publisher->header->version = MS5837_SHM_VERSION;
+    publisher->header->size = size;
+    publisher->header->slot_size = sizeof(ms5837_shm_sample_t);
+    MS5837_BARRIER();
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+    publisher->header->epoch = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    MS5837_BARRIER();
+    publisher->header->magic = MS5837_SHM_MAGIC;
+    
+    return 0;
+}
+
+/**
+ * @brief     close a publisher
+ * @param[in] *publisher pointer to a publisher structure
+ * @param[in] *name pointer to the shared memory name to remove, NULL keeps it
+ * @return    status code
+ *            - 0 success
+ *            - 2 publisher is NULL
+ *            - 3 publisher is not opened
+ * @note      keep the name when the publisher restarts, mapped subscribers can't see a removed name
+ */
+uint8_t ms5837_shm_publisher_close(ms5837_shm_publisher_t *publisher, const char *name)
+{
+    if (publisher == NULL)
+    {
+        return 2;
+    }
+    if (publisher->header == NULL)
+    {
+        return 3;
+    }
+    
+    (void)munmap(publisher->header, publisher->len);
+    publisher->header = NULL;
+    publisher->slot = NULL;
+    if (name != NULL)
+    {
+        (void)shm_unlink(name);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     publish a sample
+ * @param[in] *publisher pointer to a publisher structure
+ * @param[in] *sample pointer to a sample structure, seq is filled by the publisher
+ * @return    status code
+ *            - 0 success
+ *            - 2 publisher is NULL
+ *            - 3 publisher is not opened
+ * @note      only one thread can publish, it never waits for the subscribers
+ */
+uint8_t ms5837_shm_publish(ms5837_shm_publisher_t *publisher, const ms5837_shm_sample_t *sample)
+{
+    volatile ms5837_shm_sample_t *slot;
+    ms5837_shm_sample_t data;
+    uint64_t head;
+    
+    if ((publisher == NULL) || (sample == NULL))
+    {
+        return 2;
+    }
+    if (publisher->header == NULL)
+    {
+        return 3;
+    }
+    
+    /* invalidate the slot, fill it and then give it the new sequence number */
+    head = publisher->head + 1;
+    slot = &publisher->slot[(head - 1) % publisher->header->size];
+    data = *sample;
+    data.seq = 0;
+    slot->seq = 0;
+    MS5837_BARRIER();
+    *(ms5837_shm_sample_t *)slot = data;
+    MS5837_BARRIER();
+    slot->seq = head;
+    MS5837_BARRIER();
+    publisher->header->head = head;
+    publisher->head = head;
+    
+    return 0;
+}
+
+/**
+ * @brief     open a subscriber
+ * @param[in] *subscriber pointer to a subscriber structure
+ * @param[in] *name pointer to the shared memory name of the publisher
+ * @param[in] decimation read every decimation sample, 1 reads all
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 subscriber is NULL
+ *            - 4 decimation is invalid
+ *            - 5 ring is invalid
+ * @note      the subscriber starts with the next published sample
+ */
+uint8_t ms5837_shm_subscriber_open(ms5837_shm_subscriber_t *subscriber, const char *name, uint32_t decimation)
+{
+    int fd;
+    void *addr;
+    struct stat st;
+    const ms5837_shm_header_t *header;
+    
+    if ((subscriber == NULL) || (name == NULL))
+    {
+        return 2;
+    }
+    if (decimation == 0)
+    {
+        return 4;
+    }
+    
+    fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(ms5837_shm_header_t)))
+    {
+        (void)close(fd);
+        
+        return 5;
+    }
+    addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return 1;
+    }
+    header = (const ms5837_shm_header_t *)addr;
+    if ((header->magic != MS5837_SHM_MAGIC) || (header->version != MS5837_SHM_VERSION) ||
+        (header->slot_size != sizeof(ms5837_shm_sample_t)) || (header->size == 0) ||
+        ((size_t)st.st_size < sizeof(ms5837_shm_header_t) + (size_t)header->size * sizeof(ms5837_shm_sample_t)))
+    {
+        (void)munmap(addr, (size_t)st.st_size);
+        
+        return 5;
+    }
+    
+    subscriber->header = header;
+    subscriber->slot = (const ms5837_shm_sample_t *)((const uint8_t *)addr + sizeof(ms5837_shm_header_t));
+    subscriber->len = (size_t)st.st_size;
+    subscriber->epoch = header->epoch;
+    MS5837_BARRIER();
+    subscriber->next = header->head + 1;
+    subscriber->lost = 0;
+    subscriber->decimation = decimation;
+    subscriber->size = header->size;
+    
+    return 0;
+}
+
+/**
+ * @brief     close a subscriber
+ * @param[in] *subscriber pointer to a subscriber structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 subscriber is NULL
+ *            - 3 subscriber is not opened
+ * @note      none
+ */
+uint8_t ms5837_shm_subscriber_close(ms5837_shm_subscriber_t *subscriber)
+{
+    if (subscriber == NULL)
+    {
+        return 2;
+    }
+    if (subscriber->header == NULL)
+    {
+        return 3;
+    }
+    
+    (void)munmap((void *)subscriber->header, subscriber->len);
+    subscriber->header = NULL;
+    subscriber->slot = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief      read the next sample
+ * @param[in]  *subscriber pointer to a subscriber structure
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no new sample
+ *             - 2 subscriber is NULL
+ *             - 3 subscriber is not opened
+ *             - 4 ring is resized, reopen the subscriber
+ *             - 5 ring is invalid
+ * @note       it reads the mapped ring without locks or syscalls, a slow subscriber skips to the oldest
+ *             sample and counts the overwritten samples as lost, a gap in seq shows it,
+ *             it only trusts the slot number checked at open, never the live header
+ */
+uint8_t ms5837_shm_subscriber_read(ms5837_shm_subscriber_t *subscriber, ms5837_shm_sample_t *sample)
+{
+    const volatile ms5837_shm_sample_t *slot;
+    uint64_t epoch;
+    uint64_t head;
+    uint64_t skip;
+    uint64_t first;
+    uint64_t last;
+    uint64_t index;
+    uint32_t size;
+    
+    if ((subscriber == NULL) || (sample == NULL))
+    {
+        return 2;
+    }
+    if (subscriber->header == NULL)
+    {
+        return 3;
+    }
+    
+    size = subscriber->size;
+    while (1)
+    {
+        /* follow a restarted publisher, a resized ring needs a new mapping */
+        epoch = subscriber->header->epoch;
+        MS5837_BARRIER();
+        head = subscriber->header->head;
+        MS5837_BARRIER();
+        if (epoch != subscriber->epoch)
+        {
+            if (subscriber->header->size != size)
+            {
+                return 4;
+            }
+            subscriber->epoch = epoch;
+            subscriber->next = head + 1;
+            
+            return 1;
+        }
+        if (head < subscriber->next)
+        {
+            return 1;
+        }
+        
+        /* skip the overwritten samples */
+        if ((head - subscriber->next) >= size)
+        {
+            skip = (head - size + 1 - subscriber->next + subscriber->decimation - 1) / subscriber->decimation;
+            subscriber->next += skip * subscriber->decimation;
+            subscriber->lost += skip;
+            
+            continue;
+        }
+        
+        /* copy the slot, a changed sequence number means it was overwritten during the copy */
+        index = (subscriber->next - 1) % size;
+        if (sizeof(ms5837_shm_header_t) + (size_t)(index + 1) * sizeof(ms5837_shm_sample_t) > subscriber->len)
+        {
+            return 5;
+        }
+        slot = &subscriber->slot[index];
+        first = slot->seq;
+        MS5837_BARRIER();
+        *sample = *(const ms5837_shm_sample_t *)slot;
+        MS5837_BARRIER();
+        last = slot->seq;
+        if ((first != subscriber->next) || (last != subscriber->next))
+        {
+            subscriber->next += subscriber->decimation;
+            subscriber->lost++;
+            
+            continue;
+        }
+        sample->seq = subscriber->next;
+        subscriber->next += subscriber->decimation;
+        
+        return 0;
+    }
+}
+
+/**
+ * @brief      get the lost samples
+ * @param[in]  *subscriber pointer to a subscriber structure
+ * @param[out] *lost pointer to a lost sample number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 subscriber is NULL
+ *             - 3 subscriber is not opened
+ * @note       decimated samples are not lost
+ */
+uint8_t ms5837_shm_subscriber_get_lost(ms5837_shm_subscriber_t *subscriber, uint64_t *lost)
+{
+    if ((subscriber == NULL) || (lost == NULL))
+    {
+        return 2;
+    }
+    if (subscriber->header == NULL)
+    {
+        return 3;
+    }
+    
+    *lost = subscriber->lost;
+    
+    return 0;
+}
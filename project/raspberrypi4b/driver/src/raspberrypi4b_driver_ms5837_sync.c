@@ -0,0 +1,553 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_ms5837_sync.c
+ * @brief     raspberrypi4b driver ms5837 sync source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "raspberrypi4b_driver_ms5837_sync.h"
+#include <errno.h>
+#include <time.h>
+
+/**
+ * @brief sync timing definition
+ */
+#define SYNC_LEAD_NS               500000       /**< workers leave the barrier 500us before the deadline */
+#define SYNC_SPIN_NS               50000        /**< spin the last 50us before a deadline */
+#define SYNC_START_MARGIN_NS       1000000      /**< first deadline 1ms after start */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_sync_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     sleep until the deadline
+ * @param[in] deadline deadline in CLOCK_MONOTONIC ns
+ * @param[in] spin_ns spin window before the deadline
+ * @return    wakeup time in ns
+ * @note      none
+ */
+static uint64_t a_sync_wait_until(uint64_t deadline, uint64_t spin_ns)
+{
+    struct timespec ts;
+    uint64_t now;
+    
+    /* sleep the coarse part */
+    if (deadline > spin_ns)
+    {
+        ts.tv_sec = (time_t)((deadline - spin_ns) / 1000000000ULL);
+        ts.tv_nsec = (long)((deadline - spin_ns) % 1000000000ULL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        {
+            /* sleep again */
+        }
+    }
+    
+    /* spin the fine part */
+    do
+    {
+        now = a_sync_now_ns();
+    } while (now < deadline);
+    
+    return now;
+}
+
+/**
+ * @brief     convert one sample from the common deadline
+ * @param[in] *worker pointer to a worker structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample failed
+ * @note      none
+ */
+static uint8_t a_sync_sample(ms5837_sync_worker_t *worker)
+{
+    ms5837_sampler_sample_t *sample = &worker->sample;
+    ms5837_osr_t osr;
+    uint32_t us;
+    
+    /* start the temperature conversion at the deadline, a staged configuration takes effect here */
+    worker->start_ns = a_sync_wait_until(worker->sync->deadline_ns, SYNC_SPIN_NS);
+    if (ms5837_start_temperature_convert(worker->handle) != 0)
+    {
+        return 1;
+    }
+    (void)ms5837_get_temperature_osr(worker->handle, &osr);
+    (void)ms5837_get_convert_time(worker->handle, osr, &us);
+    (void)a_sync_wait_until(worker->start_ns + (uint64_t)us * 1000ULL, 0);
+    if (ms5837_read_adc(worker->handle, &sample->temperature_raw) != 0)
+    {
+        return 1;
+    }
+    
+    /* pressure */
+    (void)ms5837_get_pressure_osr(worker->handle, &osr);
+    (void)ms5837_get_convert_time(worker->handle, osr, &us);
+    if (ms5837_start_pressure_convert(worker->handle) != 0)
+    {
+        return 1;
+    }
+    (void)a_sync_wait_until(a_sync_now_ns() + (uint64_t)us * 1000ULL, 0);
+    if (ms5837_read_adc(worker->handle, &sample->pressure_raw) != 0)
+    {
+        return 1;
+    }
+    (void)ms5837_calculate_temperature_pressure(worker->handle, sample->temperature_raw, &sample->temperature_c,
+                                                sample->pressure_raw, &sample->pressure_mbar);
+    sample->deadline_ns = worker->sync->deadline_ns;
+    sample->timestamp_ns = a_sync_now_ns();
+    
+    return 0;
+}
+
+/**
+ * @brief     worker thread
+ * @param[in] *arg pointer to a worker structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_sync_worker(void *arg)
+{
+    ms5837_sync_worker_t *worker = (ms5837_sync_worker_t *)arg;
+    ms5837_sync_t *sync = worker->sync;
+    
+    /* wait until all threads are up, a failed start releases the created workers here */
+    while (sem_wait(&sync->launch) != 0)
+    {
+        /* wait again */
+    }
+    if (__atomic_load_n(&sync->quit, __ATOMIC_ACQUIRE) != 0)
+    {
+        return NULL;
+    }
+    while (1)
+    {
+        /* wait for the set */
+        (void)pthread_barrier_wait(&sync->start);
+        if (__atomic_load_n(&sync->quit, __ATOMIC_ACQUIRE) != 0)
+        {
+            break;
+        }
+        
+        /* sample and report the set, a failed worker reports at once so it doesn't hold the vote */
+        worker->ok = (a_sync_sample(worker) == 0) ? 1 : 0;
+        (void)pthread_barrier_wait(&sync->done);
+        
+        /* resync after a failure before the next set, it keeps the calibration and takes about 3ms */
+        if (worker->ok == 0)
+        {
+            if (ms5837_resync(worker->handle) == 0)
+            {
+                __atomic_add_fetch(&sync->stats.resyncs, 1, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     controller thread
+ * @param[in] *arg pointer to a sync structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_sync_controller(void *arg)
+{
+    ms5837_sync_t *sync = (ms5837_sync_t *)arg;
+    ms5837_sync_set_t set;
+    ms5837_fusion_t *fusion;
+    uint64_t period;
+    uint64_t next;
+    uint64_t now;
+    uint8_t i;
+    
+    period = (uint64_t)sync->period_us * 1000ULL;
+    next = a_sync_now_ns() + SYNC_START_MARGIN_NS;
+    while ((__atomic_load_n(&sync->stop, __ATOMIC_ACQUIRE) == 0) &&
+           ((sync->times == 0) || (sync->stats.sets < sync->times)))
+    {
+        uint64_t first = UINT64_MAX;
+        uint64_t last = 0;
+        
+        /* release the workers shortly before the deadline */
+        sync->deadline_ns = next;
+        (void)a_sync_wait_until(next - SYNC_LEAD_NS, 0);
+        (void)pthread_barrier_wait(&sync->start);
+        (void)pthread_barrier_wait(&sync->done);
+        
+        /* build the set */
+        memset(&set, 0, sizeof(ms5837_sync_set_t));
+        set.deadline_ns = next;
+        set.num = sync->num;
+        for (i = 0; i < sync->num; i++)
+        {
+            ms5837_sync_worker_t *worker = &sync->worker[i];
+            
+            if (worker->start_ns < first)
+            {
+                first = worker->start_ns;
+            }
+            if (worker->start_ns > last)
+            {
+                last = worker->start_ns;
+            }
+            if (worker->ok != 0)
+            {
+                set.valid |= (uint8_t)(1 << i);
+                set.sample[i] = worker->sample;
+            }
+            else
+            {
+                sync->stats.errors++;
+            }
+        }
+        set.skew_ns = last - first;
+        if (set.skew_ns > sync->stats.max_skew_ns)
+        {
+            sync->stats.max_skew_ns = set.skew_ns;
+        }
+        sync->stats.skew_sum_ns += set.skew_ns;
+        sync->stats.sets++;
+        
+        /* vote the set before the callback */
+        fusion = __atomic_load_n(&sync->fusion, __ATOMIC_ACQUIRE);
+        if (fusion != NULL)
+        {
+            int32_t temperature;
+            int32_t pressure[MS5837_BUS_MAX_NUM] = {0};
+            
+            for (i = 0; i < sync->num; i++)
+            {
+                if ((set.valid & (1 << i)) != 0)
+                {
+                    ms5837_handle_t *handle = sync->worker[i].handle;
+                    
+                    /* the applied type of the handle gives the pressure unit */
+                    (void)ms5837_compensate(handle, set.sample[i].temperature_raw, &temperature,
+                                            set.sample[i].pressure_raw, &pressure[i]);
+                    pressure[i] *= (handle->type == MS5837_TYPE_30BA26) ? 10 : 1;
+                }
+            }
+            (void)ms5837_fusion_vote(fusion, set.deadline_ns / 1000ULL, set.valid, pressure, NULL);
+        }
+        if (sync->receive != NULL)
+        {
+            sync->receive(&set);
+        }
+        
+        /* skip the periods already passed */
+        next += period;
+        now = a_sync_now_ns();
+        if ((now + SYNC_LEAD_NS) > next)
+        {
+            uint64_t skipped = (now + SYNC_LEAD_NS - next) / period + 1;
+            
+            sync->stats.missed += skipped;
+            next += skipped * period;
+        }
+    }
+    
+    /* release the workers to quit */
+    __atomic_store_n(&sync->quit, 1, __ATOMIC_RELEASE);
+    (void)pthread_barrier_wait(&sync->start);
+    
+    return NULL;
+}
+
+/**
+ * @brief     join all threads and report the statistics
+ * @param[in] *sync pointer to a sync structure
+ * @note      none
+ */
+static void a_sync_join(ms5837_sync_t *sync)
+{
+    uint8_t i;
+    
+    (void)pthread_join(sync->thread, NULL);
+    for (i = 0; i < sync->num; i++)
+    {
+        (void)pthread_join(sync->worker[i].thread, NULL);
+    }
+    (void)pthread_barrier_destroy(&sync->start);
+    (void)pthread_barrier_destroy(&sync->done);
+    (void)sem_destroy(&sync->launch);
+    sync->running = 0;
+    
+    ms5837_interface_debug_print("ms5837: sync sets %llu missed %llu errors %llu resyncs %llu.\n",
+                                 (unsigned long long)sync->stats.sets, (unsigned long long)sync->stats.missed,
+                                 (unsigned long long)sync->stats.errors, (unsigned long long)sync->stats.resyncs);
+    if (sync->stats.sets > 0)
+    {
+        ms5837_interface_debug_print("ms5837: sync skew max %0.1fus mean %0.1fus.\n",
+                                     (double)sync->stats.max_skew_ns / 1000.0,
+                                     (double)sync->stats.skew_sum_ns / (double)sync->stats.sets / 1000.0);
+    }
+}
+
+/**
+ * @brief     release and join the created workers of a failed start
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] created created worker number
+ * @note      the workers still wait at the launch gate, so none of them has entered a barrier
+ */
+static void a_sync_abort(ms5837_sync_t *sync, uint8_t created)
+{
+    uint8_t i;
+    
+    __atomic_store_n(&sync->quit, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < created; i++)
+    {
+        (void)sem_post(&sync->launch);
+    }
+    for (i = 0; i < created; i++)
+    {
+        (void)pthread_join(sync->worker[i].thread, NULL);
+    }
+    (void)pthread_barrier_destroy(&sync->start);
+    (void)pthread_barrier_destroy(&sync->done);
+    (void)sem_destroy(&sync->launch);
+}
+
+/**
+ * @brief     start the synchronized sampling
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] **handle pointer to an array of initialized handles, each on its own bus
+ * @param[in] num handle number
+ * @param[in] period_us sampling period
+ * @param[in] times set times, 0 runs until stop
+ * @param[in] *fusion pointer to an initialized fusion structure with one sensor per handle, can be NULL
+ * @param[in] *receive pointer to a set callback, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 sync is NULL
+ *            - 4 thread create failed
+ * @note      every period all workers leave a barrier and start the conversions at the same deadline,
+ *            the fusion votes every set from the first one and the callback runs after it in the controller thread,
+ *            a failed worker reports its set at once and resyncs before the next one,
+ *            the pressure unit of each sensor comes from the applied type of its handle
+ */
+uint8_t ms5837_sync_start(ms5837_sync_t *sync, ms5837_handle_t **handle, uint8_t num, uint32_t period_us,
+                          uint64_t times, ms5837_fusion_t *fusion, void (*receive)(ms5837_sync_set_t *set))
+{
+    uint8_t i;
+    
+    if (sync == NULL)
+    {
+        return 2;
+    }
+    if ((handle == NULL) || (num == 0) || (num > MS5837_BUS_MAX_NUM) ||
+        ((uint64_t)period_us * 1000ULL <= SYNC_LEAD_NS) || ((fusion != NULL) && (fusion->config.num != num)))
+    {
+        ms5837_interface_debug_print("ms5837: sync param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* save the params */
+    memset(sync, 0, sizeof(ms5837_sync_t));
+    sync->num = num;
+    sync->period_us = period_us;
+    sync->times = times;
+    sync->receive = receive;
+    sync->fusion = fusion;
+    for (i = 0; i < num; i++)
+    {
+        sync->worker[i].sync = sync;
+        sync->worker[i].handle = handle[i];
+    }
+    
+    /* workers and the controller meet at both barriers, the workers pass the launch gate first */
+    if (sem_init(&sync->launch, 0, 0) != 0)
+    {
+        return 1;
+    }
+    if (pthread_barrier_init(&sync->start, NULL, num + 1) != 0)
+    {
+        (void)sem_destroy(&sync->launch);
+        
+        return 1;
+    }
+    if (pthread_barrier_init(&sync->done, NULL, num + 1) != 0)
+    {
+        (void)pthread_barrier_destroy(&sync->start);
+        (void)sem_destroy(&sync->launch);
+        
+        return 1;
+    }
+    
+    /* create the threads */
+    for (i = 0; i < num; i++)
+    {
+        if (pthread_create(&sync->worker[i].thread, NULL, a_sync_worker, &sync->worker[i]) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: create worker failed.\n");
+            a_sync_abort(sync, i);
+            
+            return 4;
+        }
+    }
+    if (pthread_create(&sync->thread, NULL, a_sync_controller, sync) != 0)
+    {
+        ms5837_interface_debug_print("ms5837: create controller failed.\n");
+        a_sync_abort(sync, num);
+        
+        return 4;
+    }
+    
+    /* all threads are up, open the gate */
+    for (i = 0; i < num; i++)
+    {
+        (void)sem_post(&sync->launch);
+    }
+    sync->running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     wait for the synchronized sampling to finish the set times
+ * @param[in] *sync pointer to a sync structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sync is NULL
+ *            - 3 sync is not running
+ * @note      none
+ */
+uint8_t ms5837_sync_wait(ms5837_sync_t *sync)
+{
+    if (sync == NULL)
+    {
+        return 2;
+    }
+    if (sync->running != 1)
+    {
+        return 3;
+    }
+    
+    a_sync_join(sync);
+    
+    return 0;
+}
+
+/**
+ * @brief     stop the synchronized sampling
+ * @param[in] *sync pointer to a sync structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sync is NULL
+ *            - 3 sync is not running
+ * @note      the current set is finished first
+ */
+uint8_t ms5837_sync_stop(ms5837_sync_t *sync)
+{
+    if (sync == NULL)
+    {
+        return 2;
+    }
+    if (sync->running != 1)
+    {
+        return 3;
+    }
+    
+    __atomic_store_n(&sync->stop, 1, __ATOMIC_RELEASE);
+    a_sync_join(sync);
+    
+    return 0;
+}
+
+/**
+ * @brief      get the sync statistics
+ * @param[in]  *sync pointer to a sync structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sync is NULL
+ * @note       read it after the threads have stopped
+ */
+uint8_t ms5837_sync_get_stats(ms5837_sync_t *sync, ms5837_sync_stats_t *stats)
+{
+    if (sync == NULL)
+    {
+        return 2;
+    }
+    
+    *stats = sync->stats;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a fusion stage to the synchronized sampling
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] *fusion pointer to an initialized fusion structure with one sensor per handle, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 sync is NULL
+ *            - 3 sync is not running
+ *            - 4 fusion sensor number is not the handle number
+ * @note      it swaps the fusion of ms5837_sync_start while running, every later set is voted in the controller thread
+ *            as soon as the last worker is done and before the callback, read it with ms5837_fusion_get
+ */
+uint8_t ms5837_sync_set_fusion(ms5837_sync_t *sync, ms5837_fusion_t *fusion)
+{
+    if (sync == NULL)
+    {
+        return 2;
+    }
+    if (sync->running != 1)
+    {
+        return 3;
+    }
+    if ((fusion != NULL) && (fusion->config.num != sync->num))
+    {
+        return 4;
+    }
+    
+    __atomic_store_n(&sync->fusion, fusion, __ATOMIC_RELEASE);
+    
+    return 0;
+}
@@ -0,0 +1,915 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      convert.c
+ * @brief     convert source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "driver_ms5837.h"
+#include "driver_ms5837_archive.h"
+#include <getopt.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief convert chunk definition
+ */
+#define CONVERT_CHUNK_SIZE        (1024 * 1024)        /**< input bytes of one chunk */
+#define CONVERT_LINE_MAX          256                  /**< max csv line length */
+#define CONVERT_THREAD_MAX        64                   /**< max worker threads */
+#define CONVERT_RECORD_SIZE       16                   /**< binary record size */
+
+/**
+ * @brief convert slot state enumeration definition
+ */
+typedef enum
+{
+    CONVERT_SLOT_EMPTY  = 0x00,        /**< free for the reader */
+    CONVERT_SLOT_FILLED = 0x01,        /**< read, waiting for a worker */
+    CONVERT_SLOT_BUSY   = 0x02,        /**< owned by a worker */
+    CONVERT_SLOT_DONE   = 0x03,        /**< converted, waiting for the writer */
+} convert_slot_state_t;
+
+/**
+ * @brief convert slot structure definition
+ */
+typedef struct convert_slot_s
+{
+    char in[CONVERT_CHUNK_SIZE + CONVERT_LINE_MAX];        /**< input chunk */
+    uint32_t in_len;                                       /**< input length */
+    uint8_t *out;                                          /**< output buffer */
+    uint32_t out_len;                                      /**< output length */
+    uint32_t out_size;                                     /**< output buffer size */
+    uint32_t samples;                                      /**< converted samples */
+    uint32_t bad;                                          /**< skipped lines */
+    uint8_t failed;                                        /**< out of memory */
+    ms5837_archive_t archive;                              /**< archive writer */
+    convert_slot_state_t state;                            /**< slot state */
+} convert_slot_t;
+
+static ms5837_handle_t gs_handle;                  /**< handle with the prom of the log */
+static uint16_t gs_prom[8];                        /**< prom words of the log */
+static convert_slot_t *gs_slot;                    /**< chunk slots */
+static uint32_t gs_slot_num;                       /**< chunk slot number */
+static uint64_t gs_work_seq;                       /**< next chunk for a worker */
+static uint8_t gs_quit;                            /**< worker quit flag */
+static pthread_mutex_t gs_mutex;                   /**< slot state mutex */
+static pthread_cond_t gs_work_cond;                /**< a chunk is filled */
+static pthread_cond_t gs_done_cond;                /**< a chunk is converted */
+static uint8_t gs_binary;                          /**< binary input */
+static uint8_t gs_archive;                         /**< archive output */
+static double gs_scale;                            /**< pressure counts per mbar */
+static int32_t gs_pressure_mul;                    /**< pressure counts to 0.01 mbar */
+static double gs_depth_mm;                         /**< depth in mm per mbar */
+static double gs_surface;                          /**< surface pressure in mbar */
+static double gs_density;                          /**< water density in kg/m3 */
+
+/**
+ * @brief  prom iic init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_convert_iic_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  prom iic deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_convert_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     prom iic read
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      only the prom words of the log can be read
+ */
+static uint8_t a_convert_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    if (((reg & 0xF0) != 0xA0) || (len != 2))
+    {
+        return 1;
+    }
+    buf[0] = (uint8_t)(gs_prom[(reg & 0x0F) >> 1] >> 8);
+    buf[1] = (uint8_t)(gs_prom[(reg & 0x0F) >> 1] >> 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     prom iic write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_convert_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    (void)reg;
+    (void)buf;
+    (void)len;
+    
+    return 0;
+}
+
+/**
+ * @brief     prom delay
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_convert_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/**
+ * @brief     print to stderr
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_convert_debug_print(const char *const fmt, ...)
+{
+    va_list args;
+    
+    va_start(args, fmt);
+    (void)vfprintf(stderr, fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief     load the prom and init the handle
+ * @param[in] *path pointer to a prom file path
+ * @param[in] type chip type, 0xFF keeps the type of the prom
+ * @return    status code
+ *            - 0 success
+ *            - 1 load failed
+ * @note      the file holds 7 words in decimal or 0x hex, the crc and the type are checked by ms5837_init
+ */
+static uint8_t a_convert_load_prom(const char *path, uint8_t type)
+{
+    FILE *fp;
+    unsigned long word;
+    char text[32];
+    uint8_t i;
+    
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        a_convert_debug_print("ms5837_convert: open %s failed.\n", path);
+        
+        return 1;
+    }
+    for (i = 0; i < 7; i++)
+    {
+        if (fscanf(fp, " %31[^ ,\t\r\n]%*[ ,\t\r\n]", text) < 1)
+        {
+            break;
+        }
+        word = strtoul(text, NULL, 0);
+        if (word > 0xFFFF)
+        {
+            break;
+        }
+        gs_prom[i] = (uint16_t)word;
+    }
+    (void)fclose(fp);
+    if (i != 7)
+    {
+        a_convert_debug_print("ms5837_convert: %s needs 7 prom words.\n", path);
+        
+        return 1;
+    }
+    
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    DRIVER_MS5837_LINK_IIC_INIT(&gs_handle, a_convert_iic_init);
+    DRIVER_MS5837_LINK_IIC_DEINIT(&gs_handle, a_convert_iic_deinit);
+    DRIVER_MS5837_LINK_IIC_READ(&gs_handle, a_convert_iic_read);
+    DRIVER_MS5837_LINK_IIC_WRITE(&gs_handle, a_convert_iic_write);
+    DRIVER_MS5837_LINK_DELAY_MS(&gs_handle, a_convert_delay_ms);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, a_convert_debug_print);
+    if (ms5837_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    if (type != 0xFF)
+    {
+        (void)ms5837_set_type(&gs_handle, (ms5837_type_t)type);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     reserve output space of a slot
+ * @param[in] *slot pointer to a slot
+ * @param[in] len needed bytes
+ * @return    status code
+ *            - 0 success
+ *            - 1 out of memory
+ * @note      the buffer only grows, so the memory is bounded by the largest chunk
+ */
+static uint8_t a_convert_reserve(convert_slot_t *slot, uint32_t len)
+{
+    uint8_t *out;
+    uint32_t size;
+    
+    if (slot->out_len + len <= slot->out_size)
+    {
+        return 0;
+    }
+    size = (slot->out_size == 0) ? (2 * CONVERT_CHUNK_SIZE) : (slot->out_size * 2);
+    while (size < slot->out_len + len)
+    {
+        size *= 2;
+    }
+    out = (uint8_t *)realloc(slot->out, size);
+    if (out == NULL)
+    {
+        return 1;
+    }
+    slot->out = out;
+    slot->out_size = size;
+    
+    return 0;
+}
+
+/**
+ * @brief     flush the archive of a slot
+ * @param[in] *slot pointer to a slot
+ * @return    status code
+ *            - 0 success
+ *            - 1 out of memory
+ * @note      none
+ */
+static uint8_t a_convert_flush(convert_slot_t *slot)
+{
+    uint32_t len;
+    
+    if (a_convert_reserve(slot, MS5837_ARCHIVE_BLOCK_SIZE_MAX) != 0)
+    {
+        return 1;
+    }
+    (void)ms5837_archive_encode(&slot->archive, slot->out + slot->out_len, slot->out_size - slot->out_len, &len);
+    slot->out_len += len;
+    
+    return 0;
+}
+
+/**
+ * @brief     print a fixed point number
+ * @param[in] *text pointer to a text buffer
+ * @param[in] value value in units of the last decimal
+ * @param[in] decimals decimal places
+ * @param[in] end character after the number
+ * @return    pointer to the end of the text
+ * @note      it is several times faster than snprintf with %f, which bounds the csv throughput
+ */
+static char *a_convert_fixed(char *text, int64_t value, uint8_t decimals, char end)
+{
+    char digit[24];
+    uint64_t u;
+    uint8_t n = 0;
+    
+    if (value < 0)
+    {
+        *text++ = '-';
+        u = (uint64_t)(-(value + 1)) + 1;
+    }
+    else
+    {
+        u = (uint64_t)value;
+    }
+    do
+    {
+        digit[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while ((u != 0) || (n <= decimals));
+    while (n > 0)
+    {
+        if ((n == decimals) && (decimals != 0))
+        {
+            *text++ = '.';
+        }
+        *text++ = digit[--n];
+    }
+    *text++ = end;
+    
+    return text;
+}
+
+/**
+ * @brief     convert one sample
+ * @param[in] *slot pointer to a slot
+ * @param[in] time_us sample time
+ * @param[in] d1 raw pressure
+ * @param[in] d2 raw temperature
+ * @return    status code
+ *            - 0 success
+ *            - 1 out of memory
+ * @note      none
+ */
+static uint8_t a_convert_sample(convert_slot_t *slot, uint64_t time_us, uint32_t d1, uint32_t d2)
+{
+    int32_t temperature;
+    int32_t pressure;
+    char *text;
+    
+    (void)ms5837_compensate(&gs_handle, d2, &temperature, d1, &pressure);
+    slot->samples++;
+    if (gs_archive != 0)
+    {
+        if (ms5837_archive_append(&slot->archive, time_us, temperature, pressure) == 1)
+        {
+            if (a_convert_flush(slot) != 0)
+            {
+                return 1;
+            }
+            (void)ms5837_archive_append(&slot->archive, time_us, temperature, pressure);
+        }
+        
+        return 0;
+    }
+    if (a_convert_reserve(slot, 96) != 0)
+    {
+        return 1;
+    }
+    text = (char *)slot->out + slot->out_len;
+    text = a_convert_fixed(text, (int64_t)time_us, 0, ',');
+    text = a_convert_fixed(text, temperature, 2, ',');
+    text = a_convert_fixed(text, (int64_t)pressure * gs_pressure_mul, 2, ',');
+    text = a_convert_fixed(text, (int64_t)llround(((double)pressure / gs_scale - gs_surface) * gs_depth_mm), 3, '\n');
+    slot->out_len = (uint32_t)(text - (char *)slot->out);
+    
+    return 0;
+}
+
+/**
+ * @brief     convert one chunk
+ * @param[in] *slot pointer to a slot
+ * @note      csv lines are time_us,d1,d2, blank lines and lines starting with # are skipped,
+ *            binary records are a little endian uint64 time_us, uint32 d1 and uint32 d2
+ */
+static void a_convert_chunk(convert_slot_t *slot)
+{
+    uint32_t i;
+    
+    slot->out_len = 0;
+    slot->samples = 0;
+    slot->bad = 0;
+    slot->failed = 0;
+    if (gs_archive != 0)
+    {
+        (void)ms5837_archive_init(&slot->archive, (ms5837_type_t)gs_handle.type);
+    }
+    if (gs_binary != 0)
+    {
+        for (i = 0; i + CONVERT_RECORD_SIZE <= slot->in_len; i += CONVERT_RECORD_SIZE)
+        {
+            const uint8_t *p = (const uint8_t *)slot->in + i;
+            uint64_t time_us = 0;
+            uint32_t d1;
+            uint32_t d2;
+            int8_t j;
+            
+            for (j = 7; j >= 0; j--)
+            {
+                time_us = (time_us << 8) | p[j];
+            }
+            d1 = (uint32_t)p[8] | ((uint32_t)p[9] << 8) | ((uint32_t)p[10] << 16) | ((uint32_t)p[11] << 24);
+            d2 = (uint32_t)p[12] | ((uint32_t)p[13] << 8) | ((uint32_t)p[14] << 16) | ((uint32_t)p[15] << 24);
+            if (a_convert_sample(slot, time_us, d1, d2) != 0)
+            {
+                slot->failed = 1;
+                
+                return;
+            }
+        }
+    }
+    else
+    {
+        char *line = slot->in;
+        char *end = slot->in + slot->in_len;
+        
+        while (line < end)
+        {
+            char *next = memchr(line, '\n', (size_t)(end - line));
+            char *p;
+            unsigned long long time_us;
+            unsigned long d1;
+            unsigned long d2;
+            
+            next = (next == NULL) ? end : next;
+            *next = '\0';
+            while ((*line == ' ') || (*line == '\t'))
+            {
+                line++;
+            }
+            if ((*line == '\0') || (*line == '\r') || (*line == '#'))
+            {
+                line = next + 1;
+                
+                continue;
+            }
+            time_us = strtoull(line, &p, 10);
+            if ((p != line) && ((*p == ',') || (*p == ' ') || (*p == '\t')))
+            {
+                line = p + 1;
+                d1 = strtoul(line, &p, 10);
+                if ((p != line) && ((*p == ',') || (*p == ' ') || (*p == '\t')))
+                {
+                    line = p + 1;
+                    d2 = strtoul(line, &p, 10);
+                    if ((p != line) && ((*p == '\0') || (*p == '\r')) && (d1 <= 0xFFFFFF) && (d2 <= 0xFFFFFF))
+                    {
+                        if (a_convert_sample(slot, (uint64_t)time_us, (uint32_t)d1, (uint32_t)d2) != 0)
+                        {
+                            slot->failed = 1;
+                            
+                            return;
+                        }
+                        line = next + 1;
+                        
+                        continue;
+                    }
+                }
+            }
+            slot->bad++;
+            line = next + 1;
+        }
+    }
+    if ((gs_archive != 0) && (a_convert_flush(slot) != 0))
+    {
+        slot->failed = 1;
+    }
+}
+
+/**
+ * @brief     worker thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      workers take the filled chunks in order, the writer puts them back in order
+ */
+static void *a_convert_worker(void *arg)
+{
+    convert_slot_t *slot;
+    
+    (void)arg;
+    while (1)
+    {
+        (void)pthread_mutex_lock(&gs_mutex);
+        while ((gs_quit == 0) && (gs_slot[gs_work_seq % gs_slot_num].state != CONVERT_SLOT_FILLED))
+        {
+            (void)pthread_cond_wait(&gs_work_cond, &gs_mutex);
+        }
+        if (gs_quit != 0)
+        {
+            (void)pthread_mutex_unlock(&gs_mutex);
+            
+            break;
+        }
+        slot = &gs_slot[gs_work_seq % gs_slot_num];
+        slot->state = CONVERT_SLOT_BUSY;
+        gs_work_seq++;
+        (void)pthread_cond_broadcast(&gs_work_cond);
+        (void)pthread_mutex_unlock(&gs_mutex);
+        
+        a_convert_chunk(slot);
+        
+        (void)pthread_mutex_lock(&gs_mutex);
+        slot->state = CONVERT_SLOT_DONE;
+        (void)pthread_cond_signal(&gs_done_cond);
+        (void)pthread_mutex_unlock(&gs_mutex);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief         fill a chunk
+ * @param[in]     *fp pointer to the input file
+ * @param[in]     *slot pointer to a slot
+ * @param[in,out] *carry pointer to the partial csv line of the last chunk
+ * @param[in,out] *carry_len pointer to the partial line length
+ * @return        status code
+ *                - 0 success
+ *                - 1 line is too long
+ * @note          a csv chunk ends at its last newline, a binary chunk at a whole record
+ */
+static uint8_t a_convert_fill(FILE *fp, convert_slot_t *slot, char *carry, uint32_t *carry_len)
+{
+    uint32_t len;
+    uint32_t cut;
+    
+    memcpy(slot->in, carry, *carry_len);
+    len = *carry_len + (uint32_t)fread(slot->in + *carry_len, 1, CONVERT_CHUNK_SIZE, fp);
+    if (gs_binary != 0)
+    {
+        cut = len - len % CONVERT_RECORD_SIZE;
+    }
+    else if (feof(fp) != 0)
+    {
+        cut = len;
+    }
+    else
+    {
+        for (cut = len; (cut > 0) && (slot->in[cut - 1] != '\n'); cut--)
+        {
+        }
+    }
+    if (len - cut >= CONVERT_LINE_MAX)
+    {
+        return 1;
+    }
+    *carry_len = len - cut;
+    memcpy(carry, slot->in + cut, *carry_len);
+    slot->in_len = cut;
+    
+    return 0;
+}
+
+/**
+ * @brief     convert a log
+ * @param[in] *fin pointer to the input file
+ * @param[in] *fout pointer to the output file
+ * @param[in] threads worker thread number
+ * @return    status code
+ *            - 0 success
+ *            - 1 convert failed
+ * @note      the reader and the writer share this thread, at most 2 chunks per worker are in flight
+ */
+static uint8_t a_convert_run(FILE *fin, FILE *fout, uint32_t threads)
+{
+    pthread_t tid[CONVERT_THREAD_MAX];
+    char carry[CONVERT_LINE_MAX];
+    uint32_t carry_len = 0;
+    uint64_t read_seq = 0;
+    uint64_t write_seq = 0;
+    uint64_t samples = 0;
+    uint64_t bad = 0;
+    uint64_t bytes = 0;
+    uint8_t eof = 0;
+    uint8_t res = 0;
+    uint32_t i;
+    struct timespec start;
+    struct timespec stop;
+    double seconds;
+    
+    gs_slot_num = threads * 2;
+    gs_slot = (convert_slot_t *)calloc(gs_slot_num, sizeof(convert_slot_t));
+    if (gs_slot == NULL)
+    {
+        return 1;
+    }
+    gs_work_seq = 0;
+    gs_quit = 0;
+    (void)pthread_mutex_init(&gs_mutex, NULL);
+    (void)pthread_cond_init(&gs_work_cond, NULL);
+    (void)pthread_cond_init(&gs_done_cond, NULL);
+    for (i = 0; i < threads; i++)
+    {
+        if (pthread_create(&tid[i], NULL, a_convert_worker, NULL) != 0)
+        {
+            break;
+        }
+    }
+    threads = i;
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    (void)pthread_mutex_lock(&gs_mutex);
+    while ((threads != 0) && ((eof == 0) || (write_seq != read_seq)))
+    {
+        convert_slot_t *slot = &gs_slot[write_seq % gs_slot_num];
+        
+        /* write the converted chunks in order */
+        if (slot->state == CONVERT_SLOT_DONE)
+        {
+            (void)pthread_mutex_unlock(&gs_mutex);
+            if ((slot->failed != 0) || (fwrite(slot->out, 1, slot->out_len, fout) != slot->out_len))
+            {
+                a_convert_debug_print("ms5837_convert: write failed.\n");
+                res = 1;
+                eof = 1;
+            }
+            samples += slot->samples;
+            bad += slot->bad;
+            bytes += slot->out_len;
+            (void)pthread_mutex_lock(&gs_mutex);
+            slot->state = CONVERT_SLOT_EMPTY;
+            write_seq++;
+            
+            continue;
+        }
+        
+        /* read the next chunk into a free slot */
+        slot = &gs_slot[read_seq % gs_slot_num];
+        if ((eof == 0) && (slot->state == CONVERT_SLOT_EMPTY))
+        {
+            (void)pthread_mutex_unlock(&gs_mutex);
+            if (a_convert_fill(fin, slot, carry, &carry_len) != 0)
+            {
+                a_convert_debug_print("ms5837_convert: line is longer than %d bytes.\n", CONVERT_LINE_MAX);
+                res = 1;
+                eof = 1;
+            }
+            else
+            {
+                eof = ((feof(fin) != 0) || (ferror(fin) != 0)) ? 1 : 0;
+            }
+            (void)pthread_mutex_lock(&gs_mutex);
+            if ((res == 0) && (slot->in_len != 0))
+            {
+                slot->state = CONVERT_SLOT_FILLED;
+                read_seq++;
+                (void)pthread_cond_signal(&gs_work_cond);
+            }
+            
+            continue;
+        }
+        (void)pthread_cond_wait(&gs_done_cond, &gs_mutex);
+    }
+    gs_quit = 1;
+    (void)pthread_cond_broadcast(&gs_work_cond);
+    (void)pthread_mutex_unlock(&gs_mutex);
+    for (i = 0; i < threads; i++)
+    {
+        (void)pthread_join(tid[i], NULL);
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &stop);
+    seconds = (double)(stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1e9;
+    
+    for (i = 0; i < gs_slot_num; i++)
+    {
+        free(gs_slot[i].out);
+    }
+    free(gs_slot);
+    (void)pthread_cond_destroy(&gs_done_cond);
+    (void)pthread_cond_destroy(&gs_work_cond);
+    (void)pthread_mutex_destroy(&gs_mutex);
+    if (threads == 0)
+    {
+        a_convert_debug_print("ms5837_convert: create thread failed.\n");
+        
+        return 1;
+    }
+    if (carry_len != 0)
+    {
+        a_convert_debug_print("ms5837_convert: %u trailing bytes are not a whole record.\n", carry_len);
+    }
+    a_convert_debug_print("ms5837_convert: %llu samples, %llu bad lines, %llu output bytes in %0.3fs with %u threads, %0.2f Msamples/s.\n",
+                          (unsigned long long)samples, (unsigned long long)bad, (unsigned long long)bytes,
+                          seconds, threads, (seconds > 0.0) ? (double)samples / seconds / 1e6 : 0.0);
+    
+    return res;
+}
+
+/**
+ * @brief  print the help
+ * @note   none
+ */
+static void a_convert_help(void)
+{
+    a_convert_debug_print("Usage:\n");
+    a_convert_debug_print("  ms5837_convert (-h | --help)\n");
+    a_convert_debug_print("  ms5837_convert --prom=<path> [--type=<02BA01 | 02BA21 | 30BA26>] [--input=<csv | bin>] [--output=<csv | archive>]\n");
+    a_convert_debug_print("                 [--threads=<num>] [--surface=<mbar>] [--density=<kg/m3>] <in | -> <out | ->\n");
+    a_convert_debug_print("\n");
+    a_convert_debug_print("Options:\n");
+    a_convert_debug_print("      --density=<kg/m3>    Set the water density of the depth.([default: 1029])\n");
+    a_convert_debug_print("  -h, --help               Show the help.\n");
+    a_convert_debug_print("      --input=<csv | bin>  Set the raw log format, csv lines are time_us,d1,d2 and bin records are\n");
+    a_convert_debug_print("                           little endian uint64 time_us, uint32 d1 and uint32 d2.([default: csv])\n");
+    a_convert_debug_print("      --output=<csv | archive>\n");
+    a_convert_debug_print("                           Set the output format, csv lines are time_us,temperature_c,pressure_mbar,depth_m\n");
+    a_convert_debug_print("                           and archive is the columnar block format of driver_ms5837_archive.h.([default: csv])\n");
+    a_convert_debug_print("      --prom=<path>        Set the file of the 7 prom words in decimal or 0x hex.\n");
+    a_convert_debug_print("      --surface=<mbar>     Set the surface pressure of the depth.([default: 1013.25])\n");
+    a_convert_debug_print("      --threads=<num>      Set the worker threads.([default: the online cpus])\n");
+    a_convert_debug_print("      --type=<02BA01 | 02BA21 | 30BA26>\n");
+    a_convert_debug_print("                           Set the chip type.([default: the type of the prom])\n");
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"prom", required_argument, NULL, 1},
+        {"type", required_argument, NULL, 2},
+        {"input", required_argument, NULL, 3},
+        {"output", required_argument, NULL, 4},
+        {"threads", required_argument, NULL, 5},
+        {"surface", required_argument, NULL, 6},
+        {"density", required_argument, NULL, 7},
+        {NULL, 0, NULL, 0},
+    };
+    char prom[256] = {0};
+    uint8_t type = 0xFF;
+    long threads;
+    FILE *fin;
+    FILE *fout;
+    uint8_t res;
+    int c;
+    
+    gs_binary = 0;
+    gs_archive = 0;
+    gs_surface = 1013.25;
+    gs_density = 1029.0;
+    threads = sysconf(_SC_NPROCESSORS_ONLN);
+    
+    /* parse */
+    while ((c = getopt_long(argc, argv, short_options, long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            /* prom */
+            case 1 :
+            {
+                strncpy(prom, optarg, 255);
+                
+                break;
+            }
+            
+            /* type */
+            case 2 :
+            {
+                if (strcmp("02BA01", optarg) == 0)
+                {
+                    type = MS5837_TYPE_02BA01;
+                }
+                else if (strcmp("02BA21", optarg) == 0)
+                {
+                    type = MS5837_TYPE_02BA21;
+                }
+                else if (strcmp("30BA26", optarg) == 0)
+                {
+                    type = MS5837_TYPE_30BA26;
+                }
+                else
+                {
+                    a_convert_help();
+                    
+                    return 1;
+                }
+                
+                break;
+            }
+            
+            /* input */
+            case 3 :
+            {
+                gs_binary = (strcmp("bin", optarg) == 0) ? 1 : 0;
+                
+                break;
+            }
+            
+            /* output */
+            case 4 :
+            {
+                gs_archive = (strcmp("archive", optarg) == 0) ? 1 : 0;
+                
+                break;
+            }
+            
+            /* threads */
+            case 5 :
+            {
+                threads = atol(optarg);
+                
+                break;
+            }
+            
+            /* surface */
+            case 6 :
+            {
+                gs_surface = atof(optarg);
+                
+                break;
+            }
+            
+            /* density */
+            case 7 :
+            {
+                gs_density = atof(optarg);
+                
+                break;
+            }
+            
+            /* help and the others */
+            default :
+            {
+                a_convert_help();
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    if ((prom[0] == '\0') || (argc - optind != 2) || (gs_density <= 0.0))
+    {
+        a_convert_help();
+        
+        return 1;
+    }
+    threads = (threads < 1) ? 1 : ((threads > CONVERT_THREAD_MAX) ? CONVERT_THREAD_MAX : threads);
+    if (a_convert_load_prom(prom, type) != 0)
+    {
+        return 1;
+    }
+    gs_scale = (gs_handle.type == MS5837_TYPE_30BA26) ? 10.0 : 100.0;
+    gs_pressure_mul = (gs_handle.type == MS5837_TYPE_30BA26) ? 10 : 1;
+    gs_depth_mm = 100.0 * 1000.0 / (gs_density * 9.80665);
+    
+    /* open the files, - is the standard stream */
+    fin = (strcmp("-", argv[optind]) == 0) ? stdin : fopen(argv[optind], "rb");
+    if (fin == NULL)
+    {
+        a_convert_debug_print("ms5837_convert: open %s failed.\n", argv[optind]);
+        
+        return 1;
+    }
+    fout = (strcmp("-", argv[optind + 1]) == 0) ? stdout : fopen(argv[optind + 1], "wb");
+    if (fout == NULL)
+    {
+        a_convert_debug_print("ms5837_convert: open %s failed.\n", argv[optind + 1]);
+        if (fin != stdin)
+        {
+            (void)fclose(fin);
+        }
+        
+        return 1;
+    }
+    res = a_convert_run(fin, fout, (uint32_t)threads);
+    if (fin != stdin)
+    {
+        (void)fclose(fin);
+    }
+    if ((fflush(fout) != 0) || ((fout != stdout) && (fclose(fout) != 0)))
+    {
+        res = 1;
+    }
+    
+    return res;
+}
@@ -34,10 +34,318 @@
  * </table>
  */
 
+#include "driver_ms5837_archive_test.h"
+#include "driver_ms5837_kalman_test.h"
 #include "driver_ms5837_read_test.h"
+#include "driver_ms5837_rollup_test.h"
+#include "driver_ms5837_sim_test.h"
+#include "driver_ms5837_sync_test.h"
+#include "driver_ms5837_wave_test.h"
+#include "driver_ms5837_window_test.h"
 #include "driver_ms5837_basic.h"
+#include "driver_ms5837_sim.h"
+#include "driver_ms5837_archive.h"
+#include "driver_ms5837_deadband.h"
+#include "driver_ms5837_fusion.h"
+#include "driver_ms5837_kalman.h"
+#include "driver_ms5837_predict.h"
+#include "driver_ms5837_rollup.h"
+#include "driver_ms5837_trigger.h"
+#include "driver_ms5837_wave.h"
+#include "driver_ms5837_window.h"
+#include "raspberrypi4b_driver_ms5837_broker.h"
+#include "raspberrypi4b_driver_ms5837_bus.h"
+#include "raspberrypi4b_driver_ms5837_sampler.h"
+#include "raspberrypi4b_driver_ms5837_rt.h"
+#include "raspberrypi4b_driver_ms5837_sync.h"
+#include "raspberrypi4b_driver_ms5837_record.h"
+#include "raspberrypi4b_driver_ms5837_shm.h"
 #include <getopt.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <math.h>
 #include <stdlib.h>
+#include <time.h>
+
+static ms5837_handle_t gs_sample_handle[MS5837_BUS_MAX_NUM];        /**< sample handles */
+static uint32_t gs_sample_times;                                  /**< sample times */
+static uint32_t gs_sample_count[MS5837_BUS_MAX_NUM];               /**< sample count */
+static ms5837_window_t gs_sample_window[MS5837_BUS_MAX_NUM];       /**< sample window */
+static ms5837_trigger_t gs_trigger;                                /**< event rules */
+static ms5837_trigger_event_t gs_trigger_buf[32];                  /**< pending events */
+static int gs_trigger_fd;                                          /**< event wakeup */
+static volatile uint8_t gs_trigger_quit;                           /**< consumer quit flag */
+static uint32_t gs_trigger_wakeups;                                /**< consumer wakeups */
+static float gs_trigger_scale;                                     /**< pressure counts per mbar */
+static ms5837_deadband_t gs_deadband;                              /**< report by exception filter */
+static ms5837_shm_publisher_t gs_publisher;                        /**< shared memory publisher */
+static ms5837_shm_subscriber_t gs_subscriber;                      /**< shared memory subscriber */
+static ms5837_broker_t gs_broker;                                  /**< request broker */
+static ms5837_predict_t gs_predict;                                /**< pressure predictor */
+static ms5837_kalman_t gs_kalman;                                  /**< depth estimator */
+static ms5837_wave_t gs_wave;                                      /**< wave analyser */
+static ms5837_fusion_t gs_fusion;                                  /**< redundant sensor fusion */
+static ms5837_correction_t gs_correction;                          /**< user correction */
+static ms5837_log_event_t gs_trace_buf[4096];                      /**< trace event buffer */
+static ms5837_log_t gs_trace;                                      /**< trace log */
+static ms5837_archive_t gs_archive;                                /**< archive writer */
+static ms5837_archive_block_t gs_archive_block;                    /**< decoded archive block */
+static uint8_t gs_archive_buf[MS5837_ARCHIVE_BLOCK_SIZE_MAX];      /**< encoded archive block */
+static ms5837_rollup_t gs_rollup;                                  /**< rollup of the archive */
+static ms5837_rollup_bucket_t gs_rollup_second[3600];              /**< last hour of 1s buckets */
+static ms5837_rollup_bucket_t gs_rollup_minute[1440];              /**< last day of 1min buckets */
+static ms5837_rollup_bucket_t gs_rollup_hour[744];                 /**< last month of 1h buckets */
+static ms5837_rollup_bucket_t gs_rollup_bin[120];                  /**< rollup query bins */
+
+/**
+ * @brief     sampler receive callback
+ * @param[in] index sensor index
+ * @param[in] *sample pointer to a sample structure
+ * @note      none
+ */
+static void a_sample_receive(uint8_t index, ms5837_sampler_sample_t *sample)
+{
+    if (gs_sample_count[index] >= gs_sample_times)
+    {
+        return;
+    }
+    gs_sample_count[index]++;
+    ms5837_interface_debug_print("ms5837: bus %d %d/%d.\n", index, gs_sample_count[index], gs_sample_times);
+    ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", sample->temperature_c);
+    ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", sample->pressure_mbar);
+    ms5837_interface_debug_print("ms5837: latency is %lluus.\n",
+                                 (unsigned long long)((sample->timestamp_ns - sample->deadline_ns) / 1000ULL));
+}
+
+/**
+ * @brief     deadband receive callback
+ * @param[in] index sensor index
+ * @param[in] *sample pointer to a reported sample structure
+ * @note      none
+ */
+static void a_deadband_receive(uint8_t index, ms5837_sampler_sample_t *sample)
+{
+    (void)index;
+    ms5837_interface_debug_print("ms5837: %0.3fs temperature is %0.2fC pressure is %0.2fmbar%s%s%s%s.\n",
+                                 (double)sample->timestamp_ns / 1000000000.0, sample->temperature_c, sample->pressure_mbar,
+                                 ((sample->reason & MS5837_DEADBAND_REASON_FIRST) != 0) ? " first" : "",
+                                 ((sample->reason & MS5837_DEADBAND_REASON_TEMPERATURE) != 0) ? " temperature" : "",
+                                 ((sample->reason & MS5837_DEADBAND_REASON_PRESSURE) != 0) ? " pressure" : "",
+                                 ((sample->reason & MS5837_DEADBAND_REASON_HEARTBEAT) != 0) ? " heartbeat" : "");
+}
+
+/**
+ * @brief     kalman receive callback
+ * @param[in] index sensor index
+ * @param[in] *sample pointer to a sample structure
+ * @note      none
+ */
+static void a_kalman_receive(uint8_t index, ms5837_sampler_sample_t *sample)
+{
+    ms5837_kalman_state_t state;
+    
+    (void)index;
+    if (ms5837_kalman_get(&gs_kalman, sample->timestamp_ns / 1000ULL, &state) != 0)
+    {
+        return;
+    }
+    ms5837_interface_debug_print("ms5837: depth is %0.4fm std %0.4fm velocity %0.3fm/s acceleration %0.3fm/s2.\n",
+                                 (double)state.depth_um / 1000000.0, (double)state.depth_std_um / 1000000.0,
+                                 (double)state.velocity_um_s / 1000000.0, (double)state.acceleration_um_s2 / 1000000.0);
+}
+
+/**
+ * @brief     retune receive callback
+ * @param[in] *sample pointer to a sample structure
+ * @note      it runs in the sampling thread, so the osr is the one of the sample
+ */
+static void a_retune_receive(ms5837_sampler_sample_t *sample)
+{
+    ms5837_osr_t osr;
+    
+    (void)ms5837_get_pressure_osr(&gs_sample_handle[0], &osr);
+    gs_sample_count[0]++;
+    ms5837_interface_debug_print("ms5837: %d/%d osr %d temperature is %0.2fC pressure is %0.2fmbar.\n",
+                                 gs_sample_count[0], gs_sample_times, 256 << osr,
+                                 sample->temperature_c, sample->pressure_mbar);
+}
+
+/**
+ * @brief     trigger consumer thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      it sleeps in the eventfd until the sampler fires an event
+ */
+static void *a_trigger_consumer(void *arg)
+{
+    static const char *const name[] = {"surfaced", "over depth", "fast descent", "fast ascent"};
+    ms5837_trigger_event_t event;
+    uint64_t count;
+    
+    (void)arg;
+    while (read(gs_trigger_fd, &count, sizeof(count)) == sizeof(count))
+    {
+        if (gs_trigger_quit != 0)
+        {
+            break;
+        }
+        gs_trigger_wakeups++;
+        while (ms5837_trigger_pop(&gs_trigger, &event) == 0)
+        {
+            ms5837_interface_debug_print("ms5837: %0.3fs %s %s, %0.2f%s.\n", (double)event.time_us / 1000000.0,
+                                         name[event.rule], (event.active != 0) ? "entered" : "released",
+                                         (double)event.value / gs_trigger_scale, (event.rule < 2) ? "mbar" : "mbar/s");
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     sync receive callback
+ * @param[in] *set pointer to a sync set structure
+ * @note      none
+ */
+static void a_sync_receive(ms5837_sync_set_t *set)
+{
+    uint8_t i;
+    
+    gs_sample_count[0]++;
+    ms5837_interface_debug_print("ms5837: set %d/%d skew is %lluus.\n", gs_sample_count[0], gs_sample_times,
+                                 (unsigned long long)(set->skew_ns / 1000ULL));
+    for (i = 0; i < set->num; i++)
+    {
+        if ((set->valid & (1 << i)) == 0)
+        {
+            ms5837_interface_debug_print("ms5837: bus %d sample failed.\n", i);
+            
+            continue;
+        }
+        ms5837_interface_debug_print("ms5837: bus %d temperature is %0.2fC pressure is %0.2fmbar.\n", i,
+                                     set->sample[i].temperature_c, set->sample[i].pressure_mbar);
+    }
+}
+
+/**
+ * @brief     fusion set callback
+ * @param[in] *set pointer to a set structure
+ * @note      the set is voted before the callback
+ */
+static void a_fusion_receive(ms5837_sync_set_t *set)
+{
+    static const char *const name[] = {"ok", "missing", "outlier", "fault"};
+    ms5837_fusion_result_t result;
+    uint8_t i;
+    
+    if (ms5837_fusion_get(&gs_fusion, &result) != 0)
+    {
+        return;
+    }
+    gs_sample_count[0]++;
+    ms5837_interface_debug_print("ms5837: set %d/%d depth is %0.4fm pressure is %0.2fmbar spread %0.2fmbar quorum %d.\n",
+                                 gs_sample_count[0], gs_sample_times, (double)result.depth_um / 1000000.0,
+                                 (double)result.pressure_pa / 100.0, (double)result.spread_pa / 100.0, result.quorum);
+    for (i = 0; i < set->num; i++)
+    {
+        ms5837_interface_debug_print("ms5837: bus %d pressure is %0.2fmbar health is %s.\n", i,
+                                     set->sample[i].pressure_mbar, name[result.health[i]]);
+    }
+}
+
+/**
+ * @brief     decode and print the traced events
+ * @note      none
+ */
+static void a_trace_print(void)
+{
+    ms5837_log_event_t event;
+    char text[128];
+    uint32_t dropped;
+    
+    while (ms5837_log_pop(&gs_trace, &event) == 0)
+    {
+        (void)ms5837_log_decode(&event, text, sizeof(text));
+        ms5837_interface_debug_print("%s.\n", text);
+    }
+    if ((ms5837_log_get_dropped(&gs_trace, &dropped) == 0) && (dropped != 0))
+    {
+        ms5837_interface_debug_print("ms5837: %u trace events dropped.\n", dropped);
+    }
+}
+
+/**
+ * @brief      load a correction table file
+ * @param[in]  *path pointer to a file path
+ * @param[in]  scale pressure counts per mbar
+ * @param[out] *correction pointer to a correction structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       every line is temperature_c,correction_mbar with the temperatures in equal steps,
+ *             empty lines and lines starting with # are skipped
+ */
+static uint8_t a_correct_load(const char *path, float scale, ms5837_correction_t *correction)
+{
+    FILE *fp;
+    char line[128];
+    float temperature_c;
+    float correction_mbar;
+    int32_t temperature;
+    
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        ms5837_interface_debug_print("ms5837: open %s failed.\n", path);
+        
+        return 1;
+    }
+    correction->table_num = 0;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r'))
+        {
+            continue;
+        }
+        if (sscanf(line, "%f,%f", &temperature_c, &correction_mbar) != 2)
+        {
+            ms5837_interface_debug_print("ms5837: table line %s is invalid.\n", line);
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        if (correction->table_num >= MS5837_CORRECTION_POINTS)
+        {
+            ms5837_interface_debug_print("ms5837: table has more than %d points.\n", MS5837_CORRECTION_POINTS);
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        temperature = (int32_t)lroundf(temperature_c * 100.0f);
+        if (correction->table_num == 0)
+        {
+            correction->table_start = temperature;
+        }
+        else if (correction->table_num == 1)
+        {
+            correction->table_step = temperature - correction->table_start;
+        }
+        if ((correction->table_num > 0) &&
+            ((correction->table_step <= 0) ||
+             (temperature != correction->table_start + correction->table_step * correction->table_num)))
+        {
+            ms5837_interface_debug_print("ms5837: table temperatures are not in equal steps.\n");
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        correction->table[correction->table_num] = (int32_t)lroundf(correction_mbar * scale);
+        correction->table_num++;
+    }
+    (void)fclose(fp);
+    
+    return 0;
+}
 
 /**
  * @brief     ms5837 full function
@@ -63,11 +371,64 @@ uint8_t ms5837(uint8_t argc, char **argv)
         {"test", required_argument, NULL, 't'},
         {"times", required_argument, NULL, 1},
         {"type", required_argument, NULL, 2},
+        {"bus", required_argument, NULL, 3},
+        {"period", required_argument, NULL, 4},
+        {"priority", required_argument, NULL, 5},
+        {"cpu", required_argument, NULL, 6},
+        {"lock", no_argument, NULL, 7},
+        {"trace", no_argument, NULL, 8},
+        {"retry", required_argument, NULL, 9},
+        {"budget", required_argument, NULL, 10},
+        {"file", required_argument, NULL, 11},
+        {"low", required_argument, NULL, 12},
+        {"high", required_argument, NULL, 13},
+        {"rate", required_argument, NULL, 14},
+        {"deadband", required_argument, NULL, 15},
+        {"heartbeat", required_argument, NULL, 16},
+        {"name", required_argument, NULL, 17},
+        {"decimation", required_argument, NULL, 18},
+        {"socket", required_argument, NULL, 19},
+        {"age", required_argument, NULL, 20},
+        {"surface", required_argument, NULL, 21},
+        {"density", required_argument, NULL, 22},
+        {"height", required_argument, NULL, 23},
+        {"tolerance", required_argument, NULL, 24},
+        {"offset", required_argument, NULL, 25},
+        {"gain", required_argument, NULL, 26},
+        {"table", required_argument, NULL, 27},
+        {"osr", required_argument, NULL, 28},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint32_t times = 3;
     ms5837_type_t chip_type = MS5837_TYPE_02BA01;
+    char bus[MS5837_BUS_MAX_NUM][32] = {"/dev/i2c-1"};
+    uint8_t bus_num = 0;
+    uint32_t period = 1000;
+    int32_t priority = 0;
+    int32_t cpu = -1;
+    uint8_t lock = 0;
+    uint8_t trace = 0;
+    uint8_t retry = 0;
+    uint32_t budget = 0;
+    char file[256] = "ms5837.rec";
+    float low = 1100.0f;
+    float high = 3000.0f;
+    float rate = 100.0f;
+    float deadband = 0.5f;
+    uint32_t heartbeat = 10000;
+    char name[256] = "/ms5837";
+    uint32_t decimation = 1;
+    char sock[108] = "/tmp/ms5837.sock";
+    uint32_t age = 0;
+    float surface = 1013.25f;
+    uint32_t density = 1029;
+    float height = 10.0f;
+    float tolerance = 1.0f;
+    float offset = 0.0f;
+    float gain = 1.0f;
+    char table[256] = "";
+    ms5837_osr_t osr = MS5837_OSR_256;
     
     /* if no params */
     if (argc == 1)
@@ -171,162 +532,2063 @@ uint8_t ms5837(uint8_t argc, char **argv)
                 break;
             } 
             
-            /* the end */
-            case -1 :
+            /* bus */
+            case 3 :
             {
+                /* add the bus */
+                if (bus_num >= MS5837_BUS_MAX_NUM)
+                {
+                    return 5;
+                }
+                memset(bus[bus_num], 0, sizeof(char) * 32);
+                strncpy(bus[bus_num], optarg, 31);
+                bus_num++;
+                
                 break;
             }
             
-            /* others */
-            default :
+            /* period */
+            case 4 :
             {
-                return 5;
+                /* set the period */
+                period = atol(optarg);
+                
+                break;
             }
-        }
-    } while (c != -1);
-    
-    /* run the function */
-    if (strcmp("t_read", type) == 0)
-    {
-        uint8_t res;
-        
-        /* run the read test */
-        res = ms5837_read_test(chip_type, times);
-        if (res != 0)
-        {
-            return 1;
-        }
-        else
-        {
-            return 0;
-        }
-    }
-    else if (strcmp("e_read", type) == 0)
-    {
-        uint8_t res;
-        uint32_t i;
-        
-        /* basic init */
-        res = ms5837_basic_init(chip_type);
-        if (res != 0)
-        {
-            return 1;
-        }
-        
-        /* loop */
-        for (i = 0; i < times; i++)
-        {
-            float temperature_c;
-            float pressure_mbar;
             
-            /* read data */
-            res = ms5837_basic_read(&temperature_c, &pressure_mbar);
-            if (res != 0)
+            /* priority */
+            case 5 :
             {
-                (void)ms5837_basic_deinit();
+                /* set the priority */
+                priority = atol(optarg);
                 
-                return 1;
+                break;
             }
             
-            /* output */
-            ms5837_interface_debug_print("ms5837: %d/%d.\n", i + 1, times);
-            ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", temperature_c);
-            ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", pressure_mbar);
+            /* cpu */
+            case 6 :
+            {
+                /* set the cpu */
+                cpu = atol(optarg);
+                
+                break;
+            }
             
-            /* delay 1000ms */
-            ms5837_interface_delay_ms(1000);
-        }
-        
-        /* deinit */
-        (void)ms5837_basic_deinit();
-        
-        return 0;
-    }
-    else if (strcmp("h", type) == 0)
-    {
-        help:
-        ms5837_interface_debug_print("Usage:\n");
-        ms5837_interface_debug_print("  ms5837 (-i | --information)\n");
-        ms5837_interface_debug_print("  ms5837 (-h | --help)\n");
-        ms5837_interface_debug_print("  ms5837 (-p | --port)\n");
-        ms5837_interface_debug_print("  ms5837 (-t read | --test=read) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
-        ms5837_interface_debug_print("  ms5837 (-e read | --example=read) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
-        ms5837_interface_debug_print("\n");
-        ms5837_interface_debug_print("Options:\n");
-        ms5837_interface_debug_print("  -e <read>, --example=<read>\n");
-        ms5837_interface_debug_print("                       Run the driver example.\n");
-        ms5837_interface_debug_print("  -h, --help           Show the help.\n");
-        ms5837_interface_debug_print("  -i, --information    Show the chip information.\n");
-        ms5837_interface_debug_print("  -p, --port           Display the pin connections of the current board.\n");
-        ms5837_interface_debug_print("  -t <read>, --test=<read>\n");
-        ms5837_interface_debug_print("                       Run the driver test.\n");
-        ms5837_interface_debug_print("      --times=<num>    Set the running times.([default: 3])\n");
-        ms5837_interface_debug_print("      --type=<02BA01 | 02BA21 | 30BA26>\n");
-        ms5837_interface_debug_print("                       Set the chip type.([default: 02BA01])\n");
-
-        return 0;
-    }
-    else if (strcmp("i", type) == 0)
-    {
-        ms5837_info_t info;
-        
-        /* print ms5837 info */
-        ms5837_info(&info);
-        ms5837_interface_debug_print("ms5837: chip is %s.\n", info.chip_name);
-        ms5837_interface_debug_print("ms5837: manufacturer is %s.\n", info.manufacturer_name);
-        ms5837_interface_debug_print("ms5837: interface is %s.\n", info.interface);
-        ms5837_interface_debug_print("ms5837: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000 ) / 100);
-        ms5837_interface_debug_print("ms5837: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
-        ms5837_interface_debug_print("ms5837: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
-        ms5837_interface_debug_print("ms5837: max current is %0.2fmA.\n", info.max_current_ma);
-        ms5837_interface_debug_print("ms5837: max temperature is %0.1fC.\n", info.temperature_max);
-        ms5837_interface_debug_print("ms5837: min temperature is %0.1fC.\n", info.temperature_min);
-        
-        return 0;
-    }
-    else if (strcmp("p", type) == 0)
-    {
-        /* print pin connection */
-        ms5837_interface_debug_print("ms5837: SCL connected to GPIO3.\n");
-        ms5837_interface_debug_print("ms5837: SDA connected to GPIO2.\n");
-        
-        return 0;
-    }
-    else
-    {
-        return 5;
-    }
-}
-
-/**
- * @brief     main function
- * @param[in] argc arg numbers
- * @param[in] **argv arg address
- * @return    status code
- *             - 0 success
- * @note      none
- */
-int main(uint8_t argc, char **argv)
-{
-    uint8_t res;
-
-    res = ms5837(argc, argv);
-    if (res == 0)
-    {
-        /* run success */
-    }
-    else if (res == 1)
-    {
-        ms5837_interface_debug_print("ms5837: run failed.\n");
-    }
-    else if (res == 5)
-    {
-        ms5837_interface_debug_print("ms5837: param is invalid.\n");
+            /* lock */
+            case 7 :
+            {
+                /* lock the memory */
+                lock = 1;
+                
+                break;
+            }
+            
+            /* trace */
+            case 8 :
+            {
+                /* trace the events */
+                trace = 1;
+                
+                break;
+            }
+            
+            /* retry */
+            case 9 :
+            {
+                /* set the retry times */
+                retry = (uint8_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* budget */
+            case 10 :
+            {
+                /* set the retry budget */
+                budget = atol(optarg);
+                
+                break;
+            }
+            
+            /* file */
+            case 11 :
+            {
+                /* set the record file */
+                memset(file, 0, sizeof(char) * 256);
+                strncpy(file, optarg, 255);
+                
+                break;
+            }
+            
+            /* low pressure */
+            case 12 :
+            {
+                /* set the low pressure */
+                low = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* high pressure */
+            case 13 :
+            {
+                /* set the high pressure */
+                high = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* pressure rate */
+            case 14 :
+            {
+                /* set the pressure rate */
+                rate = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* pressure deadband */
+            case 15 :
+            {
+                /* set the pressure deadband */
+                deadband = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* heartbeat */
+            case 16 :
+            {
+                /* set the heartbeat */
+                heartbeat = atol(optarg);
+                
+                break;
+            }
+            
+            /* shared memory name */
+            case 17 :
+            {
+                /* set the shared memory name */
+                memset(name, 0, sizeof(char) * 256);
+                strncpy(name, optarg, 255);
+                
+                break;
+            }
+            
+            /* decimation */
+            case 18 :
+            {
+                /* set the decimation */
+                decimation = atol(optarg);
+                
+                break;
+            }
+            
+            /* socket path */
+            case 19 :
+            {
+                /* set the socket path */
+                memset(sock, 0, sizeof(char) * 108);
+                strncpy(sock, optarg, 107);
+                
+                break;
+            }
+            
+            /* max age */
+            case 20 :
+            {
+                /* set the max age */
+                age = atol(optarg);
+                
+                break;
+            }
+            
+            /* surface pressure */
+            case 21 :
+            {
+                /* set the surface pressure */
+                surface = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* water density */
+            case 22 :
+            {
+                /* set the water density */
+                density = atol(optarg);
+                
+                break;
+            }
+            
+            /* sensor height */
+            case 23 :
+            {
+                /* set the sensor height */
+                height = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* fusion tolerance */
+            case 24 :
+            {
+                /* set the fusion tolerance */
+                tolerance = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* correction offset */
+            case 25 :
+            {
+                /* set the correction offset */
+                offset = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* correction gain */
+            case 26 :
+            {
+                /* set the correction gain */
+                gain = (float)atof(optarg);
+                
+                break;
+            }
+            
+            /* correction table */
+            case 27 :
+            {
+                /* set the correction table file */
+                memset(table, 0, sizeof(char) * 256);
+                strncpy(table, optarg, 255);
+                
+                break;
+            }
+            
+            /* osr */
+            case 28 :
+            {
+                /* set the retuned osr */
+                if (strcmp("256", optarg) == 0)
+                {
+                    osr = MS5837_OSR_256;
+                }
+                else if (strcmp("512", optarg) == 0)
+                {
+                    osr = MS5837_OSR_512;
+                }
+                else if (strcmp("1024", optarg) == 0)
+                {
+                    osr = MS5837_OSR_1024;
+                }
+                else if (strcmp("2048", optarg) == 0)
+                {
+                    osr = MS5837_OSR_2048;
+                }
+                else if (strcmp("4096", optarg) == 0)
+                {
+                    osr = MS5837_OSR_4096;
+                }
+                else if (strcmp("8192", optarg) == 0)
+                {
+                    osr = MS5837_OSR_8192;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    /* run the function */
+    if (strcmp("t_read", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the read test */
+        res = ms5837_read_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_sim", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the sim test */
+        res = ms5837_sim_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_sync", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the sync test */
+        res = ms5837_sync_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_archive", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the archive test */
+        res = ms5837_archive_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_rollup", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the rollup test */
+        res = ms5837_rollup_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_window", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the window test */
+        res = ms5837_window_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_kalman", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the kalman test */
+        res = ms5837_kalman_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_wave", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the wave test */
+        res = ms5837_wave_test(chip_type, times);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("e_read", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        
+        /* basic init */
+        res = ms5837_basic_init(chip_type);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            float temperature_c;
+            float pressure_mbar;
+            
+            /* read data */
+            res = ms5837_basic_read(&temperature_c, &pressure_mbar);
+            if (res != 0)
+            {
+                (void)ms5837_basic_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            ms5837_interface_debug_print("ms5837: %d/%d.\n", i + 1, times);
+            ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", temperature_c);
+            ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", pressure_mbar);
+            
+            /* delay 1000ms */
+            ms5837_interface_delay_ms(1000);
+        }
+        
+        /* deinit */
+        (void)ms5837_basic_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_sample", type) == 0)
+    {
+        uint8_t res;
+        uint8_t i;
+        uint8_t index;
+        uint8_t done;
+        ms5837_sampler_t sampler;
+        ms5837_sampler_stats_t stats;
+        
+        /* use the default bus */
+        if (bus_num == 0)
+        {
+            bus_num = 1;
+        }
+        
+        /* sampler init */
+        res = ms5837_sampler_init(&sampler);
+        if (res != 0)
+        {
+            return 1;
+        }
+        (void)ms5837_log_init(&gs_trace, gs_trace_buf, sizeof(gs_trace_buf) / sizeof(gs_trace_buf[0]));
+        
+        /* init all sensors */
+        for (i = 0; i < bus_num; i++)
+        {
+            (void)ms5837_bus_link(&gs_sample_handle[i], i, bus[i]);
+            (void)ms5837_set_retry(&gs_sample_handle[i], retry, budget);
+            res = ms5837_init(&gs_sample_handle[i]);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: init %s failed.\n", bus[i]);
+                goto sample_failed;
+            }
+            if ((ms5837_set_type(&gs_sample_handle[i], chip_type) != 0) ||
+                (ms5837_set_temperature_osr(&gs_sample_handle[i], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+                (ms5837_set_pressure_osr(&gs_sample_handle[i], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+            {
+                ms5837_interface_debug_print("ms5837: config %s failed.\n", bus[i]);
+                (void)ms5837_deinit(&gs_sample_handle[i]);
+                goto sample_failed;
+            }
+            if (trace != 0)
+            {
+                (void)ms5837_bus_trace(&gs_sample_handle[i], i, &gs_trace);
+            }
+            res = ms5837_sampler_add(&sampler, &gs_sample_handle[i], period * 1000, a_sample_receive, &index);
+            if (res != 0)
+            {
+                (void)ms5837_deinit(&gs_sample_handle[i]);
+                goto sample_failed;
+            }
+            gs_sample_count[index] = 0;
+            (void)ms5837_window_init(&gs_sample_window[index], MS5837_WINDOW_MODE_TUMBLING, times, NULL);
+            (void)ms5837_sampler_set_window(&sampler, index, &gs_sample_window[index]);
+        }
+        gs_sample_times = times;
+        
+        /* start sampling */
+        res = ms5837_sampler_start(&sampler);
+        if (res != 0)
+        {
+            goto sample_failed;
+        }
+        
+        /* run the event loop */
+        do
+        {
+            res = ms5837_sampler_poll(&sampler, -1);
+            if (res != 0)
+            {
+                goto sample_failed;
+            }
+            a_trace_print();
+            done = 1;
+            for (i = 0; i < sampler.num; i++)
+            {
+                if (gs_sample_count[i] < times)
+                {
+                    done = 0;
+                }
+            }
+        } while (done == 0);
+        
+        /* read the latest sample at once and then wait for the next one */
+        for (i = 0; i < sampler.num; i++)
+        {
+            ms5837_sampler_sample_t sample;
+            uint64_t age_ns;
+            
+            if (ms5837_sampler_get_latest(&sampler, i, &sample, &age_ns) == 0)
+            {
+                ms5837_interface_debug_print("ms5837: bus %d latest pressure is %0.2fmbar age %lluus.\n", i,
+                                             sample.pressure_mbar, (unsigned long long)(age_ns / 1000ULL));
+            }
+            if (ms5837_sampler_get_fresh(&sampler, i, &sample, (int32_t)(period * 2)) == 0)
+            {
+                ms5837_interface_debug_print("ms5837: bus %d fresh pressure is %0.2fmbar.\n", i, sample.pressure_mbar);
+            }
+        }
+        (void)ms5837_sampler_stop(&sampler);
+        
+        /* output the statistics */
+        for (i = 0; i < sampler.num; i++)
+        {
+            ms5837_window_summary_t summary;
+            
+            if (ms5837_window_get(&gs_sample_window[i], &summary) == 0)
+            {
+                double scale = (chip_type == MS5837_TYPE_30BA26) ? 10.0 : 100.0;
+                
+                ms5837_interface_debug_print("ms5837: bus %d window %u samples temperature mean %0.2fC std %0.3fC min %0.2fC max %0.2fC.\n",
+                                             i, summary.count, summary.temperature.mean / 100.0,
+                                             sqrt(summary.temperature.variance) / 100.0,
+                                             summary.temperature.min / 100.0, summary.temperature.max / 100.0);
+                ms5837_interface_debug_print("ms5837: bus %d window pressure mean %0.2fmbar std %0.3fmbar min %0.2fmbar max %0.2fmbar rate %0.3fmbar/s.\n",
+                                             i, summary.pressure.mean / scale, sqrt(summary.pressure.variance) / scale,
+                                             summary.pressure.min / scale, summary.pressure.max / scale,
+                                             summary.pressure.rate / scale);
+            }
+            (void)ms5837_sampler_get_stats(&sampler, i, &stats);
+            ms5837_interface_debug_print("ms5837: bus %d samples %llu missed %llu errors %llu resyncs %llu max lateness %lluus.\n", i,
+                                         (unsigned long long)stats.samples, (unsigned long long)stats.missed,
+                                         (unsigned long long)stats.errors, (unsigned long long)stats.resyncs,
+                                         (unsigned long long)(stats.max_lateness_ns / 1000ULL));
+#if (MS5837_INSTRUMENT == 1)
+            {
+                ms5837_instrument_t instrument;
+                uint8_t j;
+                
+                if (ms5837_get_instrument(sampler.sensor[i].handle, &instrument) == 0)
+                {
+                    ms5837_interface_debug_print("ms5837: bus %d read %u write %u tx %u rx %u failures %u retries %u.\n", i,
+                                                 instrument.iic_read, instrument.iic_write, instrument.tx_bytes,
+                                                 instrument.rx_bytes, instrument.failures, instrument.retries);
+                    for (j = 0; j < MS5837_INSTRUMENT_BUCKET; j++)
+                    {
+                        if ((instrument.bus_latency[j] | instrument.convert_overshoot[j] | instrument.sample_latency[j]) != 0)
+                        {
+                            ms5837_interface_debug_print("ms5837: bus %d <%uus bus %u overshoot %u sample %u.\n", i,
+                                                         1U << j, instrument.bus_latency[j],
+                                                         instrument.convert_overshoot[j], instrument.sample_latency[j]);
+                        }
+                    }
+                }
+            }
+#endif
+        }
+        
+        /* deinit */
+        for (i = 0; i < sampler.num; i++)
+        {
+            (void)ms5837_deinit(sampler.sensor[i].handle);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        
+        return 0;
+        
+        sample_failed:
+        for (i = 0; i < sampler.num; i++)
+        {
+            (void)ms5837_deinit(sampler.sensor[i].handle);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        
+        return 1;
+    }
+    else if (strcmp("e_rt", type) == 0)
+    {
+        uint8_t res;
+        ms5837_rt_t rt;
+        ms5837_rt_config_t config;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        if (trace != 0)
+        {
+            (void)ms5837_log_init(&gs_trace, gs_trace_buf, sizeof(gs_trace_buf) / sizeof(gs_trace_buf[0]));
+            (void)ms5837_bus_trace(&gs_sample_handle[0], 0, &gs_trace);
+        }
+        
+        /* run the real time thread */
+        ms5837_rt_default_config(&config);
+        config.period_us = period * 1000;
+        config.priority = priority;
+        config.cpu = cpu;
+        config.lock_memory = lock;
+        res = ms5837_rt_start(&rt, &gs_sample_handle[0], &config, NULL, 0, times, NULL);
+        if (res != 0)
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        (void)ms5837_rt_wait(&rt);
+        if (trace != 0)
+        {
+            a_trace_print();
+        }
+        
+        /* deinit */
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return 0;
+    }
+    else if (strcmp("e_sync", type) == 0)
+    {
+        uint8_t res;
+        ms5837_sync_t sync;
+        ms5837_handle_t *handle[MS5837_BUS_MAX_NUM];
+        uint8_t i;
+        
+        /* use the default bus */
+        if (bus_num == 0)
+        {
+            bus_num = 1;
+        }
+        if (trace != 0)
+        {
+            (void)ms5837_log_init(&gs_trace, gs_trace_buf, sizeof(gs_trace_buf) / sizeof(gs_trace_buf[0]));
+        }
+        
+        /* init the sensors, one per bus */
+        for (i = 0; i < bus_num; i++)
+        {
+            (void)ms5837_bus_link(&gs_sample_handle[i], i, bus[i]);
+            (void)ms5837_set_retry(&gs_sample_handle[i], retry, budget);
+            res = ms5837_init(&gs_sample_handle[i]);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: init %s failed.\n", bus[i]);
+                
+                goto sync_failed;
+            }
+            if ((ms5837_set_type(&gs_sample_handle[i], chip_type) != 0) ||
+                (ms5837_set_temperature_osr(&gs_sample_handle[i], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+                (ms5837_set_pressure_osr(&gs_sample_handle[i], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+            {
+                ms5837_interface_debug_print("ms5837: config %s failed.\n", bus[i]);
+                (void)ms5837_deinit(&gs_sample_handle[i]);
+                
+                goto sync_failed;
+            }
+            if (trace != 0)
+            {
+                (void)ms5837_bus_trace(&gs_sample_handle[i], i, &gs_trace);
+            }
+            handle[i] = &gs_sample_handle[i];
+        }
+        
+        /* sample all buses at the same deadlines */
+        gs_sample_count[0] = 0;
+        gs_sample_times = times;
+        res = ms5837_sync_start(&sync, handle, bus_num, period * 1000, times, NULL, a_sync_receive);
+        if (res != 0)
+        {
+            goto sync_failed;
+        }
+        (void)ms5837_sync_wait(&sync);
+        if (trace != 0)
+        {
+            a_trace_print();
+        }
+        
+        /* deinit */
+        for (i = 0; i < bus_num; i++)
+        {
+            (void)ms5837_deinit(&gs_sample_handle[i]);
+        }
+        
+        return 0;
+        
+        sync_failed:
+        while (i > 0)
+        {
+            i--;
+            (void)ms5837_deinit(&gs_sample_handle[i]);
+        }
+        
+        return 1;
+    }
+    else if (strcmp("e_sim", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t errors = 0;
+        uint64_t start_us;
+        uint64_t elapsed_us;
+        uint32_t temperature_raw;
+        uint32_t pressure_raw;
+        float temperature_c = 0.0f;
+        float pressure_mbar = 0.0f;
+        struct timespec begin;
+        struct timespec end;
+        ms5837_sim_t sim;
+        
+        /* the simulated chip reports the chosen type */
+        (void)ms5837_sim_init(&sim);
+        (void)ms5837_sim_set_prom(&sim, 0, chip_type, NULL);
+        (void)ms5837_sim_set_environment(&sim, 0, 20.0f, 1013.25f);
+        
+        /* init the sensor on the virtual clock */
+        (void)ms5837_sim_link(&gs_sample_handle[0], 0);
+        DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_sample_handle[0], ms5837_interface_debug_print);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            (void)ms5837_sim_deinit(&sim);
+            
+            return 1;
+        }
+        if ((ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            (void)ms5837_sim_deinit(&sim);
+            
+            return 1;
+        }
+        
+        /* sample in virtual time */
+        (void)clock_gettime(CLOCK_MONOTONIC, &begin);
+        for (i = 0; i < times; i++)
+        {
+            start_us = sim.now_us;
+            if (ms5837_read_temperature_pressure(&gs_sample_handle[0], &temperature_raw, &temperature_c,
+                                                 &pressure_raw, &pressure_mbar) != 0)
+            {
+                errors++;
+            }
+            elapsed_us = sim.now_us - start_us;
+            if (elapsed_us < (uint64_t)period * 1000)
+            {
+                (void)ms5837_sim_advance(&sim, (uint64_t)period * 1000 - elapsed_us);
+            }
+        }
+        (void)clock_gettime(CLOCK_MONOTONIC, &end);
+        ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", temperature_c);
+        ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", pressure_mbar);
+        ms5837_interface_debug_print("ms5837: %u samples %u errors in %0.1fs virtual time and %0.3fs wall time.\n",
+                                     times, errors, (double)sim.now_us / 1000000.0,
+                                     (double)(end.tv_sec - begin.tv_sec) + (double)(end.tv_nsec - begin.tv_nsec) / 1000000000.0);
+        
+        /* deinit */
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        (void)ms5837_sim_deinit(&sim);
+        
+        return 0;
+    }
+    else if (strcmp("e_record", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t temperature_raw;
+        uint32_t pressure_raw;
+        float temperature_c;
+        float pressure_mbar;
+        
+        /* record from the prom read on */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_record_start(&gs_sample_handle[0], file);
+        if (res != 0)
+        {
+            return 1;
+        }
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            (void)ms5837_record_stop(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            (void)ms5837_record_stop(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* a failed read is recorded as well */
+            res = ms5837_read_temperature_pressure(&gs_sample_handle[0], &temperature_raw, &temperature_c,
+                                                   &pressure_raw, &pressure_mbar);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: %d/%d read failed.\n", i + 1, times);
+            }
+            else
+            {
+                ms5837_interface_debug_print("ms5837: %d/%d.\n", i + 1, times);
+                ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", temperature_c);
+                ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", pressure_mbar);
+            }
+            ms5837_interface_delay_ms(period);
+        }
+        
+        /* deinit */
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        res = ms5837_record_stop(&gs_sample_handle[0]);
+        
+        return (res != 0) ? 1 : 0;
+    }
+    else if (strcmp("e_replay", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i = 0;
+        uint32_t position;
+        uint32_t num;
+        uint32_t temperature_raw;
+        uint32_t pressure_raw;
+        float temperature_c;
+        float pressure_mbar;
+        struct timespec begin;
+        struct timespec end;
+        ms5837_replay_record_t *record;
+        ms5837_replay_stats_t stats;
+        ms5837_replay_t replay;
+        
+        /* load the record */
+        res = ms5837_record_load(file, &record, &num);
+        if (res != 0)
+        {
+            return 1;
+        }
+        (void)ms5837_replay_init(&replay, record, num);
+        
+        /* init from the recorded prom */
+        (void)ms5837_replay_link(&gs_sample_handle[0]);
+        DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_sample_handle[0], ms5837_interface_debug_print);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        (void)clock_gettime(CLOCK_MONOTONIC, &begin);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            (void)ms5837_replay_deinit(&replay);
+            ms5837_record_free(record);
+            
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            (void)ms5837_replay_deinit(&replay);
+            ms5837_record_free(record);
+            
+            return 1;
+        }
+        
+        /* read until the record is used up or stops matching */
+        while (replay.position < replay.num)
+        {
+            position = replay.position;
+            i++;
+            res = ms5837_read_temperature_pressure(&gs_sample_handle[0], &temperature_raw, &temperature_c,
+                                                   &pressure_raw, &pressure_mbar);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: %d read failed.\n", i);
+            }
+            else
+            {
+                ms5837_interface_debug_print("ms5837: %d.\n", i);
+                ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", temperature_c);
+                ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", pressure_mbar);
+            }
+            if (replay.position == position)
+            {
+                break;
+            }
+        }
+        (void)clock_gettime(CLOCK_MONOTONIC, &end);
+        (void)ms5837_replay_get_stats(&replay, &stats);
+        ms5837_interface_debug_print("ms5837: replayed %u/%u records skipped %u mismatches %u overruns %u.\n",
+                                     stats.position, stats.num, stats.skipped, stats.mismatches, stats.overruns);
+        ms5837_interface_debug_print("ms5837: %0.3fs recorded time in %0.3fs wall time.\n",
+                                     (double)replay.now_us / 1000000.0,
+                                     (double)(end.tv_sec - begin.tv_sec) + (double)(end.tv_nsec - begin.tv_nsec) / 1000000000.0);
+        
+        /* deinit */
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        (void)ms5837_replay_deinit(&replay);
+        ms5837_record_free(record);
+        
+        return 0;
+    }
+    else if (strcmp("e_archive", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t len;
+        uint32_t used;
+        uint32_t size = 0;
+        uint32_t blocks = 0;
+        uint32_t num = 0;
+        uint64_t start_us = 0;
+        uint64_t end_us = 0;
+        uint64_t step_us;
+        uint8_t level;
+        uint32_t temperature_raw;
+        uint32_t pressure_raw;
+        int32_t temperature;
+        int32_t pressure;
+        float temperature_c;
+        float pressure_mbar;
+        struct timespec ts;
+        uint8_t *data;
+        FILE *fp;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        fp = fopen(file, "wb");
+        if (fp == NULL)
+        {
+            ms5837_interface_debug_print("ms5837: open %s failed.\n", file);
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        (void)ms5837_archive_init(&gs_archive, chip_type);
+        (void)ms5837_rollup_init(&gs_rollup, gs_rollup_second, 3600, gs_rollup_minute, 1440, gs_rollup_hour, 744);
+        (void)ms5837_archive_set_rollup(&gs_archive, &gs_rollup);
+        
+        /* archive the integer results, a full block is written out */
+        for (i = 0; i < times; i++)
+        {
+            if (ms5837_read_temperature_pressure(&gs_sample_handle[0], &temperature_raw, &temperature_c,
+                                                 &pressure_raw, &pressure_mbar) == 0)
+            {
+                (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+                (void)ms5837_compensate(&gs_sample_handle[0], temperature_raw, &temperature, pressure_raw, &pressure);
+                end_us = (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL + 1;
+                start_us = (start_us == 0) ? (end_us - 1) : start_us;
+                if (ms5837_archive_append(&gs_archive, (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL,
+                                          temperature, pressure) == 1)
+                {
+                    (void)ms5837_archive_encode(&gs_archive, gs_archive_buf, sizeof(gs_archive_buf), &len);
+                    (void)fwrite(gs_archive_buf, 1, len, fp);
+                    (void)ms5837_archive_append(&gs_archive, (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL,
+                                                temperature, pressure);
+                }
+            }
+            ms5837_interface_delay_ms(period);
+        }
+        (void)ms5837_archive_encode(&gs_archive, gs_archive_buf, sizeof(gs_archive_buf), &len);
+        (void)fwrite(gs_archive_buf, 1, len, fp);
+        (void)fclose(fp);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        /* read the archive back */
+        fp = fopen(file, "rb");
+        if ((fp == NULL) || (fseek(fp, 0, SEEK_END) != 0))
+        {
+            return 1;
+        }
+        size = (uint32_t)ftell(fp);
+        data = (uint8_t *)malloc((size == 0) ? 1 : size);
+        if ((data == NULL) || (fseek(fp, 0, SEEK_SET) != 0) || (fread(data, 1, size, fp) != size))
+        {
+            free(data);
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        (void)fclose(fp);
+        for (len = 0, i = 0; len < size; len += used, blocks++)
+        {
+            uint16_t j;
+            
+            if (ms5837_archive_decode(data + len, size - len, &gs_archive_block, &used) != 0)
+            {
+                ms5837_interface_debug_print("ms5837: archive block %u is invalid.\n", blocks);
+                
+                break;
+            }
+            for (j = 0; j < gs_archive_block.count; j++, i++)
+            {
+                (void)ms5837_archive_convert(&gs_archive_block, j, &temperature_c, &pressure_mbar);
+                ms5837_interface_debug_print("ms5837: %llu us temperature is %0.2fC pressure is %0.2fmbar.\n",
+                                             (unsigned long long)(gs_archive_block.time_us[j] - gs_archive_block.time_us[0]),
+                                             temperature_c, pressure_mbar);
+            }
+        }
+        free(data);
+        ms5837_interface_debug_print("ms5837: archived %u samples in %u blocks and %u bytes, %0.2f bytes per sample.\n",
+                                     i, blocks, size, (i == 0) ? 0.0 : (double)size / (double)i);
+        
+        /* downsample from the rollup with the finest step that fits the bins */
+        if (end_us == 0)
+        {
+            return 0;
+        }
+        
+        /* the query reads whole seconds, so end after the second of the last sample */
+        end_us = end_us - end_us % 1000000ULL + 1000000ULL;
+        for (step_us = 1000000ULL; ; step_us = (step_us < 60000000ULL) ? 60000000ULL : 3600000000ULL)
+        {
+            start_us -= start_us % step_us;
+            if ((ms5837_rollup_query(&gs_rollup, start_us, end_us, step_us, gs_rollup_bin, 120, &num, &level) == 0) ||
+                (step_us == 3600000000ULL))
+            {
+                break;
+            }
+        }
+        for (i = 0; i < num; i++)
+        {
+            double scale = (chip_type == MS5837_TYPE_30BA26) ? 10.0 : 100.0;
+            
+            if (gs_rollup_bin[i].count == 0)
+            {
+                continue;
+            }
+            ms5837_interface_debug_print("ms5837: rollup level %d bin %u has %u samples, temperature %0.2fC..%0.2fC mean %0.2fC, "
+                                         "pressure %0.2fmbar..%0.2fmbar mean %0.2fmbar.\n", level, i, gs_rollup_bin[i].count,
+                                         gs_rollup_bin[i].temperature_min / 100.0, gs_rollup_bin[i].temperature_max / 100.0,
+                                         (double)gs_rollup_bin[i].temperature_sum / gs_rollup_bin[i].count / 100.0,
+                                         gs_rollup_bin[i].pressure_min / scale, gs_rollup_bin[i].pressure_max / scale,
+                                         (double)gs_rollup_bin[i].pressure_sum / gs_rollup_bin[i].count / scale);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_trigger", type) == 0)
+    {
+        uint8_t res;
+        uint8_t index;
+        ms5837_sampler_t sampler;
+        ms5837_sampler_stats_t stats;
+        ms5837_trigger_rule_t rule;
+        pthread_t consumer;
+        uint64_t one = 1;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* surfaced below low, over depth above high and both rate directions, 1mbar or 10% hysteresis */
+        gs_trigger_scale = (chip_type == MS5837_TYPE_30BA26) ? 10.0f : 100.0f;
+        (void)ms5837_trigger_init(&gs_trigger, gs_trigger_buf, sizeof(gs_trigger_buf) / sizeof(gs_trigger_buf[0]), 1000000);
+        rule.source = MS5837_TRIGGER_SOURCE_PRESSURE;
+        rule.edge = MS5837_TRIGGER_EDGE_BELOW;
+        rule.threshold = (int32_t)(low * gs_trigger_scale);
+        rule.hysteresis = (int32_t)gs_trigger_scale;
+        (void)ms5837_trigger_add_rule(&gs_trigger, &rule, &index);
+        rule.edge = MS5837_TRIGGER_EDGE_ABOVE;
+        rule.threshold = (int32_t)(high * gs_trigger_scale);
+        (void)ms5837_trigger_add_rule(&gs_trigger, &rule, &index);
+        rule.source = MS5837_TRIGGER_SOURCE_PRESSURE_RATE;
+        rule.threshold = (int32_t)(rate * gs_trigger_scale);
+        rule.hysteresis = (int32_t)(rate * gs_trigger_scale / 10.0f);
+        (void)ms5837_trigger_add_rule(&gs_trigger, &rule, &index);
+        rule.edge = MS5837_TRIGGER_EDGE_BELOW;
+        rule.threshold = -(int32_t)(rate * gs_trigger_scale);
+        (void)ms5837_trigger_add_rule(&gs_trigger, &rule, &index);
+        
+        /* the consumer sleeps until an event */
+        gs_trigger_quit = 0;
+        gs_trigger_wakeups = 0;
+        gs_trigger_fd = eventfd(0, EFD_CLOEXEC);
+        if ((gs_trigger_fd < 0) || (pthread_create(&consumer, NULL, a_trigger_consumer, NULL) != 0))
+        {
+            ms5837_interface_debug_print("ms5837: create the consumer failed.\n");
+            if (gs_trigger_fd >= 0)
+            {
+                (void)close(gs_trigger_fd);
+            }
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* sample */
+        res = ms5837_sampler_init(&sampler);
+        if ((res != 0) ||
+            (ms5837_sampler_add(&sampler, &gs_sample_handle[0], period * 1000, NULL, &index) != 0) ||
+            (ms5837_sampler_set_trigger(&sampler, index, &gs_trigger, gs_trigger_fd) != 0) ||
+            (ms5837_sampler_start(&sampler) != 0))
+        {
+            res = 1;
+        }
+        else
+        {
+            do
+            {
+                res = ms5837_sampler_poll(&sampler, -1);
+                (void)ms5837_sampler_get_stats(&sampler, index, &stats);
+            } while ((res == 0) && (stats.samples < times));
+            (void)ms5837_sampler_stop(&sampler);
+            ms5837_interface_debug_print("ms5837: %llu samples woke the consumer %u times.\n",
+                                         (unsigned long long)stats.samples, gs_trigger_wakeups);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        gs_trigger_quit = 1;
+        (void)write(gs_trigger_fd, &one, sizeof(one));
+        (void)pthread_join(consumer, NULL);
+        (void)close(gs_trigger_fd);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return res;
+    }
+    else if (strcmp("e_deadband", type) == 0)
+    {
+        uint8_t res;
+        uint8_t index;
+        uint32_t reported;
+        uint32_t suppressed;
+        float scale;
+        ms5837_sampler_t sampler;
+        ms5837_sampler_stats_t stats;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* 0.1C temperature band, the pressure band and the heartbeat from the options */
+        scale = (chip_type == MS5837_TYPE_30BA26) ? 10.0f : 100.0f;
+        if (ms5837_deadband_init(&gs_deadband, 10, (int32_t)(deadband * scale), (uint64_t)heartbeat * 1000ULL) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: deadband is invalid.\n");
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* sample */
+        res = ms5837_sampler_init(&sampler);
+        if ((res != 0) ||
+            (ms5837_sampler_add(&sampler, &gs_sample_handle[0], period * 1000, a_deadband_receive, &index) != 0) ||
+            (ms5837_sampler_set_deadband(&sampler, index, &gs_deadband) != 0) ||
+            (ms5837_sampler_start(&sampler) != 0))
+        {
+            res = 1;
+        }
+        else
+        {
+            do
+            {
+                res = ms5837_sampler_poll(&sampler, -1);
+                (void)ms5837_sampler_get_stats(&sampler, index, &stats);
+            } while ((res == 0) && (stats.samples < times));
+            (void)ms5837_sampler_stop(&sampler);
+            (void)ms5837_deadband_get_stats(&gs_deadband, &reported, &suppressed);
+            ms5837_interface_debug_print("ms5837: reported %u samples and suppressed %u samples.\n", reported, suppressed);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return res;
+    }
+    else if (strcmp("e_publish", type) == 0)
+    {
+        uint8_t res;
+        uint8_t index;
+        ms5837_sampler_t sampler;
+        ms5837_sampler_stats_t stats;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* open the ring, the name is kept so the subscribers follow a restart */
+        if (ms5837_shm_publisher_open(&gs_publisher, name, 1024) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: open %s failed.\n", name);
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* sample */
+        res = ms5837_sampler_init(&sampler);
+        if ((res != 0) ||
+            (ms5837_sampler_add(&sampler, &gs_sample_handle[0], period * 1000, NULL, &index) != 0) ||
+            (ms5837_sampler_set_publisher(&sampler, index, &gs_publisher) != 0) ||
+            (ms5837_sampler_start(&sampler) != 0))
+        {
+            res = 1;
+        }
+        else
+        {
+            do
+            {
+                res = ms5837_sampler_poll(&sampler, -1);
+                (void)ms5837_sampler_get_stats(&sampler, index, &stats);
+            } while ((res == 0) && (stats.samples < times));
+            (void)ms5837_sampler_stop(&sampler);
+            ms5837_interface_debug_print("ms5837: published %llu samples to %s.\n", (unsigned long long)stats.samples, name);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        (void)ms5837_shm_publisher_close(&gs_publisher, NULL);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return res;
+    }
+    else if (strcmp("e_subscribe", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t idle;
+        uint64_t lost;
+        ms5837_shm_sample_t sample;
+        
+        /* open the ring of a running publisher */
+        if (ms5837_shm_subscriber_open(&gs_subscriber, name, decimation) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: open %s failed.\n", name);
+            
+            return 1;
+        }
+        
+        /* poll the ring, give up after 5s without a sample */
+        for (i = 0, idle = 0; (i < times) && (idle < 5000); )
+        {
+            res = ms5837_shm_subscriber_read(&gs_subscriber, &sample);
+            if (res == 4)
+            {
+                /* the publisher restarted with another size, map the new ring */
+                (void)ms5837_shm_subscriber_close(&gs_subscriber);
+                if (ms5837_shm_subscriber_open(&gs_subscriber, name, decimation) != 0)
+                {
+                    ms5837_interface_debug_print("ms5837: reopen %s failed.\n", name);
+                    
+                    return 1;
+                }
+                
+                continue;
+            }
+            if (res != 0)
+            {
+                ms5837_interface_delay_ms(1);
+                idle++;
+                
+                continue;
+            }
+            idle = 0;
+            i++;
+            ms5837_interface_debug_print("ms5837: seq %llu bus %d temperature is %0.2fC pressure is %0.2fmbar.\n",
+                                         (unsigned long long)sample.seq, sample.index,
+                                         sample.temperature_c, sample.pressure_mbar);
+        }
+        (void)ms5837_shm_subscriber_get_lost(&gs_subscriber, &lost);
+        ms5837_interface_debug_print("ms5837: read %u samples lost %llu samples.\n", i, (unsigned long long)lost);
+        (void)ms5837_shm_subscriber_close(&gs_subscriber);
+        
+        return (i < times) ? 1 : 0;
+    }
+    else if (strcmp("e_broker", type) == 0)
+    {
+        uint8_t res;
+        uint8_t index;
+        ms5837_broker_stats_t stats;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* serve the requests until times requests are answered */
+        res = ms5837_broker_init(&gs_broker, sock);
+        if (res != 0)
+        {
+            ms5837_interface_debug_print("ms5837: listen on %s failed.\n", sock);
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        if (ms5837_broker_add(&gs_broker, &gs_sample_handle[0], &index) != 0)
+        {
+            res = 1;
+        }
+        else
+        {
+            do
+            {
+                res = ms5837_broker_poll(&gs_broker, -1);
+                (void)ms5837_broker_get_stats(&gs_broker, index, &stats);
+            } while ((res == 0) && (stats.requests < times));
+            ms5837_interface_debug_print("ms5837: served %llu requests with %llu conversions, %llu cached %llu coalesced %llu errors.\n",
+                                         (unsigned long long)stats.requests, (unsigned long long)stats.conversions,
+                                         (unsigned long long)stats.cached, (unsigned long long)stats.coalesced,
+                                         (unsigned long long)stats.errors);
+        }
+        (void)ms5837_broker_deinit(&gs_broker);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return res;
+    }
+    else if (strcmp("e_request", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        ms5837_broker_response_t response;
+        
+        /* request a sample from the running broker every period */
+        for (i = 0; i < times; i++)
+        {
+            res = ms5837_broker_request(sock, 0, age * 1000, &response);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: request %s failed.\n", sock);
+                
+                return 1;
+            }
+            ms5837_interface_debug_print("ms5837: %d/%d temperature is %0.2fC pressure is %0.2fmbar age %uus shared by %u requests.\n",
+                                         i + 1, times, response.temperature_c, response.pressure_mbar,
+                                         response.age_us, response.shared);
+            ms5837_interface_delay_ms(period);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_predict", type) == 0)
+    {
+        uint8_t res;
+        uint8_t index;
+        uint32_t tick;
+        uint64_t now;
+        uint64_t next;
+        float scale;
+        float pressure;
+        float uncertainty;
+        struct timespec ts;
+        ms5837_sampler_t sampler;
+        ms5837_sampler_stats_t stats;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        scale = (chip_type == MS5837_TYPE_30BA26) ? 10.0f : 100.0f;
+        (void)ms5837_predict_init(&gs_predict, 0.5f, 0.1f);
+        
+        /* sample and estimate the pressure on a 1ms tick, print every 100 ticks */
+        res = ms5837_sampler_init(&sampler);
+        if ((res != 0) ||
+            (ms5837_sampler_add(&sampler, &gs_sample_handle[0], period * 1000, NULL, &index) != 0) ||
+            (ms5837_sampler_set_predict(&sampler, index, &gs_predict) != 0) ||
+            (ms5837_sampler_start(&sampler) != 0))
+        {
+            res = 1;
+        }
+        else
+        {
+            (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+            next = (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+            tick = 0;
+            do
+            {
+                (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+                now = (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+                if (now >= next)
+                {
+                    if (((tick % 100) == 0) && (ms5837_predict_get(&gs_predict, now, &pressure, &uncertainty) == 0))
+                    {
+                        ms5837_interface_debug_print("ms5837: tick %u pressure is %0.2fmbar uncertainty %0.3fmbar.\n",
+                                                     tick, pressure / scale, uncertainty / scale);
+                    }
+                    tick++;
+                    next += 1000;
+                    
+                    continue;
+                }
+                res = ms5837_sampler_poll(&sampler, (int32_t)((next - now + 999) / 1000));
+                (void)ms5837_sampler_get_stats(&sampler, index, &stats);
+            } while ((res == 0) && (stats.samples < times));
+            (void)ms5837_sampler_stop(&sampler);
+            ms5837_interface_debug_print("ms5837: %u ticks served from %llu samples.\n", tick, (unsigned long long)stats.samples);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return res;
+    }
+    else if (strcmp("e_kalman", type) == 0)
+    {
+        uint8_t res;
+        uint8_t index;
+        float scale;
+        uint32_t noise;
+        ms5837_sampler_t sampler;
+        ms5837_sampler_stats_t stats;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* the depth noise of one sample and a 0.05m/s2 acceleration change in one period */
+        scale = (chip_type == MS5837_TYPE_30BA26) ? 10.0f : 100.0f;
+        noise = (chip_type == MS5837_TYPE_30BA26) ? 2000 : 200;
+        if (ms5837_kalman_init(&gs_kalman, chip_type, period * 1000, (int32_t)(surface * scale), density, noise, 50000) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: kalman param is invalid.\n");
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* sample */
+        res = ms5837_sampler_init(&sampler);
+        if ((res != 0) ||
+            (ms5837_sampler_add(&sampler, &gs_sample_handle[0], period * 1000, a_kalman_receive, &index) != 0) ||
+            (ms5837_sampler_set_kalman(&sampler, index, &gs_kalman) != 0) ||
+            (ms5837_sampler_start(&sampler) != 0))
+        {
+            res = 1;
+        }
+        else
+        {
+            do
+            {
+                res = ms5837_sampler_poll(&sampler, -1);
+                (void)ms5837_sampler_get_stats(&sampler, index, &stats);
+            } while ((res == 0) && (stats.samples < times));
+            (void)ms5837_sampler_stop(&sampler);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return res;
+    }
+    else if (strcmp("e_wave", type) == 0)
+    {
+        uint8_t res;
+        uint8_t index;
+        uint32_t count;
+        ms5837_wave_config_t config;
+        ms5837_wave_summary_t summary;
+        ms5837_sampler_t sampler;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* 256 sample segments, 8 segments a summary, swell to wind sea bands */
+        memset(&config, 0, sizeof(ms5837_wave_config_t));
+        config.type = chip_type;
+        config.period_us = period * 1000;
+        config.length = 256;
+        config.segments = 8;
+        config.surface = (int32_t)(surface * ((chip_type == MS5837_TYPE_30BA26) ? 10.0f : 100.0f));
+        config.density = (float)density;
+        config.height_m = height;
+        config.band_num = 4;
+        config.band_hz[0] = 0.04f;
+        config.band_hz[1] = 0.1f;
+        config.band_hz[2] = 0.15f;
+        config.band_hz[3] = 0.2f;
+        config.band_hz[4] = 0.3f;
+        if (ms5837_wave_init(&gs_wave, &config) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: wave param is invalid.\n");
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* sample and print the summaries */
+        res = ms5837_sampler_init(&sampler);
+        if ((res != 0) ||
+            (ms5837_sampler_add(&sampler, &gs_sample_handle[0], period * 1000, NULL, &index) != 0) ||
+            (ms5837_sampler_set_wave(&sampler, index, &gs_wave) != 0) ||
+            (ms5837_sampler_start(&sampler) != 0))
+        {
+            res = 1;
+        }
+        else
+        {
+            count = 0;
+            do
+            {
+                res = ms5837_sampler_poll(&sampler, -1);
+                if ((ms5837_wave_get_summary(&gs_wave, &summary) == 0) && (summary.count != count))
+                {
+                    count = summary.count;
+                    ms5837_interface_debug_print("ms5837: %u/%u depth is %0.2fm hs is %0.3fm tp is %0.1fs tz is %0.1fs gaps %u.\n",
+                                                 count, times, summary.depth_m, summary.hs_m, summary.tp_s, summary.tz_s, summary.gaps);
+                    ms5837_interface_debug_print("ms5837: band energy is %0.5fm2 %0.5fm2 %0.5fm2 %0.5fm2.\n",
+                                                 summary.band_m2[0], summary.band_m2[1], summary.band_m2[2], summary.band_m2[3]);
+                }
+            } while ((res == 0) && (count < times));
+            (void)ms5837_sampler_stop(&sampler);
+        }
+        (void)ms5837_sampler_deinit(&sampler);
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return res;
+    }
+    else if (strcmp("e_fusion", type) == 0)
+    {
+        uint8_t res;
+        ms5837_sync_t sync;
+        ms5837_handle_t *handle[MS5837_BUS_MAX_NUM];
+        ms5837_fusion_config_t config;
+        uint32_t outliers;
+        uint32_t missing;
+        uint8_t i;
+        
+        /* use the default bus */
+        if (bus_num == 0)
+        {
+            bus_num = 1;
+        }
+        
+        /* init the sensors, one per bus */
+        for (i = 0; i < bus_num; i++)
+        {
+            (void)ms5837_bus_link(&gs_sample_handle[i], i, bus[i]);
+            (void)ms5837_set_retry(&gs_sample_handle[i], retry, budget);
+            res = ms5837_init(&gs_sample_handle[i]);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: init %s failed.\n", bus[i]);
+                
+                goto fusion_failed;
+            }
+            if ((ms5837_set_type(&gs_sample_handle[i], chip_type) != 0) ||
+                (ms5837_set_temperature_osr(&gs_sample_handle[i], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+                (ms5837_set_pressure_osr(&gs_sample_handle[i], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+            {
+                ms5837_interface_debug_print("ms5837: config %s failed.\n", bus[i]);
+                (void)ms5837_deinit(&gs_sample_handle[i]);
+                
+                goto fusion_failed;
+            }
+            handle[i] = &gs_sample_handle[i];
+        }
+        
+        /* mean of the sensors inside the tolerance without the lowest and the highest of 3 or more, 3 bad sets in a row fault a sensor */
+        memset(&config, 0, sizeof(ms5837_fusion_config_t));
+        config.num = bus_num;
+        config.mode = MS5837_FUSION_MODE_TRIMMED_MEAN;
+        config.trim = (bus_num >= 3) ? 1 : 0;
+        config.surface_pa = (int32_t)(surface * 100.0f);
+        config.density = density;
+        config.tolerance_pa = (uint32_t)(tolerance * 100.0f);
+        config.fault_count = 3;
+        if (ms5837_fusion_init(&gs_fusion, &config) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: fusion param is invalid.\n");
+            
+            goto fusion_failed;
+        }
+        
+        /* sample all buses at the same deadlines and vote each set */
+        gs_sample_count[0] = 0;
+        gs_sample_times = times;
+        res = ms5837_sync_start(&sync, handle, bus_num, period * 1000, times, &gs_fusion, a_fusion_receive);
+        if (res != 0)
+        {
+            goto fusion_failed;
+        }
+        (void)ms5837_sync_wait(&sync);
+        for (i = 0; i < bus_num; i++)
+        {
+            (void)ms5837_fusion_get_stats(&gs_fusion, i, &outliers, &missing);
+            ms5837_interface_debug_print("ms5837: bus %d outlier %u sets missing %u sets.\n", i, outliers, missing);
+        }
+        
+        /* deinit */
+        for (i = 0; i < bus_num; i++)
+        {
+            (void)ms5837_deinit(&gs_sample_handle[i]);
+        }
+        
+        return 0;
+        
+        fusion_failed:
+        while (i > 0)
+        {
+            i--;
+            (void)ms5837_deinit(&gs_sample_handle[i]);
+        }
+        
+        return 1;
+    }
+    else if (strcmp("e_correct", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        float scale;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* build the correction in the integer units of the type */
+        scale = (chip_type == MS5837_TYPE_30BA26) ? 10.0f : 100.0f;
+        memset(&gs_correction, 0, sizeof(ms5837_correction_t));
+        gs_correction.pressure_offset = (int32_t)lroundf(offset * scale);
+        gs_correction.pressure_gain = (int32_t)lroundf(gain * 65536.0f);
+        if ((table[0] != 0) && (a_correct_load(table, scale, &gs_correction) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        if (ms5837_set_correction(&gs_sample_handle[0], &gs_correction) != 0)
+        {
+            ms5837_interface_debug_print("ms5837: correction param is invalid.\n");
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        ms5837_interface_debug_print("ms5837: correction offset is %0.2fmbar gain is %0.4f table has %d points.\n",
+                                     (double)gs_correction.pressure_offset / scale,
+                                     (double)gs_correction.pressure_gain / 65536.0, gs_correction.table_num);
+        
+        /* the driver returns the corrected results */
+        for (i = 0; i < times; i++)
+        {
+            uint32_t temperature_raw;
+            uint32_t pressure_raw;
+            float temperature_c;
+            float pressure_mbar;
+            
+            res = ms5837_read_temperature_pressure(&gs_sample_handle[0], &temperature_raw, &temperature_c,
+                                                   &pressure_raw, &pressure_mbar);
+            if (res != 0)
+            {
+                (void)ms5837_deinit(&gs_sample_handle[0]);
+                
+                return 1;
+            }
+            ms5837_interface_debug_print("ms5837: %d/%d.\n", i + 1, times);
+            ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", temperature_c);
+            ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", pressure_mbar);
+            ms5837_interface_delay_ms(period);
+        }
+        
+        /* deinit */
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return 0;
+    }
+    else if (strcmp("e_retune", type) == 0)
+    {
+        uint8_t res;
+        uint32_t ticket;
+        uint32_t applied;
+        uint32_t ms;
+        ms5837_rt_t rt;
+        ms5837_rt_config_t config;
+        ms5837_config_t retune;
+        
+        /* init the sensor */
+        (void)ms5837_bus_link(&gs_sample_handle[0], 0, bus[0]);
+        (void)ms5837_set_retry(&gs_sample_handle[0], retry, budget);
+        res = ms5837_init(&gs_sample_handle[0]);
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((ms5837_set_type(&gs_sample_handle[0], chip_type) != 0) ||
+            (ms5837_set_temperature_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_TEMPERATURE_OSR) != 0) ||
+            (ms5837_set_pressure_osr(&gs_sample_handle[0], MS5837_BASIC_DEFAULT_PRESSURE_OSR) != 0))
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* run the sampling thread */
+        gs_sample_count[0] = 0;
+        gs_sample_times = times;
+        ms5837_rt_default_config(&config);
+        config.period_us = period * 1000;
+        res = ms5837_rt_start(&rt, &gs_sample_handle[0], &config, NULL, 0, times, a_retune_receive);
+        if (res != 0)
+        {
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        
+        /* retune halfway without stopping the stream */
+        ms5837_interface_delay_ms(period * (times / 2) + period / 2);
+        retune.type = chip_type;
+        retune.temperature_osr = osr;
+        retune.pressure_osr = osr;
+        if (ms5837_stage_config(&gs_sample_handle[0], &retune, &ticket) != 0)
+        {
+            (void)ms5837_rt_stop(&rt);
+            (void)ms5837_deinit(&gs_sample_handle[0]);
+            
+            return 1;
+        }
+        ms5837_interface_debug_print("ms5837: staged osr %d ticket %u.\n", 256 << osr, ticket);
+        for (ms = 0; ms < period * 2; ms++)
+        {
+            (void)ms5837_get_config_ticket(&gs_sample_handle[0], &applied);
+            if ((int32_t)(applied - ticket) >= 0)
+            {
+                ms5837_interface_debug_print("ms5837: ticket %u applied after %ums.\n", ticket, ms);
+                
+                break;
+            }
+            ms5837_interface_delay_ms(1);
+        }
+        (void)ms5837_rt_wait(&rt);
+        
+        /* deinit */
+        (void)ms5837_deinit(&gs_sample_handle[0]);
+        
+        return 0;
+    }
+    else if (strcmp("h", type) == 0)
+    {
+        help:
+        ms5837_interface_debug_print("Usage:\n");
+        ms5837_interface_debug_print("  ms5837 (-i | --information)\n");
+        ms5837_interface_debug_print("  ms5837 (-h | --help)\n");
+        ms5837_interface_debug_print("  ms5837 (-p | --port)\n");
+        ms5837_interface_debug_print("  ms5837 (-t read | --test=read) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-t sim | --test=sim) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-t sync | --test=sync) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-t archive | --test=archive) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-t rollup | --test=rollup) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-t window | --test=window) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-t kalman | --test=kalman) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-t wave | --test=wave) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e read | --example=read) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e sample | --example=sample) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--trace]\n");
+        ms5837_interface_debug_print("  ms5837 (-e rt | --example=rt) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--priority=<num>] [--cpu=<num>] [--lock]\n");
+        ms5837_interface_debug_print("         [--retry=<num>] [--budget=<us>] [--trace]\n");
+        ms5837_interface_debug_print("  ms5837 (-e sync | --example=sync) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--trace]\n");
+        ms5837_interface_debug_print("  ms5837 (-e sim | --example=sim) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--period=<ms>] [--retry=<num>] [--budget=<us>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e record | --example=record) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--file=<path>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e replay | --example=replay) [--type=<02BA01 | 02BA21 | 30BA26>] [--retry=<num>]\n");
+        ms5837_interface_debug_print("         [--budget=<us>] [--file=<path>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e archive | --example=archive) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--file=<path>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e trigger | --example=trigger) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--low=<mbar>] [--high=<mbar>] [--rate=<mbar/s>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e deadband | --example=deadband) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--deadband=<mbar>] [--heartbeat=<ms>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e publish | --example=publish) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--name=<shm>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e subscribe | --example=subscribe) [--times=<num>] [--name=<shm>] [--decimation=<num>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e broker | --example=broker) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--retry=<num>] [--budget=<us>] [--socket=<path>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e request | --example=request) [--times=<num>] [--period=<ms>] [--socket=<path>] [--age=<ms>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e predict | --example=predict) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e kalman | --example=kalman) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--surface=<mbar>] [--density=<kg/m3>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e wave | --example=wave) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--surface=<mbar>] [--density=<kg/m3>]\n");
+        ms5837_interface_debug_print("         [--height=<m>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e fusion | --example=fusion) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--surface=<mbar>] [--density=<kg/m3>]\n");
+        ms5837_interface_debug_print("         [--tolerance=<mbar>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e correct | --example=correct) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--offset=<mbar>] [--gain=<num>]\n");
+        ms5837_interface_debug_print("         [--table=<path>]\n");
+        ms5837_interface_debug_print("  ms5837 (-e retune | --example=retune) [--type=<02BA01 | 02BA21 | 30BA26>] [--times=<num>]\n");
+        ms5837_interface_debug_print("         [--bus=<dev>] [--period=<ms>] [--retry=<num>] [--budget=<us>] [--osr=<256 | 512 | 1024 | 2048 | 4096 | 8192>]\n");
+        ms5837_interface_debug_print("\n");
+        ms5837_interface_debug_print("Options:\n");
+        ms5837_interface_debug_print("      --age=<ms>       Set the max age of a cached sample of the request example, 0 waits for a new conversion.([default: 0])\n");
+        ms5837_interface_debug_print("      --budget=<us>    Set the time budget of an iic transaction with its retries, 0 means no limit.([default: 0])\n");
+        ms5837_interface_debug_print("      --bus=<dev>      Add an iic bus with one sensor, repeat it for more sensors.([default: /dev/i2c-1])\n");
+        ms5837_interface_debug_print("      --cpu=<num>      Pin the real time thread to the cpu.([default: -1])\n");
+        ms5837_interface_debug_print("      --deadband=<mbar> Set the pressure deadband of the deadband example.([default: 0.5])\n");
+        ms5837_interface_debug_print("      --decimation=<num>\n");
+        ms5837_interface_debug_print("                       Set the decimation of the subscribe example, it reads every num sample.([default: 1])\n");
+        ms5837_interface_debug_print("      --density=<kg/m3>\n");
+        ms5837_interface_debug_print("                       Set the water density of the kalman, wave and fusion examples.([default: 1029])\n");
+        ms5837_interface_debug_print("  -e <read | sample | rt | sync | sim | record | replay | archive | trigger | deadband\n");
+        ms5837_interface_debug_print("      | publish | subscribe | broker | request | predict | kalman | wave | fusion | correct | retune>,\n");
+        ms5837_interface_debug_print("      --example=<read | sample | rt | sync | sim | record | replay | archive | trigger | deadband | publish\n");
+        ms5837_interface_debug_print("      | subscribe | broker | request | predict | kalman | wave | fusion | correct | retune>\n");
+        ms5837_interface_debug_print("                       Run the driver example.\n");
+        ms5837_interface_debug_print("      --file=<path>    Set the file of the record, replay and archive examples.([default: ms5837.rec])\n");
+        ms5837_interface_debug_print("      --gain=<num>     Set the pressure gain of the correct example.([default: 1.0])\n");
+        ms5837_interface_debug_print("      --heartbeat=<ms> Set the max time between two reports of the deadband example, 0 disables it.([default: 10000])\n");
+        ms5837_interface_debug_print("      --height=<m>     Set the sensor height above the seabed of the wave example.([default: 10])\n");
+        ms5837_interface_debug_print("  -h, --help           Show the help.\n");
+        ms5837_interface_debug_print("      --high=<mbar>    Set the over depth pressure of the trigger example.([default: 3000])\n");
+        ms5837_interface_debug_print("  -i, --information    Show the chip information.\n");
+        ms5837_interface_debug_print("      --lock           Lock the memory of the real time thread.\n");
+        ms5837_interface_debug_print("      --low=<mbar>     Set the surfaced pressure of the trigger example.([default: 1100])\n");
+        ms5837_interface_debug_print("      --name=<shm>     Set the shared memory name of the publish and subscribe examples.([default: /ms5837])\n");
+        ms5837_interface_debug_print("      --offset=<mbar>  Set the pressure offset of the correct example.([default: 0.0])\n");
+        ms5837_interface_debug_print("      --osr=<256 | 512 | 1024 | 2048 | 4096 | 8192>\n");
+        ms5837_interface_debug_print("                       Set the osr staged halfway by the retune example.([default: 256])\n");
+        ms5837_interface_debug_print("  -p, --port           Display the pin connections of the current board.\n");
+        ms5837_interface_debug_print("      --period=<ms>    Set the sampling period.([default: 1000])\n");
+        ms5837_interface_debug_print("      --priority=<num> Set the SCHED_FIFO priority of the real time thread, 0 keeps the default scheduler.([default: 0])\n");
+        ms5837_interface_debug_print("      --rate=<mbar/s>  Set the pressure rate of the trigger example in both directions.([default: 100])\n");
+        ms5837_interface_debug_print("      --retry=<num>    Set the retry times of an iic transaction, a failed sample resyncs the sensor.([default: 0])\n");
+        ms5837_interface_debug_print("      --socket=<path>  Set the unix socket of the broker and request examples.([default: /tmp/ms5837.sock])\n");
+        ms5837_interface_debug_print("      --surface=<mbar> Set the surface pressure of the kalman, wave and fusion examples.([default: 1013.25])\n");
+        ms5837_interface_debug_print("      --table=<path>   Set the temperature correction table of the correct example,\n");
+        ms5837_interface_debug_print("                       every line is temperature_c,correction_mbar in equal temperature steps.\n");
+        ms5837_interface_debug_print("  -t <read | sim | sync | archive | rollup | window | kalman | wave>, --test=<read | sim | sync | archive | rollup | window | kalman | wave>\n");
+        ms5837_interface_debug_print("                       Run the driver test.\n");
+        ms5837_interface_debug_print("      --times=<num>    Set the running times.([default: 3])\n");
+        ms5837_interface_debug_print("      --tolerance=<mbar>\n");
+        ms5837_interface_debug_print("                       Set the max distance from the median of an agreeing sensor of the fusion example.([default: 1.0])\n");
+        ms5837_interface_debug_print("      --trace          Log the driver events into a ring and decode them after each sample.\n");
+        ms5837_interface_debug_print("      --type=<02BA01 | 02BA21 | 30BA26>\n");
+        ms5837_interface_debug_print("                       Set the chip type.([default: 02BA01])\n");
+        
+        return 0;
+    }
+    else if (strcmp("i", type) == 0)
+    {
+        ms5837_info_t info;
+        
+        /* print ms5837 info */
+        ms5837_info(&info);
+        ms5837_interface_debug_print("ms5837: chip is %s.\n", info.chip_name);
+        ms5837_interface_debug_print("ms5837: manufacturer is %s.\n", info.manufacturer_name);
+        ms5837_interface_debug_print("ms5837: interface is %s.\n", info.interface);
+        ms5837_interface_debug_print("ms5837: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000 ) / 100);
+        ms5837_interface_debug_print("ms5837: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ms5837_interface_debug_print("ms5837: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ms5837_interface_debug_print("ms5837: max current is %0.2fmA.\n", info.max_current_ma);
+        ms5837_interface_debug_print("ms5837: max temperature is %0.1fC.\n", info.temperature_max);
+        ms5837_interface_debug_print("ms5837: min temperature is %0.1fC.\n", info.temperature_min);
+        
+        return 0;
+    }
+    else if (strcmp("p", type) == 0)
+    {
+        /* print pin connection */
+        ms5837_interface_debug_print("ms5837: SCL connected to GPIO3.\n");
+        ms5837_interface_debug_print("ms5837: SDA connected to GPIO2.\n");
+        
+        return 0;
     }
     else
     {
-        ms5837_interface_debug_print("ms5837: unknown status code.\n");
+        return 5;
     }
+}
 
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+    
+    res = ms5837(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        ms5837_interface_debug_print("ms5837: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        ms5837_interface_debug_print("ms5837: param is invalid.\n");
+    }
+    else
+    {
+        ms5837_interface_debug_print("ms5837: unknown status code.\n");
+    }
+    
     return 0;
 }
@@ -106,6 +106,25 @@ void ms5837_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return free running time in us
+ * @note   systick runs from the 168MHz hclk with a 1ms reload
+ */
+uint32_t ms5837_interface_timestamp_us(void)
+{
+    uint32_t ms;
+    uint32_t val;
+    
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+    
+    return ms * 1000 + (SysTick->LOAD - val) / 168;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
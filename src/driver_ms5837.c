@@ -62,6 +62,231 @@
 #define MS5837_CMD_ADC_READ     0x00        /**< command adc read */
 #define MS5837_CMD_PROM_READ    0xA0        /**< command prom read */
 
+/**
+ * @brief conversion time table definition
+ */
+static const uint8_t gs_convert_delay_ms[6] = {1, 2, 3, 5, 10, 19};                   /**< blocking delay in ms */
+static const uint32_t gs_convert_time_us[6] = {600, 1170, 2280, 4540, 9040, 18080};   /**< max conversion time in us */
+
+/**
+ * @brief     get the timestamp
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    timestamp in us
+ * @note      it returns 0 when timestamp_us is not linked
+ */
+static uint32_t a_ms5837_timestamp(ms5837_handle_t *handle)
+{
+    if (handle->timestamp_us == NULL)        /* check the timestamp */
+    {
+        return 0;                            /* no timestamp */
+    }
+    
+    return handle->timestamp_us();           /* get the timestamp */
+}
+
+#if (MS5837_INSTRUMENT == 1)
+
+/**
+ * @brief     get the histogram bucket
+ * @param[in] us time in us
+ * @return    bucket index
+ * @note      none
+ */
+static uint8_t a_ms5837_bucket(uint32_t us)
+{
+    uint8_t n = 0;
+    
+    while ((us != 0) && (n < (MS5837_INSTRUMENT_BUCKET - 1)))        /* loop the bit length */
+    {
+        us >>= 1;                                                    /* next bit */
+        n++;                                                         /* next bucket */
+    }
+    
+    return n;                                                        /* return the bucket */
+}
+
+/**
+ * @brief     begin the instrument update
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @note      seq is odd until a_ms5837_instrument_end
+ */
+static void a_ms5837_instrument_begin(ms5837_handle_t *handle)
+{
+    handle->instrument.seq++;        /* mark updating */
+    MS5837_BARRIER();                /* order the updates */
+}
+
+/**
+ * @brief     end the instrument update
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @note      none
+ */
+static void a_ms5837_instrument_end(ms5837_handle_t *handle)
+{
+    MS5837_BARRIER();                /* order the updates */
+    handle->instrument.seq++;        /* mark updated */
+}
+
+/**
+ * @brief     record an iic transaction
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] write 1 for write and 0 for read
+ * @param[in] len data length
+ * @param[in] start transaction start time
+ * @param[in] res transaction result
+ * @note      none
+ */
+static void a_ms5837_instrument_iic(ms5837_handle_t *handle, uint8_t write, uint16_t len, uint32_t start, uint8_t res)
+{
+    uint32_t end;
+    
+    end = a_ms5837_timestamp(handle);                                                        /* get the end time */
+    a_ms5837_instrument_begin(handle);                                                       /* begin */
+    if (write != 0)                                                                          /* write */
+    {
+        handle->instrument.iic_write++;                                                      /* count write */
+        handle->instrument.tx_bytes += 1 + (uint32_t)(len);                                  /* command and data */
+    }
+    else                                                                                     /* read */
+    {
+        handle->instrument.iic_read++;                                                       /* count read */
+        handle->instrument.tx_bytes += 1;                                                    /* command */
+        handle->instrument.rx_bytes += len;                                                  /* data */
+    }
+    if (res != 0)                                                                            /* check the result */
+    {
+        handle->instrument.failures++;                                                       /* count failure */
+    }
+    if (handle->timestamp_us != NULL)                                                        /* check the timestamp */
+    {
+        handle->instrument.bus_latency[a_ms5837_bucket(end - start)]++;                      /* latency histogram */
+    }
+    a_ms5837_instrument_end(handle);                                                         /* end */
+}
+
+/**
+ * @brief     record a finished sample
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @note      none
+ */
+static void a_ms5837_instrument_sample(ms5837_handle_t *handle)
+{
+    uint32_t end;
+    
+    if ((handle->sample_pending == 0) || (handle->timestamp_us == NULL))                     /* check the sample */
+    {
+        return;                                                                              /* nothing to record */
+    }
+    end = a_ms5837_timestamp(handle);                                                        /* get the end time */
+    a_ms5837_instrument_begin(handle);                                                       /* begin */
+    handle->instrument.sample_latency[a_ms5837_bucket(end - handle->sample_start)]++;        /* latency histogram */
+    a_ms5837_instrument_end(handle);                                                         /* end */
+    handle->sample_pending = 0;                                                              /* clear the flag */
+}
+#endif
+
+/**
+ * @brief     report an event
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] id event id
+ * @param[in] arg event argument
+ * @param[in] *text pointer to a debug message, NULL for trace only events
+ * @note      the message is only formatted when no event function is linked
+ */
+static void a_ms5837_event(ms5837_handle_t *handle, uint16_t id, uint32_t arg, const char *const text)
+{
+    if (handle->event != NULL)                    /* check the event */
+    {
+        handle->event(id, arg);                   /* push the event */
+    }
+    else if (text != NULL)                        /* check the text */
+    {
+        handle->debug_print("%s", text);          /* print the text */
+    }
+    else
+    {
+        /* trace only */
+    }
+}
+
+/**
+ * @brief     check the retry policy
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] retry done retry times
+ * @param[in] start transaction start time
+ * @return    1 if it can retry, 0 if not
+ * @note      none
+ */
+static uint8_t a_ms5837_retry_allowed(ms5837_handle_t *handle, uint8_t retry, uint32_t start)
+{
+    if (retry >= handle->retry_times)                                               /* check the times */
+    {
+        return 0;                                                                   /* no more retry */
+    }
+    if ((handle->retry_budget_us != 0) && (handle->timestamp_us != NULL) &&
+        ((handle->timestamp_us() - start) >= handle->retry_budget_us))              /* check the budget */
+    {
+        return 0;                                                                   /* out of time */
+    }
+    
+    return 1;                                                                       /* retry */
+}
+
+/**
+ * @brief      transfer bytes with the retry policy
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  write 1 for write and 0 for read
+ * @param[in]  reg iic register address
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transfer failed
+ * @note       none
+ */
+static uint8_t a_ms5837_iic_transfer(ms5837_handle_t *handle, uint8_t write, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    uint8_t retry;
+    uint32_t start;
+#if (MS5837_INSTRUMENT == 1)
+    uint32_t begin;
+#endif
+    
+    start = a_ms5837_timestamp(handle);                                             /* get the start time */
+    for (retry = 0; ; retry++)                                                      /* loop all retries */
+    {
+#if (MS5837_INSTRUMENT == 1)
+        begin = a_ms5837_timestamp(handle);                                         /* get the begin time */
+#endif
+        if (write != 0)                                                             /* write */
+        {
+            res = handle->iic_write(MS5837_ADDRESS, reg, data, len);                /* write the register */
+        }
+        else                                                                        /* read */
+        {
+            res = handle->iic_read(MS5837_ADDRESS, reg, data, len);                 /* read the register */
+        }
+#if (MS5837_INSTRUMENT == 1)
+        a_ms5837_instrument_iic(handle, write, len, begin, res);                    /* record the transaction */
+#endif
+        if (res == 0)                                                               /* check the result */
+        {
+            return 0;                                                               /* success return 0 */
+        }
+        if (a_ms5837_retry_allowed(handle, retry, start) == 0)                      /* check the policy */
+        {
+            return 1;                                                               /* return error */
+        }
+        a_ms5837_event(handle, MS5837_EVENT_RETRY, reg, NULL);                      /* trace the retry */
+#if (MS5837_INSTRUMENT == 1)
+        a_ms5837_instrument_begin(handle);                                          /* begin */
+        handle->instrument.retries++;                                               /* count the retry */
+        a_ms5837_instrument_end(handle);                                            /* end */
+#endif
+    }
+}
+
 /**
  * @brief      read bytes
  * @param[in]  *handle pointer to an ms5837 handle structure
@@ -75,7 +300,7 @@
  */
 static uint8_t a_ms5837_iic_read(ms5837_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len)
 {
-    if (handle->iic_read(MS5837_ADDRESS, reg, data, len) != 0)        /* read the register */
+    if (a_ms5837_iic_transfer(handle, 0, reg, data, len) != 0)        /* read the register */
     {
         return 1;                                                     /* return error */
     }
@@ -98,7 +323,7 @@ static uint8_t a_ms5837_iic_read(ms5837_handle_t *handle, uint8_t reg, uint8_t *
  */
 static uint8_t a_ms5837_iic_write(ms5837_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len)
 {
-    if (handle->iic_write(MS5837_ADDRESS, reg, data, len) != 0)       /* write the register */
+    if (a_ms5837_iic_transfer(handle, 1, reg, data, len) != 0)        /* write the register */
     {
         return 1;                                                     /* return error */
     }
@@ -108,6 +333,132 @@ static uint8_t a_ms5837_iic_write(ms5837_handle_t *handle, uint8_t reg, uint8_t
     }
 }
 
+/**
+ * @brief     start a conversion
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] cmd convert command
+ * @param[in] osr adc osr
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the osr takes the bits 1 - 3 of the command, 0x40, 0x42 ... 0x4A for d1
+ */
+static uint8_t a_ms5837_convert(ms5837_handle_t *handle, uint8_t cmd, uint8_t osr)
+{
+    cmd = (uint8_t)(cmd + (osr << 1));                                             /* set the osr bits */
+    if (a_ms5837_iic_write(handle, cmd, NULL, 0) != 0)                             /* sent the command */
+    {
+        return 1;                                                                  /* return error */
+    }
+    a_ms5837_event(handle, MS5837_EVENT_CONVERT, cmd, NULL);                       /* trace the conversion */
+#if (MS5837_INSTRUMENT == 1)
+    handle->convert_start = a_ms5837_timestamp(handle);                            /* save the start time */
+    handle->convert_osr = osr;                                                     /* save the osr */
+    handle->convert_pending = 1;                                                   /* set the flag */
+    if ((cmd & 0xF0) == MS5837_CMD_D2)                                             /* a sample starts with d2 */
+    {
+        handle->sample_start = handle->convert_start;                              /* save the start time */
+        handle->sample_pending = 1;                                                /* set the flag */
+    }
+    if (osr <= MS5837_OSR_8192)                                                    /* check the osr */
+    {
+        a_ms5837_instrument_begin(handle);                                         /* begin */
+        handle->instrument.convert[osr]++;                                         /* count the conversion */
+        a_ms5837_instrument_end(handle);                                           /* end */
+    }
+#endif
+
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      read the adc result
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *raw pointer to a raw data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ms5837_read_raw(ms5837_handle_t *handle, uint32_t *raw)
+{
+    uint8_t buf[3];
+#if (MS5837_INSTRUMENT == 1)
+    uint32_t elapsed;
+    uint32_t limit;
+    
+    if ((handle->convert_pending != 0) && (handle->timestamp_us != NULL))                       /* check the conversion */
+    {
+        elapsed = a_ms5837_timestamp(handle) - handle->convert_start;                           /* get the elapsed time */
+        limit = gs_convert_time_us[(handle->convert_osr > MS5837_OSR_8192) ?
+                                   MS5837_OSR_8192 : handle->convert_osr];                      /* get the max time */
+        a_ms5837_instrument_begin(handle);                                                      /* begin */
+        handle->instrument.convert_overshoot[a_ms5837_bucket((elapsed > limit) ? 
+                                                             (elapsed - limit) : 0)]++;         /* overshoot histogram */
+        a_ms5837_instrument_end(handle);                                                        /* end */
+    }
+    handle->convert_pending = 0;                                                                /* clear the flag */
+#endif
+
+    if (a_ms5837_iic_read(handle, MS5837_CMD_ADC_READ, buf, 3) != 0)                            /* read adc */
+    {
+        return 1;                                                                               /* return error */
+    }
+    *raw = (((uint32_t)buf[0]) << 16) | (((uint32_t)buf[1]) << 8) | buf[2];                     /* set the raw */
+    if (*raw == 0)                                                                              /* the conversion is not ready */
+    {
+        return 1;                                                                               /* return error */
+    }
+    a_ms5837_event(handle, MS5837_EVENT_ADC, *raw, NULL);                                       /* trace the adc */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     delay the conversion time
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] osr adc osr
+ * @note      unknown osr values wait as long as osr 8192
+ */
+static void a_ms5837_delay_convert(ms5837_handle_t *handle, uint8_t osr)
+{
+    if (osr > MS5837_OSR_8192)                            /* check the osr */
+    {
+        osr = MS5837_OSR_8192;                            /* use the longest time */
+    }
+    handle->delay_ms(gs_convert_delay_ms[osr]);           /* delay the conversion time */
+}
+
+/**
+ * @brief     apply the staged configuration at a conversion boundary
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @note      a configuration that is being staged is left for the next boundary
+ */
+static void a_ms5837_apply_config(ms5837_handle_t *handle)
+{
+    uint32_t seq;
+    ms5837_config_t config;
+    
+    seq = handle->stage_seq;                                                  /* get the sequence */
+    if ((seq == handle->applied_seq) || ((seq & 1) != 0))                     /* nothing new or staging */
+    {
+        return;                                                               /* return */
+    }
+    MS5837_BARRIER();                                                         /* order the reads */
+    config = handle->staged;                                                  /* copy the configuration */
+    MS5837_BARRIER();                                                         /* order the reads */
+    if (handle->stage_seq != seq)                                             /* staged again */
+    {
+        return;                                                               /* try at the next boundary */
+    }
+    handle->type = (uint8_t)(config.type);                                    /* set the type */
+    handle->temp_osr = (uint8_t)(config.temperature_osr);                     /* set the temperature osr */
+    handle->press_osr = (uint8_t)(config.pressure_osr);                       /* set the pressure osr */
+    MS5837_BARRIER();                                                         /* publish the settings first */
+    handle->applied_seq = seq;                                                /* set the applied sequence */
+    a_ms5837_event(handle, MS5837_EVENT_CONFIG, seq, NULL);                   /* trace the configuration */
+}
+
 /**
  * @brief     get the crc4
  * @param[in] *n_prom pointer to a prom buffer
@@ -150,16 +501,66 @@ static uint8_t a_ms5837_crc4(uint16_t n_prom[8])
 }
 
 /**
- * @brief     calculate temperature and pressure
- * @param[in] *handle pointer to an ms5837 handle structure
- * @param[in] d2_temp temperature raw data
- * @param[in] *temperature_c pointer to a temperature buffer
- * @param[in] d1_press pressure raw data
- * @param[in] *pressure_mbar pointer to a pressure buffer
- * @note      none
+ * @brief         apply the user correction
+ * @param[in]     *correction pointer to a correction structure
+ * @param[in,out] *temperature pointer to a temperature buffer in 0.01C
+ * @param[in,out] *pressure pointer to a pressure buffer, NULL to correct only the temperature
+ * @note          none
  */
-static void a_ms5837_calculate_temperature_pressure(ms5837_handle_t *handle, uint32_t d2_temp, float *temperature_c, 
-                                                    uint32_t d1_press, float *pressure_mbar)
+static void a_ms5837_correct(const ms5837_correction_t *correction, int32_t *temperature, int32_t *pressure)
+{
+    int64_t p;
+    int64_t d;
+    int64_t i;
+    int64_t step;
+    int64_t delta;
+    int32_t table;
+    
+    *temperature = *temperature + correction->temperature_offset;                             /* correct the temperature */
+    if (pressure == NULL)                                                                     /* only the temperature */
+    {
+        return;                                                                               /* return */
+    }
+    p = (int64_t)(*pressure) + correction->pressure_offset;                                   /* add the offset */
+    p = p * correction->pressure_gain / 65536;                                                /* apply the gain */
+    if (correction->table_num != 0)                                                           /* with a table */
+    {
+        d = (int64_t)(*temperature) - correction->table_start;                                /* get the table distance */
+        if ((d <= 0) || (correction->table_num == 1))                                         /* before the first point */
+        {
+            table = correction->table[0];                                                     /* hold the first point */
+        }
+        else
+        {
+            step = correction->table_step;                                                    /* get the step */
+            i = d / step;                                                                     /* get the point index */
+            if (i >= (int64_t)(correction->table_num - 1))                                    /* after the last point */
+            {
+                table = correction->table[correction->table_num - 1];                         /* hold the last point */
+            }
+            else
+            {
+                d = d - i * step;                                                             /* get the distance in the step */
+                delta = (int64_t)(correction->table[i + 1]) - correction->table[i];           /* get the point delta */
+                table = correction->table[i] + (int32_t)(delta * d / step);                   /* interpolate linearly */
+            }
+        }
+        p = p + table;                                                                        /* add the table correction */
+    }
+    *pressure = (int32_t)p;                                                                   /* set the pressure */
+}
+
+/**
+ * @brief      compensate temperature and pressure in integers
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  d2_temp temperature raw data
+ * @param[out] *temperature pointer to a temperature buffer in 0.01C
+ * @param[in]  d1_press pressure raw data
+ * @param[out] *pressure pointer to a pressure buffer in 0.01mbar for 02ba, 0.1mbar for 30ba26
+ * @note       none
+ */
+static void a_ms5837_compensate(ms5837_handle_t *handle, uint32_t d2_temp, int32_t *temperature, 
+                                uint32_t d1_press, int32_t *pressure)
 {
     int32_t dt = 0;
     int64_t sens = 0;
@@ -171,7 +572,8 @@ static void a_ms5837_calculate_temperature_pressure(ms5837_handle_t *handle, uin
     int64_t sens2 = 0;
     int32_t p;
     int32_t temp;
-
+    const ms5837_correction_t *correction;
+    
     dt = d2_temp - (uint32_t)(handle->c[4]) * 256;                                            /* get the dt */
     if ((handle->type == MS5837_TYPE_02BA01) || (handle->type == MS5837_TYPE_02BA21))         /* 02ba01 and 02ba21 */
     {
@@ -210,7 +612,7 @@ static void a_ms5837_calculate_temperature_pressure(ms5837_handle_t *handle, uin
         }
         else
         {
-            ti = (int32_t)(2 * (dt * dt) / 137438953472U);                                    /* get the ti */
+            ti = (int32_t)((2 * (int64_t)(dt) * (int64_t)(dt)) / 137438953472U);               /* get the ti */
             offi = (1 * (temp - 2000) * (temp - 2000)) / 16;                                  /* get the offi */
             sensi = 0;                                                                        /* get the sensi */
         }
@@ -218,15 +620,49 @@ static void a_ms5837_calculate_temperature_pressure(ms5837_handle_t *handle, uin
     off2 = off - offi;                                                                        /* get the off2 */
     sens2 = sens - sensi;                                                                     /* get the sens2 */
     temp = (temp - ti);                                                                       /* get the temp */
-    *temperature_c = (float)(temp) / 100.0f;                                                  /* set the temperature */
     if ((handle->type == MS5837_TYPE_02BA01) || (handle->type == MS5837_TYPE_02BA21))         /* 02ba01 and 02ba21 */
     {
         p = (int32_t)((((d1_press * sens2) / 2097152 - off2) / 32768));                       /* get the p */
-        *pressure_mbar = (float)(p) / 100.0f;                                                 /* set the pressure */
     }
     else
     {
         p = (int32_t)((((d1_press * sens2) / 2097152 - off2) / 8192));                        /* get the p */
+    }
+    correction = handle->correction;                                                          /* get the correction once */
+    if (correction != NULL)                                                                   /* with a correction */
+    {
+        a_ms5837_correct(correction, &temp, &p);                                              /* correct the results */
+    }
+    *temperature = temp;                                                                      /* set the temperature */
+    *pressure = p;                                                                            /* set the pressure */
+#if (MS5837_INSTRUMENT == 1)
+    a_ms5837_instrument_sample(handle);                                                       /* record the sample */
+#endif
+}
+
+/**
+ * @brief     calculate temperature and pressure
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] d2_temp temperature raw data
+ * @param[in] *temperature_c pointer to a temperature buffer
+ * @param[in] d1_press pressure raw data
+ * @param[in] *pressure_mbar pointer to a pressure buffer
+ * @note      none
+ */
+static void a_ms5837_calculate_temperature_pressure(ms5837_handle_t *handle, uint32_t d2_temp, float *temperature_c, 
+                                                    uint32_t d1_press, float *pressure_mbar)
+{
+    int32_t temp;
+    int32_t p;
+    
+    a_ms5837_compensate(handle, d2_temp, &temp, d1_press, &p);                                /* compensate in integers */
+    *temperature_c = (float)(temp) / 100.0f;                                                  /* set the temperature */
+    if ((handle->type == MS5837_TYPE_02BA01) || (handle->type == MS5837_TYPE_02BA21))         /* 02ba01 and 02ba21 */
+    {
+        *pressure_mbar = (float)(p) / 100.0f;                                                 /* set the pressure */
+    }
+    else
+    {
         *pressure_mbar = (float)(p) / 10.0f;                                                  /* set the pressure */
     }
 }
@@ -243,7 +679,8 @@ static void a_ms5837_calculate_temperature(ms5837_handle_t *handle, uint32_t d2_
     int32_t dt = 0;
     int32_t ti = 0;
     int32_t temp;
-
+    const ms5837_correction_t *correction;
+    
     dt = d2_temp - (uint32_t)(handle->c[4]) * 256;                                           /* get the dt */
     temp = 2000 + (int64_t)(dt) * handle->c[5] / 8388608;                                    /* get the temp */
     if ((handle->type == MS5837_TYPE_02BA01) || (handle->type == MS5837_TYPE_02BA21))        /* 02ba01 and 02ba21 */
@@ -261,11 +698,19 @@ static void a_ms5837_calculate_temperature(ms5837_handle_t *handle, uint32_t d2_
         }
         else
         {
-            ti = (int32_t)((2 * (dt * dt)) / 137438953472U);                                 /* get the ti */
+            ti = (int32_t)((2 * (int64_t)(dt) * (int64_t)(dt)) / 137438953472U);              /* get the ti */
         }
     }
     temp = (temp - ti);                                                                      /* get the temp */
+    correction = handle->correction;                                                         /* get the correction once */
+    if (correction != NULL)                                                                  /* with a correction */
+    {
+        a_ms5837_correct(correction, &temp, NULL);                                           /* correct the temperature */
+    }
     *temperature_c = (float)(temp) / 100.0f;                                                 /* set the temperature */
+#if (MS5837_INSTRUMENT == 1)
+    a_ms5837_instrument_sample(handle);                                                      /* record the sample */
+#endif
 }
 
 /**
@@ -392,8 +837,9 @@ uint8_t ms5837_init(ms5837_handle_t *handle)
     }
     handle->temp_osr = MS5837_OSR_256;                               /* set 256 temperature osr */
     handle->press_osr = MS5837_OSR_256;                              /* set 256 pressure osr */
+    handle->applied_seq = handle->stage_seq;                         /* drop a configuration staged before */
     handle->inited = 1;                                              /* flag finish initialization */
-
+    
     return 0;                                                        /* success return 0 */
 }
 
@@ -472,7 +918,7 @@ uint8_t ms5837_get_type(ms5837_handle_t *handle, ms5837_type_t *type)
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      it is applied at once, use ms5837_stage_config beside a running acquisition
  */
 uint8_t ms5837_set_type(ms5837_handle_t *handle, ms5837_type_t type)
 {
@@ -525,7 +971,7 @@ uint8_t ms5837_get_temperature_osr(ms5837_handle_t *handle, ms5837_osr_t *osr)
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 30ba26 can't support osr 8192
- * @note      none
+ * @note      it is applied at once, use ms5837_stage_config beside a running acquisition
  */
 uint8_t ms5837_set_temperature_osr(ms5837_handle_t *handle, ms5837_osr_t osr)
 {
@@ -586,7 +1032,7 @@ uint8_t ms5837_get_pressure_osr(ms5837_handle_t *handle, ms5837_osr_t *osr)
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 30ba26 can't support osr 8192
- * @note      none
+ * @note      it is applied at once, use ms5837_stage_config beside a running acquisition
  */
 uint8_t ms5837_set_pressure_osr(ms5837_handle_t *handle, ms5837_osr_t osr)
 {
@@ -629,8 +1075,6 @@ uint8_t ms5837_set_pressure_osr(ms5837_handle_t *handle, ms5837_osr_t osr)
 uint8_t ms5837_read_temperature_pressure(ms5837_handle_t *handle, uint32_t *temperature_raw, float *temperature_c, 
                                          uint32_t *pressure_raw, float *pressure_mbar)
 {
-    uint8_t buf[3];
-    
     if (handle == NULL)                                                                        /* check handle */
     {
         return 2;                                                                              /* return error */
@@ -640,81 +1084,38 @@ uint8_t ms5837_read_temperature_pressure(ms5837_handle_t *handle, uint32_t *temp
         return 3;                                                                              /* return error */
     }
     
-    if (a_ms5837_iic_write(handle, MS5837_CMD_D2 + handle->temp_osr, NULL, 0) != 0)            /* sent d2 */
+    a_ms5837_apply_config(handle);                                                             /* apply the staged configuration */
+    if (a_ms5837_convert(handle, MS5837_CMD_D2, handle->temp_osr) != 0)                        /* sent d2 */
     {
-        handle->debug_print("ms5837: sent d2 failed.\n");                                      /* sent d2 failed */
+        a_ms5837_event(handle, MS5837_EVENT_SENT_D2_FAILED, handle->temp_osr,
+                       "ms5837: sent d2 failed.\n");                                           /* sent d2 failed */
         
         return 1;                                                                              /* return error */
     }
-    if (handle->temp_osr == MS5837_OSR_256)                                                    /* osr 256 */
-    {
-        handle->delay_ms(1);                                                                   /* delay 1ms */
-    }
-    else if (handle->temp_osr == MS5837_OSR_512)                                               /* osr 512 */
-    {
-        handle->delay_ms(2);                                                                   /* delay 2ms */
-    }
-    else if (handle->temp_osr == MS5837_OSR_1024)                                              /* osr 1024 */
-    {
-        handle->delay_ms(3);                                                                   /* delay 3ms */
-    }
-    else if (handle->temp_osr == MS5837_OSR_2048)                                              /* osr 2048 */
-    {
-        handle->delay_ms(5);                                                                   /* delay 5ms */
-    }
-    else if (handle->temp_osr == MS5837_OSR_4096)                                              /* osr 4096 */
-    {
-        handle->delay_ms(9);                                                                   /* delay 9ms */
-    }
-    else                                                                                       /* osr 8192 */
-    {
-        handle->delay_ms(18);                                                                  /* delay 18ms */
-    }
-    if (a_ms5837_iic_read(handle, MS5837_CMD_ADC_READ, buf, 3) != 0)                           /* read adc */
+    a_ms5837_delay_convert(handle, handle->temp_osr);                                          /* delay the conversion time */
+    if (a_ms5837_read_raw(handle, temperature_raw) != 0)                                       /* read adc */
     {
-        handle->debug_print("ms5837: read adc failed.\n");                                     /* read adc failed */
+        a_ms5837_event(handle, MS5837_EVENT_READ_ADC_FAILED, 0,
+                       "ms5837: read adc failed.\n");                                          /* read adc failed */
         
         return 1;                                                                              /* return error */
     }
-    *temperature_raw = (((uint32_t)buf[0]) << 16) | (((uint32_t)buf[1]) << 8) | buf[2];        /* set the temperature raw */
     
-    if (a_ms5837_iic_write(handle, MS5837_CMD_D1 + handle->press_osr, NULL, 0) != 0)           /* sent d1 */
+    if (a_ms5837_convert(handle, MS5837_CMD_D1, handle->press_osr) != 0)                       /* sent d1 */
     {
-        handle->debug_print("ms5837: sent d1 failed.\n");                                      /* sent d1 failed */
+        a_ms5837_event(handle, MS5837_EVENT_SENT_D1_FAILED, handle->press_osr,
+                       "ms5837: sent d1 failed.\n");                                           /* sent d1 failed */
         
         return 1;                                                                              /* return error */
     }
-    if (handle->press_osr == MS5837_OSR_256)                                                   /* osr 256 */
-    {
-        handle->delay_ms(1);                                                                   /* delay 1ms */
-    }
-    else if (handle->press_osr == MS5837_OSR_512)                                              /* osr 512 */
+    a_ms5837_delay_convert(handle, handle->press_osr);                                         /* delay the conversion time */
+    if (a_ms5837_read_raw(handle, pressure_raw) != 0)                                          /* read adc */
     {
-        handle->delay_ms(2);                                                                   /* delay 2ms */
+        a_ms5837_event(handle, MS5837_EVENT_READ_ADC_FAILED, 0,
+                       "ms5837: read adc failed.\n");                                          /* read adc failed */
+        
+        return 1;                                                                              /* return error */
     }
-    else if (handle->press_osr == MS5837_OSR_1024)                                             /* osr 1024 */
-    {
-        handle->delay_ms(3);                                                                   /* delay 3ms */
-    }
-    else if (handle->press_osr == MS5837_OSR_2048)                                             /* osr 2048 */
-    {
-        handle->delay_ms(5);                                                                   /* delay 5ms */
-    }
-    else if (handle->press_osr == MS5837_OSR_4096)                                             /* osr 4096 */
-    {
-        handle->delay_ms(9);                                                                   /* delay 9ms */
-    }
-    else                                                                                       /* osr 8192 */
-    {
-        handle->delay_ms(18);                                                                  /* delay 18ms */
-    }
-    if (a_ms5837_iic_read(handle, MS5837_CMD_ADC_READ, buf, 3) != 0)                           /* read adc */
-    {
-        handle->debug_print("ms5837: read adc failed.\n");                                     /* read adc failed */
-        
-        return 1;                                                                              /* return error */
-    }
-    *pressure_raw = (((uint32_t)buf[0]) << 16) | (((uint32_t)buf[1]) << 8) | buf[2];           /* set the temperature raw */
     a_ms5837_calculate_temperature_pressure(handle, *temperature_raw, temperature_c, 
                                             *pressure_raw, pressure_mbar);                     /* calculate temperature and pressure */
     
@@ -735,7 +1136,6 @@ uint8_t ms5837_read_temperature_pressure(ms5837_handle_t *handle, uint32_t *temp
  */
 uint8_t ms5837_read_pressure(ms5837_handle_t *handle, uint32_t *pressure_raw, float *pressure_mbar)
 {
-    uint8_t buf[3];
     uint32_t temperature_raw;
     float temperature_c; 
     
@@ -748,103 +1148,167 @@ uint8_t ms5837_read_pressure(ms5837_handle_t *handle, uint32_t *pressure_raw, fl
         return 3;                                                                              /* return error */
     }
     
-    if (a_ms5837_iic_write(handle, MS5837_CMD_D2 + handle->temp_osr, NULL, 0) != 0)            /* sent d2 */
+    a_ms5837_apply_config(handle);                                                             /* apply the staged configuration */
+    if (a_ms5837_convert(handle, MS5837_CMD_D2, handle->temp_osr) != 0)                        /* sent d2 */
     {
-        handle->debug_print("ms5837: sent d2 failed.\n");                                      /* sent d2 failed */
+        a_ms5837_event(handle, MS5837_EVENT_SENT_D2_FAILED, handle->temp_osr,
+                       "ms5837: sent d2 failed.\n");                                           /* sent d2 failed */
         
         return 1;                                                                              /* return error */
     }
-    if (handle->temp_osr == MS5837_OSR_256)                                                    /* osr 256 */
-    {
-        handle->delay_ms(1);                                                                   /* delay 1ms */
-    }
-    else if (handle->temp_osr == MS5837_OSR_512)                                               /* osr 512 */
+    a_ms5837_delay_convert(handle, handle->temp_osr);                                          /* delay the conversion time */
+    if (a_ms5837_read_raw(handle, &temperature_raw) != 0)                                      /* read adc */
     {
-        handle->delay_ms(2);                                                                   /* delay 2ms */
+        a_ms5837_event(handle, MS5837_EVENT_READ_ADC_FAILED, 0,
+                       "ms5837: read adc failed.\n");                                          /* read adc failed */
+        
+        return 1;                                                                              /* return error */
     }
-    else if (handle->temp_osr == MS5837_OSR_1024)                                              /* osr 1024 */
+    
+    if (a_ms5837_convert(handle, MS5837_CMD_D1, handle->press_osr) != 0)                       /* sent d1 */
     {
-        handle->delay_ms(3);                                                                   /* delay 3ms */
+        a_ms5837_event(handle, MS5837_EVENT_SENT_D1_FAILED, handle->press_osr,
+                       "ms5837: sent d1 failed.\n");                                           /* sent d1 failed */
+        
+        return 1;                                                                              /* return error */
     }
-    else if (handle->temp_osr == MS5837_OSR_2048)                                              /* osr 2048 */
+    a_ms5837_delay_convert(handle, handle->press_osr);                                         /* delay the conversion time */
+    if (a_ms5837_read_raw(handle, pressure_raw) != 0)                                          /* read adc */
     {
-        handle->delay_ms(5);                                                                   /* delay 5ms */
+        a_ms5837_event(handle, MS5837_EVENT_READ_ADC_FAILED, 0,
+                       "ms5837: read adc failed.\n");                                          /* read adc failed */
+        
+        return 1;                                                                              /* return error */
     }
-    else if (handle->temp_osr == MS5837_OSR_4096)                                              /* osr 4096 */
+    a_ms5837_calculate_temperature_pressure(handle, temperature_raw, &temperature_c, 
+                                            *pressure_raw, pressure_mbar);                     /* calculate temperature and pressure */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ms5837_read_temperature(ms5837_handle_t *handle, uint32_t *temperature_raw, float *temperature_c)
+{
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->delay_ms(9);                                                                   /* delay 9ms */
+        return 2;                                                                              /* return error */
     }
-    else                                                                                       /* osr 8192 */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->delay_ms(18);                                                                  /* delay 18ms */
+        return 3;                                                                              /* return error */
     }
-    if (a_ms5837_iic_read(handle, MS5837_CMD_ADC_READ, buf, 3) != 0)                           /* read adc */
+    
+    a_ms5837_apply_config(handle);                                                             /* apply the staged configuration */
+    if (a_ms5837_convert(handle, MS5837_CMD_D2, handle->temp_osr) != 0)                        /* sent d2 */
     {
-        handle->debug_print("ms5837: read adc failed.\n");                                     /* read adc failed */
+        a_ms5837_event(handle, MS5837_EVENT_SENT_D2_FAILED, handle->temp_osr,
+                       "ms5837: sent d2 failed.\n");                                           /* sent d2 failed */
         
         return 1;                                                                              /* return error */
     }
-    temperature_raw = (((uint32_t)buf[0]) << 16) | (((uint32_t)buf[1]) << 8) | buf[2];         /* set the temperature raw */
-    
-    if (a_ms5837_iic_write(handle, MS5837_CMD_D1 + handle->press_osr, NULL, 0) != 0)           /* sent d1 */
+    a_ms5837_delay_convert(handle, handle->temp_osr);                                          /* delay the conversion time */
+    if (a_ms5837_read_raw(handle, temperature_raw) != 0)                                       /* read adc */
     {
-        handle->debug_print("ms5837: sent d1 failed.\n");                                      /* sent d1 failed */
+        a_ms5837_event(handle, MS5837_EVENT_READ_ADC_FAILED, 0,
+                       "ms5837: read adc failed.\n");                                          /* read adc failed */
         
         return 1;                                                                              /* return error */
     }
-    if (handle->press_osr == MS5837_OSR_256)                                                   /* osr 256 */
-    {
-        handle->delay_ms(1);                                                                   /* delay 1ms */
-    }
-    else if (handle->press_osr == MS5837_OSR_512)                                              /* osr 512 */
+    a_ms5837_calculate_temperature(handle, *temperature_raw, temperature_c);                   /* calculate temperature and pressure */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     start the temperature conversion
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start temperature convert failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      read the result by ms5837_read_adc after the conversion time,
+ *            a staged configuration is applied first, so get the osr after the start
+ */
+uint8_t ms5837_start_temperature_convert(ms5837_handle_t *handle)
+{
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->delay_ms(2);                                                                   /* delay 2ms */
+        return 2;                                                                              /* return error */
     }
-    else if (handle->press_osr == MS5837_OSR_1024)                                             /* osr 1024 */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->delay_ms(3);                                                                   /* delay 3ms */
+        return 3;                                                                              /* return error */
     }
-    else if (handle->press_osr == MS5837_OSR_2048)                                             /* osr 2048 */
+    
+    a_ms5837_apply_config(handle);                                                             /* apply the staged configuration */
+    if (a_ms5837_convert(handle, MS5837_CMD_D2, handle->temp_osr) != 0)                        /* sent d2 */
     {
-        handle->delay_ms(5);                                                                   /* delay 5ms */
+        a_ms5837_event(handle, MS5837_EVENT_SENT_D2_FAILED, handle->temp_osr,
+                       "ms5837: sent d2 failed.\n");                                           /* sent d2 failed */
+        
+        return 1;                                                                              /* return error */
     }
-    else if (handle->press_osr == MS5837_OSR_4096)                                             /* osr 4096 */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     start the pressure conversion
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start pressure convert failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      read the result by ms5837_read_adc after the conversion time
+ */
+uint8_t ms5837_start_pressure_convert(ms5837_handle_t *handle)
+{
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->delay_ms(9);                                                                   /* delay 9ms */
+        return 2;                                                                              /* return error */
     }
-    else                                                                                       /* osr 8192 */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->delay_ms(18);                                                                  /* delay 18ms */
+        return 3;                                                                              /* return error */
     }
-    if (a_ms5837_iic_read(handle, MS5837_CMD_ADC_READ, buf, 3) != 0)                           /* read adc */
+    
+    if (a_ms5837_convert(handle, MS5837_CMD_D1, handle->press_osr) != 0)                       /* sent d1 */
     {
-        handle->debug_print("ms5837: read adc failed.\n");                                     /* read adc failed */
+        a_ms5837_event(handle, MS5837_EVENT_SENT_D1_FAILED, handle->press_osr,
+                       "ms5837: sent d1 failed.\n");                                           /* sent d1 failed */
         
         return 1;                                                                              /* return error */
     }
-    *pressure_raw = (((uint32_t)buf[0]) << 16) | (((uint32_t)buf[1]) << 8) | buf[2];           /* set the temperature raw */
-    a_ms5837_calculate_temperature_pressure(handle, temperature_raw, &temperature_c, 
-                                            *pressure_raw, pressure_mbar);                     /* calculate temperature and pressure */
     
     return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      read the temperature
+ * @brief      read the adc result of the last conversion
  * @param[in]  *handle pointer to an ms5837 handle structure
- * @param[out] *temperature_raw pointer to a raw temperature buffer
- * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *raw pointer to a raw data buffer
  * @return     status code
  *             - 0 success
- *             - 1 read temperature failed
+ *             - 1 read adc failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       the chip returns 0 if the conversion is not finished, it is reported as a read failure with raw 0
  */
-uint8_t ms5837_read_temperature(ms5837_handle_t *handle, uint32_t *temperature_raw, float *temperature_c)
+uint8_t ms5837_read_adc(ms5837_handle_t *handle, uint32_t *raw)
 {
-    uint8_t buf[3];
-    
     if (handle == NULL)                                                                        /* check handle */
     {
         return 2;                                                                              /* return error */
@@ -854,44 +1318,105 @@ uint8_t ms5837_read_temperature(ms5837_handle_t *handle, uint32_t *temperature_r
         return 3;                                                                              /* return error */
     }
     
-    if (a_ms5837_iic_write(handle, MS5837_CMD_D2 + handle->temp_osr, NULL, 0) != 0)            /* sent d2 */
+    if (a_ms5837_read_raw(handle, raw) != 0)                                                   /* read adc */
     {
-        handle->debug_print("ms5837: sent d2 failed.\n");                                      /* sent d2 failed */
+        a_ms5837_event(handle, MS5837_EVENT_READ_ADC_FAILED, 0,
+                       "ms5837: read adc failed.\n");                                          /* read adc failed */
         
         return 1;                                                                              /* return error */
     }
-    if (handle->temp_osr == MS5837_OSR_256)                                                    /* osr 256 */
-    {
-        handle->delay_ms(1);                                                                   /* delay 1ms */
-    }
-    else if (handle->temp_osr == MS5837_OSR_512)                                               /* osr 512 */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the max conversion time of the osr
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  osr adc osr
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 osr is invalid
+ * @note       none
+ */
+uint8_t ms5837_get_convert_time(ms5837_handle_t *handle, ms5837_osr_t osr, uint32_t *us)
+{
+    if (handle == NULL)                                     /* check handle */
     {
-        handle->delay_ms(2);                                                                   /* delay 2ms */
+        return 2;                                           /* return error */
     }
-    else if (handle->temp_osr == MS5837_OSR_1024)                                              /* osr 1024 */
+    if ((uint32_t)(osr) > MS5837_OSR_8192)                  /* check the osr */
     {
-        handle->delay_ms(3);                                                                   /* delay 3ms */
+        handle->debug_print("ms5837: osr is invalid.\n");   /* osr is invalid */
+        
+        return 4;                                           /* return error */
     }
-    else if (handle->temp_osr == MS5837_OSR_2048)                                              /* osr 2048 */
+    
+    *us = gs_convert_time_us[osr];                          /* get the time */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      calculate the temperature and pressure from the raw data
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  temperature_raw raw temperature data
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[in]  pressure_raw raw pressure data
+ * @param[out] *pressure_mbar pointer to a converted pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ms5837_calculate_temperature_pressure(ms5837_handle_t *handle, uint32_t temperature_raw, float *temperature_c,
+                                              uint32_t pressure_raw, float *pressure_mbar)
+{
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->delay_ms(5);                                                                   /* delay 5ms */
+        return 2;                                                                              /* return error */
     }
-    else if (handle->temp_osr == MS5837_OSR_4096)                                              /* osr 4096 */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->delay_ms(9);                                                                   /* delay 9ms */
+        return 3;                                                                              /* return error */
     }
-    else                                                                                       /* osr 8192 */
+    
+    a_ms5837_calculate_temperature_pressure(handle, temperature_raw, temperature_c,
+                                            pressure_raw, pressure_mbar);                      /* calculate temperature and pressure */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      compensate the raw data in integers
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  temperature_raw raw temperature data
+ * @param[out] *temperature pointer to a temperature buffer in 0.01C
+ * @param[in]  pressure_raw raw pressure data
+ * @param[out] *pressure pointer to a pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the pressure is in 0.01mbar for 02ba01 and 02ba21 and in 0.1mbar for 30ba26,
+ *             ms5837_calculate_temperature_pressure returns the same values as floats,
+ *             the results include the correction set by ms5837_set_correction
+ */
+uint8_t ms5837_compensate(ms5837_handle_t *handle, uint32_t temperature_raw, int32_t *temperature,
+                          uint32_t pressure_raw, int32_t *pressure)
+{
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->delay_ms(18);                                                                  /* delay 18ms */
+        return 2;                                                                              /* return error */
     }
-    if (a_ms5837_iic_read(handle, MS5837_CMD_ADC_READ, buf, 3) != 0)                           /* read adc */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->debug_print("ms5837: read adc failed.\n");                                     /* read adc failed */
-        
-        return 1;                                                                              /* return error */
+        return 3;                                                                              /* return error */
     }
-    *temperature_raw = (((uint32_t)buf[0]) << 16) | (((uint32_t)buf[1]) << 8) | buf[2];        /* set the temperature raw */
-    a_ms5837_calculate_temperature(handle, *temperature_raw, temperature_c);                   /* calculate temperature and pressure */
+    
+    a_ms5837_compensate(handle, temperature_raw, temperature, pressure_raw, pressure);         /* compensate in integers */
     
     return 0;                                                                                  /* success return 0 */
 }
@@ -916,10 +1441,11 @@ uint8_t ms5837_reset(ms5837_handle_t *handle)
     {
         return 3;                                                          /* return error */
     } 
-
+    
     if (a_ms5837_iic_write(handle, MS5837_CMD_RESET, NULL, 0) != 0)        /* reset the device */
     {
-        handle->debug_print("ms5837: reset failed.\n");                    /* reset failed */
+        a_ms5837_event(handle, MS5837_EVENT_RESET_FAILED, 0,
+                       "ms5837: reset failed.\n");                         /* reset failed */
         
         return 1;                                                          /* return error */
     }
@@ -928,6 +1454,294 @@ uint8_t ms5837_reset(ms5837_handle_t *handle)
     return 0;                                                              /* success return 0 */
 }
 
+/**
+ * @brief     set the retry policy of the iic transactions
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] times max retry times of a transaction, 0 disables the retry
+ * @param[in] budget_us time budget of a transaction including the retries, 0 means no limit
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it can be set before ms5837_init, the budget needs the timestamp_us function,
+ *            a failed transaction is only retried, the bus is recovered by ms5837_resync
+ */
+uint8_t ms5837_set_retry(ms5837_handle_t *handle, uint8_t times, uint32_t budget_us)
+{
+    if (handle == NULL)                         /* check handle */
+    {
+        return 2;                               /* return error */
+    }
+    
+    handle->retry_times = times;                /* set the times */
+    handle->retry_budget_us = budget_us;        /* set the budget */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the retry policy of the iic transactions
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @param[out] *budget_us pointer to a time budget buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ms5837_get_retry(ms5837_handle_t *handle, uint8_t *times, uint32_t *budget_us)
+{
+    if (handle == NULL)                         /* check handle */
+    {
+        return 2;                               /* return error */
+    }
+    
+    *times = handle->retry_times;               /* get the times */
+    *budget_us = handle->retry_budget_us;       /* get the budget */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief     resynchronize the device after a bus error
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 resync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 prom changed
+ * @note      it recovers the bus, resets the device and checks the first prom word,
+ *            the calibration read by ms5837_init is kept so it only takes about 3ms
+ */
+uint8_t ms5837_resync(ms5837_handle_t *handle)
+{
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    if (handle->bus_recover != NULL)                                                    /* check the bus recover */
+    {
+        if (handle->bus_recover() != 0)                                                 /* recover the bus */
+        {
+            a_ms5837_event(handle, MS5837_EVENT_BUS_RECOVER_FAILED, 0,
+                           "ms5837: bus recover failed.\n");                            /* bus recover failed */
+            
+            return 1;                                                                   /* return error */
+        }
+    }
+    if (a_ms5837_iic_write(handle, MS5837_CMD_RESET, NULL, 0) != 0)                     /* reset the device */
+    {
+        a_ms5837_event(handle, MS5837_EVENT_RESET_FAILED, 0,
+                       "ms5837: reset failed.\n");                                      /* reset failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    handle->delay_ms(3);                                                                /* wait the prom reload */
+    if (a_ms5837_iic_read(handle, MS5837_CMD_PROM_READ, buf, 2) != 0)                   /* read the first prom word */
+    {
+        a_ms5837_event(handle, MS5837_EVENT_READ_PROM_FAILED, 0,
+                       "ms5837: read prom failed.\n");                                  /* read prom failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    if ((buf[0] != handle->prom[0]) || (buf[1] != handle->prom[1]))                     /* check the prom */
+    {
+        a_ms5837_event(handle, MS5837_EVENT_PROM_CHANGED, ((uint32_t)(buf[0]) << 8) | buf[1],
+                       "ms5837: prom changed.\n");                                      /* prom changed */
+        
+        return 4;                                                                       /* return error */
+    }
+#if (MS5837_INSTRUMENT == 1)
+    handle->convert_pending = 0;                                                        /* the conversion is lost */
+    handle->sample_pending = 0;                                                         /* the sample is lost */
+#endif
+    a_ms5837_event(handle, MS5837_EVENT_RESYNC, 0, NULL);                               /* trace the resync */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the user correction of the compensated results
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] *correction pointer to a correction structure, NULL to remove the correction
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 correction is invalid
+ * @note      the temperature gets the offset, then the pressure becomes
+ *            (pressure + pressure_offset) * pressure_gain / 65536 plus the table value at the temperature,
+ *            the table is interpolated linearly and held at its first and last points,
+ *            the correction is used by reference and swapped with one pointer store so it can be set beside the acquisition,
+ *            fill another structure to change it and reuse the old one after the next sample
+ */
+uint8_t ms5837_set_correction(ms5837_handle_t *handle, const ms5837_correction_t *correction)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (correction != NULL)                                                             /* check the correction */
+    {
+        if ((correction->pressure_gain <= 0) ||
+            (correction->table_num > MS5837_CORRECTION_POINTS))                         /* check the gain and the points */
+        {
+            return 4;                                                                   /* return error */
+        }
+        if ((correction->table_num > 1) && (correction->table_step <= 0))               /* check the step */
+        {
+            return 4;                                                                   /* return error */
+        }
+    }
+    
+    MS5837_BARRIER();                                                                   /* publish the table first */
+    handle->correction = correction;                                                    /* swap the correction */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the user correction of the compensated results
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] **correction pointer to a correction pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       it gets NULL without a correction
+ */
+uint8_t ms5837_get_correction(ms5837_handle_t *handle, const ms5837_correction_t **correction)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    *correction = handle->correction;                                                   /* get the correction */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief         apply the user correction to compensated results
+ * @param[in]     *handle pointer to an ms5837 handle structure
+ * @param[in,out] *temperature pointer to a temperature buffer in 0.01C
+ * @param[in,out] *pressure pointer to a pressure buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle, temperature or pressure is NULL
+ * @note          it leaves the results unchanged without a correction,
+ *                the c++ wrappers use it after their own compensation
+ */
+uint8_t ms5837_correct(ms5837_handle_t *handle, int32_t *temperature, int32_t *pressure)
+{
+    const ms5837_correction_t *correction;
+    
+    if ((handle == NULL) || (temperature == NULL) || (pressure == NULL))                /* check the pointers */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    correction = handle->correction;                                                    /* get the correction once */
+    if (correction != NULL)                                                             /* with a correction */
+    {
+        a_ms5837_correct(correction, temperature, pressure);                            /* correct the results */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      stage a configuration for the next conversion boundary
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  *config pointer to a configuration structure
+ * @param[out] *ticket pointer to a ticket buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or config is NULL
+ *             - 3 handle is not initialized
+ *             - 4 config is invalid
+ * @note       the type and both osr are applied together by the thread that starts the next temperature conversion,
+ *             a sample in progress keeps its settings and a later staging replaces a pending one,
+ *             it can run beside the acquisition from one controlling thread, ms5837_init drops a pending staging,
+ *             the applied ticket is reported by ms5837_get_config_ticket and by an MS5837_EVENT_CONFIG event,
+ *             don't use it on a handle linked to an ms5837::sensor, its reads refuse a staged configuration
+ */
+uint8_t ms5837_stage_config(ms5837_handle_t *handle, const ms5837_config_t *config, uint32_t *ticket)
+{
+    uint32_t seq;
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if (config == NULL)                                                                 /* check config */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if ((config->type > MS5837_TYPE_30BA26) ||
+        (config->temperature_osr > MS5837_OSR_8192) ||
+        (config->pressure_osr > MS5837_OSR_8192))                                       /* check the config */
+    {
+        handle->debug_print("ms5837: config is invalid.\n");                            /* config is invalid */
+        
+        return 4;                                                                       /* return error */
+    }
+    if ((config->type == MS5837_TYPE_30BA26) &&
+        ((config->temperature_osr == MS5837_OSR_8192) ||
+         (config->pressure_osr == MS5837_OSR_8192)))                                    /* check the osr */
+    {
+        handle->debug_print("ms5837: 30ba26 can't support osr 8192.\n");                /* 30ba26 can't support osr 8192 */
+        
+        return 4;                                                                       /* return error */
+    }
+    
+    seq = handle->stage_seq;                                                            /* get the sequence */
+    handle->stage_seq = seq + 1;                                                        /* mark staging */
+    MS5837_BARRIER();                                                                   /* order the updates */
+    handle->staged = *config;                                                           /* copy the configuration */
+    MS5837_BARRIER();                                                                   /* order the updates */
+    handle->stage_seq = seq + 2;                                                        /* mark staged */
+    *ticket = seq + 2;                                                                  /* set the ticket */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the ticket of the applied configuration
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *ticket pointer to a ticket buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a staged configuration is in effect when (int32_t)(applied - staged) >= 0
+ */
+uint8_t ms5837_get_config_ticket(ms5837_handle_t *handle, uint32_t *ticket)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    *ticket = handle->applied_seq;                                                      /* get the ticket */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
 /**
  * @brief     set the chip register
  * @param[in] *handle pointer to an ms5837 handle structure
@@ -961,7 +1775,7 @@ uint8_t ms5837_set_reg(ms5837_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
         
         return 1;                                                       /* return error */
     }
-
+    
     return 0;                                                           /* success return 0 */
 }
 
@@ -998,10 +1812,78 @@ uint8_t ms5837_get_reg(ms5837_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
         
         return 1;                                                      /* return error */
     }
-
+    
     return 0;                                                          /* success return 0 */
 }
 
+#if (MS5837_INSTRUMENT == 1)
+/**
+ * @brief      get a consistent copy of the instrument
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *instrument pointer to an instrument buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 instrument is busy
+ * @note       it can run beside the acquisition and retries while an update is in progress
+ */
+uint8_t ms5837_get_instrument(ms5837_handle_t *handle, ms5837_instrument_t *instrument)
+{
+    uint8_t i;
+    uint32_t seq;
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    for (i = 0; i < 16; i++)                                                            /* retry 16 times */
+    {
+        seq = handle->instrument.seq;                                                   /* get the sequence */
+        if ((seq & 1) != 0)                                                             /* updating */
+        {
+            continue;                                                                   /* retry */
+        }
+        MS5837_BARRIER();                                                               /* order the reads */
+        memcpy(instrument, &handle->instrument, sizeof(ms5837_instrument_t));           /* copy the instrument */
+        MS5837_BARRIER();                                                               /* order the reads */
+        if (handle->instrument.seq == seq)                                              /* not changed */
+        {
+            return 0;                                                                   /* success return 0 */
+        }
+    }
+    handle->debug_print("ms5837: instrument is busy.\n");                               /* instrument is busy */
+    
+    return 4;                                                                           /* return error */
+}
+
+/**
+ * @brief     clear the instrument
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t ms5837_clear_instrument(ms5837_handle_t *handle)
+{
+    uint32_t seq;
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    a_ms5837_instrument_begin(handle);                                                  /* begin */
+    seq = handle->instrument.seq;                                                       /* save the sequence */
+    memset(&handle->instrument, 0, sizeof(ms5837_instrument_t));                        /* clear the instrument */
+    handle->instrument.seq = seq;                                                       /* restore the sequence */
+    a_ms5837_instrument_end(handle);                                                    /* end */
+    
+    return 0;                                                                           /* success return 0 */
+}
+#endif
+
 /**
  * @brief      get chip's information
  * @param[out] *info pointer to an ms5837 info structure
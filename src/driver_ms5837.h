@@ -79,6 +79,102 @@ typedef enum
     MS5837_OSR_8192 = 0x05,        /**< max 18.08ms */
 } ms5837_osr_t;
 
+/**
+ * @brief ms5837 event enumeration definition
+ */
+typedef enum
+{
+    MS5837_EVENT_CONVERT            = 0x01,        /**< conversion started, arg is the command */
+    MS5837_EVENT_ADC                = 0x02,        /**< adc read, arg is the raw data */
+    MS5837_EVENT_RETRY              = 0x03,        /**< iic transaction retried, arg is the register */
+    MS5837_EVENT_RESYNC             = 0x04,        /**< device resynchronized */
+    MS5837_EVENT_CONFIG             = 0x05,        /**< staged configuration applied, arg is the ticket */
+    MS5837_EVENT_SENT_D1_FAILED     = 0x10,        /**< sent d1 failed, arg is the osr */
+    MS5837_EVENT_SENT_D2_FAILED     = 0x11,        /**< sent d2 failed, arg is the osr */
+    MS5837_EVENT_READ_ADC_FAILED    = 0x12,        /**< read adc failed */
+    MS5837_EVENT_RESET_FAILED       = 0x13,        /**< reset failed */
+    MS5837_EVENT_READ_PROM_FAILED   = 0x14,        /**< read prom failed */
+    MS5837_EVENT_PROM_CHANGED       = 0x15,        /**< prom changed, arg is the read word */
+    MS5837_EVENT_BUS_RECOVER_FAILED = 0x16,        /**< bus recover failed */
+} ms5837_event_t;
+
+/**
+ * @brief ms5837 memory barrier definition
+ * @note  the driver and its modules share it to order a sequence number and the data it guards,
+ *        define MS5837_BARRIER to port it to a compiler without the gcc builtins
+ */
+#ifndef MS5837_BARRIER
+    #if defined(__GNUC__)
+        #define MS5837_BARRIER()        __sync_synchronize()        /**< full memory barrier */
+    #else
+        #define MS5837_BARRIER()                                    /**< no barrier */
+    #endif
+#endif
+
+/**
+ * @brief ms5837 instrument definition
+ * @note  define MS5837_INSTRUMENT as 1 to build the counters and histograms into the handle
+ */
+#ifndef MS5837_INSTRUMENT
+    #define MS5837_INSTRUMENT        0        /**< instrument disabled */
+#endif
+
+/**
+ * @brief ms5837 instrument histogram bucket number definition
+ * @note  bucket 0 counts 0us and bucket n counts [2^(n-1), 2^n)us, the last one also counts the longer times
+ */
+#define MS5837_INSTRUMENT_BUCKET        24        /**< 24 buckets */
+
+#if (MS5837_INSTRUMENT == 1)
+/**
+ * @brief ms5837 instrument structure definition
+ */
+typedef struct ms5837_instrument_s
+{
+    uint32_t convert[6];                                         /**< conversions of each osr */
+    uint32_t iic_read;                                           /**< iic read transactions */
+    uint32_t iic_write;                                          /**< iic write transactions */
+    uint32_t tx_bytes;                                           /**< sent bytes including the command byte */
+    uint32_t rx_bytes;                                           /**< received bytes */
+    uint32_t failures;                                           /**< failed iic transactions */
+    uint32_t retries;                                            /**< retried iic transactions */
+    uint32_t bus_latency[MS5837_INSTRUMENT_BUCKET];              /**< iic transaction latency histogram */
+    uint32_t convert_overshoot[MS5837_INSTRUMENT_BUCKET];        /**< wait beyond the max conversion time histogram */
+    uint32_t sample_latency[MS5837_INSTRUMENT_BUCKET];           /**< d2 command to compensated result histogram */
+    volatile uint32_t seq;                                       /**< update sequence, odd while updating */
+} ms5837_instrument_t;
+#endif
+
+/**
+ * @brief ms5837 configuration structure definition
+ */
+typedef struct ms5837_config_s
+{
+    ms5837_type_t type;                   /**< chip type */
+    ms5837_osr_t temperature_osr;         /**< temperature osr */
+    ms5837_osr_t pressure_osr;            /**< pressure osr */
+} ms5837_config_t;
+
+/**
+ * @brief ms5837 correction table point number definition
+ */
+#define MS5837_CORRECTION_POINTS        16        /**< 16 points */
+
+/**
+ * @brief ms5837 correction structure definition
+ * @note  the pressure is in the unit of ms5837_compensate, 0.01mbar for 02ba01 and 02ba21 and 0.1mbar for 30ba26
+ */
+typedef struct ms5837_correction_s
+{
+    int32_t temperature_offset;                        /**< temperature offset in 0.01C */
+    int32_t pressure_offset;                           /**< pressure offset */
+    int32_t pressure_gain;                             /**< pressure gain in 1/65536, 65536 is 1.0 */
+    int32_t table_start;                               /**< temperature of the first table point in 0.01C */
+    int32_t table_step;                                /**< temperature step of the table points in 0.01C */
+    uint8_t table_num;                                 /**< table point number in [0, MS5837_CORRECTION_POINTS] */
+    int32_t table[MS5837_CORRECTION_POINTS];           /**< pressure correction of each table point */
+} ms5837_correction_t;
+
 /**
  * @brief ms5837 handle structure definition
  */
@@ -90,12 +186,29 @@ typedef struct ms5837_handle_s
     uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
+    uint32_t (*timestamp_us)(void);                                                     /**< point to a timestamp_us function address */
+    void (*event)(uint16_t id, uint32_t arg);                                           /**< point to an event function address */
+    uint8_t (*bus_recover)(void);                                                       /**< point to a bus_recover function address */
     uint8_t prom[16];                                                                   /**< prom */
     uint16_t c[6];                                                                      /**< c1 - c6 */
     uint8_t temp_osr;                                                                   /**< temperature osr */
     uint8_t press_osr;                                                                  /**< pressure osr */
     uint8_t type;                                                                       /**< type */
     uint8_t inited;                                                                     /**< inited flag */
+    uint8_t retry_times;                                                                /**< retry times of an iic transaction */
+    uint32_t retry_budget_us;                                                           /**< time budget of an iic transaction */
+    const ms5837_correction_t *volatile correction;                                     /**< user correction, NULL for none */
+    ms5837_config_t staged;                                                             /**< staged configuration */
+    volatile uint32_t stage_seq;                                                        /**< staged sequence, odd while staging */
+    volatile uint32_t applied_seq;                                                      /**< sequence of the applied configuration */
+#if (MS5837_INSTRUMENT == 1)
+    ms5837_instrument_t instrument;                                                     /**< instrument */
+    uint32_t convert_start;                                                             /**< last conversion command time */
+    uint32_t sample_start;                                                              /**< last d2 command time */
+    uint8_t convert_osr;                                                                /**< last conversion osr */
+    uint8_t convert_pending;                                                            /**< conversion started flag */
+    uint8_t sample_pending;                                                             /**< sample started flag */
+#endif
 } ms5837_handle_t;
 
 /**
@@ -181,6 +294,32 @@ typedef struct ms5837_info_s
  */
 #define DRIVER_MS5837_LINK_DEBUG_PRINT(HANDLE, FUC)          (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to an ms5837 handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      optional, the latency histograms are skipped when it is not linked
+ */
+#define DRIVER_MS5837_LINK_TIMESTAMP_US(HANDLE, FUC)         (HANDLE)->timestamp_us = FUC
+
+/**
+ * @brief     link event function
+ * @param[in] HANDLE pointer to an ms5837 handle structure
+ * @param[in] FUC pointer to an event function address
+ * @note      optional, when it is linked the acquisition reports ms5837_event_t ids to it
+ *            instead of formatting messages with debug_print
+ */
+#define DRIVER_MS5837_LINK_EVENT(HANDLE, FUC)                (HANDLE)->event = FUC
+
+/**
+ * @brief     link bus_recover function
+ * @param[in] HANDLE pointer to an ms5837 handle structure
+ * @param[in] FUC pointer to a bus_recover function address
+ * @note      optional, it is only called by ms5837_resync before the device reset,
+ *            the transfer retries don't call it
+ */
+#define DRIVER_MS5837_LINK_BUS_RECOVER(HANDLE, FUC)          (HANDLE)->bus_recover = FUC
+
 /**
  * @}
  */
@@ -276,6 +415,91 @@ uint8_t ms5837_read_pressure(ms5837_handle_t *handle, uint32_t *pressure_raw, fl
  */
 uint8_t ms5837_read_temperature(ms5837_handle_t *handle, uint32_t *temperature_raw, float *temperature_c);
 
+/**
+ * @brief     start the temperature conversion
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start temperature convert failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      read the result by ms5837_read_adc after the conversion time,
+ *            a staged configuration is applied first, so get the osr after the start
+ */
+uint8_t ms5837_start_temperature_convert(ms5837_handle_t *handle);
+
+/**
+ * @brief     start the pressure conversion
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start pressure convert failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      read the result by ms5837_read_adc after the conversion time
+ */
+uint8_t ms5837_start_pressure_convert(ms5837_handle_t *handle);
+
+/**
+ * @brief      read the adc result of the last conversion
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *raw pointer to a raw data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read adc failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the chip returns 0 if the conversion is not finished, it is reported as a read failure with raw 0
+ */
+uint8_t ms5837_read_adc(ms5837_handle_t *handle, uint32_t *raw);
+
+/**
+ * @brief      get the max conversion time of the osr
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  osr adc osr
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 osr is invalid
+ * @note       none
+ */
+uint8_t ms5837_get_convert_time(ms5837_handle_t *handle, ms5837_osr_t osr, uint32_t *us);
+
+/**
+ * @brief      calculate the temperature and pressure from the raw data
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  temperature_raw raw temperature data
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[in]  pressure_raw raw pressure data
+ * @param[out] *pressure_mbar pointer to a converted pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ms5837_calculate_temperature_pressure(ms5837_handle_t *handle, uint32_t temperature_raw, float *temperature_c,
+                                              uint32_t pressure_raw, float *pressure_mbar);
+
+/**
+ * @brief      compensate the raw data in integers
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  temperature_raw raw temperature data
+ * @param[out] *temperature pointer to a temperature buffer in 0.01C
+ * @param[in]  pressure_raw raw pressure data
+ * @param[out] *pressure pointer to a pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the pressure is in 0.01mbar for 02ba01 and 02ba21 and in 0.1mbar for 30ba26,
+ *             ms5837_calculate_temperature_pressure returns the same values as floats,
+ *             the results include the correction set by ms5837_set_correction
+ */
+uint8_t ms5837_compensate(ms5837_handle_t *handle, uint32_t temperature_raw, int32_t *temperature,
+                          uint32_t pressure_raw, int32_t *pressure);
+
 /**
  * @brief     set the device type
  * @param[in] *handle pointer to an ms5837 handle structure
@@ -284,7 +508,7 @@ uint8_t ms5837_read_temperature(ms5837_handle_t *handle, uint32_t *temperature_r
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      it is applied at once, use ms5837_stage_config beside a running acquisition
  */
 uint8_t ms5837_set_type(ms5837_handle_t *handle, ms5837_type_t type);
 
@@ -309,7 +533,7 @@ uint8_t ms5837_get_type(ms5837_handle_t *handle, ms5837_type_t *type);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 30ba26 can't support osr 8192
- * @note      none
+ * @note      it is applied at once, use ms5837_stage_config beside a running acquisition
  */
 uint8_t ms5837_set_temperature_osr(ms5837_handle_t *handle, ms5837_osr_t osr);
 
@@ -334,7 +558,7 @@ uint8_t ms5837_get_temperature_osr(ms5837_handle_t *handle, ms5837_osr_t *osr);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 30ba26 can't support osr 8192
- * @note      none
+ * @note      it is applied at once, use ms5837_stage_config beside a running acquisition
  */
 uint8_t ms5837_set_pressure_osr(ms5837_handle_t *handle, ms5837_osr_t osr);
 
@@ -362,6 +586,115 @@ uint8_t ms5837_get_pressure_osr(ms5837_handle_t *handle, ms5837_osr_t *osr);
  */
 uint8_t ms5837_reset(ms5837_handle_t *handle);
 
+/**
+ * @brief     set the retry policy of the iic transactions
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] times max retry times of a transaction, 0 disables the retry
+ * @param[in] budget_us time budget of a transaction including the retries, 0 means no limit
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it can be set before ms5837_init, the budget needs the timestamp_us function,
+ *            a failed transaction is only retried, the bus is recovered by ms5837_resync
+ */
+uint8_t ms5837_set_retry(ms5837_handle_t *handle, uint8_t times, uint32_t budget_us);
+
+/**
+ * @brief      get the retry policy of the iic transactions
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @param[out] *budget_us pointer to a time budget buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ms5837_get_retry(ms5837_handle_t *handle, uint8_t *times, uint32_t *budget_us);
+
+/**
+ * @brief     resynchronize the device after a bus error
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 resync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 prom changed
+ * @note      it recovers the bus, resets the device and checks the first prom word,
+ *            the calibration read by ms5837_init is kept so it only takes about 3ms
+ */
+uint8_t ms5837_resync(ms5837_handle_t *handle);
+
+/**
+ * @brief     set the user correction of the compensated results
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] *correction pointer to a correction structure, NULL to remove the correction
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 correction is invalid
+ * @note      the temperature gets the offset, then the pressure becomes
+ *            (pressure + pressure_offset) * pressure_gain / 65536 plus the table value at the temperature,
+ *            the table is interpolated linearly and held at its first and last points,
+ *            the correction is used by reference and swapped with one pointer store so it can be set beside the acquisition,
+ *            fill another structure to change it and reuse the old one after the next sample
+ */
+uint8_t ms5837_set_correction(ms5837_handle_t *handle, const ms5837_correction_t *correction);
+
+/**
+ * @brief      get the user correction of the compensated results
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] **correction pointer to a correction pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       it gets NULL without a correction
+ */
+uint8_t ms5837_get_correction(ms5837_handle_t *handle, const ms5837_correction_t **correction);
+
+/**
+ * @brief         apply the user correction to compensated results
+ * @param[in]     *handle pointer to an ms5837 handle structure
+ * @param[in,out] *temperature pointer to a temperature buffer in 0.01C
+ * @param[in,out] *pressure pointer to a pressure buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle, temperature or pressure is NULL
+ * @note          it leaves the results unchanged without a correction,
+ *                the c++ wrappers use it after their own compensation
+ */
+uint8_t ms5837_correct(ms5837_handle_t *handle, int32_t *temperature, int32_t *pressure);
+
+/**
+ * @brief      stage a configuration for the next conversion boundary
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[in]  *config pointer to a configuration structure
+ * @param[out] *ticket pointer to a ticket buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or config is NULL
+ *             - 3 handle is not initialized
+ *             - 4 config is invalid
+ * @note       the type and both osr are applied together by the thread that starts the next temperature conversion,
+ *             a sample in progress keeps its settings and a later staging replaces a pending one,
+ *             it can run beside the acquisition from one controlling thread, ms5837_init drops a pending staging,
+ *             the applied ticket is reported by ms5837_get_config_ticket and by an MS5837_EVENT_CONFIG event,
+ *             don't use it on a handle linked to an ms5837::sensor, its reads refuse a staged configuration
+ */
+uint8_t ms5837_stage_config(ms5837_handle_t *handle, const ms5837_config_t *config, uint32_t *ticket);
+
+/**
+ * @brief      get the ticket of the applied configuration
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *ticket pointer to a ticket buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a staged configuration is in effect when (int32_t)(applied - staged) >= 0
+ */
+uint8_t ms5837_get_config_ticket(ms5837_handle_t *handle, uint32_t *ticket);
+
 /**
  * @}
  */
@@ -403,6 +736,30 @@ uint8_t ms5837_set_reg(ms5837_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ms5837_get_reg(ms5837_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len);
 
+#if (MS5837_INSTRUMENT == 1)
+/**
+ * @brief      get a consistent copy of the instrument
+ * @param[in]  *handle pointer to an ms5837 handle structure
+ * @param[out] *instrument pointer to an instrument buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 instrument is busy
+ * @note       it can run beside the acquisition and retries while an update is in progress
+ */
+uint8_t ms5837_get_instrument(ms5837_handle_t *handle, ms5837_instrument_t *instrument);
+
+/**
+ * @brief     clear the instrument
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t ms5837_clear_instrument(ms5837_handle_t *handle);
+#endif
+
 /**
  * @}
  */
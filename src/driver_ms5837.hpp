@@ -0,0 +1,325 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837.hpp
+ * @brief     driver ms5837 c++ header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_HPP
+#define DRIVER_MS5837_HPP
+
+#include "driver_ms5837.h"
+
+#include <cstdint>
+
+/**
+ * @defgroup ms5837_cpp_driver ms5837 c++ driver function
+ * @brief    ms5837 c++ driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+namespace ms5837
+{
+
+/**
+ * @brief max conversion time table in us, indexed by the osr
+ */
+inline constexpr uint32_t convert_time_us[6] = {600, 1170, 2280, 4540, 9040, 18080};
+
+/**
+ * @brief blocking conversion delay table in ms, indexed by the osr
+ */
+inline constexpr uint32_t convert_delay_ms[6] = {1, 2, 3, 5, 10, 19};
+
+/**
+ * @brief     check an osr
+ * @param[in] osr adc osr
+ * @return    true if the osr is valid
+ * @note      none
+ */
+constexpr bool osr_is_valid(ms5837_osr_t osr) noexcept
+{
+    return (static_cast<uint32_t>(osr) <= static_cast<uint32_t>(MS5837_OSR_8192));
+}
+
+/**
+ * @brief     check a type and osr combination
+ * @param[in] type chip type
+ * @param[in] osr adc osr
+ * @return    true if the chip supports the osr
+ * @note      30ba26 can't support osr 8192
+ */
+constexpr bool osr_is_supported(ms5837_type_t type, ms5837_osr_t osr) noexcept
+{
+    return osr_is_valid(osr) && !((type == MS5837_TYPE_30BA26) && (osr == MS5837_OSR_8192));
+}
+
+/**
+ * @brief ms5837 compensation constant structure definition
+ * @note  the first order sens and off are c1 * sens_mul + c3 * dt / sens_div and c2 * off_mul + c4 * dt / off_div
+ */
+template <ms5837_type_t Type>
+struct type_traits
+{
+    static constexpr bool is_30ba = (Type == MS5837_TYPE_30BA26);        /**< 30ba26 flag */
+    static constexpr int64_t sens_mul = is_30ba ? 32768 : 65536;         /**< c1 multiplier */
+    static constexpr int64_t sens_div = is_30ba ? 256 : 128;             /**< c3 * dt divider */
+    static constexpr int64_t off_mul = is_30ba ? 65536 : 131072;         /**< c2 multiplier */
+    static constexpr int64_t off_div = is_30ba ? 128 : 64;               /**< c4 * dt divider */
+    static constexpr int64_t p_div = is_30ba ? 8192 : 32768;             /**< pressure divider */
+    static constexpr int32_t p_per_mbar = is_30ba ? 10 : 100;            /**< pressure counts per mbar */
+};
+
+/**
+ * @brief ms5837 sample structure definition
+ */
+struct sample
+{
+    uint32_t temperature_raw;        /**< raw temperature */
+    uint32_t pressure_raw;           /**< raw pressure */
+    int32_t temperature;             /**< temperature in 0.01C */
+    int32_t pressure;                /**< pressure in p_per_mbar counts */
+    float temperature_c;             /**< temperature in C */
+    float pressure_mbar;             /**< pressure in mbar */
+};
+
+/**
+ * @brief         compensate the raw data
+ * @tparam        Type chip type
+ * @param[in]     c c1 - c6
+ * @param[in,out] s sample with the raw data set
+ * @note          it uses the second order compensation of the datasheet in 64 bits,
+ *                the user correction of a handle is not applied, sensor::compensate adds it
+ */
+template <ms5837_type_t Type>
+constexpr void compensate(const uint16_t (&c)[6], sample &s) noexcept
+{
+    using traits = type_traits<Type>;
+    
+    const int64_t dt = static_cast<int64_t>(static_cast<int32_t>(s.temperature_raw - static_cast<uint32_t>(c[4]) * 256U));
+    const int64_t sens = static_cast<int64_t>(c[0]) * traits::sens_mul + (static_cast<int64_t>(c[2]) * dt) / traits::sens_div;
+    const int64_t off = static_cast<int64_t>(c[1]) * traits::off_mul + (static_cast<int64_t>(c[3]) * dt) / traits::off_div;
+    const int64_t temp = 2000 + dt * static_cast<int64_t>(c[5]) / 8388608;
+    const int64_t t2 = (temp - 2000) * (temp - 2000);
+    int64_t ti = 0;
+    int64_t offi = 0;
+    int64_t sensi = 0;
+    
+    if constexpr (traits::is_30ba)
+    {
+        if ((temp / 100) < 20)
+        {
+            ti = (3 * dt * dt) / 8589934592LL;
+            offi = (3 * t2) / 2;
+            sensi = (5 * t2) / 8;
+            if ((temp / 100) < -15)
+            {
+                offi += 7 * (temp + 1500) * (temp + 1500);
+                sensi += 4 * (temp + 1500) * (temp + 1500);
+            }
+        }
+        else
+        {
+            ti = (2 * dt * dt) / 137438953472LL;
+            offi = t2 / 16;
+        }
+    }
+    else
+    {
+        if ((temp / 100) < 20)
+        {
+            ti = (11 * dt * dt) / 34359738368LL;
+            offi = (31 * t2) / 8;
+            sensi = (63 * t2) / 32;
+        }
+    }
+    s.temperature = static_cast<int32_t>(temp - ti);
+    s.pressure = static_cast<int32_t>(((static_cast<int64_t>(s.pressure_raw) * (sens - sensi)) / 2097152 - (off - offi)) / traits::p_div);
+    s.temperature_c = static_cast<float>(s.temperature) / 100.0f;
+    s.pressure_mbar = static_cast<float>(s.pressure) / static_cast<float>(traits::p_per_mbar);
+}
+
+/**
+ * @brief ms5837 sensor class definition
+ * @note  the bus still goes through the linked handle, the osr and the compensation are fixed at compile time,
+ *        don't use ms5837_stage_config or the set functions on the linked handle, a read refuses a changed handle
+ */
+template <ms5837_type_t Type, ms5837_osr_t TemperatureOsr = MS5837_OSR_4096, ms5837_osr_t PressureOsr = MS5837_OSR_4096>
+class sensor
+{
+    static_assert(osr_is_valid(TemperatureOsr) && osr_is_valid(PressureOsr), "ms5837: osr is invalid");
+    static_assert(osr_is_supported(Type, TemperatureOsr) && osr_is_supported(Type, PressureOsr),
+                  "ms5837: 30ba26 can't support osr 8192");
+    
+    public:
+        static constexpr ms5837_type_t type = Type;                                                      /**< chip type */
+        static constexpr ms5837_osr_t temperature_osr = TemperatureOsr;                                  /**< temperature osr */
+        static constexpr ms5837_osr_t pressure_osr = PressureOsr;                                        /**< pressure osr */
+        static constexpr uint32_t temperature_convert_time_us = convert_time_us[TemperatureOsr];        /**< temperature conversion time */
+        static constexpr uint32_t pressure_convert_time_us = convert_time_us[PressureOsr];              /**< pressure conversion time */
+        static constexpr uint32_t sample_time_us = temperature_convert_time_us + pressure_convert_time_us; /**< sample time */
+        
+        /**
+         * @brief     constructor
+         * @param[in] &handle linked ms5837 handle
+         * @note      none
+         */
+        explicit sensor(ms5837_handle_t &handle) noexcept : m_handle(handle)
+        {
+        }
+        
+        /**
+         * @brief  initialize the chip and apply the type and osr
+         * @return status code
+         *         - 0 success
+         *         - 1 init failed
+         * @note   none
+         */
+        uint8_t init() noexcept
+        {
+            if (ms5837_init(&m_handle) != 0)
+            {
+                return 1;
+            }
+            if ((ms5837_set_type(&m_handle, Type) != 0) ||
+                (ms5837_set_temperature_osr(&m_handle, TemperatureOsr) != 0) ||
+                (ms5837_set_pressure_osr(&m_handle, PressureOsr) != 0))
+            {
+                (void)ms5837_deinit(&m_handle);
+                
+                return 1;
+            }
+            
+            return 0;
+        }
+        
+        /**
+         * @brief  close the chip
+         * @return status code
+         *         - 0 success
+         *         - 1 deinit failed
+         * @note   none
+         */
+        uint8_t deinit() noexcept
+        {
+            return (ms5837_deinit(&m_handle) != 0) ? 1 : 0;
+        }
+        
+        /**
+         * @brief      read the temperature and pressure
+         * @param[out] &s sample buffer
+         * @return     status code
+         *             - 0 success
+         *             - 1 read failed
+         *             - 5 handle is not bound
+         * @note       it blocks for the two conversions
+         */
+        uint8_t read(sample &s) noexcept
+        {
+            if (!is_bound())
+            {
+                return 5;
+            }
+            if (ms5837_start_temperature_convert(&m_handle) != 0)
+            {
+                return 1;
+            }
+            m_handle.delay_ms(convert_delay_ms[TemperatureOsr]);
+            if (ms5837_read_adc(&m_handle, &s.temperature_raw) != 0)
+            {
+                return 1;
+            }
+            if (ms5837_start_pressure_convert(&m_handle) != 0)
+            {
+                return 1;
+            }
+            m_handle.delay_ms(convert_delay_ms[PressureOsr]);
+            if (ms5837_read_adc(&m_handle, &s.pressure_raw) != 0)
+            {
+                return 1;
+            }
+            compensate(s);
+            
+            return 0;
+        }
+        
+        /**
+         * @brief         compensate the raw data with the calibration of this chip
+         * @param[in,out] &s sample with the raw data set
+         * @note          it applies the user correction of the handle like ms5837_compensate
+         */
+        void compensate(sample &s) const noexcept
+        {
+            ms5837::compensate<Type>(m_handle.c, s);
+            if (m_handle.correction != nullptr)
+            {
+                (void)ms5837_correct(&m_handle, &s.temperature, &s.pressure);
+                s.temperature_c = static_cast<float>(s.temperature) / 100.0f;
+                s.pressure_mbar = static_cast<float>(s.pressure) / static_cast<float>(type_traits<Type>::p_per_mbar);
+            }
+        }
+        
+        /**
+         * @brief  check that the handle still has the type and osr of the template
+         * @return true if no other configuration is set or staged
+         * @note   none
+         */
+        bool is_bound() const noexcept
+        {
+            return (m_handle.stage_seq == m_handle.applied_seq) &&
+                   (m_handle.type == static_cast<uint8_t>(Type)) &&
+                   (m_handle.temp_osr == static_cast<uint8_t>(TemperatureOsr)) &&
+                   (m_handle.press_osr == static_cast<uint8_t>(PressureOsr));
+        }
+        
+        /**
+         * @brief  get the linked handle
+         * @return reference of the handle
+         * @note   none
+         */
+        ms5837_handle_t &handle() noexcept
+        {
+            return m_handle;
+        }
+        
+    private:
+        ms5837_handle_t &m_handle;        /**< linked handle */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,505 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_archive.c
+ * @brief     driver ms5837 archive source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_archive.h"
+
+/**
+ * @brief block header definition
+ */
+#define ARCHIVE_MAGIC          0xA5        /**< block magic */
+#define ARCHIVE_VERSION        0x01        /**< block version */
+
+/**
+ * @brief     zigzag encode
+ * @param[in] v signed value
+ * @return    unsigned value
+ * @note      none
+ */
+static inline uint64_t a_archive_zigzag(int64_t v)
+{
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+/**
+ * @brief     zigzag decode
+ * @param[in] u unsigned value
+ * @return    signed value
+ * @note      none
+ */
+static inline int64_t a_archive_unzigzag(uint64_t u)
+{
+    return (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+}
+
+/**
+ * @brief     get the bit width of a value
+ * @param[in] u unsigned value
+ * @return    bit width
+ * @note      none
+ */
+static uint8_t a_archive_width(uint64_t u)
+{
+    uint8_t w = 0;
+    
+    while (u != 0)
+    {
+        w++;
+        u >>= 1;
+    }
+    
+    return w;
+}
+
+/**
+ * @brief         pack bits
+ * @param[in]     *buf pointer to a zeroed buffer
+ * @param[in,out] *bit pointer to the bit position
+ * @param[in]     value packed value
+ * @param[in]     width bit width
+ * @note          lsb first
+ */
+static void a_archive_put(uint8_t *buf, uint32_t *bit, uint64_t value, uint8_t width)
+{
+    while (width > 0)
+    {
+        uint8_t shift = (uint8_t)(*bit & 7);
+        uint8_t n = (uint8_t)(8 - shift);
+        
+        if (n > width)
+        {
+            n = width;
+        }
+        buf[*bit >> 3] |= (uint8_t)((value & ((1U << n) - 1)) << shift);
+        value >>= n;
+        width = (uint8_t)(width - n);
+        *bit += n;
+    }
+}
+
+/**
+ * @brief         unpack bits
+ * @param[in]     *buf pointer to a buffer
+ * @param[in,out] *bit pointer to the bit position
+ * @param[in]     width bit width
+ * @return        unpacked value
+ * @note          lsb first
+ */
+static uint64_t a_archive_get(const uint8_t *buf, uint32_t *bit, uint8_t width)
+{
+    uint64_t value = 0;
+    uint8_t done = 0;
+    
+    while (done < width)
+    {
+        uint8_t shift = (uint8_t)(*bit & 7);
+        uint8_t n = (uint8_t)(8 - shift);
+        
+        if (n > (width - done))
+        {
+            n = (uint8_t)(width - done);
+        }
+        value |= (uint64_t)((buf[*bit >> 3] >> shift) & ((1U << n) - 1)) << done;
+        done = (uint8_t)(done + n);
+        *bit += n;
+    }
+    
+    return value;
+}
+
+/**
+ * @brief     write a little endian value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] value written value
+ * @param[in] bytes byte number
+ * @note      none
+ */
+static void a_archive_put_le(uint8_t *buf, uint64_t value, uint8_t bytes)
+{
+    uint8_t i;
+    
+    for (i = 0; i < bytes; i++)
+    {
+        buf[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief     read a little endian value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] bytes byte number
+ * @return    read value
+ * @note      none
+ */
+static uint64_t a_archive_get_le(const uint8_t *buf, uint8_t bytes)
+{
+    uint64_t value = 0;
+    uint8_t i;
+    
+    for (i = 0; i < bytes; i++)
+    {
+        value |= (uint64_t)buf[i] << (8 * i);
+    }
+    
+    return value;
+}
+
+/**
+ * @brief     initialize the archive writer
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] type chip type of the samples
+ * @return    status code
+ *            - 0 success
+ *            - 2 archive is NULL
+ * @note      none
+ */
+uint8_t ms5837_archive_init(ms5837_archive_t *archive, ms5837_type_t type)
+{
+    if (archive == NULL)                        /* check archive */
+    {
+        return 2;                               /* return error */
+    }
+    
+    archive->block.count = 0;                   /* clear the count */
+    archive->block.type = (uint8_t)type;        /* set the type */
+    archive->rollup = NULL;                     /* no rollup */
+    archive->inited = 1;                        /* flag inited */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the rollup fed by append
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] *rollup pointer to an initialized rollup structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 archive is NULL
+ *            - 3 archive is not initialized
+ * @note      every appended sample is also added to the rollup
+ */
+uint8_t ms5837_archive_set_rollup(ms5837_archive_t *archive, ms5837_rollup_t *rollup)
+{
+    if (archive == NULL)             /* check archive */
+    {
+        return 2;                    /* return error */
+    }
+    if (archive->inited != 1)        /* check archive initialization */
+    {
+        return 3;                    /* return error */
+    }
+    
+    archive->rollup = rollup;        /* set the rollup */
+    
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief     append a sample
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 1 block is full
+ *            - 2 archive is NULL
+ *            - 3 archive is not initialized
+ * @note      a full block keeps the sample out, encode the block and append it again
+ */
+uint8_t ms5837_archive_append(ms5837_archive_t *archive, uint64_t time_us, int32_t temperature, int32_t pressure)
+{
+    ms5837_archive_block_t *block;
+    
+    if (archive == NULL)                                   /* check archive */
+    {
+        return 2;                                          /* return error */
+    }
+    if (archive->inited != 1)                              /* check archive initialization */
+    {
+        return 3;                                          /* return error */
+    }
+    
+    block = &archive->block;                               /* get the block */
+    if (block->count >= MS5837_ARCHIVE_BLOCK)              /* check the space */
+    {
+        return 1;                                          /* return error */
+    }
+    block->time_us[block->count] = time_us;                /* set the time */
+    block->temperature[block->count] = temperature;        /* set the temperature */
+    block->pressure[block->count] = pressure;              /* set the pressure */
+    block->count++;                                        /* count the sample */
+    if (archive->rollup != NULL)                           /* check the rollup */
+    {
+        (void)ms5837_rollup_add(archive->rollup,
+                                time_us, temperature,
+                                pressure);                 /* update the rollup */
+    }
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief      encode the pending samples into a block
+ * @param[in]  *archive pointer to an archive structure
+ * @param[out] *buf pointer to a block buffer
+ * @param[in]  size block buffer size
+ * @param[out] *len pointer to a block length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 archive is NULL
+ *             - 3 archive is not initialized
+ *             - 4 buffer is too small
+ * @note       timestamps are stored as delta of delta, temperature and pressure as zigzag deltas,
+ *             each column is bit packed with the width of its largest value,
+ *             MS5837_ARCHIVE_BLOCK_SIZE_MAX bytes always fit, no pending sample gives a length of 0
+ */
+uint8_t ms5837_archive_encode(ms5837_archive_t *archive, uint8_t *buf, uint32_t size, uint32_t *len)
+{
+    ms5837_archive_block_t *block;
+    uint64_t zz;
+    uint64_t d0 = 0;
+    uint32_t bytes;
+    uint32_t bit;
+    uint16_t n;
+    uint16_t i;
+    uint8_t tw = 0;
+    uint8_t ww = 0;
+    uint8_t pw = 0;
+    uint8_t *payload;
+    
+    if (archive == NULL)                                                                          /* check archive */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (archive->inited != 1)                                                                     /* check archive initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    block = &archive->block;                                                                      /* get the block */
+    n = block->count;                                                                             /* get the count */
+    if (n == 0)                                                                                   /* check the count */
+    {
+        *len = 0;                                                                                 /* nothing to encode */
+        
+        return 0;                                                                                 /* success return 0 */
+    }
+    
+    /* find the column widths */
+    if (n >= 2)                                                                                   /* first delta */
+    {
+        d0 = a_archive_zigzag((int64_t)(block->time_us[1] - block->time_us[0]));                  /* zigzag it */
+    }
+    for (i = 2; i < n; i++)                                                                       /* delta of delta */
+    {
+        zz = a_archive_zigzag((int64_t)(block->time_us[i] - block->time_us[i - 1]) -
+                              (int64_t)(block->time_us[i - 1] - block->time_us[i - 2]));          /* zigzag it */
+        tw = (a_archive_width(zz) > tw) ? a_archive_width(zz) : tw;                               /* max width */
+    }
+    for (i = 1; i < n; i++)                                                                       /* deltas */
+    {
+        zz = a_archive_zigzag((int64_t)block->temperature[i] - block->temperature[i - 1]);        /* zigzag it */
+        ww = (a_archive_width(zz) > ww) ? a_archive_width(zz) : ww;                               /* max width */
+        zz = a_archive_zigzag((int64_t)block->pressure[i] - block->pressure[i - 1]);              /* zigzag it */
+        pw = (a_archive_width(zz) > pw) ? a_archive_width(zz) : pw;                               /* max width */
+    }
+    bytes = ((uint32_t)((n > 2) ? (n - 2) : 0) * tw + 7) / 8 +
+            ((uint32_t)(n - 1) * ww + 7) / 8 + ((uint32_t)(n - 1) * pw + 7) / 8;                  /* payload bytes */
+    if (size < (MS5837_ARCHIVE_HEADER_SIZE + bytes))                                              /* check the size */
+    {
+        return 4;                                                                                 /* return error */
+    }
+    
+    /* write the header */
+    memset(buf, 0, MS5837_ARCHIVE_HEADER_SIZE + bytes);                                           /* clear the block */
+    buf[0] = ARCHIVE_MAGIC;                                                                       /* set the magic */
+    buf[1] = ARCHIVE_VERSION;                                                                     /* set the version */
+    buf[2] = block->type;                                                                         /* set the type */
+    a_archive_put_le(&buf[4], n, 2);                                                              /* set the count */
+    buf[6] = tw;                                                                                  /* set the time width */
+    buf[7] = ww;                                                                                  /* set the temperature width */
+    buf[8] = pw;                                                                                  /* set the pressure width */
+    a_archive_put_le(&buf[12], block->time_us[0], 8);                                             /* set the first time */
+    a_archive_put_le(&buf[20], d0, 8);                                                            /* set the first delta */
+    a_archive_put_le(&buf[28], (uint32_t)block->temperature[0], 4);                               /* set the first temperature */
+    a_archive_put_le(&buf[32], (uint32_t)block->pressure[0], 4);                                  /* set the first pressure */
+    a_archive_put_le(&buf[36], bytes, 4);                                                         /* set the payload bytes */
+    
+    /* pack the columns, each one starts on a byte */
+    payload = &buf[MS5837_ARCHIVE_HEADER_SIZE];                                                   /* get the payload */
+    bit = 0;                                                                                      /* time column */
+    for (i = 2; i < n; i++)                                                                       /* delta of delta */
+    {
+        a_archive_put(payload, &bit, a_archive_zigzag((int64_t)(block->time_us[i] - block->time_us[i - 1]) -
+                      (int64_t)(block->time_us[i - 1] - block->time_us[i - 2])), tw);             /* pack it */
+    }
+    bit = (bit + 7) & ~7U;                                                                        /* temperature column */
+    for (i = 1; i < n; i++)                                                                       /* deltas */
+    {
+        a_archive_put(payload, &bit, a_archive_zigzag((int64_t)block->temperature[i] -
+                      block->temperature[i - 1]), ww);                                            /* pack it */
+    }
+    bit = (bit + 7) & ~7U;                                                                        /* pressure column */
+    for (i = 1; i < n; i++)                                                                       /* deltas */
+    {
+        a_archive_put(payload, &bit, a_archive_zigzag((int64_t)block->pressure[i] -
+                      block->pressure[i - 1]), pw);                                               /* pack it */
+    }
+    *len = MS5837_ARCHIVE_HEADER_SIZE + bytes;                                                    /* set the length */
+    block->count = 0;                                                                             /* clear the block */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      decode a block
+ * @param[in]  *buf pointer to an encoded block
+ * @param[in]  len encoded data length, it can cover more blocks
+ * @param[out] *block pointer to a block buffer
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 block is invalid
+ *             - 2 buf is NULL
+ * @note       step the buffer by used to decode the next block
+ */
+uint8_t ms5837_archive_decode(const uint8_t *buf, uint32_t len, ms5837_archive_block_t *block, uint32_t *used)
+{
+    const uint8_t *payload;
+    int64_t delta;
+    uint32_t bytes;
+    uint32_t bit;
+    uint16_t n;
+    uint16_t i;
+    uint8_t tw;
+    uint8_t ww;
+    uint8_t pw;
+    
+    if (buf == NULL)                                                                                    /* check buf */
+    {
+        return 2;                                                                                       /* return error */
+    }
+    if ((len < MS5837_ARCHIVE_HEADER_SIZE) || (buf[0] != ARCHIVE_MAGIC) ||
+        (buf[1] != ARCHIVE_VERSION))                                                                    /* check the header */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    
+    n = (uint16_t)a_archive_get_le(&buf[4], 2);                                                         /* get the count */
+    tw = buf[6];                                                                                        /* get the time width */
+    ww = buf[7];                                                                                        /* get the temperature width */
+    pw = buf[8];                                                                                        /* get the pressure width */
+    bytes = (uint32_t)a_archive_get_le(&buf[36], 4);                                                    /* get the payload bytes */
+    if ((n == 0) || (n > MS5837_ARCHIVE_BLOCK) || (tw > 64) || (ww > 33) || (pw > 33) ||
+        (bytes > (len - MS5837_ARCHIVE_HEADER_SIZE)) ||
+        (bytes < ((uint32_t)((n > 2) ? (n - 2) : 0) * tw + 7) / 8 +
+                 ((uint32_t)(n - 1) * ww + 7) / 8 + ((uint32_t)(n - 1) * pw + 7) / 8))                  /* check the block */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    
+    /* first values */
+    block->type = buf[2];                                                                               /* get the type */
+    block->count = n;                                                                                   /* get the count */
+    block->time_us[0] = a_archive_get_le(&buf[12], 8);                                                  /* get the first time */
+    block->temperature[0] = (int32_t)(uint32_t)a_archive_get_le(&buf[28], 4);                           /* get the first temperature */
+    block->pressure[0] = (int32_t)(uint32_t)a_archive_get_le(&buf[32], 4);                              /* get the first pressure */
+    delta = a_archive_unzigzag(a_archive_get_le(&buf[20], 8));                                          /* get the first delta */
+    
+    /* unpack the columns */
+    payload = &buf[MS5837_ARCHIVE_HEADER_SIZE];                                                         /* get the payload */
+    bit = 0;                                                                                            /* time column */
+    if (n >= 2)                                                                                         /* second time */
+    {
+        block->time_us[1] = block->time_us[0] + (uint64_t)delta;                                        /* add the delta */
+    }
+    for (i = 2; i < n; i++)                                                                             /* delta of delta */
+    {
+        delta += a_archive_unzigzag(a_archive_get(payload, &bit, tw));                                  /* get the delta */
+        block->time_us[i] = block->time_us[i - 1] + (uint64_t)delta;                                    /* add the delta */
+    }
+    bit = (bit + 7) & ~7U;                                                                              /* temperature column */
+    for (i = 1; i < n; i++)                                                                             /* deltas */
+    {
+        block->temperature[i] = (int32_t)(block->temperature[i - 1] +
+                                          a_archive_unzigzag(a_archive_get(payload, &bit, ww)));        /* add the delta */
+    }
+    bit = (bit + 7) & ~7U;                                                                              /* pressure column */
+    for (i = 1; i < n; i++)                                                                             /* deltas */
+    {
+        block->pressure[i] = (int32_t)(block->pressure[i - 1] +
+                                       a_archive_unzigzag(a_archive_get(payload, &bit, pw)));           /* add the delta */
+    }
+    *used = MS5837_ARCHIVE_HEADER_SIZE + bytes;                                                         /* set the used length */
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      convert a decoded sample to floats
+ * @param[in]  *block pointer to a block structure
+ * @param[in]  index sample index
+ * @param[out] *temperature_c pointer to a temperature buffer
+ * @param[out] *pressure_mbar pointer to a pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 block is NULL
+ *             - 4 index is invalid
+ * @note       the results equal ms5837_calculate_temperature_pressure
+ */
+uint8_t ms5837_archive_convert(const ms5837_archive_block_t *block, uint16_t index, float *temperature_c, float *pressure_mbar)
+{
+    if (block == NULL)                                                    /* check block */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (index >= block->count)                                            /* check the index */
+    {
+        return 4;                                                         /* return error */
+    }
+    
+    *temperature_c = (float)(block->temperature[index]) / 100.0f;         /* set the temperature */
+    if (block->type == MS5837_TYPE_30BA26)                                /* 30ba26 */
+    {
+        *pressure_mbar = (float)(block->pressure[index]) / 10.0f;         /* set the pressure */
+    }
+    else                                                                  /* 02ba01 and 02ba21 */
+    {
+        *pressure_mbar = (float)(block->pressure[index]) / 100.0f;        /* set the pressure */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_archive.h
+ * @brief     driver ms5837 archive header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_ARCHIVE_H
+#define DRIVER_MS5837_ARCHIVE_H
+
+#include "driver_ms5837_rollup.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_archive_driver ms5837 archive driver function
+ * @brief    ms5837 archive driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 archive format definition
+ */
+#define MS5837_ARCHIVE_BLOCK              1024        /**< max samples of one block */
+#define MS5837_ARCHIVE_HEADER_SIZE        40          /**< block header size in bytes */
+#define MS5837_ARCHIVE_BLOCK_SIZE_MAX     (MS5837_ARCHIVE_HEADER_SIZE + 8 * MS5837_ARCHIVE_BLOCK + \
+                                           2 * ((33 * MS5837_ARCHIVE_BLOCK + 7) / 8))            /**< worst case block size in bytes */
+
+/**
+ * @brief ms5837 archive block structure definition
+ * @note  the columns keep the integer results of ms5837_compensate
+ */
+typedef struct ms5837_archive_block_s
+{
+    uint64_t time_us[MS5837_ARCHIVE_BLOCK];         /**< timestamp column */
+    int32_t temperature[MS5837_ARCHIVE_BLOCK];      /**< temperature column in 0.01C */
+    int32_t pressure[MS5837_ARCHIVE_BLOCK];         /**< pressure column in the unit of the type */
+    uint16_t count;                                 /**< sample count */
+    uint8_t type;                                   /**< chip type */
+} ms5837_archive_block_t;
+
+/**
+ * @brief ms5837 archive structure definition
+ */
+typedef struct ms5837_archive_s
+{
+    ms5837_archive_block_t block;        /**< pending samples */
+    ms5837_rollup_t *rollup;             /**< rollup fed by append */
+    uint8_t inited;                      /**< inited flag */
+} ms5837_archive_t;
+
+/**
+ * @brief     initialize the archive writer
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] type chip type of the samples
+ * @return    status code
+ *            - 0 success
+ *            - 2 archive is NULL
+ * @note      none
+ */
+uint8_t ms5837_archive_init(ms5837_archive_t *archive, ms5837_type_t type);
+
+/**
+ * @brief     set the rollup fed by append
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] *rollup pointer to an initialized rollup structure, NULL to detach
+ * @return    status code
+ *            - 0 success
+ *            - 2 archive is NULL
+ *            - 3 archive is not initialized
+ * @note      every appended sample is also added to the rollup
+ */
+uint8_t ms5837_archive_set_rollup(ms5837_archive_t *archive, ms5837_rollup_t *rollup);
+
+/**
+ * @brief     append a sample
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 1 block is full
+ *            - 2 archive is NULL
+ *            - 3 archive is not initialized
+ * @note      a full block keeps the sample out, encode the block and append it again
+ */
+uint8_t ms5837_archive_append(ms5837_archive_t *archive, uint64_t time_us, int32_t temperature, int32_t pressure);
+
+/**
+ * @brief      encode the pending samples into a block
+ * @param[in]  *archive pointer to an archive structure
+ * @param[out] *buf pointer to a block buffer
+ * @param[in]  size block buffer size
+ * @param[out] *len pointer to a block length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 archive is NULL
+ *             - 3 archive is not initialized
+ *             - 4 buffer is too small
+ * @note       timestamps are stored as delta of delta, temperature and pressure as zigzag deltas,
+ *             each column is bit packed with the width of its largest value,
+ *             MS5837_ARCHIVE_BLOCK_SIZE_MAX bytes always fit, no pending sample gives a length of 0
+ */
+uint8_t ms5837_archive_encode(ms5837_archive_t *archive, uint8_t *buf, uint32_t size, uint32_t *len);
+
+/**
+ * @brief      decode a block
+ * @param[in]  *buf pointer to an encoded block
+ * @param[in]  len encoded data length, it can cover more blocks
+ * @param[out] *block pointer to a block buffer
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 block is invalid
+ *             - 2 buf is NULL
+ * @note       step the buffer by used to decode the next block
+ */
+uint8_t ms5837_archive_decode(const uint8_t *buf, uint32_t len, ms5837_archive_block_t *block, uint32_t *used);
+
+/**
+ * @brief      convert a decoded sample to floats
+ * @param[in]  *block pointer to a block structure
+ * @param[in]  index sample index
+ * @param[out] *temperature_c pointer to a temperature buffer
+ * @param[out] *pressure_mbar pointer to a pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 block is NULL
+ *             - 4 index is invalid
+ * @note       the results equal ms5837_calculate_temperature_pressure
+ */
+uint8_t ms5837_archive_convert(const ms5837_archive_block_t *block, uint16_t index, float *temperature_c, float *pressure_mbar);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,423 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_coro.hpp
+ * @brief     driver ms5837 c++20 coroutine header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_CORO_HPP
+#define DRIVER_MS5837_CORO_HPP
+
+#include "driver_ms5837.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @defgroup ms5837_coro_driver ms5837 coroutine driver function
+ * @brief    ms5837 coroutine driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+namespace ms5837
+{
+
+/**
+ * @brief scheduler concept definition
+ * @note  call_after runs fn(arg) once after us microseconds on the loop thread,
+ *        an asio loop can implement it with a steady_timer
+ */
+template <class S>
+concept scheduler = requires(S &s, uint32_t us, void (*fn)(void *), void *arg)
+{
+    s.call_after(us, fn, arg);
+};
+
+/**
+ * @brief ms5837 timer loop class definition
+ * @note  a minimal single thread scheduler, it sleeps until the next timer and runs it
+ */
+class timer_loop
+{
+    public:
+        /**
+         * @brief     run a function after a delay
+         * @param[in] us delay in us
+         * @param[in] *fn pointer to a function
+         * @param[in] *arg pointer to the function argument
+         * @note      none
+         */
+        void call_after(uint32_t us, void (*fn)(void *), void *arg)
+        {
+            m_timers.push(timer{clock::now() + std::chrono::microseconds(us), m_seq++, fn, arg});
+        }
+        
+        /**
+         * @brief  run the next timer
+         * @return false if there is no timer
+         * @note   it blocks until the timer expires
+         */
+        bool run_one()
+        {
+            if (m_timers.empty())
+            {
+                return false;
+            }
+            timer t = m_timers.top();
+            m_timers.pop();
+            std::this_thread::sleep_until(t.deadline);
+            t.fn(t.arg);
+            
+            return true;
+        }
+        
+        /**
+         * @brief run all timers until none is left
+         * @note  none
+         */
+        void run()
+        {
+            while (run_one())
+            {
+            }
+        }
+        
+    private:
+        using clock = std::chrono::steady_clock;
+        
+        /**
+         * @brief timer structure definition
+         */
+        struct timer
+        {
+            clock::time_point deadline;        /**< expiry time */
+            uint64_t seq;                      /**< insertion order of equal deadlines */
+            void (*fn)(void *);                /**< function */
+            void *arg;                         /**< function argument */
+            
+            bool operator>(const timer &other) const noexcept
+            {
+                return (deadline != other.deadline) ? (deadline > other.deadline) : (seq > other.seq);
+            }
+        };
+        
+        std::priority_queue<timer, std::vector<timer>, std::greater<timer>> m_timers;        /**< pending timers */
+        uint64_t m_seq = 0;                                                                  /**< timer sequence */
+};
+
+/**
+ * @brief ms5837 virtual loop class definition
+ * @note  a single thread scheduler on a virtual clock, it jumps the clock to the next timer instead of sleeping,
+ *        bind it to ms5837_sim_t::now_us so that the simulated conversions and the timers share one time base
+ */
+class virtual_loop
+{
+    public:
+        /**
+         * @brief     constructor
+         * @param[in] &now_us reference to the virtual clock in us
+         * @note      none
+         */
+        explicit virtual_loop(uint64_t &now_us) noexcept : m_now_us(now_us)
+        {
+        }
+        
+        /**
+         * @brief     run a function after a delay
+         * @param[in] us delay in us
+         * @param[in] *fn pointer to a function
+         * @param[in] *arg pointer to the function argument
+         * @note      none
+         */
+        void call_after(uint32_t us, void (*fn)(void *), void *arg)
+        {
+            m_timers.push(timer{m_now_us + us, m_seq++, fn, arg});
+        }
+        
+        /**
+         * @brief  run the next timer
+         * @return false if there is no timer
+         * @note   the clock never goes back, work done by the timer may have moved it already
+         */
+        bool run_one()
+        {
+            if (m_timers.empty())
+            {
+                return false;
+            }
+            timer t = m_timers.top();
+            m_timers.pop();
+            if (t.deadline > m_now_us)
+            {
+                m_now_us = t.deadline;
+            }
+            t.fn(t.arg);
+            
+            return true;
+        }
+        
+        /**
+         * @brief run all timers until none is left
+         * @note  none
+         */
+        void run()
+        {
+            while (run_one())
+            {
+            }
+        }
+        
+        /**
+         * @brief  get the virtual time
+         * @return time in us
+         * @note   none
+         */
+        uint64_t now_us() const noexcept
+        {
+            return m_now_us;
+        }
+        
+    private:
+        /**
+         * @brief timer structure definition
+         */
+        struct timer
+        {
+            uint64_t deadline;             /**< expiry time in us */
+            uint64_t seq;                  /**< insertion order of equal deadlines */
+            void (*fn)(void *);            /**< function */
+            void *arg;                     /**< function argument */
+            
+            bool operator>(const timer &other) const noexcept
+            {
+                return (deadline != other.deadline) ? (deadline > other.deadline) : (seq > other.seq);
+            }
+        };
+        
+        uint64_t &m_now_us;                                                                  /**< virtual clock */
+        std::priority_queue<timer, std::vector<timer>, std::greater<timer>> m_timers;        /**< pending timers */
+        uint64_t m_seq = 0;                                                                  /**< timer sequence */
+};
+
+/**
+ * @brief ms5837 detached coroutine definition
+ * @note  it starts at once and frees itself at the end, for coroutines that report through their arguments
+ */
+struct detached
+{
+    struct promise_type
+    {
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() noexcept
+        {
+        }
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief ms5837 read result structure definition
+ */
+struct read_result
+{
+    uint8_t status;        /**< 0 success, 1 read failed, 4 read is running, 5 handle is not bound */
+    sample value;          /**< sample */
+};
+
+/**
+ * @brief ms5837 asynchronous sensor class definition
+ * @note  co_await read() starts the conversions and suspends on the scheduler timers instead of delay_ms,
+ *        only one read of a sensor can run at a time
+ */
+template <class Sensor, scheduler Scheduler>
+class async_sensor
+{
+    public:
+        /**
+         * @brief ms5837 read awaitable class definition
+         */
+        class read_awaitable
+        {
+            public:
+                explicit read_awaitable(async_sensor &owner) noexcept : m_owner(owner)
+                {
+                }
+                
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+                
+                bool await_suspend(std::coroutine_handle<> caller) noexcept
+                {
+                    if (m_owner.m_busy)
+                    {
+                        m_result.status = 4;
+                        
+                        return false;
+                    }
+                    if (!m_owner.m_sensor.is_bound())
+                    {
+                        m_result.status = 5;
+                        
+                        return false;
+                    }
+                    if (ms5837_start_temperature_convert(&m_owner.m_sensor.handle()) != 0)
+                    {
+                        m_result.status = 1;
+                        
+                        return false;
+                    }
+                    m_owner.m_busy = true;
+                    m_caller = caller;
+                    m_owner.m_scheduler.call_after(Sensor::temperature_convert_time_us, &read_awaitable::a_temperature_done, this);
+                    
+                    return true;
+                }
+                
+                read_result await_resume() const noexcept
+                {
+                    return m_result;
+                }
+                
+            private:
+                /**
+                 * @brief     temperature conversion timer
+                 * @param[in] *arg pointer to the awaitable
+                 * @note      it reads the temperature and starts the pressure conversion
+                 */
+                static void a_temperature_done(void *arg) noexcept
+                {
+                    read_awaitable *self = static_cast<read_awaitable *>(arg);
+                    ms5837_handle_t &handle = self->m_owner.m_sensor.handle();
+                    
+                    if ((ms5837_read_adc(&handle, &self->m_result.value.temperature_raw) != 0) ||
+                        (ms5837_start_pressure_convert(&handle) != 0))
+                    {
+                        self->a_finish(1);
+                        
+                        return;
+                    }
+                    self->m_owner.m_scheduler.call_after(Sensor::pressure_convert_time_us, &read_awaitable::a_pressure_done, self);
+                }
+                
+                /**
+                 * @brief     pressure conversion timer
+                 * @param[in] *arg pointer to the awaitable
+                 * @note      it reads the pressure, compensates the sample and resumes the caller
+                 */
+                static void a_pressure_done(void *arg) noexcept
+                {
+                    read_awaitable *self = static_cast<read_awaitable *>(arg);
+                    
+                    if (ms5837_read_adc(&self->m_owner.m_sensor.handle(), &self->m_result.value.pressure_raw) != 0)
+                    {
+                        self->a_finish(1);
+                        
+                        return;
+                    }
+                    self->m_owner.m_sensor.compensate(self->m_result.value);
+                    self->a_finish(0);
+                }
+                
+                /**
+                 * @brief     finish the read
+                 * @param[in] status read status
+                 * @note      none
+                 */
+                void a_finish(uint8_t status) noexcept
+                {
+                    m_result.status = status;
+                    m_owner.m_busy = false;
+                    m_caller.resume();
+                }
+                
+                async_sensor &m_owner;                    /**< sensor */
+                std::coroutine_handle<> m_caller;         /**< suspended coroutine */
+                read_result m_result{};                   /**< result */
+        };
+        
+        /**
+         * @brief     constructor
+         * @param[in] &sensor initialized sensor
+         * @param[in] &scheduler timer scheduler
+         * @note      none
+         */
+        async_sensor(Sensor &sensor, Scheduler &scheduler) noexcept : m_sensor(sensor), m_scheduler(scheduler)
+        {
+        }
+        
+        /**
+         * @brief  read the temperature and pressure
+         * @return awaitable of a read_result
+         * @note   none
+         */
+        read_awaitable read() noexcept
+        {
+            return read_awaitable(*this);
+        }
+        
+    private:
+        Sensor &m_sensor;                /**< sensor */
+        Scheduler &m_scheduler;          /**< scheduler */
+        bool m_busy = false;             /**< read running flag */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
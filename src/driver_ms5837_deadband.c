@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_deadband.c
+ * @brief     driver ms5837 deadband source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_deadband.h"
+
+/**
+ * @brief     check if a value left its deadband
+ * @param[in] value current value
+ * @param[in] last last reported value
+ * @param[in] band deadband
+ * @return    1 if the value left the deadband, else 0
+ * @note      none
+ */
+static uint8_t a_deadband_moved(int32_t value, int32_t last, int32_t band)
+{
+    int64_t diff;
+    
+    diff = (int64_t)value - (int64_t)last;
+    if (diff < 0)
+    {
+        diff = -diff;
+    }
+    
+    return (diff > (int64_t)band) ? 1 : 0;
+}
+
+/**
+ * @brief     initialize a deadband
+ * @param[in] *deadband pointer to a deadband structure
+ * @param[in] temperature_band temperature deadband in 0.01C
+ * @param[in] pressure_band pressure deadband in the unit of the type
+ * @param[in] heartbeat_us max time between reports, 0 disables
+ * @return    status code
+ *            - 0 success
+ *            - 2 deadband is NULL
+ *            - 4 band is invalid
+ * @note      a band of 0 reports every change
+ */
+uint8_t ms5837_deadband_init(ms5837_deadband_t *deadband, int32_t temperature_band, int32_t pressure_band, uint64_t heartbeat_us)
+{
+    if (deadband == NULL)                                     /* check deadband */
+    {
+        return 2;                                             /* return error */
+    }
+    if ((temperature_band < 0) || (pressure_band < 0))        /* check the bands */
+    {
+        return 4;                                             /* return error */
+    }
+    
+    memset(deadband, 0, sizeof(ms5837_deadband_t));           /* clear the deadband */
+    deadband->temperature_band = temperature_band;            /* set the temperature band */
+    deadband->pressure_band = pressure_band;                  /* set the pressure band */
+    deadband->heartbeat_us = heartbeat_us;                    /* set the heartbeat */
+    deadband->inited = 1;                                     /* flag inited */
+    
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief     reset a deadband
+ * @param[in] *deadband pointer to a deadband structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 deadband is NULL
+ *            - 3 deadband is not initialized
+ * @note      the next sample is reported
+ */
+uint8_t ms5837_deadband_reset(ms5837_deadband_t *deadband)
+{
+    if (deadband == NULL)             /* check deadband */
+    {
+        return 2;                     /* return error */
+    }
+    if (deadband->inited != 1)        /* check deadband initialization */
+    {
+        return 3;                     /* return error */
+    }
+    
+    deadband->started = 0;            /* restart the reports */
+    deadband->reported = 0;           /* clear the reported */
+    deadband->suppressed = 0;         /* clear the suppressed */
+    
+    return 0;                         /* success return 0 */
+}
+
+/**
+ * @brief      check a sample against the deadband
+ * @param[in]  *deadband pointer to a deadband structure
+ * @param[in]  time_us sample time
+ * @param[in]  temperature temperature from ms5837_compensate
+ * @param[in]  pressure pressure from ms5837_compensate
+ * @param[out] *reason pointer to a reason mask buffer, it can be NULL
+ * @return     status code
+ *             - 0 report the sample
+ *             - 1 suppress the sample
+ *             - 2 deadband is NULL
+ *             - 3 deadband is not initialized
+ * @note       the deadband is measured from the last reported sample, so a slow drift is reported
+ *             once it has moved a whole band, reason is 0 for a suppressed sample
+ */
+uint8_t ms5837_deadband_check(ms5837_deadband_t *deadband, uint64_t time_us, int32_t temperature, int32_t pressure,
+                              uint8_t *reason)
+{
+    uint64_t elapsed;
+    uint8_t mask;
+    
+    if (deadband == NULL)                                                                        /* check deadband */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (deadband->inited != 1)                                                                   /* check deadband initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    mask = 0;                                                                                    /* clear the mask */
+    if (deadband->started == 0)                                                                  /* check the first sample */
+    {
+        mask |= MS5837_DEADBAND_REASON_FIRST;                                                    /* first sample */
+    }
+    else
+    {
+        elapsed = time_us - deadband->time_us;                                                   /* get the elapsed time */
+        if (a_deadband_moved(temperature, deadband->temperature,
+                             deadband->temperature_band) != 0)                                   /* check the temperature */
+        {
+            mask |= MS5837_DEADBAND_REASON_TEMPERATURE;                                          /* temperature moved */
+        }
+        if (a_deadband_moved(pressure, deadband->pressure, deadband->pressure_band) != 0)        /* check the pressure */
+        {
+            mask |= MS5837_DEADBAND_REASON_PRESSURE;                                             /* pressure moved */
+        }
+        if ((deadband->heartbeat_us != 0) && (elapsed >= deadband->heartbeat_us))                /* check the heartbeat */
+        {
+            mask |= MS5837_DEADBAND_REASON_HEARTBEAT;                                            /* heartbeat */
+        }
+    }
+    if (reason != NULL)                                                                          /* check the reason */
+    {
+        *reason = mask;                                                                          /* set the reason */
+    }
+    if (mask == 0)                                                                               /* check the mask */
+    {
+        deadband->suppressed++;                                                                  /* count the suppressed */
+        
+        return 1;                                                                                /* suppress the sample */
+    }
+    deadband->time_us = time_us;                                                                 /* save the time */
+    deadband->temperature = temperature;                                                         /* save the temperature */
+    deadband->pressure = pressure;                                                               /* save the pressure */
+    deadband->started = 1;                                                                       /* flag started */
+    deadband->reported++;                                                                        /* count the reported */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the deadband counters
+ * @param[in]  *deadband pointer to a deadband structure
+ * @param[out] *reported pointer to a reported sample number buffer
+ * @param[out] *suppressed pointer to a suppressed sample number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 deadband is NULL
+ *             - 3 deadband is not initialized
+ * @note       none
+ */
+uint8_t ms5837_deadband_get_stats(ms5837_deadband_t *deadband, uint32_t *reported, uint32_t *suppressed)
+{
+    if (deadband == NULL)                      /* check deadband */
+    {
+        return 2;                              /* return error */
+    }
+    if (deadband->inited != 1)                 /* check deadband initialization */
+    {
+        return 3;                              /* return error */
+    }
+    
+    *reported = deadband->reported;            /* get the reported */
+    *suppressed = deadband->suppressed;        /* get the suppressed */
+    
+    return 0;                                  /* success return 0 */
+}
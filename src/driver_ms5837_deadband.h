@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_deadband.h
+ * @brief     driver ms5837 deadband header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_DEADBAND_H
+#define DRIVER_MS5837_DEADBAND_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_deadband_driver ms5837 deadband driver function
+ * @brief    ms5837 deadband driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 deadband reason enumeration definition
+ */
+typedef enum
+{
+    MS5837_DEADBAND_REASON_FIRST       = (1 << 0),        /**< first sample after init or reset */
+    MS5837_DEADBAND_REASON_TEMPERATURE = (1 << 1),        /**< temperature left the deadband */
+    MS5837_DEADBAND_REASON_PRESSURE    = (1 << 2),        /**< pressure left the deadband */
+    MS5837_DEADBAND_REASON_HEARTBEAT   = (1 << 3),        /**< heartbeat interval passed */
+} ms5837_deadband_reason_t;
+
+/**
+ * @brief ms5837 deadband structure definition
+ * @note  the values keep the units of ms5837_compensate
+ */
+typedef struct ms5837_deadband_s
+{
+    int32_t temperature_band;        /**< temperature deadband */
+    int32_t pressure_band;           /**< pressure deadband */
+    uint64_t heartbeat_us;           /**< max time between reports, 0 disables */
+    uint64_t time_us;                /**< time of the last report */
+    int32_t temperature;             /**< temperature of the last report */
+    int32_t pressure;                /**< pressure of the last report */
+    uint32_t reported;               /**< reported samples */
+    uint32_t suppressed;             /**< suppressed samples */
+    uint8_t started;                 /**< first report done flag */
+    uint8_t inited;                  /**< inited flag */
+} ms5837_deadband_t;
+
+/**
+ * @brief     initialize a deadband
+ * @param[in] *deadband pointer to a deadband structure
+ * @param[in] temperature_band temperature deadband in 0.01C
+ * @param[in] pressure_band pressure deadband in the unit of the type
+ * @param[in] heartbeat_us max time between reports, 0 disables
+ * @return    status code
+ *            - 0 success
+ *            - 2 deadband is NULL
+ *            - 4 band is invalid
+ * @note      a band of 0 reports every change
+ */
+uint8_t ms5837_deadband_init(ms5837_deadband_t *deadband, int32_t temperature_band, int32_t pressure_band, uint64_t heartbeat_us);
+
+/**
+ * @brief     reset a deadband
+ * @param[in] *deadband pointer to a deadband structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 deadband is NULL
+ *            - 3 deadband is not initialized
+ * @note      the next sample is reported
+ */
+uint8_t ms5837_deadband_reset(ms5837_deadband_t *deadband);
+
+/**
+ * @brief      check a sample against the deadband
+ * @param[in]  *deadband pointer to a deadband structure
+ * @param[in]  time_us sample time
+ * @param[in]  temperature temperature from ms5837_compensate
+ * @param[in]  pressure pressure from ms5837_compensate
+ * @param[out] *reason pointer to a reason mask buffer, it can be NULL
+ * @return     status code
+ *             - 0 report the sample
+ *             - 1 suppress the sample
+ *             - 2 deadband is NULL
+ *             - 3 deadband is not initialized
+ * @note       the deadband is measured from the last reported sample, so a slow drift is reported
+ *             once it has moved a whole band, reason is 0 for a suppressed sample
+ */
+uint8_t ms5837_deadband_check(ms5837_deadband_t *deadband, uint64_t time_us, int32_t temperature, int32_t pressure,
+                              uint8_t *reason);
+
+/**
+ * @brief      get the deadband counters
+ * @param[in]  *deadband pointer to a deadband structure
+ * @param[out] *reported pointer to a reported sample number buffer
+ * @param[out] *suppressed pointer to a suppressed sample number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 deadband is NULL
+ *             - 3 deadband is not initialized
+ * @note       none
+ */
+uint8_t ms5837_deadband_get_stats(ms5837_deadband_t *deadband, uint32_t *reported, uint32_t *suppressed);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,385 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_fusion.c
+ * @brief     driver ms5837 fusion source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_fusion.h"
+
+/**
+ * @brief      sort the masked pressures
+ * @param[in]  *value pointer to the pressures in Pa
+ * @param[in]  num sensor number
+ * @param[in]  mask sensor bit mask
+ * @param[out] *sorted pointer to a sorted pressure buffer
+ * @return     sorted pressure number
+ * @note       insertion sort of at most MS5837_FUSION_MAX values
+ */
+static uint8_t a_fusion_sort(const int64_t *value, uint8_t num, uint8_t mask, int64_t *sorted)
+{
+    int64_t v;
+    uint8_t n;
+    uint8_t i;
+    uint8_t j;
+    
+    n = 0;
+    for (i = 0; i < num; i++)
+    {
+        if ((mask & (1 << i)) == 0)
+        {
+            continue;
+        }
+        v = value[i];
+        j = n;
+        while ((j > 0) && (sorted[j - 1] > v))
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+        n++;
+    }
+    
+    return n;
+}
+
+/**
+ * @brief     get the median of the masked pressures
+ * @param[in] *value pointer to the pressures in Pa
+ * @param[in] num sensor number
+ * @param[in] mask voting sensor bit mask, not 0
+ * @return    median, the mean of the middle two for an even count
+ * @note      none
+ */
+static int64_t a_fusion_median(const int64_t *value, uint8_t num, uint8_t mask)
+{
+    int64_t sorted[MS5837_FUSION_MAX];
+    uint8_t n;
+    
+    n = a_fusion_sort(value, num, mask, sorted);
+    if ((n % 2) != 0)
+    {
+        return sorted[n / 2];
+    }
+    
+    return (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+/**
+ * @brief         track the health of a sensor
+ * @param[in,out] *fusion pointer to a fusion structure
+ * @param[in]     index sensor index
+ * @param[in]     health health of this set
+ * @return        health with the fault state
+ * @note          none
+ */
+static uint8_t a_fusion_track(ms5837_fusion_t *fusion, uint8_t index, uint8_t health)
+{
+    uint8_t bit;
+    
+    bit = (uint8_t)(1 << index);
+    if (health == MS5837_FUSION_HEALTH_OK)
+    {
+        fusion->bad[index] = 0;
+        if ((fusion->fault & bit) != 0)
+        {
+            fusion->good[index]++;
+            if (fusion->good[index] >= fusion->config.fault_count)
+            {
+                fusion->fault &= (uint8_t)(~bit);
+                fusion->good[index] = 0;
+            }
+        }
+    }
+    else
+    {
+        if (health == MS5837_FUSION_HEALTH_OUTLIER)
+        {
+            fusion->outliers[index]++;
+        }
+        else
+        {
+            fusion->missing[index]++;
+        }
+        fusion->good[index] = 0;
+        if (fusion->bad[index] < fusion->config.fault_count)
+        {
+            fusion->bad[index]++;
+        }
+        if (fusion->bad[index] >= fusion->config.fault_count)
+        {
+            fusion->fault |= bit;
+        }
+    }
+    
+    return ((fusion->fault & bit) != 0) ? MS5837_FUSION_HEALTH_FAULT : health;
+}
+
+/**
+ * @brief     initialize a fusion stage
+ * @param[in] *fusion pointer to a fusion structure
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 fusion or config is NULL
+ *            - 4 config is invalid
+ * @note      none
+ */
+uint8_t ms5837_fusion_init(ms5837_fusion_t *fusion, const ms5837_fusion_config_t *config)
+{
+    if ((fusion == NULL) || (config == NULL))                                    /* check fusion and config */
+    {
+        return 2;                                                                /* return error */
+    }
+    if ((config->num == 0) || (config->num > MS5837_FUSION_MAX) ||
+        (config->mode > MS5837_FUSION_MODE_TRIMMED_MEAN) || (config->density < 500) ||
+        (config->density > 2000) || (config->fault_count == 0) ||
+        ((config->mode == MS5837_FUSION_MODE_TRIMMED_MEAN) &&
+         (config->trim * 2 >= config->num)))                                     /* check the config */
+    {
+        return 4;                                                                /* return error */
+    }
+    
+    memset(fusion, 0, sizeof(ms5837_fusion_t));                                  /* clear the fusion */
+    fusion->config = *config;                                                    /* save the config */
+    fusion->rho_g = (int64_t)config->density * 980665 / 100;                     /* set the pressure of one meter */
+    fusion->inited = 1;                                                          /* flag inited */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      vote a set of time aligned samples
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  time_us set time
+ * @param[in]  valid valid sample bit mask
+ * @param[in]  *pressure_pa pointer to the pressures of each sensor in Pa
+ * @param[out] *result pointer to a result buffer, can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample agrees with the median
+ *             - 2 fusion or pressure_pa is NULL
+ *             - 3 fusion is not initialized
+ * @note       the median of the sensors not faulted flags the outliers, only integer math,
+ *             the faulted sensors vote when no other sensor has a sample and the quorum is 0,
+ *             no agreeing sample keeps the last pressure, only one thread can vote
+ */
+uint8_t ms5837_fusion_vote(ms5837_fusion_t *fusion, uint64_t time_us, uint8_t valid, const int32_t *pressure_pa,
+                           ms5837_fusion_result_t *result)
+{
+    ms5837_fusion_result_t res;
+    int64_t value[MS5837_FUSION_MAX];
+    int64_t sorted[MS5837_FUSION_MAX];
+    int64_t median;
+    int64_t fused;
+    int64_t sum;
+    int64_t depth;
+    int64_t distance;
+    uint8_t voting;
+    uint8_t health;
+    uint8_t used;
+    uint8_t trim;
+    uint8_t kept;
+    uint8_t i;
+    
+    if ((fusion == NULL) || (pressure_pa == NULL))                                             /* check fusion and pressure */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (fusion->inited != 1)                                                                   /* check fusion initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    
+    res = fusion->result;                                                                      /* start from the last result */
+    res.time_us = time_us;                                                                     /* set the time */
+    res.count++;                                                                               /* count the vote */
+    valid &= (uint8_t)((1 << fusion->config.num) - 1);                                         /* mask the sensors */
+    for (i = 0; i < fusion->config.num; i++)                                                   /* convert each sensor */
+    {
+        value[i] = (int64_t)pressure_pa[i];                                                    /* get the pressure */
+    }
+    voting = valid & (uint8_t)(~fusion->fault);                                                /* leave the faulted sensors out */
+    res.quorum = 1;                                                                            /* quorum by default */
+    if (voting == 0)                                                                           /* check the voting sensors */
+    {
+        voting = valid;                                                                        /* let the faulted sensors vote */
+        res.quorum = 0;                                                                        /* no quorum */
+    }
+    median = (voting != 0) ? a_fusion_median(value, fusion->config.num, voting) : 0;           /* get the median */
+    res.used = 0;                                                                              /* clear the used mask */
+    res.outlier = 0;                                                                           /* clear the outlier mask */
+    for (i = 0; i < fusion->config.num; i++)                                                   /* check each sensor */
+    {
+        distance = (value[i] > median) ? (value[i] - median) : (median - value[i]);            /* get the distance to the median */
+        if ((valid & (1 << i)) == 0)                                                           /* check the sample */
+        {
+            health = MS5837_FUSION_HEALTH_MISSING;                                             /* missing */
+        }
+        else if (distance > (int64_t)fusion->config.tolerance_pa)                              /* check the tolerance */
+        {
+            health = MS5837_FUSION_HEALTH_OUTLIER;                                             /* outlier */
+            res.outlier |= (uint8_t)(1 << i);                                                  /* flag the outlier */
+        }
+        else
+        {
+            health = MS5837_FUSION_HEALTH_OK;                                                  /* ok */
+            if ((voting & (1 << i)) != 0)                                                      /* check the voting sensor */
+            {
+                res.used |= (uint8_t)(1 << i);                                                 /* use the sensor */
+            }
+        }
+        res.health[i] = a_fusion_track(fusion, i, health);                                     /* track the health */
+    }
+    res.fault = fusion->fault;                                                                 /* set the fault mask */
+    
+    if (res.used != 0)                                                                         /* check the used sensors */
+    {
+        used = a_fusion_sort(value, fusion->config.num, res.used, sorted);                     /* sort the used sensors */
+        if (fusion->config.mode == MS5837_FUSION_MODE_TRIMMED_MEAN)                            /* check the mode */
+        {
+            trim = (uint8_t)((used - 1) / 2);                                                  /* keep one sensor at least */
+            trim = (fusion->config.trim < trim) ? fusion->config.trim : trim;                  /* limit the trim */
+            sum = 0;                                                                           /* clear the sum */
+            for (i = trim; i < used - trim; i++)                                               /* sum the kept sensors */
+            {
+                sum += sorted[i];                                                              /* sum the pressure */
+            }
+            kept = (uint8_t)(used - trim * 2);                                                 /* get the kept number */
+            fused = (sum >= 0) ? ((sum + kept / 2) / kept) : ((sum - kept / 2) / kept);        /* get the rounded mean */
+        }
+        else
+        {
+            fused = median;                                                                    /* use the median */
+        }
+        res.pressure_pa = (int32_t)fused;                                                      /* set the pressure */
+        res.spread_pa = (uint32_t)(sorted[used - 1] - sorted[0]);                              /* set the spread */
+        depth = (fused - fusion->config.surface_pa) * 1000000000LL / fusion->rho_g;            /* get the depth */
+        depth = (depth > INT32_MAX) ? INT32_MAX : depth;                                       /* limit the depth */
+        res.depth_um = (int32_t)((depth < INT32_MIN) ? INT32_MIN : depth);                     /* set the depth */
+        if (used * 2 <= fusion->config.num)                                                    /* check the quorum */
+        {
+            res.quorum = 0;                                                                    /* no quorum */
+        }
+    }
+    else
+    {
+        res.spread_pa = 0;                                                                     /* no spread */
+        res.quorum = 0;                                                                        /* no quorum */
+    }
+    
+    fusion->seq++;                                                                             /* start writing */
+    MS5837_BARRIER();                                                                          /* order the sequence and the result */
+    fusion->result = res;                                                                      /* publish the result */
+    MS5837_BARRIER();                                                                          /* order the result and the sequence */
+    fusion->seq++;                                                                             /* stop writing */
+    if (result != NULL)                                                                        /* check the result buffer */
+    {
+        *result = res;                                                                         /* copy the result */
+    }
+    
+    return (res.used != 0) ? 0 : 1;                                                            /* return the vote status */
+}
+
+/**
+ * @brief      get the last result
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no vote yet
+ *             - 2 fusion is NULL
+ *             - 3 fusion is not initialized
+ * @note       a new result has a new count
+ */
+uint8_t ms5837_fusion_get(ms5837_fusion_t *fusion, ms5837_fusion_result_t *result)
+{
+    uint32_t seq;
+    
+    if (fusion == NULL)                                        /* check fusion */
+    {
+        return 2;                                              /* return error */
+    }
+    if (fusion->inited != 1)                                   /* check fusion initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    
+    do
+    {
+        seq = fusion->seq;                                     /* get the sequence */
+        MS5837_BARRIER();                                      /* order the sequence and the result */
+        *result = fusion->result;                              /* copy the result */
+        MS5837_BARRIER();                                      /* order the result and the sequence */
+    } while (((seq & 1) != 0) || (seq != fusion->seq));        /* retry a torn copy */
+    if (result->count == 0)                                    /* check the count */
+    {
+        return 1;                                              /* no vote yet */
+    }
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the statistics of a sensor
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  index sensor index
+ * @param[out] *outliers pointer to an outlier set count buffer
+ * @param[out] *missing pointer to a missing set count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 fusion is NULL
+ *             - 3 fusion is not initialized
+ *             - 4 index is invalid
+ * @note       read it from the voting thread
+ */
+uint8_t ms5837_fusion_get_stats(ms5837_fusion_t *fusion, uint8_t index, uint32_t *outliers, uint32_t *missing)
+{
+    if (fusion == NULL)                         /* check fusion */
+    {
+        return 2;                               /* return error */
+    }
+    if (fusion->inited != 1)                    /* check fusion initialization */
+    {
+        return 3;                               /* return error */
+    }
+    if (index >= fusion->config.num)            /* check the index */
+    {
+        return 4;                               /* return error */
+    }
+    
+    *outliers = fusion->outliers[index];        /* get the outliers */
+    *missing = fusion->missing[index];          /* get the missing sets */
+    
+    return 0;                                   /* success return 0 */
+}
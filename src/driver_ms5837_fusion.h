@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_fusion.h
+ * @brief     driver ms5837 fusion header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_FUSION_H
+#define DRIVER_MS5837_FUSION_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_fusion_driver ms5837 fusion driver function
+ * @brief    ms5837 fusion driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 fusion max sensor number definition
+ */
+#define MS5837_FUSION_MAX        8        /**< max sensor number */
+
+/**
+ * @brief ms5837 fusion mode enumeration definition
+ */
+typedef enum
+{
+    MS5837_FUSION_MODE_MEDIAN       = 0x00,        /**< median of the voting sensors */
+    MS5837_FUSION_MODE_TRIMMED_MEAN = 0x01,        /**< mean of the agreeing voting sensors without the trim lowest and highest ones */
+} ms5837_fusion_mode_t;
+
+/**
+ * @brief ms5837 fusion health enumeration definition
+ */
+typedef enum
+{
+    MS5837_FUSION_HEALTH_OK      = 0x00,        /**< inside the tolerance of the median */
+    MS5837_FUSION_HEALTH_MISSING = 0x01,        /**< no sample in the set */
+    MS5837_FUSION_HEALTH_OUTLIER = 0x02,        /**< outside the tolerance of the median */
+    MS5837_FUSION_HEALTH_FAULT   = 0x03,        /**< left out of the vote after bad sets in a row */
+} ms5837_fusion_health_t;
+
+/**
+ * @brief ms5837 fusion config structure definition
+ */
+typedef struct ms5837_fusion_config_s
+{
+    uint8_t num;                                   /**< sensor number in [1, MS5837_FUSION_MAX] */
+    ms5837_fusion_mode_t mode;                     /**< fusion mode */
+    uint8_t trim;                                  /**< sensors dropped from each end of the trimmed mean, 2 * trim < num */
+    int32_t surface_pa;                            /**< pressure at the surface in Pa */
+    uint32_t density;                              /**< water density in kg/m3 in [500, 2000] */
+    uint32_t tolerance_pa;                         /**< max distance from the median of an agreeing sensor in Pa */
+    uint8_t fault_count;                           /**< bad sets in a row to fault a sensor and good sets in a row to recover it */
+} ms5837_fusion_config_t;
+
+/**
+ * @brief ms5837 fusion result structure definition
+ */
+typedef struct ms5837_fusion_result_s
+{
+    uint64_t time_us;                              /**< set time */
+    uint32_t count;                                /**< vote count */
+    int32_t pressure_pa;                           /**< fused pressure in Pa */
+    int32_t depth_um;                              /**< fused depth in um */
+    uint32_t spread_pa;                            /**< spread of the fused sensors in Pa */
+    uint8_t used;                                  /**< fused sensor bit mask */
+    uint8_t outlier;                               /**< outlier sensor bit mask */
+    uint8_t fault;                                 /**< faulted sensor bit mask */
+    uint8_t quorum;                                /**< 1 when more than half of the sensors are fused */
+    uint8_t health[MS5837_FUSION_MAX];             /**< health of each sensor */
+} ms5837_fusion_result_t;
+
+/**
+ * @brief ms5837 fusion structure definition
+ */
+typedef struct ms5837_fusion_s
+{
+    ms5837_fusion_config_t config;                 /**< config */
+    int64_t rho_g;                                 /**< density times gravity in mPa/m */
+    uint8_t bad[MS5837_FUSION_MAX];                /**< bad sets in a row */
+    uint8_t good[MS5837_FUSION_MAX];               /**< good sets in a row of a faulted sensor */
+    uint32_t outliers[MS5837_FUSION_MAX];          /**< outlier sets */
+    uint32_t missing[MS5837_FUSION_MAX];           /**< missing sets */
+    uint8_t fault;                                 /**< faulted sensor bit mask */
+    ms5837_fusion_result_t result;                 /**< last result */
+    volatile uint32_t seq;                         /**< odd while the result is written */
+    uint8_t inited;                                /**< inited flag */
+} ms5837_fusion_t;
+
+/**
+ * @brief     initialize a fusion stage
+ * @param[in] *fusion pointer to a fusion structure
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 fusion or config is NULL
+ *            - 4 config is invalid
+ * @note      none
+ */
+uint8_t ms5837_fusion_init(ms5837_fusion_t *fusion, const ms5837_fusion_config_t *config);
+
+/**
+ * @brief      vote a set of time aligned samples
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  time_us set time
+ * @param[in]  valid valid sample bit mask
+ * @param[in]  *pressure_pa pointer to the pressures of each sensor in Pa
+ * @param[out] *result pointer to a result buffer, can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample agrees with the median
+ *             - 2 fusion or pressure_pa is NULL
+ *             - 3 fusion is not initialized
+ * @note       the median of the sensors not faulted flags the outliers, only integer math,
+ *             the faulted sensors vote when no other sensor has a sample and the quorum is 0,
+ *             no agreeing sample keeps the last pressure, only one thread can vote
+ */
+uint8_t ms5837_fusion_vote(ms5837_fusion_t *fusion, uint64_t time_us, uint8_t valid, const int32_t *pressure_pa,
+                           ms5837_fusion_result_t *result);
+
+/**
+ * @brief      get the last result
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no vote yet
+ *             - 2 fusion is NULL
+ *             - 3 fusion is not initialized
+ * @note       a new result has a new count
+ */
+uint8_t ms5837_fusion_get(ms5837_fusion_t *fusion, ms5837_fusion_result_t *result);
+
+/**
+ * @brief      get the statistics of a sensor
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  index sensor index
+ * @param[out] *outliers pointer to an outlier set count buffer
+ * @param[out] *missing pointer to a missing set count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 fusion is NULL
+ *             - 3 fusion is not initialized
+ *             - 4 index is invalid
+ * @note       read it from the voting thread
+ */
+uint8_t ms5837_fusion_get_stats(ms5837_fusion_t *fusion, uint8_t index, uint32_t *outliers, uint32_t *missing);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
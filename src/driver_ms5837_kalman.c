@@ -0,0 +1,414 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_kalman.c
+ * @brief     driver ms5837 kalman source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_kalman.h"
+
+/**
+ * @brief kalman limit definition
+ */
+#define MS5837_KALMAN_ONE          65536LL               /**< one in 16 fraction bits */
+#define MS5837_KALMAN_GAP          (4 * 65536LL)         /**< longest extrapolation in periods */
+#define MS5837_KALMAN_P_MAX        68719476736LL         /**< covariance limit keeping the products in 64 bits */
+#define MS5837_KALMAN_Y_MAX        1099511627776LL       /**< innovation limit */
+#define MS5837_KALMAN_K_MAX        1048576LL             /**< gain limit */
+#define MS5837_KALMAN_RATE_MAX     1099511627776LL       /**< velocity and acceleration limit */
+#define MS5837_KALMAN_INT32_MAX    2147483647LL          /**< output limit */
+
+/**
+ * @brief     clamp a value
+ * @param[in] value input value
+ * @param[in] limit positive limit
+ * @return    clamped value
+ * @note      none
+ */
+static int64_t a_kalman_clamp(int64_t value, int64_t limit)
+{
+    if (value > limit)
+    {
+        return limit;
+    }
+    if (value < -limit)
+    {
+        return -limit;
+    }
+    
+    return value;
+}
+
+/**
+ * @brief     get the integer square root
+ * @param[in] value input value
+ * @return    square root rounded down
+ * @note      a fixed count of steps
+ */
+static uint32_t a_kalman_sqrt(uint64_t value)
+{
+    uint64_t res;
+    uint64_t bit;
+    
+    res = 0;
+    bit = 1ULL << 62;
+    while (bit != 0)
+    {
+        if (value >= res + bit)
+        {
+            value -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    
+    return (uint32_t)res;
+}
+
+/**
+ * @brief     get the depth of a pressure
+ * @param[in] *kalman pointer to a kalman structure
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    depth in um
+ * @note      none
+ */
+static int64_t a_kalman_depth(ms5837_kalman_t *kalman, int32_t pressure)
+{
+    int64_t pa;
+    
+    pa = (int64_t)pressure * kalman->pa - kalman->surface_pa;
+    
+    return pa * 1000000000LL / kalman->rho_g;
+}
+
+/**
+ * @brief         predict the state and the covariance
+ * @param[in,out] *kalman pointer to a kalman structure
+ * @param[in]     t elapsed periods with 16 fraction bits
+ * @note          constant acceleration with a discrete white acceleration change
+ */
+static void a_kalman_predict(ms5837_kalman_t *kalman, int64_t t)
+{
+    int64_t f[3][3];
+    int64_t fp[3][3];
+    int64_t g[3];
+    int64_t half;
+    int64_t sum;
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+    
+    half = t * t / MS5837_KALMAN_ONE / 2;
+    kalman->x[0] += kalman->x[1] * t / MS5837_KALMAN_ONE + kalman->x[2] * half / MS5837_KALMAN_ONE;
+    kalman->x[1] += kalman->x[2] * t / MS5837_KALMAN_ONE;
+    
+    f[0][0] = MS5837_KALMAN_ONE;
+    f[0][1] = t;
+    f[0][2] = half;
+    f[1][0] = 0;
+    f[1][1] = MS5837_KALMAN_ONE;
+    f[1][2] = t;
+    f[2][0] = 0;
+    f[2][1] = 0;
+    f[2][2] = MS5837_KALMAN_ONE;
+    g[0] = half;
+    g[1] = t;
+    g[2] = MS5837_KALMAN_ONE;
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            sum = 0;
+            for (k = i; k < 3; k++)
+            {
+                sum += f[i][k] * kalman->p[k][j];
+            }
+            fp[i][j] = sum / MS5837_KALMAN_ONE;
+        }
+    }
+    for (i = 0; i < 3; i++)
+    {
+        for (j = i; j < 3; j++)
+        {
+            sum = 0;
+            for (k = j; k < 3; k++)
+            {
+                sum += fp[i][k] * f[j][k];
+            }
+            sum = sum / MS5837_KALMAN_ONE + kalman->q * g[i] / MS5837_KALMAN_ONE * g[j] / MS5837_KALMAN_ONE;
+            if (i == j)
+            {
+                sum = (sum < 0) ? 0 : a_kalman_clamp(sum, MS5837_KALMAN_P_MAX);
+            }
+            else
+            {
+                sum = a_kalman_clamp(sum, MS5837_KALMAN_P_MAX);
+            }
+            kalman->p[i][j] = sum;
+            kalman->p[j][i] = sum;
+        }
+    }
+}
+
+/**
+ * @brief     correct the state and the covariance with a depth
+ * @param[in] *kalman pointer to a kalman structure
+ * @param[in] z measured depth in um
+ * @note      none
+ */
+static void a_kalman_correct(ms5837_kalman_t *kalman, int64_t z)
+{
+    int64_t k[3];
+    int64_t p0[3];
+    int64_t s;
+    int64_t y;
+    int64_t sum;
+    uint8_t i;
+    uint8_t j;
+    
+    s = kalman->p[0][0] + kalman->r;
+    y = a_kalman_clamp(z * MS5837_KALMAN_ONE - kalman->x[0], MS5837_KALMAN_Y_MAX);
+    for (i = 0; i < 3; i++)
+    {
+        p0[i] = kalman->p[0][i];
+        k[i] = a_kalman_clamp(kalman->p[i][0] * MS5837_KALMAN_ONE / s, MS5837_KALMAN_K_MAX);
+        kalman->x[i] += k[i] * y / MS5837_KALMAN_ONE;
+    }
+    kalman->x[1] = a_kalman_clamp(kalman->x[1], MS5837_KALMAN_RATE_MAX);
+    kalman->x[2] = a_kalman_clamp(kalman->x[2], MS5837_KALMAN_RATE_MAX);
+    for (i = 0; i < 3; i++)
+    {
+        for (j = i; j < 3; j++)
+        {
+            sum = (kalman->p[i][j] - k[i] * p0[j] / MS5837_KALMAN_ONE +
+                   kalman->p[j][i] - k[j] * p0[i] / MS5837_KALMAN_ONE) / 2;
+            if (i == j)
+            {
+                sum = (sum < 1) ? 1 : a_kalman_clamp(sum, MS5837_KALMAN_P_MAX);
+            }
+            else
+            {
+                sum = a_kalman_clamp(sum, MS5837_KALMAN_P_MAX);
+            }
+            kalman->p[i][j] = sum;
+            kalman->p[j][i] = sum;
+        }
+    }
+}
+
+/**
+ * @brief     initialize a kalman filter
+ * @param[in] *kalman pointer to a kalman structure
+ * @param[in] type chip type of the samples
+ * @param[in] period_us nominal update period in [1000, 1000000]
+ * @param[in] surface pressure at the surface from ms5837_compensate
+ * @param[in] density water density in kg/m3 in [500, 2000]
+ * @param[in] noise_um depth noise of one sample in um in [1, 65535]
+ * @param[in] accel_um_s2 acceleration change in one period in um/s2 in [1, 100000000]
+ * @return    status code
+ *            - 0 success
+ *            - 2 kalman is NULL
+ *            - 4 param is invalid
+ * @note      a larger accel_um_s2 follows manoeuvres faster, a smaller one gives a smoother state
+ */
+uint8_t ms5837_kalman_init(ms5837_kalman_t *kalman, ms5837_type_t type, uint32_t period_us, int32_t surface,
+                           uint32_t density, uint32_t noise_um, uint32_t accel_um_s2)
+{
+    int64_t sa;
+    
+    if (kalman == NULL)                                                        /* check kalman */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((period_us < 1000) || (period_us > 1000000) ||
+        (density < 500) || (density > 2000) || (noise_um < 1) || (noise_um > 65535) ||
+        (accel_um_s2 < 1) || (accel_um_s2 > 100000000))                        /* check the params */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    memset(kalman, 0, sizeof(ms5837_kalman_t));                                /* clear the filter */
+    kalman->pa = (type == MS5837_TYPE_30BA26) ? 10 : 1;                        /* set the pressure unit */
+    kalman->surface_pa = (int64_t)surface * kalman->pa;                        /* set the surface pressure */
+    kalman->rho_g = (int64_t)density * 980665 / 100;                           /* set the pressure of one meter */
+    kalman->period_us = period_us;                                             /* set the period */
+    kalman->r = (int64_t)noise_um * noise_um;                                  /* set the measurement variance */
+    sa = (int64_t)accel_um_s2 * period_us / 1000 * period_us / 3906250;        /* get the period acceleration change */
+    sa = a_kalman_clamp(sa, 16777216);                                         /* limit the acceleration change */
+    kalman->q = (sa * sa + 32768) / 65536;                                     /* set the process variance */
+    if (kalman->q < 1)                                                         /* check the process variance */
+    {
+        kalman->q = 1;                                                         /* keep some process noise */
+    }
+    kalman->inited = 1;                                                        /* flag inited */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     update a kalman filter with a sample
+ * @param[in] *kalman pointer to a kalman structure
+ * @param[in] time_us sample time
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 2 kalman is NULL
+ *            - 3 kalman is not initialized
+ *            - 4 time is not after the last update
+ * @note      only integer math with a fixed count of steps, only one thread can update,
+ *            a gap over 4 periods restarts the filter at the sample
+ */
+uint8_t ms5837_kalman_update(ms5837_kalman_t *kalman, uint64_t time_us, int32_t pressure)
+{
+    int64_t z;
+    int64_t t;
+    uint64_t elapsed;
+    
+    if (kalman == NULL)                                                             /* check kalman */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (kalman->inited != 1)                                                        /* check kalman initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if ((kalman->count != 0) && (time_us <= kalman->time_us))                       /* check the time */
+    {
+        return 4;                                                                   /* return error */
+    }
+    
+    z = a_kalman_depth(kalman, pressure);                                           /* get the depth */
+    kalman->seq++;                                                                  /* start writing */
+    MS5837_BARRIER();                                                               /* order the sequence and the state */
+    elapsed = time_us - kalman->time_us;                                            /* get the elapsed time */
+    if ((kalman->count == 0) || (elapsed > (uint64_t)kalman->period_us * 4))        /* check the first sample or a gap */
+    {
+        memset(kalman->p, 0, sizeof(kalman->p));                                    /* clear the covariance */
+        kalman->x[0] = z * MS5837_KALMAN_ONE;                                       /* start at the depth */
+        kalman->x[1] = 0;                                                           /* no velocity yet */
+        kalman->x[2] = 0;                                                           /* no acceleration yet */
+        kalman->p[0][0] = kalman->r;                                                /* set the depth variance */
+        kalman->p[1][1] = kalman->r;                                                /* set the velocity variance */
+        kalman->p[2][2] = kalman->r;                                                /* set the acceleration variance */
+    }
+    else
+    {
+        t = (int64_t)elapsed * MS5837_KALMAN_ONE / kalman->period_us;               /* get the elapsed periods */
+        a_kalman_predict(kalman, t);                                                /* predict */
+        a_kalman_correct(kalman, z);                                                /* correct with the depth */
+    }
+    kalman->time_us = time_us;                                                      /* save the time */
+    kalman->count++;                                                                /* count the update */
+    MS5837_BARRIER();                                                               /* order the state and the sequence */
+    kalman->seq++;                                                                  /* stop writing */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the state at a time
+ * @param[in]  *kalman pointer to a kalman structure
+ * @param[in]  time_us query time, a time before the last update gets the last update
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no update yet
+ *             - 2 kalman is NULL
+ *             - 3 kalman is not initialized
+ * @note       the depth and the velocity are extrapolated up to 4 periods
+ */
+uint8_t ms5837_kalman_get(ms5837_kalman_t *kalman, uint64_t time_us, ms5837_kalman_state_t *state)
+{
+    uint32_t seq;
+    uint32_t count;
+    uint64_t last;
+    int64_t x[3];
+    int64_t p;
+    int64_t t;
+    int64_t half;
+    int64_t value;
+    
+    if (kalman == NULL)                                                                          /* check kalman */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (kalman->inited != 1)                                                                     /* check kalman initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    do
+    {
+        seq = kalman->seq;                                                                       /* get the sequence */
+        MS5837_BARRIER();                                                                        /* order the sequence and the state */
+        count = kalman->count;                                                                   /* copy the count */
+        last = kalman->time_us;                                                                  /* copy the time */
+        x[0] = kalman->x[0];                                                                     /* copy the depth */
+        x[1] = kalman->x[1];                                                                     /* copy the velocity */
+        x[2] = kalman->x[2];                                                                     /* copy the acceleration */
+        p = kalman->p[0][0];                                                                     /* copy the depth variance */
+        MS5837_BARRIER();                                                                        /* order the state and the sequence */
+    } while (((seq & 1) != 0) || (seq != kalman->seq));                                          /* retry a torn copy */
+    if (count == 0)                                                                              /* check the count */
+    {
+        return 1;                                                                                /* no update yet */
+    }
+    
+    t = 0;                                                                                       /* no extrapolation */
+    if (time_us > last)                                                                          /* check the direction */
+    {
+        if (time_us - last >= (uint64_t)kalman->period_us * 4)                                   /* check the distance */
+        {
+            t = MS5837_KALMAN_GAP;                                                               /* limit the gap */
+        }
+        else
+        {
+            t = (int64_t)(time_us - last) * MS5837_KALMAN_ONE / kalman->period_us;               /* get the elapsed periods */
+        }
+    }
+    half = t * t / MS5837_KALMAN_ONE / 2;                                                        /* get the half squared periods */
+    x[0] += x[1] * t / MS5837_KALMAN_ONE + x[2] * half / MS5837_KALMAN_ONE;                      /* extrapolate the depth */
+    x[1] += x[2] * t / MS5837_KALMAN_ONE;                                                        /* extrapolate the velocity */
+    value = x[0] / MS5837_KALMAN_ONE;                                                            /* get the depth */
+    state->depth_um = (int32_t)a_kalman_clamp(value, MS5837_KALMAN_INT32_MAX);                   /* set the depth */
+    value = x[1] * 1000000 / kalman->period_us / MS5837_KALMAN_ONE;                              /* get the velocity */
+    state->velocity_um_s = (int32_t)a_kalman_clamp(value, MS5837_KALMAN_INT32_MAX);              /* set the velocity */
+    value = x[2] * 1000000 / kalman->period_us / 256 * 1000000 / kalman->period_us / 256;        /* get the acceleration */
+    state->acceleration_um_s2 = (int32_t)a_kalman_clamp(value, MS5837_KALMAN_INT32_MAX);         /* set the acceleration */
+    state->depth_std_um = a_kalman_sqrt((uint64_t)p);                                            /* set the depth deviation */
+    
+    return 0;                                                                                    /* success return 0 */
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_kalman.h
+ * @brief     driver ms5837 kalman header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_KALMAN_H
+#define DRIVER_MS5837_KALMAN_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_kalman_driver ms5837 kalman driver function
+ * @brief    ms5837 kalman driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 kalman state structure definition
+ * @note  depth, velocity and acceleration point down
+ */
+typedef struct ms5837_kalman_state_s
+{
+    int32_t depth_um;                  /**< depth in um */
+    int32_t velocity_um_s;             /**< vertical velocity in um/s */
+    int32_t acceleration_um_s2;        /**< vertical acceleration in um/s2 */
+    uint32_t depth_std_um;             /**< depth standard deviation at the last update in um */
+} ms5837_kalman_state_t;
+
+/**
+ * @brief ms5837 kalman structure definition
+ * @note  the state is kept in um, um per period and um per period squared with 16 fraction bits,
+ *        the covariance in the squares of those units with 8 fraction bits,
+ *        one thread updates while other threads get the state at the same time
+ */
+typedef struct ms5837_kalman_s
+{
+    int64_t x[3];                   /**< depth, velocity and acceleration */
+    int64_t p[3][3];                /**< covariance */
+    int64_t r;                      /**< measurement variance */
+    int64_t q;                      /**< variance of the acceleration change in one period */
+    int64_t surface_pa;             /**< surface pressure in Pa */
+    int64_t rho_g;                  /**< density times gravity in mPa/m */
+    uint64_t time_us;               /**< time of the last update */
+    uint32_t period_us;             /**< nominal update period */
+    uint32_t pa;                    /**< Pa of one pressure count */
+    uint32_t count;                 /**< update count */
+    volatile uint32_t seq;          /**< odd while the state is written */
+    uint8_t inited;                 /**< inited flag */
+} ms5837_kalman_t;
+
+/**
+ * @brief     initialize a kalman filter
+ * @param[in] *kalman pointer to a kalman structure
+ * @param[in] type chip type of the samples
+ * @param[in] period_us nominal update period in [1000, 1000000]
+ * @param[in] surface pressure at the surface from ms5837_compensate
+ * @param[in] density water density in kg/m3 in [500, 2000]
+ * @param[in] noise_um depth noise of one sample in um in [1, 65535]
+ * @param[in] accel_um_s2 acceleration change in one period in um/s2 in [1, 100000000]
+ * @return    status code
+ *            - 0 success
+ *            - 2 kalman is NULL
+ *            - 4 param is invalid
+ * @note      a larger accel_um_s2 follows manoeuvres faster, a smaller one gives a smoother state
+ */
+uint8_t ms5837_kalman_init(ms5837_kalman_t *kalman, ms5837_type_t type, uint32_t period_us, int32_t surface,
+                           uint32_t density, uint32_t noise_um, uint32_t accel_um_s2);
+
+/**
+ * @brief     update a kalman filter with a sample
+ * @param[in] *kalman pointer to a kalman structure
+ * @param[in] time_us sample time
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 2 kalman is NULL
+ *            - 3 kalman is not initialized
+ *            - 4 time is not after the last update
+ * @note      only integer math with a fixed count of steps, only one thread can update,
+ *            a gap over 4 periods restarts the filter at the sample
+ */
+uint8_t ms5837_kalman_update(ms5837_kalman_t *kalman, uint64_t time_us, int32_t pressure);
+
+/**
+ * @brief      get the state at a time
+ * @param[in]  *kalman pointer to a kalman structure
+ * @param[in]  time_us query time, a time before the last update gets the last update
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no update yet
+ *             - 2 kalman is NULL
+ *             - 3 kalman is not initialized
+ * @note       the depth and the velocity are extrapolated up to 4 periods
+ */
+uint8_t ms5837_kalman_get(ms5837_kalman_t *kalman, uint64_t time_us, ms5837_kalman_state_t *state);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
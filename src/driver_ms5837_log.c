@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_log.c
+ * @brief     driver ms5837 log source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_log.h"
+
+/**
+ * @brief log text structure definition
+ */
+typedef struct log_text_s
+{
+    uint16_t id;                /**< event id */
+    const char *format;         /**< text format with the argument */
+} log_text_t;
+
+/**
+ * @brief log text table definition
+ */
+static const log_text_t gs_log_text[] =
+{
+    {MS5837_EVENT_CONVERT,            "convert command 0x%02X"},
+    {MS5837_EVENT_ADC,                "adc raw %u"},
+    {MS5837_EVENT_RETRY,              "retry register 0x%02X"},
+    {MS5837_EVENT_RESYNC,             "resync"},
+    {MS5837_EVENT_CONFIG,             "config ticket %u"},
+    {MS5837_EVENT_SENT_D1_FAILED,     "sent d1 failed, osr %u"},
+    {MS5837_EVENT_SENT_D2_FAILED,     "sent d2 failed, osr %u"},
+    {MS5837_EVENT_READ_ADC_FAILED,    "read adc failed"},
+    {MS5837_EVENT_RESET_FAILED,       "reset failed"},
+    {MS5837_EVENT_READ_PROM_FAILED,   "read prom failed"},
+    {MS5837_EVENT_PROM_CHANGED,       "prom changed, word 0x%04X"},
+    {MS5837_EVENT_BUS_RECOVER_FAILED, "bus recover failed"},
+};
+
+/**
+ * @brief     initialize the log
+ * @param[in] *log pointer to a log structure
+ * @param[in] *buf pointer to an event buffer
+ * @param[in] size event buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 log is NULL
+ *            - 4 buffer is invalid
+ * @note      none
+ */
+uint8_t ms5837_log_init(ms5837_log_t *log, ms5837_log_event_t *buf, uint32_t size)
+{
+    if (log == NULL)                        /* check log */
+    {
+        return 2;                           /* return error */
+    }
+    if ((buf == NULL) || (size == 0))       /* check buffer */
+    {
+        return 4;                           /* return error */
+    }
+    
+    log->buf = buf;                         /* set the buffer */
+    log->size = size;                       /* set the size */
+    log->head = 0;                          /* clear the head */
+    log->tail = 0;                          /* clear the tail */
+    log->dropped = 0;                       /* clear the dropped */
+    log->inited = 1;                        /* flag inited */
+    
+    return 0;                               /* success return 0 */
+}
+
+/**
+ * @brief     push an event
+ * @param[in] *log pointer to a log structure
+ * @param[in] source event source
+ * @param[in] timestamp_us event time in us
+ * @param[in] id event id
+ * @param[in] arg event argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 log is full
+ *            - 2 log is NULL
+ *            - 3 log is not initialized
+ * @note      it only stores the event, a full log drops the new event and counts it
+ */
+uint8_t ms5837_log_push(ms5837_log_t *log, uint8_t source, uint32_t timestamp_us, uint16_t id, uint32_t arg)
+{
+    uint32_t head;
+    ms5837_log_event_t *event;
+    
+    if (log == NULL)                                  /* check log */
+    {
+        return 2;                                     /* return error */
+    }
+    if (log->inited != 1)                             /* check log initialization */
+    {
+        return 3;                                     /* return error */
+    }
+    
+    head = log->head;                                 /* get the head */
+    if ((head - log->tail) >= log->size)              /* check the space */
+    {
+        log->dropped++;                               /* count the dropped */
+        
+        return 1;                                     /* return error */
+    }
+    event = &log->buf[head % log->size];              /* get the slot */
+    event->timestamp_us = timestamp_us;               /* set the time */
+    event->arg = arg;                                 /* set the argument */
+    event->id = id;                                   /* set the id */
+    event->source = source;                           /* set the source */
+    event->reserved = 0;                              /* clear the reserved */
+    MS5837_BARRIER();                                 /* publish the event before the head */
+    log->head = head + 1;                             /* update the head */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief      pop an event
+ * @param[in]  *log pointer to a log structure
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 log is empty
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       none
+ */
+uint8_t ms5837_log_pop(ms5837_log_t *log, ms5837_log_event_t *event)
+{
+    uint32_t tail;
+    
+    if (log == NULL)                                  /* check log */
+    {
+        return 2;                                     /* return error */
+    }
+    if (log->inited != 1)                             /* check log initialization */
+    {
+        return 3;                                     /* return error */
+    }
+    
+    tail = log->tail;                                 /* get the tail */
+    if (tail == log->head)                            /* check the events */
+    {
+        return 1;                                     /* return error */
+    }
+    MS5837_BARRIER();                                 /* read the event after the head */
+    *event = log->buf[tail % log->size];              /* copy the event */
+    MS5837_BARRIER();                                 /* release the slot after the copy */
+    log->tail = tail + 1;                             /* update the tail */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the dropped event number
+ * @param[in]  *log pointer to a log structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       none
+ */
+uint8_t ms5837_log_get_dropped(ms5837_log_t *log, uint32_t *dropped)
+{
+    if (log == NULL)                    /* check log */
+    {
+        return 2;                       /* return error */
+    }
+    if (log->inited != 1)               /* check log initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    *dropped = log->dropped;            /* get the dropped */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief      decode an event to text
+ * @param[in]  *event pointer to an event structure
+ * @param[out] *buf pointer to a text buffer
+ * @param[in]  len text buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 2 event is NULL
+ *             - 4 buffer is invalid
+ * @note       it formats the text away from the acquisition, unknown ids are printed as numbers
+ */
+uint8_t ms5837_log_decode(const ms5837_log_event_t *event, char *buf, uint16_t len)
+{
+    uint32_t i;
+    int n;
+    
+    if (event == NULL)                                                                  /* check event */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if ((buf == NULL) || (len == 0))                                                    /* check buffer */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    n = snprintf(buf, len, "ms5837: %10u us source %u ",
+                 (unsigned int)event->timestamp_us, (unsigned int)event->source);       /* print the head */
+    if ((n < 0) || (n >= (int)len))                                                     /* check the length */
+    {
+        return 0;                                                                       /* truncated */
+    }
+    for (i = 0; i < sizeof(gs_log_text) / sizeof(gs_log_text[0]); i++)                  /* find the text */
+    {
+        if (gs_log_text[i].id == event->id)                                             /* found */
+        {
+            (void)snprintf(buf + n, len - n, gs_log_text[i].format,
+                           (unsigned int)event->arg);                                   /* print the text */
+            
+            return 0;                                                                   /* success return 0 */
+        }
+    }
+    (void)snprintf(buf + n, len - n, "event 0x%04X arg %u",
+                   (unsigned int)event->id, (unsigned int)event->arg);                  /* print the numbers */
+    
+    return 0;                                                                           /* success return 0 */
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_log.h
+ * @brief     driver ms5837 log header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_LOG_H
+#define DRIVER_MS5837_LOG_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_log_driver ms5837 log driver function
+ * @brief    ms5837 log driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 log event structure definition
+ */
+typedef struct ms5837_log_event_s
+{
+    uint32_t timestamp_us;        /**< event time in us */
+    uint32_t arg;                 /**< event argument */
+    uint16_t id;                  /**< event id */
+    uint8_t source;               /**< event source */
+    uint8_t reserved;             /**< reserved */
+} ms5837_log_event_t;
+
+/**
+ * @brief ms5837 log structure definition
+ * @note  one producer and one consumer can run at the same time without a lock
+ */
+typedef struct ms5837_log_s
+{
+    ms5837_log_event_t *buf;        /**< event buffer */
+    uint32_t size;                  /**< event buffer size */
+    volatile uint32_t head;         /**< written events, only changed by the producer */
+    volatile uint32_t tail;         /**< read events, only changed by the consumer */
+    volatile uint32_t dropped;      /**< dropped events */
+    uint8_t inited;                 /**< inited flag */
+} ms5837_log_t;
+
+/**
+ * @brief     initialize the log
+ * @param[in] *log pointer to a log structure
+ * @param[in] *buf pointer to an event buffer
+ * @param[in] size event buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 log is NULL
+ *            - 4 buffer is invalid
+ * @note      none
+ */
+uint8_t ms5837_log_init(ms5837_log_t *log, ms5837_log_event_t *buf, uint32_t size);
+
+/**
+ * @brief     push an event
+ * @param[in] *log pointer to a log structure
+ * @param[in] source event source
+ * @param[in] timestamp_us event time in us
+ * @param[in] id event id
+ * @param[in] arg event argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 log is full
+ *            - 2 log is NULL
+ *            - 3 log is not initialized
+ * @note      it only stores the event, a full log drops the new event and counts it
+ */
+uint8_t ms5837_log_push(ms5837_log_t *log, uint8_t source, uint32_t timestamp_us, uint16_t id, uint32_t arg);
+
+/**
+ * @brief      pop an event
+ * @param[in]  *log pointer to a log structure
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 log is empty
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       none
+ */
+uint8_t ms5837_log_pop(ms5837_log_t *log, ms5837_log_event_t *event);
+
+/**
+ * @brief      get the dropped event number
+ * @param[in]  *log pointer to a log structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       none
+ */
+uint8_t ms5837_log_get_dropped(ms5837_log_t *log, uint32_t *dropped);
+
+/**
+ * @brief      decode an event to text
+ * @param[in]  *event pointer to an event structure
+ * @param[out] *buf pointer to a text buffer
+ * @param[in]  len text buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 2 event is NULL
+ *             - 4 buffer is invalid
+ * @note       it formats the text away from the acquisition, unknown ids are printed as numbers
+ */
+uint8_t ms5837_log_decode(const ms5837_log_event_t *event, char *buf, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_predict.c
+ * @brief     driver ms5837 predict source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_predict.h"
+#include <math.h>
+
+/**
+ * @brief predict smoothing definition
+ */
+#define MS5837_PREDICT_SMOOTH        0.05f        /**< weight of a new interval and error */
+
+/**
+ * @brief     initialize a predictor
+ * @param[in] *predict pointer to a predict structure
+ * @param[in] alpha pressure gain in (0, 1]
+ * @param[in] beta rate gain in [0, 2 - alpha) and not above alpha * alpha / (1 - alpha / 2)
+ * @return    status code
+ *            - 0 success
+ *            - 2 predict is NULL
+ *            - 4 gain is invalid
+ * @note      a larger alpha follows the samples closer, a larger beta follows rate changes faster,
+ *            0.5 and 0.1 suit a slowly changing depth
+ */
+uint8_t ms5837_predict_init(ms5837_predict_t *predict, float alpha, float beta)
+{
+    if (predict == NULL)                                       /* check predict */
+    {
+        return 2;                                              /* return error */
+    }
+    if ((alpha <= 0.0f) || (alpha > 1.0f) || (beta < 0.0f) || (beta >= 2.0f - alpha) ||
+        (beta > alpha * alpha / (1.0f - alpha / 2.0f)))        /* check the gains */
+    {
+        return 4;                                              /* return error */
+    }
+    
+    memset(predict, 0, sizeof(ms5837_predict_t));              /* clear the predictor */
+    predict->alpha = alpha;                                    /* set the alpha */
+    predict->beta = beta;                                      /* set the beta */
+    predict->inited = 1;                                       /* flag inited */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief     reset a predictor
+ * @param[in] *predict pointer to a predict structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 predict is NULL
+ *            - 3 predict is not initialized
+ * @note      the gains are kept
+ */
+uint8_t ms5837_predict_reset(ms5837_predict_t *predict)
+{
+    if (predict == NULL)             /* check predict */
+    {
+        return 2;                    /* return error */
+    }
+    if (predict->inited != 1)        /* check predict initialization */
+    {
+        return 3;                    /* return error */
+    }
+    
+    predict->seq++;                  /* start writing */
+    MS5837_BARRIER();                /* order the sequence and the state */
+    predict->count = 0;              /* clear the count */
+    predict->rate = 0.0f;            /* clear the rate */
+    predict->variance = 0.0f;        /* clear the variance */
+    predict->interval = 0.0f;        /* clear the interval */
+    MS5837_BARRIER();                /* order the state and the sequence */
+    predict->seq++;                  /* stop writing */
+    
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief     update a predictor with a sample
+ * @param[in] *predict pointer to a predict structure
+ * @param[in] time_us sample time
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 2 predict is NULL
+ *            - 3 predict is not initialized
+ *            - 4 time is not after the last update
+ * @note      only one thread can update
+ */
+uint8_t ms5837_predict_update(ms5837_predict_t *predict, uint64_t time_us, int32_t pressure)
+{
+    float dt;
+    float error;
+    float square;
+    float value;
+    
+    if (predict == NULL)                                                                      /* check predict */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (predict->inited != 1)                                                                 /* check predict initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if ((predict->count != 0) && (time_us <= predict->time_us))                               /* check the time */
+    {
+        return 4;                                                                             /* return error */
+    }
+    
+    value = (float)pressure;                                                                  /* get the pressure */
+    predict->seq++;                                                                           /* start writing */
+    MS5837_BARRIER();                                                                         /* order the sequence and the state */
+    if (predict->count == 0)                                                                  /* check the first sample */
+    {
+        predict->pressure = value;                                                            /* start at the sample */
+        predict->rate = 0.0f;                                                                 /* no rate yet */
+    }
+    else
+    {
+        dt = (float)(time_us - predict->time_us) / 1000000.0f;                                /* get the interval */
+        error = value - (predict->pressure + predict->rate * dt);                             /* get the prediction error */
+        predict->pressure += predict->rate * dt + predict->alpha * error;                     /* correct the pressure */
+        predict->rate += predict->beta * error / dt;                                          /* correct the rate */
+        square = error * error;                                                               /* get the squared error */
+        if (predict->count == 1)                                                              /* check the second sample */
+        {
+            predict->interval = dt;                                                           /* start the interval */
+            predict->variance = square;                                                       /* start the variance */
+        }
+        else
+        {
+            predict->interval += MS5837_PREDICT_SMOOTH * (dt - predict->interval);            /* smooth the interval */
+            predict->variance += MS5837_PREDICT_SMOOTH * (square - predict->variance);        /* smooth the variance */
+        }
+    }
+    predict->time_us = time_us;                                                               /* save the time */
+    predict->count++;                                                                         /* count the update */
+    MS5837_BARRIER();                                                                         /* order the state and the sequence */
+    predict->seq++;                                                                           /* stop writing */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the pressure estimate at a time
+ * @param[in]  *predict pointer to a predict structure
+ * @param[in]  time_us query time, it can be before or after the last update
+ * @param[out] *pressure pointer to a pressure estimate buffer
+ * @param[out] *uncertainty pointer to an uncertainty buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no update yet
+ *             - 2 predict is NULL
+ *             - 3 predict is not initialized
+ * @note       it never waits for a conversion, the uncertainty is the rms one step prediction error
+ *             growing linearly with the distance from the last update in update intervals,
+ *             both keep the unit of ms5837_compensate
+ */
+uint8_t ms5837_predict_get(ms5837_predict_t *predict, uint64_t time_us, float *pressure, float *uncertainty)
+{
+    uint32_t seq;
+    uint32_t count;
+    uint64_t last;
+    float value;
+    float rate;
+    float interval;
+    float variance;
+    float dt;
+    
+    if (predict == NULL)                                        /* check predict */
+    {
+        return 2;                                               /* return error */
+    }
+    if (predict->inited != 1)                                   /* check predict initialization */
+    {
+        return 3;                                               /* return error */
+    }
+    
+    do
+    {
+        seq = predict->seq;                                     /* get the sequence */
+        MS5837_BARRIER();                                       /* order the sequence and the state */
+        count = predict->count;                                 /* copy the count */
+        last = predict->time_us;                                /* copy the time */
+        value = predict->pressure;                              /* copy the pressure */
+        rate = predict->rate;                                   /* copy the rate */
+        interval = predict->interval;                           /* copy the interval */
+        variance = predict->variance;                           /* copy the variance */
+        MS5837_BARRIER();                                       /* order the state and the sequence */
+    } while (((seq & 1) != 0) || (seq != predict->seq));        /* retry a torn copy */
+    if (count == 0)                                             /* check the count */
+    {
+        return 1;                                               /* no update yet */
+    }
+    
+    if (time_us >= last)                                        /* check the direction */
+    {
+        dt = (float)(time_us - last) / 1000000.0f;              /* extrapolate */
+        *pressure = value + rate * dt;                          /* get the estimate */
+    }
+    else
+    {
+        dt = (float)(last - time_us) / 1000000.0f;              /* interpolate back */
+        *pressure = value - rate * dt;                          /* get the estimate */
+    }
+    *uncertainty = sqrtf(variance);                             /* get the one step error */
+    if (interval > 0.0f)                                        /* check the interval */
+    {
+        *uncertainty *= 1.0f + dt / interval;                   /* grow with the distance */
+    }
+    
+    return 0;                                                   /* success return 0 */
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_predict.h
+ * @brief     driver ms5837 predict header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_PREDICT_H
+#define DRIVER_MS5837_PREDICT_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_predict_driver ms5837 predict driver function
+ * @brief    ms5837 predict driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 predict structure definition
+ * @note  an alpha beta filter on the pressure, the values keep the unit of ms5837_compensate,
+ *        one thread updates while other threads get estimates at the same time
+ */
+typedef struct ms5837_predict_s
+{
+    float alpha;                     /**< pressure gain */
+    float beta;                      /**< rate gain */
+    uint64_t time_us;                /**< time of the last update */
+    float pressure;                  /**< filtered pressure at the last update */
+    float rate;                      /**< filtered pressure change per second */
+    float interval;                  /**< smoothed update interval in seconds */
+    float variance;                  /**< smoothed variance of the one step prediction error */
+    uint32_t count;                  /**< update count */
+    volatile uint32_t seq;           /**< odd while the state is written */
+    uint8_t inited;                  /**< inited flag */
+} ms5837_predict_t;
+
+/**
+ * @brief     initialize a predictor
+ * @param[in] *predict pointer to a predict structure
+ * @param[in] alpha pressure gain in (0, 1]
+ * @param[in] beta rate gain in [0, 2 - alpha) and not above alpha * alpha / (1 - alpha / 2)
+ * @return    status code
+ *            - 0 success
+ *            - 2 predict is NULL
+ *            - 4 gain is invalid
+ * @note      a larger alpha follows the samples closer, a larger beta follows rate changes faster,
+ *            0.5 and 0.1 suit a slowly changing depth
+ */
+uint8_t ms5837_predict_init(ms5837_predict_t *predict, float alpha, float beta);
+
+/**
+ * @brief     reset a predictor
+ * @param[in] *predict pointer to a predict structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 predict is NULL
+ *            - 3 predict is not initialized
+ * @note      the gains are kept
+ */
+uint8_t ms5837_predict_reset(ms5837_predict_t *predict);
+
+/**
+ * @brief     update a predictor with a sample
+ * @param[in] *predict pointer to a predict structure
+ * @param[in] time_us sample time
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 2 predict is NULL
+ *            - 3 predict is not initialized
+ *            - 4 time is not after the last update
+ * @note      only one thread can update
+ */
+uint8_t ms5837_predict_update(ms5837_predict_t *predict, uint64_t time_us, int32_t pressure);
+
+/**
+ * @brief      get the pressure estimate at a time
+ * @param[in]  *predict pointer to a predict structure
+ * @param[in]  time_us query time, it can be before or after the last update
+ * @param[out] *pressure pointer to a pressure estimate buffer
+ * @param[out] *uncertainty pointer to an uncertainty buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no update yet
+ *             - 2 predict is NULL
+ *             - 3 predict is not initialized
+ * @note       it never waits for a conversion, the uncertainty is the rms one step prediction error
+ *             growing linearly with the distance from the last update in update intervals,
+ *             both keep the unit of ms5837_compensate
+ */
+uint8_t ms5837_predict_get(ms5837_predict_t *predict, uint64_t time_us, float *pressure, float *uncertainty);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,309 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_replay.c
+ * @brief     driver ms5837 replay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_replay.h"
+
+/**
+ * @brief active replay definition
+ */
+static ms5837_replay_t *gs_replay = NULL;        /**< the linked functions have no context */
+
+/**
+ * @brief      replay one transfer
+ * @param[in]  type transfer type
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transfer failed
+ * @note       records of other transfers within the search window are skipped,
+ *             a recorded failure is replayed as a failure
+ */
+static uint8_t a_replay_transfer(uint8_t type, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    const ms5837_replay_record_t *record;
+    uint32_t end;
+    uint32_t i;
+    uint16_t n;
+    
+    if (gs_replay == NULL)                                                                   /* check the replay */
+    {
+        return 1;                                                                            /* return error */
+    }
+    if (gs_replay->position >= gs_replay->num)                                               /* check the end */
+    {
+        gs_replay->overruns++;                                                               /* count the overrun */
+        
+        return 1;                                                                            /* return error */
+    }
+    
+    end = gs_replay->position + MS5837_REPLAY_SEARCH;                                        /* search window */
+    if (end > gs_replay->num)                                                                /* check the end */
+    {
+        end = gs_replay->num;                                                                /* limit the window */
+    }
+    for (i = gs_replay->position; i < end; i++)                                              /* find the transfer */
+    {
+        if ((gs_replay->record[i].type == type) && (gs_replay->record[i].reg == reg))        /* check the match */
+        {
+            break;                                                                           /* found */
+        }
+    }
+    if (i == end)                                                                            /* check the result */
+    {
+        gs_replay->mismatches++;                                                             /* count the mismatch */
+        
+        return 1;                                                                            /* return error */
+    }
+    
+    record = &gs_replay->record[i];                                                          /* get the record */
+    gs_replay->skipped += i - gs_replay->position;                                           /* count the skipped */
+    gs_replay->position = i + 1;                                                             /* next record */
+    if ((uint64_t)record->time_us > gs_replay->now_us)                                       /* the clock never goes back */
+    {
+        gs_replay->now_us = record->time_us;                                                 /* move the clock */
+    }
+    if (type == MS5837_REPLAY_TYPE_READ)                                                     /* read */
+    {
+        memset(buf, 0, len);                                                                 /* clear the buffer */
+        n = (len < record->len) ? len : record->len;                                         /* get the length */
+        memcpy(buf, record->data, (n > 4) ? 4 : n);                                          /* copy the data */
+    }
+    
+    return record->status;                                                                   /* return the status */
+}
+
+/**
+ * @brief  iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+static uint8_t a_replay_iic_init(void)
+{
+    return (gs_replay != NULL) ? 0 : 1;
+}
+
+/**
+ * @brief  iic bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_replay_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_replay_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return a_replay_transfer(MS5837_REPLAY_TYPE_READ, reg, buf, len);
+}
+
+/**
+ * @brief     iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_replay_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    (void)buf;
+    (void)len;
+    
+    return a_replay_transfer(MS5837_REPLAY_TYPE_WRITE, reg, NULL, 0);
+}
+
+/**
+ * @brief     delay on the replay clock
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_replay_delay_ms(uint32_t ms)
+{
+    if (gs_replay != NULL)
+    {
+        gs_replay->now_us += (uint64_t)ms * 1000;
+    }
+}
+
+/**
+ * @brief  get the replay timestamp
+ * @return timestamp in us
+ * @note   none
+ */
+static uint32_t a_replay_timestamp_us(void)
+{
+    return (gs_replay != NULL) ? (uint32_t)gs_replay->now_us : 0;
+}
+
+/**
+ * @brief     initialize the replay
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *record pointer to the recorded transfers
+ * @param[in] num record number
+ * @return    status code
+ *            - 0 success
+ *            - 2 replay is NULL
+ *            - 4 record is invalid
+ * @note      the linked functions have no context, so only the last initialized replay is active
+ */
+uint8_t ms5837_replay_init(ms5837_replay_t *replay, const ms5837_replay_record_t *record, uint32_t num)
+{
+    if (replay == NULL)                                /* check replay */
+    {
+        return 2;                                      /* return error */
+    }
+    if ((record == NULL) && (num != 0))                /* check the records */
+    {
+        return 4;                                      /* return error */
+    }
+    
+    memset(replay, 0, sizeof(ms5837_replay_t));        /* clear the replay */
+    replay->record = record;                           /* set the records */
+    replay->num = num;                                 /* set the number */
+    replay->inited = 1;                                /* flag inited */
+    gs_replay = replay;                                /* activate it */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief     close the replay
+ * @param[in] *replay pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 replay is NULL
+ *            - 3 replay is not initialized
+ * @note      none
+ */
+uint8_t ms5837_replay_deinit(ms5837_replay_t *replay)
+{
+    if (replay == NULL)             /* check replay */
+    {
+        return 2;                   /* return error */
+    }
+    if (replay->inited != 1)        /* check replay initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    if (gs_replay == replay)        /* check the active one */
+    {
+        gs_replay = NULL;           /* deactivate it */
+    }
+    replay->inited = 0;             /* flag closed */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     link a handle to the replay
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it links iic, delay_ms and timestamp_us, the caller still links debug_print,
+ *            every transfer returns the next matching record and moves the replay clock to its recorded time,
+ *            delay_ms only advances the replay clock, so the replay runs at full speed with the original timing
+ */
+uint8_t ms5837_replay_link(ms5837_handle_t *handle)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    
+    DRIVER_MS5837_LINK_IIC_INIT(handle, a_replay_iic_init);                /* link iic_init */
+    DRIVER_MS5837_LINK_IIC_DEINIT(handle, a_replay_iic_deinit);            /* link iic_deinit */
+    DRIVER_MS5837_LINK_IIC_READ(handle, a_replay_iic_read);                /* link iic_read */
+    DRIVER_MS5837_LINK_IIC_WRITE(handle, a_replay_iic_write);              /* link iic_write */
+    DRIVER_MS5837_LINK_DELAY_MS(handle, a_replay_delay_ms);                /* link delay_ms */
+    DRIVER_MS5837_LINK_TIMESTAMP_US(handle, a_replay_timestamp_us);        /* link timestamp_us */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the replay statistics
+ * @param[in]  *replay pointer to a replay structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 replay is NULL
+ *             - 3 replay is not initialized
+ * @note       the replay is done when position equals num
+ */
+uint8_t ms5837_replay_get_stats(ms5837_replay_t *replay, ms5837_replay_stats_t *stats)
+{
+    if (replay == NULL)                            /* check replay */
+    {
+        return 2;                                  /* return error */
+    }
+    if (replay->inited != 1)                       /* check replay initialization */
+    {
+        return 3;                                  /* return error */
+    }
+    
+    stats->position = replay->position;            /* get the position */
+    stats->num = replay->num;                      /* get the number */
+    stats->skipped = replay->skipped;              /* get the skipped */
+    stats->mismatches = replay->mismatches;        /* get the mismatches */
+    stats->overruns = replay->overruns;            /* get the overruns */
+    
+    return 0;                                      /* success return 0 */
+}
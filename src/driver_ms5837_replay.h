@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_replay.h
+ * @brief     driver ms5837 replay header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_REPLAY_H
+#define DRIVER_MS5837_REPLAY_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_replay_driver ms5837 replay driver function
+ * @brief    ms5837 replay driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 replay search window definition
+ */
+#ifndef MS5837_REPLAY_SEARCH
+    #define MS5837_REPLAY_SEARCH 16        /**< records skipped at most to find a matching transfer */
+#endif
+
+/**
+ * @brief ms5837 replay record type enumeration definition
+ */
+typedef enum
+{
+    MS5837_REPLAY_TYPE_WRITE = 0x00,        /**< iic write */
+    MS5837_REPLAY_TYPE_READ  = 0x01,        /**< iic read */
+} ms5837_replay_type_t;
+
+/**
+ * @brief ms5837 replay record structure definition
+ */
+typedef struct ms5837_replay_record_s
+{
+    uint32_t time_us;        /**< transfer start time relative to the recording start */
+    uint8_t type;            /**< record type */
+    uint8_t reg;             /**< register or command */
+    uint8_t len;             /**< transfer length, the data keep at most 4 bytes */
+    uint8_t status;          /**< recorded transfer status */
+    uint8_t data[4];         /**< read data */
+} ms5837_replay_record_t;
+
+/**
+ * @brief ms5837 replay statistics structure definition
+ */
+typedef struct ms5837_replay_stats_s
+{
+    uint32_t position;          /**< replayed records */
+    uint32_t num;               /**< total records */
+    uint32_t skipped;           /**< records skipped to find a match */
+    uint32_t mismatches;        /**< transfers without a matching record */
+    uint32_t overruns;          /**< transfers after the last record */
+} ms5837_replay_stats_t;
+
+/**
+ * @brief ms5837 replay structure definition
+ */
+typedef struct ms5837_replay_s
+{
+    const ms5837_replay_record_t *record;        /**< recorded transfers */
+    uint32_t num;                                /**< record number */
+    uint32_t position;                           /**< next record */
+    uint64_t now_us;                             /**< replay clock in us */
+    uint32_t skipped;                            /**< records skipped to find a match */
+    uint32_t mismatches;                         /**< transfers without a matching record */
+    uint32_t overruns;                           /**< transfers after the last record */
+    uint8_t inited;                              /**< inited flag */
+} ms5837_replay_t;
+
+/**
+ * @brief     initialize the replay
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *record pointer to the recorded transfers
+ * @param[in] num record number
+ * @return    status code
+ *            - 0 success
+ *            - 2 replay is NULL
+ *            - 4 record is invalid
+ * @note      the linked functions have no context, so only the last initialized replay is active
+ */
+uint8_t ms5837_replay_init(ms5837_replay_t *replay, const ms5837_replay_record_t *record, uint32_t num);
+
+/**
+ * @brief     close the replay
+ * @param[in] *replay pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 replay is NULL
+ *            - 3 replay is not initialized
+ * @note      none
+ */
+uint8_t ms5837_replay_deinit(ms5837_replay_t *replay);
+
+/**
+ * @brief     link a handle to the replay
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it links iic, delay_ms and timestamp_us, the caller still links debug_print,
+ *            every transfer returns the next matching record and moves the replay clock to its recorded time,
+ *            delay_ms only advances the replay clock, so the replay runs at full speed with the original timing
+ */
+uint8_t ms5837_replay_link(ms5837_handle_t *handle);
+
+/**
+ * @brief      get the replay statistics
+ * @param[in]  *replay pointer to a replay structure
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 replay is NULL
+ *             - 3 replay is not initialized
+ * @note       the replay is done when position equals num
+ */
+uint8_t ms5837_replay_get_stats(ms5837_replay_t *replay, ms5837_replay_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,344 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_rollup.c
+ * @brief     driver ms5837 rollup source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_rollup.h"
+
+/**
+ * @brief rollup level span definition
+ */
+static const uint64_t gs_rollup_span_us[MS5837_ROLLUP_LEVEL] = {1000000ULL, 60000000ULL, 3600000000ULL};        /**< 1s, 1min and 1h */
+
+/**
+ * @brief     merge a sample into a bucket
+ * @param[in] *bucket pointer to a bucket
+ * @param[in] temperature temperature
+ * @param[in] pressure pressure
+ * @note      none
+ */
+static void a_rollup_merge_sample(ms5837_rollup_bucket_t *bucket, int32_t temperature, int32_t pressure)
+{
+    bucket->temperature_min = (temperature < bucket->temperature_min) ? temperature : bucket->temperature_min;
+    bucket->temperature_max = (temperature > bucket->temperature_max) ? temperature : bucket->temperature_max;
+    bucket->temperature_sum += temperature;
+    bucket->pressure_min = (pressure < bucket->pressure_min) ? pressure : bucket->pressure_min;
+    bucket->pressure_max = (pressure > bucket->pressure_max) ? pressure : bucket->pressure_max;
+    bucket->pressure_sum += pressure;
+    bucket->count++;
+}
+
+/**
+ * @brief     merge a bucket into another one
+ * @param[in] *dst pointer to the merged bucket
+ * @param[in] *src pointer to a bucket
+ * @note      none
+ */
+static void a_rollup_merge_bucket(ms5837_rollup_bucket_t *dst, const ms5837_rollup_bucket_t *src)
+{
+    if (src->count == 0)
+    {
+        return;
+    }
+    if (dst->count == 0)
+    {
+        uint64_t start = dst->start_us;
+        
+        *dst = *src;
+        dst->start_us = start;
+        
+        return;
+    }
+    dst->temperature_min = (src->temperature_min < dst->temperature_min) ? src->temperature_min : dst->temperature_min;
+    dst->temperature_max = (src->temperature_max > dst->temperature_max) ? src->temperature_max : dst->temperature_max;
+    dst->temperature_sum += src->temperature_sum;
+    dst->pressure_min = (src->pressure_min < dst->pressure_min) ? src->pressure_min : dst->pressure_min;
+    dst->pressure_max = (src->pressure_max > dst->pressure_max) ? src->pressure_max : dst->pressure_max;
+    dst->pressure_sum += src->pressure_sum;
+    dst->count += src->count;
+}
+
+/**
+ * @brief     get a bucket of a ring
+ * @param[in] *ring pointer to a ring
+ * @param[in] index bucket index since the start
+ * @return    pointer to the bucket
+ * @note      none
+ */
+static inline ms5837_rollup_bucket_t *a_rollup_at(ms5837_rollup_ring_t *ring, uint64_t index)
+{
+    return &ring->buf[index % ring->size];
+}
+
+/**
+ * @brief     get the first kept bucket index of a ring
+ * @param[in] *ring pointer to a ring
+ * @return    bucket index since the start
+ * @note      none
+ */
+static inline uint64_t a_rollup_first(ms5837_rollup_ring_t *ring)
+{
+    return (ring->head > ring->size) ? (ring->head - ring->size) : 0;
+}
+
+/**
+ * @brief     merge the buckets of a ring inside a range into the bins
+ * @param[in] *ring pointer to a ring
+ * @param[in] span_us bucket span of the ring
+ * @param[in] from_us range start
+ * @param[in] to_us range end, not included
+ * @param[in] start_us first bin start
+ * @param[in] step_us bin width
+ * @param[in] *bin pointer to the bins
+ * @note      a bucket is merged when it starts and ends inside the range
+ */
+static void a_rollup_merge_range(ms5837_rollup_ring_t *ring, uint64_t span_us, uint64_t from_us, uint64_t to_us,
+                                 uint64_t start_us, uint64_t step_us, ms5837_rollup_bucket_t *bin)
+{
+    ms5837_rollup_bucket_t *bucket;
+    uint64_t lo;
+    uint64_t hi;
+    uint64_t i;
+    
+    /* binary search the first bucket that starts at or after the range start */
+    lo = a_rollup_first(ring);                                                 /* first kept */
+    hi = ring->head;                                                           /* end */
+    while (lo < hi)                                                            /* search */
+    {
+        uint64_t mid = lo + (hi - lo) / 2;                                     /* middle */
+        
+        if (a_rollup_at(ring, mid)->start_us < from_us)                        /* check the start */
+        {
+            lo = mid + 1;                                                      /* go right */
+        }
+        else
+        {
+            hi = mid;                                                          /* go left */
+        }
+    }
+    
+    /* merge the buckets into the bins */
+    for (i = lo; i < ring->head; i++)                                          /* scan forward */
+    {
+        bucket = a_rollup_at(ring, i);                                         /* get the bucket */
+        if ((bucket->start_us + span_us) > to_us)                              /* check the end */
+        {
+            break;                                                             /* done */
+        }
+        a_rollup_merge_bucket(&bin[(bucket->start_us - start_us) / step_us],
+                              bucket);                                         /* merge it */
+    }
+}
+
+/**
+ * @brief     initialize the rollup
+ * @param[in] *rollup pointer to a rollup structure
+ * @param[in] *second pointer to the 1s bucket buffer
+ * @param[in] second_size 1s bucket buffer size
+ * @param[in] *minute pointer to the 1min bucket buffer
+ * @param[in] minute_size 1min bucket buffer size
+ * @param[in] *hour pointer to the 1h bucket buffer
+ * @param[in] hour_size 1h bucket buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 rollup is NULL
+ *            - 4 buffer is invalid
+ * @note      each level keeps its newest buckets, so the buffer sizes set how far back each level reaches
+ */
+uint8_t ms5837_rollup_init(ms5837_rollup_t *rollup, ms5837_rollup_bucket_t *second, uint32_t second_size,
+                           ms5837_rollup_bucket_t *minute, uint32_t minute_size,
+                           ms5837_rollup_bucket_t *hour, uint32_t hour_size)
+{
+    if (rollup == NULL)                                                  /* check rollup */
+    {
+        return 2;                                                        /* return error */
+    }
+    if ((second == NULL) || (second_size == 0) || (minute == NULL) ||
+        (minute_size == 0) || (hour == NULL) || (hour_size == 0))        /* check the buffers */
+    {
+        return 4;                                                        /* return error */
+    }
+    
+    memset(rollup, 0, sizeof(ms5837_rollup_t));                          /* clear the rollup */
+    rollup->level[0].buf = second;                                       /* set the 1s buffer */
+    rollup->level[0].size = second_size;                                 /* set the 1s size */
+    rollup->level[1].buf = minute;                                       /* set the 1min buffer */
+    rollup->level[1].size = minute_size;                                 /* set the 1min size */
+    rollup->level[2].buf = hour;                                         /* set the 1h buffer */
+    rollup->level[2].size = hour_size;                                   /* set the 1h size */
+    rollup->inited = 1;                                                  /* flag inited */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     add a sample to all levels
+ * @param[in] *rollup pointer to a rollup structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample is late
+ *            - 2 rollup is NULL
+ *            - 3 rollup is not initialized
+ * @note      samples come in time order, a sample older than the open 1s bucket is counted and dropped from all levels
+ */
+uint8_t ms5837_rollup_add(ms5837_rollup_t *rollup, uint64_t time_us, int32_t temperature, int32_t pressure)
+{
+    ms5837_rollup_ring_t *ring;
+    ms5837_rollup_bucket_t *bucket;
+    uint64_t start;
+    uint8_t i;
+    
+    if (rollup == NULL)                                                              /* check rollup */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (rollup->inited != 1)                                                         /* check rollup initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    ring = &rollup->level[0];                                                        /* get the finest ring */
+    start = time_us - time_us % gs_rollup_span_us[0];                                /* 1s bucket start */
+    if ((ring->head > 0) && (start < a_rollup_at(ring, ring->head - 1)->start_us))   /* check the order */
+    {
+        rollup->late++;                                                              /* count the late sample */
+        
+        return 1;                                                                    /* drop it from all levels */
+    }
+    for (i = 0; i < MS5837_ROLLUP_LEVEL; i++)                                        /* all levels */
+    {
+        ring = &rollup->level[i];                                                    /* get the ring */
+        start = time_us - time_us % gs_rollup_span_us[i];                            /* bucket start */
+        bucket = (ring->head > 0) ? a_rollup_at(ring, ring->head - 1) : NULL;        /* open bucket */
+        if ((bucket == NULL) || (start != bucket->start_us))                         /* next bucket */
+        {
+            bucket = a_rollup_at(ring, ring->head);                                  /* open a new one */
+            memset(bucket, 0, sizeof(ms5837_rollup_bucket_t));                       /* clear it */
+            bucket->start_us = start;                                                /* set the start */
+            bucket->temperature_min = INT32_MAX;                                     /* init the min */
+            bucket->temperature_max = INT32_MIN;                                     /* init the max */
+            bucket->pressure_min = INT32_MAX;                                        /* init the min */
+            bucket->pressure_max = INT32_MIN;                                        /* init the max */
+            ring->head++;                                                            /* count the bucket */
+        }
+        a_rollup_merge_sample(bucket, temperature, pressure);                        /* merge the sample */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      downsample a time range
+ * @param[in]  *rollup pointer to a rollup structure
+ * @param[in]  start_us range start
+ * @param[in]  end_us range end, not included
+ * @param[in]  step_us output bin width, end - start gives one summary bin
+ * @param[out] *bin pointer to an output bin buffer
+ * @param[in]  max output bin buffer size
+ * @param[out] *num pointer to an output bin number buffer
+ * @param[out] *level pointer to a used level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rollup is NULL
+ *             - 3 rollup is not initialized
+ *             - 4 range is invalid
+ *             - 5 bin buffer is too small
+ * @note       it reads the coarsest level whose span divides the step and the start, the 1s level otherwise,
+ *             a tail that doesn't fill a bucket of that level is read from the finer levels,
+ *             only buckets inside the range are merged, so it is resolved to whole seconds,
+ *             bin i starts at start + i * step, a bin without samples has a count of 0
+ */
+uint8_t ms5837_rollup_query(ms5837_rollup_t *rollup, uint64_t start_us, uint64_t end_us, uint64_t step_us,
+                            ms5837_rollup_bucket_t *bin, uint32_t max, uint32_t *num, uint8_t *level)
+{
+    uint64_t from;
+    uint64_t to;
+    uint64_t n;
+    uint64_t i;
+    int8_t l;
+    int8_t m;
+    
+    if (rollup == NULL)                                                                   /* check rollup */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (rollup->inited != 1)                                                              /* check rollup initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if ((end_us <= start_us) || (step_us == 0))                                           /* check the range */
+    {
+        return 4;                                                                         /* return error */
+    }
+    n = (end_us - start_us + step_us - 1) / step_us;                                      /* bin number */
+    if (n > max)                                                                          /* check the buffer */
+    {
+        return 5;                                                                         /* return error */
+    }
+    
+    /* pick the coarsest level whose buckets tile the bins */
+    for (l = MS5837_ROLLUP_LEVEL - 1; l > 0; l--)                                         /* from the coarsest */
+    {
+        if (((step_us % gs_rollup_span_us[l]) == 0) &&
+            ((start_us % gs_rollup_span_us[l]) == 0))                                     /* check the alignment */
+        {
+            break;                                                                        /* use it */
+        }
+    }
+    for (i = 0; i < n; i++)                                                               /* clear the bins */
+    {
+        memset(&bin[i], 0, sizeof(ms5837_rollup_bucket_t));                               /* clear it */
+        bin[i].start_us = start_us + i * step_us;                                         /* set the start */
+    }
+    
+    /* whole buckets of the level, then the tail from the finer levels */
+    from = start_us;                                                                      /* range start */
+    for (m = l; m >= 0; m--)                                                              /* from the used level */
+    {
+        to = end_us - end_us % gs_rollup_span_us[m];                                      /* last whole bucket end */
+        if (to > from)                                                                    /* check the range */
+        {
+            a_rollup_merge_range(&rollup->level[m], gs_rollup_span_us[m], from, to,
+                                 start_us, step_us, bin);                                 /* merge the buckets */
+            from = to;                                                                    /* next range */
+        }
+    }
+    *num = (uint32_t)n;                                                                   /* set the number */
+    *level = (uint8_t)l;                                                                  /* set the level */
+    
+    return 0;                                                                             /* success return 0 */
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_rollup.h
+ * @brief     driver ms5837 rollup header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_ROLLUP_H
+#define DRIVER_MS5837_ROLLUP_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_rollup_driver ms5837 rollup driver function
+ * @brief    ms5837 rollup driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 rollup level definition
+ */
+#define MS5837_ROLLUP_LEVEL        3        /**< 1s, 1min and 1h levels */
+
+/**
+ * @brief ms5837 rollup bucket structure definition
+ * @note  mean is sum / count, the values are the integer results of ms5837_compensate
+ */
+typedef struct ms5837_rollup_bucket_s
+{
+    uint64_t start_us;                 /**< bucket start time */
+    uint32_t count;                    /**< sample count */
+    int32_t temperature_min;           /**< min temperature */
+    int32_t temperature_max;           /**< max temperature */
+    int64_t temperature_sum;           /**< temperature sum */
+    int32_t pressure_min;              /**< min pressure */
+    int32_t pressure_max;              /**< max pressure */
+    int64_t pressure_sum;              /**< pressure sum */
+} ms5837_rollup_bucket_t;
+
+/**
+ * @brief ms5837 rollup ring structure definition
+ */
+typedef struct ms5837_rollup_ring_s
+{
+    ms5837_rollup_bucket_t *buf;        /**< bucket buffer */
+    uint32_t size;                      /**< bucket buffer size */
+    uint64_t head;                      /**< written buckets, the last one is still open */
+} ms5837_rollup_ring_t;
+
+/**
+ * @brief ms5837 rollup structure definition
+ */
+typedef struct ms5837_rollup_s
+{
+    ms5837_rollup_ring_t level[MS5837_ROLLUP_LEVEL];        /**< one ring per level */
+    uint32_t late;                                          /**< samples older than the open 1s bucket */
+    uint8_t inited;                                         /**< inited flag */
+} ms5837_rollup_t;
+
+/**
+ * @brief     initialize the rollup
+ * @param[in] *rollup pointer to a rollup structure
+ * @param[in] *second pointer to the 1s bucket buffer
+ * @param[in] second_size 1s bucket buffer size
+ * @param[in] *minute pointer to the 1min bucket buffer
+ * @param[in] minute_size 1min bucket buffer size
+ * @param[in] *hour pointer to the 1h bucket buffer
+ * @param[in] hour_size 1h bucket buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 rollup is NULL
+ *            - 4 buffer is invalid
+ * @note      each level keeps its newest buckets, so the buffer sizes set how far back each level reaches
+ */
+uint8_t ms5837_rollup_init(ms5837_rollup_t *rollup, ms5837_rollup_bucket_t *second, uint32_t second_size,
+                           ms5837_rollup_bucket_t *minute, uint32_t minute_size,
+                           ms5837_rollup_bucket_t *hour, uint32_t hour_size);
+
+/**
+ * @brief     add a sample to all levels
+ * @param[in] *rollup pointer to a rollup structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample is late
+ *            - 2 rollup is NULL
+ *            - 3 rollup is not initialized
+ * @note      samples come in time order, a sample older than the open 1s bucket is counted and dropped from all levels
+ */
+uint8_t ms5837_rollup_add(ms5837_rollup_t *rollup, uint64_t time_us, int32_t temperature, int32_t pressure);
+
+/**
+ * @brief      downsample a time range
+ * @param[in]  *rollup pointer to a rollup structure
+ * @param[in]  start_us range start
+ * @param[in]  end_us range end, not included
+ * @param[in]  step_us output bin width, end - start gives one summary bin
+ * @param[out] *bin pointer to an output bin buffer
+ * @param[in]  max output bin buffer size
+ * @param[out] *num pointer to an output bin number buffer
+ * @param[out] *level pointer to a used level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rollup is NULL
+ *             - 3 rollup is not initialized
+ *             - 4 range is invalid
+ *             - 5 bin buffer is too small
+ * @note       it reads the coarsest level whose span divides the step and the start, the 1s level otherwise,
+ *             a tail that doesn't fill a bucket of that level is read from the finer levels,
+ *             only buckets inside the range are merged, so it is resolved to whole seconds,
+ *             bin i starts at start + i * step, a bin without samples has a count of 0
+ */
+uint8_t ms5837_rollup_query(ms5837_rollup_t *rollup, uint64_t start_us, uint64_t end_us, uint64_t step_us,
+                            ms5837_rollup_bucket_t *bin, uint32_t max, uint32_t *num, uint8_t *level);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,611 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_sim.c
+ * @brief     driver ms5837 sim source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_sim.h"
+
+/**
+ * @brief chip command definition
+ */
+#define SIM_CMD_RESET        0x1E        /**< command reset */
+#define SIM_CMD_D1           0x40        /**< command convert d1 */
+#define SIM_CMD_D2           0x50        /**< command convert d2 */
+#define SIM_CMD_ADC_READ     0x00        /**< command adc read */
+#define SIM_CMD_PROM_READ    0xA0        /**< command prom read */
+
+/**
+ * @brief chip conversion time definition
+ */
+static const uint32_t gs_sim_convert_us[6] = {600, 1170, 2280, 4540, 9040, 18080};        /**< max conversion time in us */
+
+/**
+ * @brief chip type bits definition
+ */
+static const uint16_t gs_sim_type_bits[3] = {0x00, 0x15, 0x1A};        /**< 02ba01, 02ba21 and 30ba26 */
+
+/**
+ * @brief default prom coefficients definition
+ */
+static const uint16_t gs_sim_default_c[6] = {34982, 36352, 20328, 22354, 26646, 26146};        /**< datasheet example */
+
+/**
+ * @brief active simulator definition
+ */
+static ms5837_sim_t *gs_sim = NULL;        /**< the linked functions have no context */
+
+/**
+ * @brief     get the crc4 of the prom
+ * @param[in] *prom pointer to the prom words
+ * @return    crc4
+ * @note      none
+ */
+static uint16_t a_sim_crc4(const uint16_t prom[8])
+{
+    uint16_t n[8];
+    uint16_t rem = 0;
+    uint16_t cnt;
+    uint16_t bit;
+    
+    memcpy(n, prom, sizeof(uint16_t) * 8);
+    n[0] = n[0] & 0x0FFF;
+    n[7] = 0;
+    for (cnt = 0; cnt < 16; cnt++)
+    {
+        rem ^= ((cnt % 2) == 1) ? (uint16_t)(n[cnt >> 1] & 0x00FF) : (uint16_t)(n[cnt >> 1] >> 8);
+        for (bit = 8; bit > 0; bit--)
+        {
+            rem = ((rem & 0x8000U) != 0) ? (uint16_t)((rem << 1) ^ 0x3000) : (uint16_t)(rem << 1);
+        }
+    }
+    
+    return (rem >> 12) & 0x000F;
+}
+
+/**
+ * @brief     iic bus write
+ * @param[in] index chip slot index
+ * @param[in] reg iic register address
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      conversions complete in virtual time
+ */
+static uint8_t a_sim_iic_write(uint8_t index, uint8_t reg)
+{
+    ms5837_sim_chip_t *chip;
+    
+    if (gs_sim == NULL)                                                                  /* check the simulator */
+    {
+        return 1;                                                                        /* return error */
+    }
+    
+    chip = &gs_sim->chip[index];                                                         /* get the chip */
+    gs_sim->now_us += gs_sim->transfer_us;                                               /* transfer time */
+    chip->writes++;                                                                      /* count the write */
+    if (chip->fail_writes != 0)                                                          /* check the fault */
+    {
+        chip->fail_writes--;                                                             /* consume the fault */
+        
+        return 1;                                                                        /* return error */
+    }
+    if (reg == SIM_CMD_RESET)                                                            /* reset */
+    {
+        chip->converting = 0;                                                            /* abort the conversion */
+    }
+    else if (((reg & 0xF0) == SIM_CMD_D1) || ((reg & 0xF0) == SIM_CMD_D2))               /* conversion */
+    {
+        uint8_t osr = (uint8_t)((reg & 0x0F) >> 1);                                      /* the osr takes the bits 1 - 3 */
+        
+        chip->cmd = reg;                                                                 /* save the command */
+        chip->converting = 1;                                                            /* start the conversion */
+        chip->ready_us = gs_sim->now_us + gs_sim_convert_us[(osr > 5) ? 5 : osr];        /* virtual end time */
+    }
+    else
+    {
+        /* other commands are ignored */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      iic bus read
+ * @param[in]  index chip slot index
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       an adc read before the conversion end returns 0 like the chip
+ */
+static uint8_t a_sim_iic_read(uint8_t index, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    ms5837_sim_chip_t *chip;
+    uint32_t adc = 0;
+    
+    if (gs_sim == NULL)                                                            /* check the simulator */
+    {
+        return 1;                                                                  /* return error */
+    }
+    
+    chip = &gs_sim->chip[index];                                                   /* get the chip */
+    gs_sim->now_us += gs_sim->transfer_us;                                         /* transfer time */
+    chip->reads++;                                                                 /* count the read */
+    if (chip->fail_reads != 0)                                                     /* check the fault */
+    {
+        chip->fail_reads--;                                                        /* consume the fault */
+        
+        return 1;                                                                  /* return error */
+    }
+    memset(buf, 0, len);                                                           /* clear the buffer */
+    if (reg == SIM_CMD_ADC_READ)                                                   /* adc read */
+    {
+        if ((chip->converting != 0) && (gs_sim->now_us >= chip->ready_us))         /* check the conversion */
+        {
+            if (chip->signal != NULL)                                              /* sample the model */
+            {
+                chip->signal(index, chip->ready_us, &chip->d1, &chip->d2);         /* at the end time */
+            }
+            adc = ((chip->cmd & 0xF0) == SIM_CMD_D1) ? chip->d1 : chip->d2;        /* get the result */
+        }
+        else
+        {
+            chip->early_reads++;                                                   /* count the early read */
+        }
+        chip->converting = 0;                                                      /* the read ends it */
+        if (len >= 3)                                                              /* check the length */
+        {
+            buf[0] = (uint8_t)((adc >> 16) & 0xFF);                                /* set msb */
+            buf[1] = (uint8_t)((adc >> 8) & 0xFF);                                 /* set mid */
+            buf[2] = (uint8_t)((adc >> 0) & 0xFF);                                 /* set lsb */
+        }
+    }
+    else if (((reg & 0xF0) == SIM_CMD_PROM_READ) && (len >= 2))                    /* prom read */
+    {
+        buf[0] = (uint8_t)((chip->prom[(reg & 0x0F) >> 1] >> 8) & 0xFF);           /* set msb */
+        buf[1] = (uint8_t)((chip->prom[(reg & 0x0F) >> 1] >> 0) & 0xFF);           /* set lsb */
+    }
+    else
+    {
+        /* other registers read 0 */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief  iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+static uint8_t a_sim_iic_init(void)
+{
+    return (gs_sim != NULL) ? 0 : 1;
+}
+
+/**
+ * @brief  iic bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_sim_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     delay in virtual time
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_sim_delay_ms(uint32_t ms)
+{
+    if (gs_sim != NULL)
+    {
+        gs_sim->now_us += (uint64_t)ms * 1000;
+    }
+}
+
+/**
+ * @brief  get the virtual timestamp
+ * @return timestamp in us
+ * @note   none
+ */
+static uint32_t a_sim_timestamp_us(void)
+{
+    return (gs_sim != NULL) ? (uint32_t)gs_sim->now_us : 0;
+}
+
+/**
+ * @brief sim slot function definition
+ */
+#define SIM_SLOT_FUNCTION(n)                                                                \
+static uint8_t a_sim##n##_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)   \
+{                                                                                           \
+    (void)addr;                                                                             \
+                                                                                            \
+    return a_sim_iic_read(n, reg, buf, len);                                                \
+}                                                                                           \
+static uint8_t a_sim##n##_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)  \
+{                                                                                           \
+    (void)addr;                                                                             \
+    (void)buf;                                                                              \
+    (void)len;                                                                              \
+                                                                                            \
+    return a_sim_iic_write(n, reg);                                                         \
+}
+
+SIM_SLOT_FUNCTION(0)
+SIM_SLOT_FUNCTION(1)
+SIM_SLOT_FUNCTION(2)
+SIM_SLOT_FUNCTION(3)
+
+/**
+ * @brief sim slot function table definition
+ */
+static uint8_t (*const gs_sim_iic_read[MS5837_SIM_MAX_NUM])(uint8_t, uint8_t, uint8_t *, uint16_t) =
+{
+    a_sim0_iic_read, a_sim1_iic_read, a_sim2_iic_read, a_sim3_iic_read,
+};
+static uint8_t (*const gs_sim_iic_write[MS5837_SIM_MAX_NUM])(uint8_t, uint8_t, uint8_t *, uint16_t) =
+{
+    a_sim0_iic_write, a_sim1_iic_write, a_sim2_iic_write, a_sim3_iic_write,
+};
+
+/**
+ * @brief     check the simulator and the chip index
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      none
+ */
+static uint8_t a_sim_check(ms5837_sim_t *sim, uint8_t index)
+{
+    if (sim == NULL)                        /* check sim */
+    {
+        return 2;                           /* return error */
+    }
+    if (sim->inited != 1)                   /* check sim initialization */
+    {
+        return 3;                           /* return error */
+    }
+    if (index >= MS5837_SIM_MAX_NUM)        /* check the index */
+    {
+        return 4;                           /* return error */
+    }
+    
+    return 0;                               /* success return 0 */
+}
+
+/**
+ * @brief     initialize the simulator
+ * @param[in] *sim pointer to a sim structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ * @note      the linked functions have no context, so only the last initialized simulator is active,
+ *            every chip starts as a 02ba01 at 20C and 1013.25mbar with the virtual clock at 0
+ */
+uint8_t ms5837_sim_init(ms5837_sim_t *sim)
+{
+    uint8_t i;
+    
+    if (sim == NULL)                                                                    /* check sim */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    memset(sim, 0, sizeof(ms5837_sim_t));                                               /* clear the sim */
+    sim->inited = 1;                                                                    /* flag inited */
+    for (i = 0; i < MS5837_SIM_MAX_NUM; i++)                                            /* default chips */
+    {
+        (void)ms5837_sim_set_prom(sim, i, MS5837_TYPE_02BA01, gs_sim_default_c);        /* set the prom */
+        (void)ms5837_sim_set_environment(sim, i, 20.0f, 1013.25f);                      /* set the environment */
+    }
+    gs_sim = sim;                                                                       /* activate it */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     close the simulator
+ * @param[in] *sim pointer to a sim structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ * @note      none
+ */
+uint8_t ms5837_sim_deinit(ms5837_sim_t *sim)
+{
+    if (sim == NULL)             /* check sim */
+    {
+        return 2;                /* return error */
+    }
+    if (sim->inited != 1)        /* check sim initialization */
+    {
+        return 3;                /* return error */
+    }
+    
+    if (gs_sim == sim)           /* check the active one */
+    {
+        gs_sim = NULL;           /* deactivate it */
+    }
+    sim->inited = 0;             /* flag closed */
+    
+    return 0;                    /* success return 0 */
+}
+
+/**
+ * @brief     link a handle to a simulated chip
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] index chip slot index
+ * @return    status code
+ *            - 0 success
+ *            - 1 link failed
+ *            - 2 handle is NULL
+ * @note      it links iic, delay_ms and timestamp_us, the caller still links debug_print,
+ *            delay_ms advances the virtual clock instead of sleeping
+ */
+uint8_t ms5837_sim_link(ms5837_handle_t *handle, uint8_t index)
+{
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (index >= MS5837_SIM_MAX_NUM)                                      /* check the index */
+    {
+        return 1;                                                         /* return error */
+    }
+    
+    DRIVER_MS5837_LINK_IIC_INIT(handle, a_sim_iic_init);                  /* link iic_init */
+    DRIVER_MS5837_LINK_IIC_DEINIT(handle, a_sim_iic_deinit);              /* link iic_deinit */
+    DRIVER_MS5837_LINK_IIC_READ(handle, gs_sim_iic_read[index]);          /* link iic_read */
+    DRIVER_MS5837_LINK_IIC_WRITE(handle, gs_sim_iic_write[index]);        /* link iic_write */
+    DRIVER_MS5837_LINK_DELAY_MS(handle, a_sim_delay_ms);                  /* link delay_ms */
+    DRIVER_MS5837_LINK_TIMESTAMP_US(handle, a_sim_timestamp_us);          /* link timestamp_us */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] us advanced time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ * @note      use it for the idle time between samples
+ */
+uint8_t ms5837_sim_advance(ms5837_sim_t *sim, uint64_t us)
+{
+    if (sim == NULL)             /* check sim */
+    {
+        return 2;                /* return error */
+    }
+    if (sim->inited != 1)        /* check sim initialization */
+    {
+        return 3;                /* return error */
+    }
+    
+    sim->now_us += us;           /* advance the clock */
+    
+    return 0;                    /* success return 0 */
+}
+
+/**
+ * @brief     set the prom of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] type chip type
+ * @param[in] *c pointer to the c1 - c6 coefficients, NULL keeps the current ones
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      the type bits and the crc of word 0 are generated
+ */
+uint8_t ms5837_sim_set_prom(ms5837_sim_t *sim, uint8_t index, ms5837_type_t type, const uint16_t c[6])
+{
+    uint8_t res;
+    uint16_t *prom;
+    
+    res = a_sim_check(sim, index);                                                 /* check the params */
+    if (res != 0)                                                                  /* check the result */
+    {
+        return res;                                                                /* return error */
+    }
+    
+    prom = sim->chip[index].prom;                                                  /* get the prom */
+    prom[0] = (uint16_t)(gs_sim_type_bits[(type > MS5837_TYPE_30BA26) ?
+                                          MS5837_TYPE_02BA01 : type] << 5);        /* set the type */
+    if (c != NULL)                                                                 /* check the coefficients */
+    {
+        memcpy(&prom[1], c, sizeof(uint16_t) * 6);                                 /* set c1 - c6 */
+    }
+    prom[7] = 0;                                                                   /* clear the last word */
+    prom[0] |= (uint16_t)(a_sim_crc4(prom) << 12);                                 /* set the crc */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the raw data of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] d1 raw pressure
+ * @param[in] d2 raw temperature
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      none
+ */
+uint8_t ms5837_sim_set_raw(ms5837_sim_t *sim, uint8_t index, uint32_t d1, uint32_t d2)
+{
+    uint8_t res;
+    
+    res = a_sim_check(sim, index);              /* check the params */
+    if (res != 0)                               /* check the result */
+    {
+        return res;                             /* return error */
+    }
+    
+    sim->chip[index].d1 = d1 & 0xFFFFFF;        /* set d1 */
+    sim->chip[index].d2 = d2 & 0xFFFFFF;        /* set d2 */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the environment of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] temperature_c temperature
+ * @param[in] pressure_mbar pressure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      the raw data come from the inverted first order compensation of the prom type,
+ *            so the second order correction below 20C shifts the readings slightly
+ */
+uint8_t ms5837_sim_set_environment(ms5837_sim_t *sim, uint8_t index, float temperature_c, float pressure_mbar)
+{
+    uint8_t res;
+    const uint16_t *prom;
+    double dt;
+    double sens;
+    double off;
+    double d1;
+    double d2;
+    
+    res = a_sim_check(sim, index);                                                      /* check the params */
+    if (res != 0)                                                                       /* check the result */
+    {
+        return res;                                                                     /* return error */
+    }
+    
+    prom = sim->chip[index].prom;                                                       /* get the prom */
+    dt = ((double)temperature_c * 100.0 - 2000.0) * 8388608.0 / (double)prom[6];        /* temp = 2000 + dt * c6 / 2^23 */
+    d2 = (double)prom[5] * 256.0 + dt;                                                  /* dt = d2 - c5 * 2^8 */
+    if (((prom[0] >> 5) & 0x7F) == gs_sim_type_bits[MS5837_TYPE_30BA26])                /* 30ba26 */
+    {
+        sens = (double)prom[1] * 32768.0 + (double)prom[3] * dt / 256.0;                /* get the sens */
+        off = (double)prom[2] * 65536.0 + (double)prom[4] * dt / 128.0;                 /* get the off */
+        d1 = ((double)pressure_mbar * 10.0 * 8192.0 + off) * 2097152.0 / sens;          /* p = (d1 * sens / 2^21 - off) / 2^13 */
+    }
+    else                                                                                /* 02ba01 and 02ba21 */
+    {
+        sens = (double)prom[1] * 65536.0 + (double)prom[3] * dt / 128.0;                /* get the sens */
+        off = (double)prom[2] * 131072.0 + (double)prom[4] * dt / 64.0;                 /* get the off */
+        d1 = ((double)pressure_mbar * 100.0 * 32768.0 + off) * 2097152.0 / sens;        /* p = (d1 * sens / 2^21 - off) / 2^15 */
+    }
+    d1 = (d1 < 0.0) ? 0.0 : ((d1 > 16777215.0) ? 16777215.0 : d1);                      /* clamp to 24 bits */
+    d2 = (d2 < 0.0) ? 0.0 : ((d2 > 16777215.0) ? 16777215.0 : d2);                      /* clamp to 24 bits */
+    sim->chip[index].d1 = (uint32_t)(d1 + 0.5);                                         /* set d1 */
+    sim->chip[index].d2 = (uint32_t)(d2 + 0.5);                                         /* set d2 */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the raw signal model of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] *signal pointer to a signal model, NULL uses the fixed raw data
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      the model is sampled at the virtual end time of every conversion
+ */
+uint8_t ms5837_sim_set_signal(ms5837_sim_t *sim, uint8_t index,
+                              void (*signal)(uint8_t index, uint64_t time_us, uint32_t *d1, uint32_t *d2))
+{
+    uint8_t res;
+    
+    res = a_sim_check(sim, index);           /* check the params */
+    if (res != 0)                            /* check the result */
+    {
+        return res;                          /* return error */
+    }
+    
+    sim->chip[index].signal = signal;        /* set the model */
+    
+    return 0;                                /* success return 0 */
+}
+
+/**
+ * @brief     inject iic failures
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] reads next reads to fail
+ * @param[in] writes next writes to fail
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      none
+ */
+uint8_t ms5837_sim_set_fault(ms5837_sim_t *sim, uint8_t index, uint32_t reads, uint32_t writes)
+{
+    uint8_t res;
+    
+    res = a_sim_check(sim, index);                /* check the params */
+    if (res != 0)                                 /* check the result */
+    {
+        return res;                               /* return error */
+    }
+    
+    sim->chip[index].fail_reads = reads;          /* set the read faults */
+    sim->chip[index].fail_writes = writes;        /* set the write faults */
+    
+    return 0;                                     /* success return 0 */
+}
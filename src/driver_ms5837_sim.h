@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_sim.h
+ * @brief     driver ms5837 sim header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_SIM_H
+#define DRIVER_MS5837_SIM_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_sim_driver ms5837 sim driver function
+ * @brief    ms5837 sim driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 sim max chip number definition
+ */
+#define MS5837_SIM_MAX_NUM 4        /**< simulated chips */
+
+/**
+ * @brief ms5837 sim chip structure definition
+ */
+typedef struct ms5837_sim_chip_s
+{
+    uint16_t prom[8];                                                                   /**< prom words with the crc */
+    uint32_t d1;                                                                        /**< raw pressure */
+    uint32_t d2;                                                                        /**< raw temperature */
+    void (*signal)(uint8_t index, uint64_t time_us, uint32_t *d1, uint32_t *d2);        /**< raw signal model, NULL keeps d1 and d2 */
+    uint8_t cmd;                                                                        /**< running conversion command */
+    uint8_t converting;                                                                 /**< conversion running flag */
+    uint64_t ready_us;                                                                  /**< conversion ready time */
+    uint32_t fail_reads;                                                                /**< next reads to fail */
+    uint32_t fail_writes;                                                               /**< next writes to fail */
+    uint64_t reads;                                                                     /**< iic reads */
+    uint64_t writes;                                                                    /**< iic writes */
+    uint64_t early_reads;                                                               /**< adc reads before the conversion end */
+} ms5837_sim_chip_t;
+
+/**
+ * @brief ms5837 sim structure definition
+ */
+typedef struct ms5837_sim_s
+{
+    uint64_t now_us;                                  /**< virtual clock in us */
+    uint32_t transfer_us;                             /**< virtual time of one iic transfer */
+    ms5837_sim_chip_t chip[MS5837_SIM_MAX_NUM];       /**< simulated chips, one per slot */
+    uint8_t inited;                                   /**< inited flag */
+} ms5837_sim_t;
+
+/**
+ * @brief     initialize the simulator
+ * @param[in] *sim pointer to a sim structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ * @note      the linked functions have no context, so only the last initialized simulator is active,
+ *            every chip starts as a 02ba01 at 20C and 1013.25mbar with the virtual clock at 0
+ */
+uint8_t ms5837_sim_init(ms5837_sim_t *sim);
+
+/**
+ * @brief     close the simulator
+ * @param[in] *sim pointer to a sim structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ * @note      none
+ */
+uint8_t ms5837_sim_deinit(ms5837_sim_t *sim);
+
+/**
+ * @brief     link a handle to a simulated chip
+ * @param[in] *handle pointer to an ms5837 handle structure
+ * @param[in] index chip slot index
+ * @return    status code
+ *            - 0 success
+ *            - 1 link failed
+ *            - 2 handle is NULL
+ * @note      it links iic, delay_ms and timestamp_us, the caller still links debug_print,
+ *            delay_ms advances the virtual clock instead of sleeping
+ */
+uint8_t ms5837_sim_link(ms5837_handle_t *handle, uint8_t index);
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] us advanced time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ * @note      use it for the idle time between samples
+ */
+uint8_t ms5837_sim_advance(ms5837_sim_t *sim, uint64_t us);
+
+/**
+ * @brief     set the prom of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] type chip type
+ * @param[in] *c pointer to the c1 - c6 coefficients, NULL keeps the current ones
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      the type bits and the crc of word 0 are generated
+ */
+uint8_t ms5837_sim_set_prom(ms5837_sim_t *sim, uint8_t index, ms5837_type_t type, const uint16_t c[6]);
+
+/**
+ * @brief     set the raw data of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] d1 raw pressure
+ * @param[in] d2 raw temperature
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      none
+ */
+uint8_t ms5837_sim_set_raw(ms5837_sim_t *sim, uint8_t index, uint32_t d1, uint32_t d2);
+
+/**
+ * @brief     set the environment of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] temperature_c temperature
+ * @param[in] pressure_mbar pressure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      the raw data come from the inverted first order compensation of the prom type,
+ *            so the second order correction below 20C shifts the readings slightly
+ */
+uint8_t ms5837_sim_set_environment(ms5837_sim_t *sim, uint8_t index, float temperature_c, float pressure_mbar);
+
+/**
+ * @brief     set the raw signal model of a chip
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] *signal pointer to a signal model, NULL uses the fixed raw data
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      the model is sampled at the virtual end time of every conversion
+ */
+uint8_t ms5837_sim_set_signal(ms5837_sim_t *sim, uint8_t index,
+                              void (*signal)(uint8_t index, uint64_t time_us, uint32_t *d1, uint32_t *d2));
+
+/**
+ * @brief     inject iic failures
+ * @param[in] *sim pointer to a sim structure
+ * @param[in] index chip slot index
+ * @param[in] reads next reads to fail
+ * @param[in] writes next writes to fail
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ *            - 3 sim is not initialized
+ *            - 4 index is invalid
+ * @note      none
+ */
+uint8_t ms5837_sim_set_fault(ms5837_sim_t *sim, uint8_t index, uint32_t reads, uint32_t writes);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
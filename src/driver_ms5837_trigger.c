@@ -0,0 +1,330 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_trigger.c
+ * @brief     driver ms5837 trigger source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_trigger.h"
+
+/**
+ * @brief     fire an event
+ * @param[in] *trigger pointer to a trigger structure
+ * @param[in] rule rule index
+ * @param[in] active active flag
+ * @param[in] time_us sample time
+ * @param[in] value source value
+ * @note      none
+ */
+static void a_trigger_fire(ms5837_trigger_t *trigger, uint8_t rule, uint8_t active, uint64_t time_us, int32_t value)
+{
+    ms5837_trigger_event_t event;
+    uint32_t head;
+    
+    event.time_us = time_us;                            /* set the time */
+    event.value = value;                                /* set the value */
+    event.rule = rule;                                  /* set the rule */
+    event.active = active;                              /* set the state */
+    if (trigger->receive != NULL)                       /* check the callback */
+    {
+        trigger->receive(&event);                       /* call the callback */
+    }
+    if (trigger->buf == NULL)                           /* check the buffer */
+    {
+        return;                                         /* no buffer */
+    }
+    head = trigger->head;                               /* get the head */
+    if ((head - trigger->tail) >= trigger->size)        /* check the space */
+    {
+        trigger->dropped++;                             /* count the dropped */
+        
+        return;                                         /* no buffer */
+    }
+    trigger->buf[head % trigger->size] = event;         /* store the event */
+    MS5837_BARRIER();                                   /* order the event and the index */
+    trigger->head = head + 1;                           /* update the head */
+}
+
+/**
+ * @brief     initialize a trigger
+ * @param[in] *trigger pointer to a trigger structure
+ * @param[in] *buf pointer to an event buffer, NULL only calls the callback
+ * @param[in] size event buffer size
+ * @param[in] rate_span_us span of the pressure rate
+ * @return    status code
+ *            - 0 success
+ *            - 2 trigger is NULL
+ *            - 4 rate span is invalid
+ * @note      the pressure rate is updated once per span, a longer span gives a smoother rate
+ */
+uint8_t ms5837_trigger_init(ms5837_trigger_t *trigger, ms5837_trigger_event_t *buf, uint32_t size, uint32_t rate_span_us)
+{
+    if (trigger == NULL)                                 /* check trigger */
+    {
+        return 2;                                        /* return error */
+    }
+    if (rate_span_us == 0)                               /* check the span */
+    {
+        return 4;                                        /* return error */
+    }
+    
+    memset(trigger, 0, sizeof(ms5837_trigger_t));        /* clear the trigger */
+    trigger->buf = (size != 0) ? buf : NULL;             /* set the buffer */
+    trigger->size = size;                                /* set the size */
+    trigger->rate_span_us = rate_span_us;                /* set the span */
+    trigger->inited = 1;                                 /* flag inited */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief      add a rule
+ * @param[in]  *trigger pointer to a trigger structure
+ * @param[in]  *rule pointer to a rule structure
+ * @param[out] *index pointer to a rule index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trigger is full
+ *             - 2 trigger is NULL
+ *             - 3 trigger is not initialized
+ *             - 4 rule is invalid
+ * @note       add the rules before the sampling starts
+ */
+uint8_t ms5837_trigger_add_rule(ms5837_trigger_t *trigger, const ms5837_trigger_rule_t *rule, uint8_t *index)
+{
+    if (trigger == NULL)                                 /* check trigger */
+    {
+        return 2;                                        /* return error */
+    }
+    if (trigger->inited != 1)                            /* check trigger initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    if ((rule == NULL) || (rule->hysteresis < 0) ||
+        (rule->source > MS5837_TRIGGER_SOURCE_PRESSURE_RATE) ||
+        (rule->edge > MS5837_TRIGGER_EDGE_BELOW))        /* check the rule */
+    {
+        return 4;                                        /* return error */
+    }
+    if (trigger->num >= MS5837_TRIGGER_MAX_RULE)         /* check the rules */
+    {
+        return 1;                                        /* return error */
+    }
+    
+    trigger->rule[trigger->num] = *rule;                 /* copy the rule */
+    *index = trigger->num;                               /* set the index */
+    trigger->num++;                                      /* count the rule */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the event callback
+ * @param[in] *trigger pointer to a trigger structure
+ * @param[in] *receive pointer to an event callback, NULL to disable
+ * @return    status code
+ *            - 0 success
+ *            - 2 trigger is NULL
+ *            - 3 trigger is not initialized
+ * @note      the callback runs in the sampling thread, keep it short
+ */
+uint8_t ms5837_trigger_set_callback(ms5837_trigger_t *trigger, void (*receive)(const ms5837_trigger_event_t *event))
+{
+    if (trigger == NULL)               /* check trigger */
+    {
+        return 2;                      /* return error */
+    }
+    if (trigger->inited != 1)          /* check trigger initialization */
+    {
+        return 3;                      /* return error */
+    }
+    
+    trigger->receive = receive;        /* set the callback */
+    
+    return 0;                          /* success return 0 */
+}
+
+/**
+ * @brief     evaluate the rules on a sample
+ * @param[in] *trigger pointer to a trigger structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 no event
+ *            - 1 events are fired
+ *            - 2 trigger is NULL
+ *            - 3 trigger is not initialized
+ * @note      a rule fires once when it enters and once when it is released,
+ *            a return of 1 is the moment to wake a sleeping consumer
+ */
+uint8_t ms5837_trigger_evaluate(ms5837_trigger_t *trigger, uint64_t time_us, int32_t temperature, int32_t pressure)
+{
+    const ms5837_trigger_rule_t *rule;
+    int32_t rate = 0;
+    int32_t value;
+    int64_t release;
+    uint8_t rate_valid = 0;
+    uint8_t last;
+    uint8_t active;
+    uint8_t mask;
+    uint8_t res = 0;
+    uint8_t i;
+    
+    if (trigger == NULL)                                                                                 /* check trigger */
+    {
+        return 2;                                                                                        /* return error */
+    }
+    if (trigger->inited != 1)                                                                            /* check trigger initialization */
+    {
+        return 3;                                                                                        /* return error */
+    }
+    
+    /* update the pressure rate once per span */
+    if (trigger->rate_started == 0)                                                                      /* first sample */
+    {
+        trigger->rate_time_us = time_us;                                                                 /* start the span */
+        trigger->rate_pressure = pressure;                                                               /* set the start pressure */
+        trigger->rate_started = 1;                                                                       /* flag started */
+    }
+    else if ((time_us - trigger->rate_time_us) >= trigger->rate_span_us)                                 /* span passed */
+    {
+        rate = (int32_t)(((int64_t)pressure - trigger->rate_pressure) * 1000000LL /
+                         (int64_t)(time_us - trigger->rate_time_us));                                    /* pressure change per second */
+        rate_valid = 1;                                                                                  /* flag the rate */
+        trigger->rate_time_us = time_us;                                                                 /* start the span */
+        trigger->rate_pressure = pressure;                                                               /* set the start pressure */
+    }
+    
+    /* enter past the threshold, release past the hysteresis */
+    for (i = 0; i < trigger->num; i++)                                                                   /* all rules */
+    {
+        rule = &trigger->rule[i];                                                                        /* get the rule */
+        if (rule->source == MS5837_TRIGGER_SOURCE_PRESSURE_RATE)                                         /* rate rule */
+        {
+            if (rate_valid == 0)                                                                         /* check the rate */
+            {
+                continue;                                                                                /* wait for the rate */
+            }
+            value = rate;                                                                                /* use the rate */
+        }
+        else
+        {
+            value = (rule->source == MS5837_TRIGGER_SOURCE_TEMPERATURE) ? temperature : pressure;        /* use the sample */
+        }
+        mask = (uint8_t)(1 << i);                                                                        /* rule mask */
+        last = ((trigger->active & mask) != 0) ? 1 : 0;                                                  /* last state */
+        if (rule->edge == MS5837_TRIGGER_EDGE_ABOVE)                                                     /* above */
+        {
+            release = (int64_t)rule->threshold - rule->hysteresis;                                       /* release below */
+            active = (last == 0) ? (value > rule->threshold) : ((int64_t)value >= release);              /* check the state */
+        }
+        else
+        {
+            release = (int64_t)rule->threshold + rule->hysteresis;                                       /* release above */
+            active = (last == 0) ? (value < rule->threshold) : ((int64_t)value <= release);              /* check the state */
+        }
+        if (active != last)                                                                              /* check the change */
+        {
+            trigger->active ^= mask;                                                                     /* flip the state */
+            a_trigger_fire(trigger, i, active, time_us, value);                                          /* fire the event */
+            res = 1;                                                                                     /* flag the event */
+        }
+    }
+    
+    return res;                                                                                          /* return the result */
+}
+
+/**
+ * @brief      pop an event
+ * @param[in]  *trigger pointer to a trigger structure
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no event
+ *             - 2 trigger is NULL
+ *             - 3 trigger is not initialized
+ * @note       a full buffer drops the new events and counts them
+ */
+uint8_t ms5837_trigger_pop(ms5837_trigger_t *trigger, ms5837_trigger_event_t *event)
+{
+    uint32_t tail;
+    
+    if (trigger == NULL)                                          /* check trigger */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (trigger->inited != 1)                                     /* check trigger initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    
+    tail = trigger->tail;                                         /* get the tail */
+    if ((trigger->buf == NULL) || (tail == trigger->head))        /* check the events */
+    {
+        return 1;                                                 /* return error */
+    }
+    MS5837_BARRIER();                                             /* order the event and the index */
+    *event = trigger->buf[tail % trigger->size];                  /* copy the event */
+    MS5837_BARRIER();                                             /* order the event and the index */
+    trigger->tail = tail + 1;                                     /* update the tail */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the active rules
+ * @param[in]  *trigger pointer to a trigger structure
+ * @param[out] *active pointer to an active rule mask buffer
+ * @param[out] *dropped pointer to a dropped event number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 trigger is NULL
+ *             - 3 trigger is not initialized
+ * @note       bit n is set while rule n is active
+ */
+uint8_t ms5837_trigger_get_state(ms5837_trigger_t *trigger, uint8_t *active, uint32_t *dropped)
+{
+    if (trigger == NULL)                /* check trigger */
+    {
+        return 2;                       /* return error */
+    }
+    if (trigger->inited != 1)           /* check trigger initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    *active = trigger->active;          /* get the mask */
+    *dropped = trigger->dropped;        /* get the dropped */
+    
+    return 0;                           /* success return 0 */
+}
@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_trigger.h
+ * @brief     driver ms5837 trigger header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_TRIGGER_H
+#define DRIVER_MS5837_TRIGGER_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_trigger_driver ms5837 trigger driver function
+ * @brief    ms5837 trigger driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 trigger rule number definition
+ */
+#define MS5837_TRIGGER_MAX_RULE        8        /**< max rules of a trigger */
+
+/**
+ * @brief ms5837 trigger source enumeration definition
+ */
+typedef enum
+{
+    MS5837_TRIGGER_SOURCE_TEMPERATURE   = 0x00,        /**< temperature */
+    MS5837_TRIGGER_SOURCE_PRESSURE      = 0x01,        /**< pressure */
+    MS5837_TRIGGER_SOURCE_PRESSURE_RATE = 0x02,        /**< pressure change per second */
+} ms5837_trigger_source_t;
+
+/**
+ * @brief ms5837 trigger edge enumeration definition
+ */
+typedef enum
+{
+    MS5837_TRIGGER_EDGE_ABOVE = 0x00,        /**< active above the threshold */
+    MS5837_TRIGGER_EDGE_BELOW = 0x01,        /**< active below the threshold */
+} ms5837_trigger_edge_t;
+
+/**
+ * @brief ms5837 trigger rule structure definition
+ * @note  the values keep the units of ms5837_compensate, the rate is in pressure units per second
+ */
+typedef struct ms5837_trigger_rule_s
+{
+    int32_t threshold;         /**< threshold */
+    int32_t hysteresis;        /**< distance back over the threshold that releases the rule */
+    uint8_t source;            /**< trigger source */
+    uint8_t edge;              /**< trigger edge */
+} ms5837_trigger_rule_t;
+
+/**
+ * @brief ms5837 trigger event structure definition
+ */
+typedef struct ms5837_trigger_event_s
+{
+    uint64_t time_us;        /**< sample time */
+    int32_t value;           /**< source value */
+    uint8_t rule;            /**< rule index */
+    uint8_t active;          /**< 1 when the rule enters, 0 when it is released */
+} ms5837_trigger_event_t;
+
+/**
+ * @brief ms5837 trigger structure definition
+ * @note  the sampling thread evaluates and one consumer pops the events at the same time without a lock
+ */
+typedef struct ms5837_trigger_s
+{
+    ms5837_trigger_rule_t rule[MS5837_TRIGGER_MAX_RULE];                 /**< rules */
+    uint8_t num;                                                         /**< rule number */
+    volatile uint8_t active;                                             /**< active rule mask */
+    uint32_t rate_span_us;                                               /**< span of the pressure rate */
+    uint64_t rate_time_us;                                               /**< start of the rate span */
+    int32_t rate_pressure;                                               /**< pressure at the start of the span */
+    uint8_t rate_started;                                                /**< rate span started flag */
+    void (*receive)(const ms5837_trigger_event_t *event);                /**< event callback */
+    ms5837_trigger_event_t *buf;                                         /**< event buffer */
+    uint32_t size;                                                       /**< event buffer size */
+    volatile uint32_t head;                                              /**< written events, only changed by the producer */
+    volatile uint32_t tail;                                              /**< read events, only changed by the consumer */
+    volatile uint32_t dropped;                                           /**< dropped events */
+    uint8_t inited;                                                      /**< inited flag */
+} ms5837_trigger_t;
+
+/**
+ * @brief     initialize a trigger
+ * @param[in] *trigger pointer to a trigger structure
+ * @param[in] *buf pointer to an event buffer, NULL only calls the callback
+ * @param[in] size event buffer size
+ * @param[in] rate_span_us span of the pressure rate
+ * @return    status code
+ *            - 0 success
+ *            - 2 trigger is NULL
+ *            - 4 rate span is invalid
+ * @note      the pressure rate is updated once per span, a longer span gives a smoother rate
+ */
+uint8_t ms5837_trigger_init(ms5837_trigger_t *trigger, ms5837_trigger_event_t *buf, uint32_t size, uint32_t rate_span_us);
+
+/**
+ * @brief      add a rule
+ * @param[in]  *trigger pointer to a trigger structure
+ * @param[in]  *rule pointer to a rule structure
+ * @param[out] *index pointer to a rule index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trigger is full
+ *             - 2 trigger is NULL
+ *             - 3 trigger is not initialized
+ *             - 4 rule is invalid
+ * @note       add the rules before the sampling starts
+ */
+uint8_t ms5837_trigger_add_rule(ms5837_trigger_t *trigger, const ms5837_trigger_rule_t *rule, uint8_t *index);
+
+/**
+ * @brief     set the event callback
+ * @param[in] *trigger pointer to a trigger structure
+ * @param[in] *receive pointer to an event callback, NULL to disable
+ * @return    status code
+ *            - 0 success
+ *            - 2 trigger is NULL
+ *            - 3 trigger is not initialized
+ * @note      the callback runs in the sampling thread, keep it short
+ */
+uint8_t ms5837_trigger_set_callback(ms5837_trigger_t *trigger, void (*receive)(const ms5837_trigger_event_t *event));
+
+/**
+ * @brief     evaluate the rules on a sample
+ * @param[in] *trigger pointer to a trigger structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 no event
+ *            - 1 events are fired
+ *            - 2 trigger is NULL
+ *            - 3 trigger is not initialized
+ * @note      a rule fires once when it enters and once when it is released,
+ *            a return of 1 is the moment to wake a sleeping consumer
+ */
+uint8_t ms5837_trigger_evaluate(ms5837_trigger_t *trigger, uint64_t time_us, int32_t temperature, int32_t pressure);
+
+/**
+ * @brief      pop an event
+ * @param[in]  *trigger pointer to a trigger structure
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no event
+ *             - 2 trigger is NULL
+ *             - 3 trigger is not initialized
+ * @note       a full buffer drops the new events and counts them
+ */
+uint8_t ms5837_trigger_pop(ms5837_trigger_t *trigger, ms5837_trigger_event_t *event);
+
+/**
+ * @brief      get the active rules
+ * @param[in]  *trigger pointer to a trigger structure
+ * @param[out] *active pointer to an active rule mask buffer
+ * @param[out] *dropped pointer to a dropped event number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 trigger is NULL
+ *             - 3 trigger is not initialized
+ * @note       bit n is set while rule n is active
+ */
+uint8_t ms5837_trigger_get_state(ms5837_trigger_t *trigger, uint8_t *active, uint32_t *dropped);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
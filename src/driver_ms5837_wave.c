@@ -0,0 +1,426 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_wave.c
+ * @brief     driver ms5837 wave source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_wave.h"
+#include <math.h>
+
+/**
+ * @brief wave constant definition
+ */
+#define MS5837_WAVE_PI            3.14159265358979f        /**< pi */
+#define MS5837_WAVE_G             9.80665f                 /**< standard gravity */
+#define MS5837_WAVE_KP_MIN        0.1f                     /**< min pressure response of a used frequency */
+
+/**
+ * @brief         run an in place radix 2 fft
+ * @param[in,out] *wave pointer to a wave structure
+ * @note          none
+ */
+static void a_wave_fft(ms5837_wave_t *wave)
+{
+    uint32_t n;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t m;
+    uint32_t a;
+    uint32_t b;
+    uint32_t half;
+    uint32_t step;
+    float c;
+    float s;
+    float tr;
+    float ti;
+    
+    n = wave->config.length;
+    j = 0;
+    for (i = 1; i < n; i++)
+    {
+        m = n >> 1;
+        while ((j & m) != 0)
+        {
+            j ^= m;
+            m >>= 1;
+        }
+        j |= m;
+        if (i < j)
+        {
+            tr = wave->re[i];
+            wave->re[i] = wave->re[j];
+            wave->re[j] = tr;
+            ti = wave->im[i];
+            wave->im[i] = wave->im[j];
+            wave->im[j] = ti;
+        }
+    }
+    for (half = 1; half < n; half <<= 1)
+    {
+        step = n / (2 * half);
+        for (i = 0; i < n; i += 2 * half)
+        {
+            for (k = 0; k < half; k++)
+            {
+                c = wave->twiddle_cos[k * step];
+                s = wave->twiddle_sin[k * step];
+                a = i + k;
+                b = a + half;
+                tr = wave->re[b] * c + wave->im[b] * s;
+                ti = wave->im[b] * c - wave->re[b] * s;
+                wave->re[b] = wave->re[a] - tr;
+                wave->im[b] = wave->im[a] - ti;
+                wave->re[a] += tr;
+                wave->im[a] += ti;
+            }
+        }
+    }
+}
+
+/**
+ * @brief     get the wave number of a frequency
+ * @param[in] omega angular frequency
+ * @param[in] depth water depth
+ * @return    wave number
+ * @note      an explicit start solved with two newton steps of the dispersion relation
+ */
+static float a_wave_number(float omega, float depth)
+{
+    float k;
+    float t;
+    float f;
+    float d;
+    uint8_t i;
+    
+    k = omega * omega / MS5837_WAVE_G;
+    if (depth <= 0.0f)
+    {
+        return k;
+    }
+    k = k / powf(tanhf(powf(k * depth, 0.75f)), 2.0f / 3.0f);
+    for (i = 0; i < 2; i++)
+    {
+        t = tanhf(k * depth);
+        f = MS5837_WAVE_G * k * t - omega * omega;
+        d = MS5837_WAVE_G * t + MS5837_WAVE_G * k * depth * (1.0f - t * t);
+        k -= f / d;
+    }
+    
+    return k;
+}
+
+/**
+ * @brief         sum the periodogram of the last segment
+ * @param[in,out] *wave pointer to a wave structure
+ * @note          the segment mean is removed before the window
+ */
+static void a_wave_segment(ms5837_wave_t *wave)
+{
+    uint32_t n;
+    uint32_t i;
+    float mean;
+    
+    n = wave->config.length;
+    mean = 0.0f;
+    for (i = 0; i < n; i++)
+    {
+        mean += wave->depth[i];
+    }
+    mean /= (float)n;
+    for (i = 0; i < n; i++)
+    {
+        wave->re[i] = (wave->depth[(wave->pos + i) % n] - mean) * wave->window[i];
+        wave->im[i] = 0.0f;
+    }
+    a_wave_fft(wave);
+    for (i = 0; i <= n / 2; i++)
+    {
+        wave->psd[i] += wave->re[i] * wave->re[i] + wave->im[i] * wave->im[i];
+    }
+    wave->depth_sum += mean;
+    wave->segments++;
+}
+
+/**
+ * @brief         make a summary of the summed periodograms
+ * @param[in,out] *wave pointer to a wave structure
+ * @note          the pressure spectrum is taken to the surface with the linear wave response,
+ *                frequencies with a response below MS5837_WAVE_KP_MIN are left out
+ */
+static void a_wave_summary(ms5837_wave_t *wave)
+{
+    ms5837_wave_summary_t summary;
+    uint32_t n;
+    uint32_t i;
+    uint8_t b;
+    float fs;
+    float df;
+    float scale;
+    float h;
+    float d;
+    float f;
+    float k;
+    float kp;
+    float s;
+    float e;
+    float m0;
+    float m2;
+    float peak;
+    float fp;
+    
+    memset(&summary, 0, sizeof(ms5837_wave_summary_t));
+    n = wave->config.length;
+    fs = 1000000.0f / (float)wave->config.period_us;
+    df = fs / (float)n;
+    scale = 2.0f / (fs * wave->power * (float)wave->segments);
+    h = (float)(wave->depth_sum / (double)wave->segments);
+    h = (h < 0.0f) ? 0.0f : h;
+    d = h + wave->config.height_m;
+    m0 = 0.0f;
+    m2 = 0.0f;
+    peak = 0.0f;
+    fp = 0.0f;
+    for (i = 1; i < n / 2; i++)
+    {
+        f = (float)i * df;
+        if ((f < wave->config.band_hz[0]) || (f >= wave->config.band_hz[wave->config.band_num]))
+        {
+            continue;
+        }
+        k = a_wave_number(2.0f * MS5837_WAVE_PI * f, d);
+        kp = (expf(-k * h) + expf(-k * (2.0f * d - h))) / (1.0f + expf(-2.0f * k * d));
+        if (kp < MS5837_WAVE_KP_MIN)
+        {
+            continue;
+        }
+        s = wave->psd[i] * scale / (kp * kp);
+        e = s * df;
+        m0 += e;
+        m2 += e * f * f;
+        if (s > peak)
+        {
+            peak = s;
+            fp = f;
+        }
+        for (b = 0; b < wave->config.band_num; b++)
+        {
+            if (f < wave->config.band_hz[b + 1])
+            {
+                summary.band_m2[b] += e;
+                
+                break;
+            }
+        }
+    }
+    summary.time_us = wave->time_us;
+    summary.count = wave->summary.count + 1;
+    summary.segments = wave->segments;
+    summary.gaps = wave->gaps;
+    summary.depth_m = h;
+    summary.hs_m = 4.0f * sqrtf(m0);
+    summary.tp_s = (fp > 0.0f) ? (1.0f / fp) : 0.0f;
+    summary.tz_s = (m2 > 0.0f) ? sqrtf(m0 / m2) : 0.0f;
+    
+    wave->seq++;
+    MS5837_BARRIER();
+    wave->summary = summary;
+    MS5837_BARRIER();
+    wave->seq++;
+    
+    memset(wave->psd, 0, sizeof(wave->psd));
+    wave->depth_sum = 0.0;
+    wave->segments = 0;
+    wave->gaps = 0;
+}
+
+/**
+ * @brief     initialize a wave analyser
+ * @param[in] *wave pointer to a wave structure
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 wave or config is NULL
+ *            - 4 config is invalid
+ * @note      none
+ */
+uint8_t ms5837_wave_init(ms5837_wave_t *wave, const ms5837_wave_config_t *config)
+{
+    uint32_t i;
+    float nyquist;
+    float angle;
+    
+    if ((wave == NULL) || (config == NULL))                                                   /* check wave and config */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if ((config->period_us < 1000) || (config->period_us > 10000000) ||
+        (config->length < 16) || (config->length > MS5837_WAVE_LENGTH_MAX) ||
+        ((config->length & (config->length - 1)) != 0) || (config->segments == 0) ||
+        (config->density < 500.0f) || (config->density > 2000.0f) || (config->height_m < 0.0f) ||
+        (config->band_num == 0) || (config->band_num > MS5837_WAVE_BAND_MAX))                 /* check the config */
+    {
+        return 4;                                                                             /* return error */
+    }
+    nyquist = 500000.0f / (float)config->period_us;                                           /* get the nyquist frequency */
+    if ((config->band_hz[0] <= 0.0f) || (config->band_hz[config->band_num] > nyquist))        /* check the band range */
+    {
+        return 4;                                                                             /* return error */
+    }
+    for (i = 0; i < config->band_num; i++)                                                    /* check each band */
+    {
+        if (config->band_hz[i + 1] <= config->band_hz[i])                                     /* check the edge order */
+        {
+            return 4;                                                                         /* return error */
+        }
+    }
+    
+    memset(wave, 0, sizeof(ms5837_wave_t));                                                   /* clear the analyser */
+    wave->config = *config;                                                                   /* save the config */
+    wave->pa = (config->type == MS5837_TYPE_30BA26) ? 10 : 1;                                 /* set the pressure unit */
+    angle = 2.0f * MS5837_WAVE_PI / (float)config->length;                                    /* get the angle of one sample */
+    for (i = 0; i < config->length; i++)                                                      /* make the window */
+    {
+        wave->window[i] = 0.5f - 0.5f * cosf(angle * (float)i);                               /* set the hann weight */
+        wave->power += wave->window[i] * wave->window[i];                                     /* sum the window power */
+    }
+    for (i = 0; i < config->length / 2; i++)                                                  /* make the twiddles */
+    {
+        wave->twiddle_cos[i] = cosf(angle * (float)i);                                        /* set the cosine */
+        wave->twiddle_sin[i] = sinf(angle * (float)i);                                        /* set the sine */
+    }
+    wave->inited = 1;                                                                         /* flag inited */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     add a sample
+ * @param[in] *wave pointer to a wave structure
+ * @param[in] time_us sample time
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 2 wave is NULL
+ *            - 3 wave is not initialized
+ *            - 4 time is not after the last sample
+ * @note      every half segment runs a windowed fft of the last segment and sums its periodogram,
+ *            the configured number of segments makes a summary,
+ *            a gap over 1.5 periods restarts the segment, only one thread can add
+ */
+uint8_t ms5837_wave_add(ms5837_wave_t *wave, uint64_t time_us, int32_t pressure)
+{
+    uint64_t elapsed;
+    float pa;
+    
+    if (wave == NULL)                                                                          /* check wave */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (wave->inited != 1)                                                                     /* check wave initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if ((wave->started != 0) && (time_us <= wave->time_us))                                    /* check the time */
+    {
+        return 4;                                                                              /* return error */
+    }
+    
+    elapsed = time_us - wave->time_us;                                                         /* get the elapsed time */
+    if ((wave->started != 0) && (elapsed * 2 > (uint64_t)wave->config.period_us * 3))          /* check the gap */
+    {
+        wave->fill = 0;                                                                        /* drop the segment */
+        wave->step = 0;                                                                        /* restart the hop */
+        wave->gaps++;                                                                          /* count the gap */
+    }
+    pa = (float)(pressure - wave->config.surface) * (float)wave->pa;                           /* get the water pressure */
+    wave->depth[wave->pos] = pa / (wave->config.density * MS5837_WAVE_G);                      /* save the depth */
+    wave->pos = (uint16_t)((wave->pos + 1) % wave->config.length);                             /* step the ring */
+    if (wave->fill < wave->config.length)                                                      /* check the fill */
+    {
+        wave->fill++;                                                                          /* count the sample */
+    }
+    wave->step++;                                                                              /* step the hop */
+    wave->time_us = time_us;                                                                   /* save the time */
+    wave->started = 1;                                                                         /* flag started */
+    if ((wave->fill == wave->config.length) && (wave->step >= wave->config.length / 2))        /* check the hop */
+    {
+        a_wave_segment(wave);                                                                  /* sum the periodogram */
+        wave->step = 0;                                                                        /* restart the hop */
+        if (wave->segments >= wave->config.segments)                                           /* check the segments */
+        {
+            a_wave_summary(wave);                                                              /* make a summary */
+        }
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the last summary
+ * @param[in]  *wave pointer to a wave structure
+ * @param[out] *summary pointer to a summary buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no summary yet
+ *             - 2 wave is NULL
+ *             - 3 wave is not initialized
+ * @note       a new summary has a new count
+ */
+uint8_t ms5837_wave_get_summary(ms5837_wave_t *wave, ms5837_wave_summary_t *summary)
+{
+    uint32_t seq;
+    
+    if (wave == NULL)                                        /* check wave */
+    {
+        return 2;                                            /* return error */
+    }
+    if (wave->inited != 1)                                   /* check wave initialization */
+    {
+        return 3;                                            /* return error */
+    }
+    
+    do
+    {
+        seq = wave->seq;                                     /* get the sequence */
+        MS5837_BARRIER();                                    /* order the sequence and the summary */
+        *summary = wave->summary;                            /* copy the summary */
+        MS5837_BARRIER();                                    /* order the summary and the sequence */
+    } while (((seq & 1) != 0) || (seq != wave->seq));        /* retry a torn copy */
+    if (summary->count == 0)                                 /* check the count */
+    {
+        return 1;                                            /* no summary yet */
+    }
+    
+    return 0;                                                /* success return 0 */
+}
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_wave.h
+ * @brief     driver ms5837 wave header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_WAVE_H
+#define DRIVER_MS5837_WAVE_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_wave_driver ms5837 wave driver function
+ * @brief    ms5837 wave driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 wave limit definition
+ */
+#define MS5837_WAVE_LENGTH_MAX        1024        /**< max segment length */
+#define MS5837_WAVE_BAND_MAX          8           /**< max band number */
+
+/**
+ * @brief ms5837 wave config structure definition
+ */
+typedef struct ms5837_wave_config_s
+{
+    ms5837_type_t type;                               /**< chip type of the samples */
+    uint32_t period_us;                               /**< sampling period in [1000, 10000000] */
+    uint16_t length;                                  /**< segment length, a power of 2 in [16, MS5837_WAVE_LENGTH_MAX] */
+    uint16_t segments;                                /**< averaged segments of one summary, they overlap by half */
+    int32_t surface;                                  /**< pressure at the surface from ms5837_compensate */
+    float density;                                    /**< water density in kg/m3 in [500, 2000] */
+    float height_m;                                   /**< sensor height above the seabed */
+    uint8_t band_num;                                 /**< band number in [1, MS5837_WAVE_BAND_MAX] */
+    float band_hz[MS5837_WAVE_BAND_MAX + 1];          /**< increasing band edges up to the nyquist frequency */
+} ms5837_wave_config_t;
+
+/**
+ * @brief ms5837 wave summary structure definition
+ * @note  the values describe the surface elevation between the first and the last band edge
+ */
+typedef struct ms5837_wave_summary_s
+{
+    uint64_t time_us;                                 /**< time of the last sample */
+    uint32_t count;                                   /**< summary count */
+    uint16_t segments;                                /**< averaged segments */
+    uint16_t gaps;                                    /**< restarted segments after a sampling gap */
+    float depth_m;                                    /**< mean sensor depth */
+    float hs_m;                                       /**< significant wave height */
+    float tp_s;                                       /**< peak period */
+    float tz_s;                                       /**< mean zero crossing period */
+    float band_m2[MS5837_WAVE_BAND_MAX];              /**< elevation variance of each band */
+} ms5837_wave_summary_t;
+
+/**
+ * @brief ms5837 wave structure definition
+ */
+typedef struct ms5837_wave_s
+{
+    ms5837_wave_config_t config;                      /**< config */
+    float depth[MS5837_WAVE_LENGTH_MAX];              /**< ring of the last depths */
+    float re[MS5837_WAVE_LENGTH_MAX];                 /**< fft real part */
+    float im[MS5837_WAVE_LENGTH_MAX];                 /**< fft imaginary part */
+    float window[MS5837_WAVE_LENGTH_MAX];             /**< hann window */
+    float twiddle_cos[MS5837_WAVE_LENGTH_MAX / 2];    /**< fft twiddle cosine */
+    float twiddle_sin[MS5837_WAVE_LENGTH_MAX / 2];    /**< fft twiddle sine */
+    float psd[MS5837_WAVE_LENGTH_MAX / 2 + 1];        /**< summed periodograms */
+    float power;                                      /**< window power */
+    double depth_sum;                                 /**< summed segment mean depths */
+    uint64_t time_us;                                 /**< time of the last sample */
+    uint32_t pa;                                      /**< Pa of one pressure count */
+    uint16_t pos;                                     /**< next ring position */
+    uint16_t fill;                                    /**< valid ring samples */
+    uint16_t step;                                    /**< samples since the last segment */
+    uint16_t segments;                                /**< summed segments */
+    uint16_t gaps;                                    /**< restarted segments */
+    uint8_t started;                                  /**< sample flag */
+    ms5837_wave_summary_t summary;                    /**< last summary */
+    volatile uint32_t seq;                            /**< odd while the summary is written */
+    uint8_t inited;                                   /**< inited flag */
+} ms5837_wave_t;
+
+/**
+ * @brief     initialize a wave analyser
+ * @param[in] *wave pointer to a wave structure
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 wave or config is NULL
+ *            - 4 config is invalid
+ * @note      none
+ */
+uint8_t ms5837_wave_init(ms5837_wave_t *wave, const ms5837_wave_config_t *config);
+
+/**
+ * @brief     add a sample
+ * @param[in] *wave pointer to a wave structure
+ * @param[in] time_us sample time
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 2 wave is NULL
+ *            - 3 wave is not initialized
+ *            - 4 time is not after the last sample
+ * @note      every half segment runs a windowed fft of the last segment and sums its periodogram,
+ *            the configured number of segments makes a summary,
+ *            a gap over 1.5 periods restarts the segment, only one thread can add
+ */
+uint8_t ms5837_wave_add(ms5837_wave_t *wave, uint64_t time_us, int32_t pressure);
+
+/**
+ * @brief      get the last summary
+ * @param[in]  *wave pointer to a wave structure
+ * @param[out] *summary pointer to a summary buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no summary yet
+ *             - 2 wave is NULL
+ *             - 3 wave is not initialized
+ * @note       a new summary has a new count
+ */
+uint8_t ms5837_wave_get_summary(ms5837_wave_t *wave, ms5837_wave_summary_t *summary);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
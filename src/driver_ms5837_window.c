@@ -0,0 +1,350 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_window.c
+ * @brief     driver ms5837 window source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ms5837_window.h"
+
+/**
+ * @brief     get a value of a slot
+ * @param[in] *slot pointer to a slot
+ * @param[in] queue queue index, 0 and 1 are temperature, 2 and 3 are pressure
+ * @return    value
+ * @note      none
+ */
+static inline int32_t a_window_value(const ms5837_window_slot_t *slot, uint8_t queue)
+{
+    return (queue < 2) ? slot->temperature : slot->pressure;
+}
+
+/**
+ * @brief     add a value to an accumulator
+ * @param[in] *acc pointer to an accumulator
+ * @param[in] value value
+ * @param[in] first first value of the window
+ * @note      none
+ */
+static inline void a_window_acc_add(ms5837_window_acc_t *acc, int32_t value, uint8_t first)
+{
+    int64_t d;
+    
+    if (first != 0)
+    {
+        acc->ref = value;
+        acc->min = value;
+        acc->max = value;
+        acc->first = value;
+        acc->sum = 0;
+        acc->sum_sq = 0;
+    }
+    d = (int64_t)value - acc->ref;
+    acc->sum += d;
+    acc->sum_sq += d * d;
+    acc->min = (value < acc->min) ? value : acc->min;
+    acc->max = (value > acc->max) ? value : acc->max;
+    acc->last = value;
+}
+
+/**
+ * @brief      summarize an accumulator
+ * @param[in]  *acc pointer to an accumulator
+ * @param[in]  count sample count
+ * @param[in]  seconds window span
+ * @param[out] *value pointer to a value buffer
+ * @note       the sums are shifted by the first value, so the variance does not cancel out
+ */
+static void a_window_summarize(const ms5837_window_acc_t *acc, uint32_t count, double seconds, ms5837_window_value_t *value)
+{
+    double mean;
+    
+    mean = (double)acc->sum / (double)count;
+    value->min = acc->min;
+    value->max = acc->max;
+    value->mean = (float)((double)acc->ref + mean);
+    value->variance = (count > 1) ? (float)(((double)acc->sum_sq - mean * (double)acc->sum) / (double)(count - 1)) : 0.0f;
+    value->rate = (seconds > 0.0) ? (float)((double)(acc->last - acc->first) / seconds) : 0.0f;
+}
+
+/**
+ * @brief     push a slot into a monotonic queue
+ * @param[in] *window pointer to a window structure
+ * @param[in] queue queue index, even queues keep the min and odd queues keep the max
+ * @param[in] pos slot position
+ * @note      the queue front is the min or max of the window
+ */
+static inline void a_window_queue_push(ms5837_window_t *window, uint8_t queue, uint32_t pos)
+{
+    int32_t value = a_window_value(&window->slot[pos], queue);
+    uint32_t back;
+    
+    while (window->len[queue] > 0)
+    {
+        back = window->head[queue] + window->len[queue] - 1;
+        back = (back >= window->size) ? (back - window->size) : back;
+        if ((((queue & 1) == 0) && (a_window_value(&window->slot[window->slot[back].queue[queue]], queue) < value)) ||
+            (((queue & 1) != 0) && (a_window_value(&window->slot[window->slot[back].queue[queue]], queue) > value)))
+        {
+            break;
+        }
+        window->len[queue]--;
+    }
+    back = window->head[queue] + window->len[queue];
+    back = (back >= window->size) ? (back - window->size) : back;
+    window->slot[back].queue[queue] = pos;
+    window->len[queue]++;
+}
+
+/**
+ * @brief     initialize a window
+ * @param[in] *window pointer to a window structure
+ * @param[in] mode window mode
+ * @param[in] size window size in samples
+ * @param[in] *slot pointer to size slots, it is only used by the sliding mode and can be NULL for the tumbling mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 window is NULL
+ *            - 4 size is invalid
+ *            - 5 slot is NULL
+ * @note      the tumbling mode keeps O(1) memory, the sliding mode keeps the window in the slots
+ */
+uint8_t ms5837_window_init(ms5837_window_t *window, ms5837_window_mode_t mode, uint32_t size, ms5837_window_slot_t *slot)
+{
+    if (window == NULL)                                                /* check window */
+    {
+        return 2;                                                      /* return error */
+    }
+    if ((size == 0) || (size > MS5837_WINDOW_SIZE_MAX))                /* check the size */
+    {
+        return 4;                                                      /* return error */
+    }
+    if ((mode == MS5837_WINDOW_MODE_SLIDING) && (slot == NULL))        /* check the slots */
+    {
+        return 5;                                                      /* return error */
+    }
+    
+    memset(window, 0, sizeof(ms5837_window_t));                        /* clear the window */
+    window->slot = slot;                                               /* set the slots */
+    window->size = size;                                               /* set the size */
+    window->mode = (uint8_t)mode;                                      /* set the mode */
+    window->inited = 1;                                                /* flag inited */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     clear a window
+ * @param[in] *window pointer to a window structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 window is NULL
+ *            - 3 window is not initialized
+ * @note      none
+ */
+uint8_t ms5837_window_reset(ms5837_window_t *window)
+{
+    if (window == NULL)                                                                                       /* check window */
+    {
+        return 2;                                                                                             /* return error */
+    }
+    if (window->inited != 1)                                                                                  /* check window initialization */
+    {
+        return 3;                                                                                             /* return error */
+    }
+    
+    return ms5837_window_init(window, (ms5837_window_mode_t)window->mode, window->size, window->slot);        /* init again */
+}
+
+/**
+ * @brief     add a sample
+ * @param[in] *window pointer to a window structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 1 a tumbling window is closed
+ *            - 2 window is NULL
+ *            - 3 window is not initialized
+ * @note      O(1) time, the sliding min and max are amortized O(1)
+ */
+uint8_t ms5837_window_add(ms5837_window_t *window, uint64_t time_us, int32_t temperature, int32_t pressure)
+{
+    ms5837_window_slot_t *slot;
+    double seconds;
+    uint8_t first;
+    uint8_t i;
+    
+    if (window == NULL)                                                                                     /* check window */
+    {
+        return 2;                                                                                           /* return error */
+    }
+    if (window->inited != 1)                                                                                /* check window initialization */
+    {
+        return 3;                                                                                           /* return error */
+    }
+    
+    window->seq++;                                                                                          /* count the sample */
+    if (window->mode == MS5837_WINDOW_MODE_TUMBLING)                                                        /* tumbling */
+    {
+        first = (window->count == 0) ? 1 : 0;                                                               /* first sample of the window */
+        window->start_us = (first != 0) ? time_us : window->start_us;                                       /* set the start */
+        window->end_us = time_us;                                                                           /* set the end */
+        a_window_acc_add(&window->acc[0], temperature, first);                                              /* add the temperature */
+        a_window_acc_add(&window->acc[1], pressure, first);                                                 /* add the pressure */
+        window->count++;                                                                                    /* count the sample */
+        if (window->count < window->size)                                                                   /* check the size */
+        {
+            return 0;                                                                                       /* success return 0 */
+        }
+        
+        /* close the window */
+        window->summary.index = window->windows;                                                            /* set the index */
+        window->summary.count = window->count;                                                              /* set the count */
+        window->summary.start_us = window->start_us;                                                        /* set the start */
+        window->summary.end_us = window->end_us;                                                            /* set the end */
+        seconds = (double)(window->end_us - window->start_us) / 1000000.0;                                  /* window span */
+        a_window_summarize(&window->acc[0], window->count, seconds, &window->summary.temperature);          /* summarize the temperature */
+        a_window_summarize(&window->acc[1], window->count, seconds, &window->summary.pressure);             /* summarize the pressure */
+        window->windows++;                                                                                  /* count the window */
+        window->count = 0;                                                                                  /* open the next window */
+        
+        return 1;                                                                                           /* return closed */
+    }
+    
+    /* drop the oldest sample, it sits in the slot to be written */
+    slot = &window->slot[window->pos];                                                                      /* get the slot */
+    if (window->count == window->size)                                                                      /* check the full window */
+    {
+        int64_t d;
+        
+        d = (int64_t)slot->temperature - window->acc[0].ref;                                                /* shifted temperature */
+        window->acc[0].sum -= d;                                                                            /* remove the temperature */
+        window->acc[0].sum_sq -= d * d;                                                                     /* remove the temperature square */
+        d = (int64_t)slot->pressure - window->acc[1].ref;                                                   /* shifted pressure */
+        window->acc[1].sum -= d;                                                                            /* remove the pressure */
+        window->acc[1].sum_sq -= d * d;                                                                     /* remove the pressure square */
+        for (i = 0; i < 4; i++)                                                                             /* all queues */
+        {
+            if ((window->len[i] > 0) && (window->slot[window->head[i]].queue[i] == window->pos))            /* check the queue front */
+            {
+                window->head[i] = (window->head[i] + 1 == window->size) ? 0 : (window->head[i] + 1);        /* pop the front */
+                window->len[i]--;                                                                           /* shorten the queue */
+            }
+        }
+        window->count--;                                                                                    /* drop the sample */
+    }
+    
+    /* add the sample, the sums keep the shift of the first sample */
+    first = (window->seq == 1) ? 1 : 0;                                                                     /* first sample since init */
+    slot->time_us = time_us;                                                                                /* set the time */
+    slot->temperature = temperature;                                                                        /* set the temperature */
+    slot->pressure = pressure;                                                                              /* set the pressure */
+    a_window_acc_add(&window->acc[0], temperature, first);                                                  /* add the temperature */
+    a_window_acc_add(&window->acc[1], pressure, first);                                                     /* add the pressure */
+    for (i = 0; i < 4; i++)                                                                                 /* all queues */
+    {
+        a_window_queue_push(window, i, window->pos);                                                        /* push the slot */
+    }
+    window->pos = (window->pos + 1 == window->size) ? 0 : (window->pos + 1);                                /* next slot */
+    window->count++;                                                                                        /* count the sample */
+    
+    return 0;                                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the summary
+ * @param[in]  *window pointer to a window structure
+ * @param[out] *summary pointer to a summary buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no summary yet
+ *             - 2 window is NULL
+ *             - 3 window is not initialized
+ * @note       the tumbling mode gives the last closed window, the sliding mode the current samples,
+ *             a changed index tells a new summary
+ */
+uint8_t ms5837_window_get(ms5837_window_t *window, ms5837_window_summary_t *summary)
+{
+    ms5837_window_acc_t acc[2];
+    const ms5837_window_slot_t *oldest;
+    const ms5837_window_slot_t *newest;
+    double seconds;
+    
+    if (window == NULL)                                                                         /* check window */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (window->inited != 1)                                                                    /* check window initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    if (window->mode == MS5837_WINDOW_MODE_TUMBLING)                                            /* tumbling */
+    {
+        if (window->windows == 0)                                                               /* check the windows */
+        {
+            return 1;                                                                           /* no summary yet */
+        }
+        *summary = window->summary;                                                             /* copy the summary */
+        
+        return 0;                                                                               /* success return 0 */
+    }
+    if (window->count == 0)                                                                     /* check the samples */
+    {
+        return 1;                                                                               /* return closed */
+    }
+    
+    /* the min and max are the queue fronts, first and last are the window ends */
+    oldest = &window->slot[(window->count == window->size) ? window->pos : 0];                  /* oldest slot */
+    newest = &window->slot[(window->pos == 0) ? (window->size - 1) : (window->pos - 1)];        /* newest slot */
+    acc[0] = window->acc[0];                                                                    /* copy the temperature sums */
+    acc[1] = window->acc[1];                                                                    /* copy the pressure sums */
+    acc[0].min = window->slot[window->slot[window->head[0]].queue[0]].temperature;              /* temperature min */
+    acc[0].max = window->slot[window->slot[window->head[1]].queue[1]].temperature;              /* temperature max */
+    acc[1].min = window->slot[window->slot[window->head[2]].queue[2]].pressure;                 /* pressure min */
+    acc[1].max = window->slot[window->slot[window->head[3]].queue[3]].pressure;                 /* pressure max */
+    acc[0].first = oldest->temperature;                                                         /* temperature first */
+    acc[1].first = oldest->pressure;                                                            /* pressure first */
+    acc[0].last = newest->temperature;                                                          /* temperature last */
+    acc[1].last = newest->pressure;                                                             /* pressure last */
+    seconds = (double)(newest->time_us - oldest->time_us) / 1000000.0;                          /* window span */
+    summary->index = window->seq;                                                               /* set the index */
+    summary->count = window->count;                                                             /* set the count */
+    summary->start_us = oldest->time_us;                                                        /* set the start */
+    summary->end_us = newest->time_us;                                                          /* set the end */
+    a_window_summarize(&acc[0], window->count, seconds, &summary->temperature);                 /* summarize the temperature */
+    a_window_summarize(&acc[1], window->count, seconds, &summary->pressure);                    /* summarize the pressure */
+    
+    return 0;                                                                                   /* success return 0 */
+}
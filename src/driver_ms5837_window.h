@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_window.h
+ * @brief     driver ms5837 window header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MS5837_WINDOW_H
+#define DRIVER_MS5837_WINDOW_H
+
+#include "driver_ms5837.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ms5837_window_driver ms5837 window driver function
+ * @brief    ms5837 window driver modules
+ * @ingroup  ms5837_driver
+ * @{
+ */
+
+/**
+ * @brief ms5837 window size definition
+ */
+#define MS5837_WINDOW_SIZE_MAX        (1UL << 24)        /**< max samples of a window, it keeps the int64 sums exact */
+
+/**
+ * @brief ms5837 window mode enumeration definition
+ */
+typedef enum
+{
+    MS5837_WINDOW_MODE_TUMBLING = 0x00,        /**< back to back windows of size samples */
+    MS5837_WINDOW_MODE_SLIDING  = 0x01,        /**< the last size samples */
+} ms5837_window_mode_t;
+
+/**
+ * @brief ms5837 window slot structure definition
+ */
+typedef struct ms5837_window_slot_s
+{
+    uint64_t time_us;            /**< sample time */
+    int32_t temperature;         /**< temperature */
+    int32_t pressure;            /**< pressure */
+    uint32_t queue[4];           /**< min and max queue slot positions */
+} ms5837_window_slot_t;
+
+/**
+ * @brief ms5837 window accumulator structure definition
+ */
+typedef struct ms5837_window_acc_s
+{
+    int32_t ref;             /**< shift of the sums */
+    int32_t min;             /**< min value */
+    int32_t max;             /**< max value */
+    int32_t first;           /**< first value */
+    int32_t last;            /**< last value */
+    int64_t sum;             /**< sum of value - ref */
+    int64_t sum_sq;          /**< sum of (value - ref)^2 */
+} ms5837_window_acc_t;
+
+/**
+ * @brief ms5837 window value structure definition
+ */
+typedef struct ms5837_window_value_s
+{
+    int32_t min;           /**< min value */
+    int32_t max;           /**< max value */
+    float mean;            /**< mean value */
+    float variance;        /**< sample variance */
+    float rate;            /**< last minus first value per second */
+} ms5837_window_value_t;
+
+/**
+ * @brief ms5837 window summary structure definition
+ * @note  the values keep the units of ms5837_compensate
+ */
+typedef struct ms5837_window_summary_s
+{
+    uint32_t index;                           /**< tumbling window index or sliding sample index */
+    uint32_t count;                           /**< sample count */
+    uint64_t start_us;                        /**< first sample time */
+    uint64_t end_us;                          /**< last sample time */
+    ms5837_window_value_t temperature;        /**< temperature summary */
+    ms5837_window_value_t pressure;           /**< pressure summary */
+} ms5837_window_summary_t;
+
+/**
+ * @brief ms5837 window structure definition
+ */
+typedef struct ms5837_window_s
+{
+    ms5837_window_slot_t *slot;               /**< sliding samples */
+    uint32_t size;                            /**< window size */
+    uint32_t seq;                             /**< added samples */
+    uint32_t pos;                             /**< next sliding slot */
+    uint32_t count;                           /**< samples in the window */
+    uint64_t start_us;                        /**< first sample time */
+    uint64_t end_us;                          /**< last sample time */
+    ms5837_window_acc_t acc[2];               /**< temperature and pressure */
+    uint32_t head[4];                         /**< min and max queue heads */
+    uint32_t len[4];                          /**< min and max queue lengths */
+    ms5837_window_summary_t summary;          /**< last closed tumbling window */
+    uint32_t windows;                         /**< closed tumbling windows */
+    uint8_t mode;                             /**< window mode */
+    uint8_t inited;                           /**< inited flag */
+} ms5837_window_t;
+
+/**
+ * @brief     initialize a window
+ * @param[in] *window pointer to a window structure
+ * @param[in] mode window mode
+ * @param[in] size window size in samples
+ * @param[in] *slot pointer to size slots, it is only used by the sliding mode and can be NULL for the tumbling mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 window is NULL
+ *            - 4 size is invalid
+ *            - 5 slot is NULL
+ * @note      the tumbling mode keeps O(1) memory, the sliding mode keeps the window in the slots
+ */
+uint8_t ms5837_window_init(ms5837_window_t *window, ms5837_window_mode_t mode, uint32_t size, ms5837_window_slot_t *slot);
+
+/**
+ * @brief     clear a window
+ * @param[in] *window pointer to a window structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 window is NULL
+ *            - 3 window is not initialized
+ * @note      none
+ */
+uint8_t ms5837_window_reset(ms5837_window_t *window);
+
+/**
+ * @brief     add a sample
+ * @param[in] *window pointer to a window structure
+ * @param[in] time_us sample time
+ * @param[in] temperature temperature from ms5837_compensate
+ * @param[in] pressure pressure from ms5837_compensate
+ * @return    status code
+ *            - 0 success
+ *            - 1 a tumbling window is closed
+ *            - 2 window is NULL
+ *            - 3 window is not initialized
+ * @note      O(1) time, the sliding min and max are amortized O(1)
+ */
+uint8_t ms5837_window_add(ms5837_window_t *window, uint64_t time_us, int32_t temperature, int32_t pressure);
+
+/**
+ * @brief      get the summary
+ * @param[in]  *window pointer to a window structure
+ * @param[out] *summary pointer to a summary buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no summary yet
+ *             - 2 window is NULL
+ *             - 3 window is not initialized
+ * @note       the tumbling mode gives the last closed window, the sliding mode the current samples,
+ *             a changed index tells a new summary
+ */
+uint8_t ms5837_window_get(ms5837_window_t *window, ms5837_window_summary_t *summary);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
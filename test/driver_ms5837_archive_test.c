@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_archive_test.c
+ * @brief     driver ms5837 archive test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#include "driver_ms5837_archive_test.h"
+
+#define ARCHIVE_TEST_SAMPLES        (2 * MS5837_ARCHIVE_BLOCK + 100)        /**< samples of one round, the last block is partial */
+#define ARCHIVE_TEST_BLOCKS         3                                       /**< blocks of one round */
+
+static ms5837_sim_t gs_sim;                                                           /**< simulator */
+static ms5837_handle_t gs_handle;                                                     /**< ms5837 handle */
+static ms5837_archive_t gs_archive;                                                   /**< archive writer */
+static ms5837_archive_block_t gs_block;                                               /**< decoded block */
+static uint8_t gs_buf[ARCHIVE_TEST_BLOCKS * MS5837_ARCHIVE_BLOCK_SIZE_MAX];           /**< encoded stream */
+static uint64_t gs_time_us[ARCHIVE_TEST_SAMPLES];                                     /**< reference timestamps */
+static int32_t gs_temperature[ARCHIVE_TEST_SAMPLES];                                  /**< reference temperatures */
+static int32_t gs_pressure[ARCHIVE_TEST_SAMPLES];                                     /**< reference pressures */
+static uint32_t gs_temperature_raw[ARCHIVE_TEST_SAMPLES];                             /**< reference raw temperatures */
+static uint32_t gs_pressure_raw[ARCHIVE_TEST_SAMPLES];                                /**< reference raw pressures */
+static uint32_t gs_seed;                                                              /**< random seed */
+static uint8_t gs_extreme;                                                            /**< extreme signal flag */
+
+/**
+ * @brief  get a pseudo random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_archive_test_random(void)
+{
+    gs_seed = gs_seed * 1664525U + 1013904223U;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief      raw signal model
+ * @param[in]  index chip slot index
+ * @param[in]  time_us conversion end time
+ * @param[out] *d1 pointer to a raw pressure buffer
+ * @param[out] *d2 pointer to a raw temperature buffer
+ * @note       a slow random walk or full range random values
+ */
+static void a_archive_test_signal(uint8_t index, uint64_t time_us, uint32_t *d1, uint32_t *d2)
+{
+    (void)index;
+    (void)time_us;
+    
+    if (gs_extreme != 0)
+    {
+        *d1 = (a_archive_test_random() & 0xFFFFFFU) | 1;
+        *d2 = (a_archive_test_random() & 0xFFFFFFU) | 1;
+    }
+    else
+    {
+        *d1 = *d1 + (a_archive_test_random() % 201) - 100;
+        *d2 = *d2 + (a_archive_test_random() % 21) - 10;
+    }
+}
+
+/**
+ * @brief     archive test
+ * @param[in] type device type
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it encodes simulated samples, decodes the blocks back and checks every sample
+ */
+uint8_t ms5837_archive_test(ms5837_type_t type, uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t pos;
+    uint32_t off;
+    uint32_t len;
+    uint32_t used;
+    
+    /* link the simulated chip */
+    (void)ms5837_sim_init(&gs_sim);
+    (void)ms5837_sim_set_prom(&gs_sim, 0, type, NULL);
+    (void)ms5837_sim_set_environment(&gs_sim, 0, 15.0f, 1500.0f);
+    (void)ms5837_sim_set_signal(&gs_sim, 0, a_archive_test_signal);
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    (void)ms5837_sim_link(&gs_handle, 0);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    
+    /* ms5837 init */
+    res = ms5837_init(&gs_handle);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    (void)ms5837_set_type(&gs_handle, type);
+    (void)ms5837_set_temperature_osr(&gs_handle, MS5837_OSR_256);
+    (void)ms5837_set_pressure_osr(&gs_handle, MS5837_OSR_256);
+    
+    /* start archive test */
+    ms5837_interface_debug_print("ms5837: start archive test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        /* odd rounds use full range samples and time gaps */
+        gs_seed = i + 1;
+        gs_extreme = (uint8_t)(i % 2);
+        (void)ms5837_archive_init(&gs_archive, type);
+        
+        /* sample and append, a full block is encoded first */
+        pos = 0;
+        for (j = 0; j < ARCHIVE_TEST_SAMPLES; j++)
+        {
+            float temperature_c;
+            float pressure_mbar;
+            
+            if (gs_extreme != 0)
+            {
+                (void)ms5837_sim_advance(&gs_sim, a_archive_test_random() & 0x3FFFFFFFU);
+            }
+            else
+            {
+                (void)ms5837_sim_advance(&gs_sim, 20000 + a_archive_test_random() % 41);
+            }
+            res = ms5837_read_temperature_pressure(&gs_handle, &gs_temperature_raw[j], &temperature_c,
+                                                   &gs_pressure_raw[j], &pressure_mbar);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: read temperature pressure failed.\n");
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            gs_time_us[j] = gs_sim.now_us;
+            (void)ms5837_compensate(&gs_handle, gs_temperature_raw[j], &gs_temperature[j],
+                                    gs_pressure_raw[j], &gs_pressure[j]);
+            if (ms5837_archive_append(&gs_archive, gs_time_us[j], gs_temperature[j], gs_pressure[j]) == 1)
+            {
+                (void)ms5837_archive_encode(&gs_archive, gs_buf + pos, MS5837_ARCHIVE_BLOCK_SIZE_MAX, &len);
+                pos += len;
+                (void)ms5837_archive_append(&gs_archive, gs_time_us[j], gs_temperature[j], gs_pressure[j]);
+            }
+        }
+        (void)ms5837_archive_encode(&gs_archive, gs_buf + pos, MS5837_ARCHIVE_BLOCK_SIZE_MAX, &len);
+        pos += len;
+        
+        /* decode the stream block by block and check every sample */
+        k = 0;
+        off = 0;
+        while (off < pos)
+        {
+            if (ms5837_archive_decode(gs_buf + off, pos - off, &gs_block, &used) != 0)
+            {
+                ms5837_interface_debug_print("ms5837: decode block at %d failed.\n", off);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            for (j = 0; j < gs_block.count; j++, k++)
+            {
+                float temperature_c[2];
+                float pressure_mbar[2];
+                
+                (void)ms5837_archive_convert(&gs_block, (uint16_t)j, &temperature_c[0], &pressure_mbar[0]);
+                (void)ms5837_calculate_temperature_pressure(&gs_handle, gs_temperature_raw[k], &temperature_c[1],
+                                                            gs_pressure_raw[k], &pressure_mbar[1]);
+                if ((k >= ARCHIVE_TEST_SAMPLES) || (gs_block.time_us[j] != gs_time_us[k]) ||
+                    (gs_block.temperature[j] != gs_temperature[k]) || (gs_block.pressure[j] != gs_pressure[k]) ||
+                    (temperature_c[0] != temperature_c[1]) || (pressure_mbar[0] != pressure_mbar[1]))
+                {
+                    ms5837_interface_debug_print("ms5837: sample %d is different.\n", k);
+                    (void)ms5837_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+            off += used;
+        }
+        if (k != ARCHIVE_TEST_SAMPLES)
+        {
+            ms5837_interface_debug_print("ms5837: decoded %d samples of %d.\n", k, ARCHIVE_TEST_SAMPLES);
+            (void)ms5837_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ms5837_interface_debug_print("ms5837: round %d %s %d samples %d bytes %0.2f bytes per sample ok.\n",
+                                     i + 1, (gs_extreme != 0) ? "extreme" : "smooth", k, pos, (float)pos / (float)k);
+    }
+    
+    /* a cut block must be rejected */
+    if (ms5837_archive_decode(gs_buf, MS5837_ARCHIVE_HEADER_SIZE - 1, &gs_block, &used) == 0)
+    {
+        ms5837_interface_debug_print("ms5837: cut block is decoded.\n");
+        (void)ms5837_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish archive test */
+    ms5837_interface_debug_print("ms5837: finish archive test.\n");
+    (void)ms5837_deinit(&gs_handle);
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}
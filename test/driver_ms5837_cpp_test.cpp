@@ -0,0 +1,354 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_cpp_test.cpp
+ * @brief     driver ms5837 c++ test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#include "driver_ms5837_coro.hpp"
+#include "driver_ms5837_sim.h"
+#include <cstdarg>
+#include <cstdio>
+
+#define CPP_TEST_TIMES        200        /**< reads of each type and path */
+
+static ms5837_sim_t gs_sim;                         /**< simulator */
+static ms5837_handle_t gs_handle;                   /**< ms5837 handle */
+static ms5837_correction_t gs_correction;           /**< user correction */
+static uint32_t gs_seed;                            /**< random seed */
+
+/**
+ * @brief     print the debug message
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_cpp_test_debug_print(const char *const fmt, ...)
+{
+    va_list args;
+    
+    va_start(args, fmt);
+    (void)vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief  get a pseudo random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_cpp_test_random(void)
+{
+    gs_seed ^= gs_seed << 13;
+    gs_seed ^= gs_seed >> 17;
+    gs_seed ^= gs_seed << 5;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief     read one sample with the coroutine wrapper
+ * @param[in] &async asynchronous sensor
+ * @param[in] &result read result buffer
+ * @param[in] &done finished flag
+ * @note      none
+ */
+template <class Async>
+static ms5837::detached a_cpp_test_read(Async &async, ms5837::read_result &result, bool &done)
+{
+    result = co_await async.read();
+    done = true;
+}
+
+/**
+ * @brief     check a c++ sample against the c compensation
+ * @param[in] *name path name
+ * @param[in] &s sample
+ * @return    status code
+ *            - 0 success
+ *            - 1 results differ
+ * @note      none
+ */
+static uint8_t a_cpp_test_check(const char *name, const ms5837::sample &s)
+{
+    int32_t temperature;
+    int32_t pressure;
+    int32_t p_per_mbar;
+    
+    p_per_mbar = (gs_handle.type == MS5837_TYPE_30BA26) ? 10 : 100;
+    if (gs_sim.chip[0].early_reads != 0)
+    {
+        (void)printf("ms5837: %s read the adc before the conversion end.\n", name);
+        
+        return 1;
+    }
+    if (ms5837_compensate(&gs_handle, s.temperature_raw, &temperature, s.pressure_raw, &pressure) != 0)
+    {
+        (void)printf("ms5837: compensate failed.\n");
+        
+        return 1;
+    }
+    if ((s.temperature != temperature) || (s.pressure != pressure) ||
+        (s.temperature_c != static_cast<float>(temperature) / 100.0f) ||
+        (s.pressure_mbar != static_cast<float>(pressure) / static_cast<float>(p_per_mbar)))
+    {
+        (void)printf("ms5837: %s got %d %d, c got %d %d from raw %u %u.\n", name,
+                     static_cast<int>(s.temperature), static_cast<int>(s.pressure),
+                     static_cast<int>(temperature), static_cast<int>(pressure),
+                     static_cast<unsigned int>(s.temperature_raw), static_cast<unsigned int>(s.pressure_raw));
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check that a sensor keeps its compile time configuration
+ * @param[in] &sensor initialized sensor
+ * @param[in] &async asynchronous sensor of the sensor
+ * @param[in] &loop virtual loop of the asynchronous sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+template <class Sensor, class Async>
+static uint8_t a_cpp_test_bound(Sensor &sensor, Async &async, ms5837::virtual_loop &loop)
+{
+    ms5837::sample s{};
+    ms5837::sample other{};
+    ms5837::read_result result{};
+    ms5837_config_t config;
+    uint32_t ticket;
+    uint64_t writes;
+    uint8_t type;
+    bool done = false;
+    
+    /* the compensation follows the template type and not the handle */
+    if (sensor.read(s) != 0)
+    {
+        (void)printf("ms5837: read failed.\n");
+        
+        return 1;
+    }
+    other = s;
+    type = gs_handle.type;
+    gs_handle.type = (type == MS5837_TYPE_30BA26) ? MS5837_TYPE_02BA01 : MS5837_TYPE_30BA26;
+    sensor.compensate(other);
+    gs_handle.type = type;
+    if ((other.temperature != s.temperature) || (other.pressure != s.pressure))
+    {
+        (void)printf("ms5837: compensate follows the handle type.\n");
+        
+        return 1;
+    }
+    
+    /* a staged configuration is refused before any transfer */
+    config.type = Sensor::type;
+    config.temperature_osr = MS5837_OSR_256;
+    config.pressure_osr = MS5837_OSR_256;
+    if (ms5837_stage_config(&gs_handle, &config, &ticket) != 0)
+    {
+        (void)printf("ms5837: stage config failed.\n");
+        
+        return 1;
+    }
+    writes = gs_sim.chip[0].writes;
+    a_cpp_test_read(async, result, done);
+    loop.run();
+    if ((sensor.read(s) != 5) || (!done) || (result.status != 5) || (gs_sim.chip[0].writes != writes))
+    {
+        (void)printf("ms5837: staged config is not refused.\n");
+        
+        return 1;
+    }
+    
+    /* the init drops the staged configuration */
+    if ((sensor.deinit() != 0) || (sensor.init() != 0) || (sensor.read(s) != 0))
+    {
+        (void)printf("ms5837: read after the init failed.\n");
+        
+        return 1;
+    }
+    
+    /* a changed osr is refused */
+    (void)ms5837_set_pressure_osr(&gs_handle, MS5837_OSR_256);
+    if (sensor.read(s) != 5)
+    {
+        (void)printf("ms5837: changed osr is not refused.\n");
+        
+        return 1;
+    }
+    (void)ms5837_set_pressure_osr(&gs_handle, Sensor::pressure_osr);
+    if (sensor.read(s) != 0)
+    {
+        (void)printf("ms5837: read failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the c++ test of one type
+ * @param[in] *name type name
+ * @param[in] max_mbar max simulated pressure
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      every second read runs with the user correction
+ */
+template <ms5837_type_t Type>
+static uint8_t a_cpp_test_run(const char *name, float max_mbar)
+{
+    using sensor_t = ms5837::sensor<Type>;
+    
+    sensor_t sensor(gs_handle);
+    ms5837::virtual_loop loop(gs_sim.now_us);
+    ms5837::async_sensor<sensor_t, ms5837::virtual_loop> async(sensor, loop);
+    uint32_t i;
+    uint32_t ticket;
+    
+    (void)printf("ms5837: check %s.\n", name);
+    (void)ms5837_sim_init(&gs_sim);
+    (void)ms5837_sim_set_prom(&gs_sim, 0, Type, NULL);
+    (void)ms5837_sim_set_environment(&gs_sim, 0, 25.0f, 1013.25f);
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    (void)ms5837_sim_link(&gs_handle, 0);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, a_cpp_test_debug_print);
+    if (sensor.init() != 0)
+    {
+        (void)printf("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    if (ms5837_stage_config(&gs_handle, NULL, &ticket) != 2)
+    {
+        (void)printf("ms5837: stage config accepted NULL.\n");
+        (void)sensor.deinit();
+        
+        return 1;
+    }
+    for (i = 0; i < CPP_TEST_TIMES; i++)
+    {
+        ms5837::sample s{};
+        ms5837::read_result result{};
+        bool done = false;
+        
+        gs_seed = i + 1;
+        (void)ms5837_sim_set_environment(&gs_sim, 0,
+                                         -30.0f + static_cast<float>(a_cpp_test_random() % 10000) / 100.0f,
+                                         10.0f + static_cast<float>(a_cpp_test_random() % 10000) * max_mbar / 10000.0f);
+        if (ms5837_set_correction(&gs_handle, ((i % 2) != 0) ? &gs_correction : NULL) != 0)
+        {
+            (void)printf("ms5837: set correction failed.\n");
+            (void)sensor.deinit();
+            
+            return 1;
+        }
+        if (sensor.read(s) != 0)
+        {
+            (void)printf("ms5837: read failed.\n");
+            (void)sensor.deinit();
+            
+            return 1;
+        }
+        if (a_cpp_test_check("sensor", s) != 0)
+        {
+            (void)sensor.deinit();
+            
+            return 1;
+        }
+        a_cpp_test_read(async, result, done);
+        loop.run();
+        if ((!done) || (result.status != 0))
+        {
+            (void)printf("ms5837: coroutine read failed.\n");
+            (void)sensor.deinit();
+            
+            return 1;
+        }
+        if (a_cpp_test_check("coroutine", result.value) != 0)
+        {
+            (void)sensor.deinit();
+            
+            return 1;
+        }
+    }
+    if (a_cpp_test_bound(sensor, async, loop) != 0)
+    {
+        (void)sensor.deinit();
+        
+        return 1;
+    }
+    (void)sensor.deinit();
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it checks that the c++ and coroutine wrappers match the c compensation with and without a user correction,
+ *         and that they keep their compile time type and osr
+ */
+int main(void)
+{
+    gs_correction.temperature_offset = -35;
+    gs_correction.pressure_offset = 120;
+    gs_correction.pressure_gain = 66191;
+    gs_correction.table_start = -1000;
+    gs_correction.table_step = 1500;
+    gs_correction.table_num = 5;
+    gs_correction.table[0] = 40;
+    gs_correction.table[1] = -25;
+    gs_correction.table[2] = 10;
+    gs_correction.table[3] = 0;
+    gs_correction.table[4] = -60;
+    
+    (void)printf("ms5837: start c++ test.\n");
+    if ((a_cpp_test_run<MS5837_TYPE_02BA01>("02ba01", 1990.0f) != 0) ||
+        (a_cpp_test_run<MS5837_TYPE_02BA21>("02ba21", 1990.0f) != 0) ||
+        (a_cpp_test_run<MS5837_TYPE_30BA26>("30ba26", 29990.0f) != 0))
+    {
+        (void)printf("ms5837: c++ test failed.\n");
+        
+        return 1;
+    }
+    (void)printf("ms5837: finish c++ test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,368 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_kalman_test.c
+ * @brief     driver ms5837 kalman test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#include "driver_ms5837_kalman_test.h"
+#include <math.h>
+
+#define KALMAN_TEST_SAMPLES        3000         /**< samples of one round */
+#define KALMAN_TEST_GAP            1500         /**< sample after a gap */
+#define KALMAN_TEST_PERIOD_US      20000        /**< nominal period */
+#define KALMAN_TEST_NOISE_UM       3000         /**< depth noise */
+#define KALMAN_TEST_ACCEL_UM_S2    500000       /**< acceleration change */
+#define KALMAN_TEST_DENSITY        1025         /**< sea water */
+
+/**
+ * @brief kalman test reference structure definition
+ */
+typedef struct kalman_test_reference_s
+{
+    double x[3];              /**< depth, velocity and acceleration in um and periods */
+    double p[3][3];           /**< covariance */
+    double q;                 /**< variance of the acceleration change in one period */
+    double r;                 /**< measurement variance */
+    uint64_t time_us;         /**< time of the last update */
+    uint32_t count;           /**< update count */
+} kalman_test_reference_t;
+
+static ms5837_sim_t gs_sim;                         /**< simulator */
+static ms5837_handle_t gs_handle;                   /**< ms5837 handle */
+static ms5837_kalman_t gs_kalman;                   /**< fixed point filter */
+static kalman_test_reference_t gs_reference;        /**< double precision filter */
+static uint32_t gs_seed;                            /**< random seed */
+
+/**
+ * @brief  get a pseudo random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_kalman_test_random(void)
+{
+    gs_seed ^= gs_seed << 13;
+    gs_seed ^= gs_seed >> 17;
+    gs_seed ^= gs_seed << 5;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief     update the double precision filter
+ * @param[in] time_us sample time
+ * @param[in] z measured depth in um
+ * @note      the same constant acceleration model as the driver without the fixed point
+ */
+static void a_kalman_test_reference_update(uint64_t time_us, double z)
+{
+    kalman_test_reference_t *ref = &gs_reference;
+    double f[3][3];
+    double fp[3][3];
+    double g[3];
+    double k[3];
+    double p0[3];
+    double t;
+    double s;
+    double y;
+    double sum;
+    uint8_t i;
+    uint8_t j;
+    uint8_t l;
+    
+    if ((ref->count == 0) || ((time_us - ref->time_us) > 4ULL * KALMAN_TEST_PERIOD_US))
+    {
+        memset(ref->p, 0, sizeof(ref->p));
+        ref->x[0] = z;
+        ref->x[1] = 0.0;
+        ref->x[2] = 0.0;
+        ref->p[0][0] = ref->r;
+        ref->p[1][1] = ref->r;
+        ref->p[2][2] = ref->r;
+    }
+    else
+    {
+        /* predict */
+        t = (double)(time_us - ref->time_us) / (double)KALMAN_TEST_PERIOD_US;
+        ref->x[0] += ref->x[1] * t + ref->x[2] * t * t / 2.0;
+        ref->x[1] += ref->x[2] * t;
+        memset(f, 0, sizeof(f));
+        f[0][0] = 1.0;
+        f[0][1] = t;
+        f[0][2] = t * t / 2.0;
+        f[1][1] = 1.0;
+        f[1][2] = t;
+        f[2][2] = 1.0;
+        g[0] = t * t / 2.0;
+        g[1] = t;
+        g[2] = 1.0;
+        for (i = 0; i < 3; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                for (l = 0, sum = 0.0; l < 3; l++)
+                {
+                    sum += f[i][l] * ref->p[l][j];
+                }
+                fp[i][j] = sum;
+            }
+        }
+        for (i = 0; i < 3; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                for (l = 0, sum = 0.0; l < 3; l++)
+                {
+                    sum += fp[i][l] * f[j][l];
+                }
+                ref->p[i][j] = sum + ref->q * g[i] * g[j];
+            }
+        }
+        
+        /* correct */
+        s = ref->p[0][0] + ref->r;
+        y = z - ref->x[0];
+        for (i = 0; i < 3; i++)
+        {
+            p0[i] = ref->p[0][i];
+            k[i] = ref->p[i][0] / s;
+            ref->x[i] += k[i] * y;
+        }
+        for (i = 0; i < 3; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                ref->p[i][j] -= k[i] * p0[j];
+            }
+        }
+    }
+    ref->time_us = time_us;
+    ref->count++;
+}
+
+/**
+ * @brief     check the fixed point state against the double precision filter
+ * @param[in] *state pointer to a fixed point state
+ * @param[in] t extrapolated periods
+ * @return    1 if it matches, 0 if not
+ * @note      the tolerances cover the truncation of the fixed point steps
+ */
+static uint8_t a_kalman_test_check(const ms5837_kalman_state_t *state, double t)
+{
+    const kalman_test_reference_t *ref = &gs_reference;
+    double depth;
+    double velocity;
+    double acceleration;
+    double std;
+    
+    depth = ref->x[0] + ref->x[1] * t + ref->x[2] * t * t / 2.0;
+    velocity = (ref->x[1] + ref->x[2] * t) * 1000000.0 / KALMAN_TEST_PERIOD_US;
+    acceleration = ref->x[2] * 1000000.0 / KALMAN_TEST_PERIOD_US * 1000000.0 / KALMAN_TEST_PERIOD_US;
+    std = sqrt(ref->p[0][0]);
+    if ((fabs((double)state->depth_um - depth) > 1e-5 * fabs(depth) + 10.0) ||
+        (fabs((double)state->velocity_um_s - velocity) > 1e-3 * fabs(velocity) + 500.0) ||
+        (fabs((double)state->acceleration_um_s2 - acceleration) > 1e-2 * fabs(acceleration) + 20000.0) ||
+        (fabs((double)state->depth_std_um - std) > 1e-3 * std + 2.0))
+    {
+        ms5837_interface_debug_print("ms5837: depth %d %0.1f velocity %d %0.1f acceleration %d %0.1f std %d %0.1f.\n",
+                                     state->depth_um, depth, state->velocity_um_s, velocity,
+                                     state->acceleration_um_s2, acceleration, state->depth_std_um, std);
+        
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     kalman test
+ * @param[in] type device type
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it checks the fixed point filter on a simulated dive against a double precision filter
+ */
+uint8_t ms5837_kalman_test(ms5837_type_t type, uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    int32_t pa;
+    int32_t surface;
+    int64_t rho_g;
+    double error;
+    ms5837_kalman_state_t state;
+    
+    /* link the simulated chip */
+    (void)ms5837_sim_init(&gs_sim);
+    (void)ms5837_sim_set_prom(&gs_sim, 0, type, NULL);
+    (void)ms5837_sim_set_environment(&gs_sim, 0, 15.0f, 1013.25f);
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    (void)ms5837_sim_link(&gs_handle, 0);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    
+    /* ms5837 init */
+    res = ms5837_init(&gs_handle);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    (void)ms5837_set_type(&gs_handle, type);
+    pa = (type == MS5837_TYPE_30BA26) ? 10 : 1;
+    surface = 101325 / pa;
+    rho_g = (int64_t)KALMAN_TEST_DENSITY * 980665 / 100;
+    
+    /* start kalman test */
+    ms5837_interface_debug_print("ms5837: start kalman test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        double amplitude;
+        double cycle;
+        double phase;
+        double truth;
+        
+        gs_seed = i + 1;
+        amplitude = 0.5 + (double)(a_kalman_test_random() % 3000) / 1000.0;
+        cycle = 5.0 + (double)(a_kalman_test_random() % 20000) / 1000.0;
+        phase = (double)(a_kalman_test_random() % 6283) / 1000.0;
+        res = ms5837_kalman_init(&gs_kalman, type, KALMAN_TEST_PERIOD_US, surface, KALMAN_TEST_DENSITY,
+                                 KALMAN_TEST_NOISE_UM, KALMAN_TEST_ACCEL_UM_S2);
+        if ((res != 0) || (ms5837_kalman_get(&gs_kalman, gs_sim.now_us, &state) != 1))
+        {
+            ms5837_interface_debug_print("ms5837: kalman init failed.\n");
+            (void)ms5837_deinit(&gs_handle);
+            
+            return 1;
+        }
+        memset(&gs_reference, 0, sizeof(gs_reference));
+        gs_reference.r = (double)KALMAN_TEST_NOISE_UM * KALMAN_TEST_NOISE_UM;
+        gs_reference.q = pow((double)KALMAN_TEST_ACCEL_UM_S2 * KALMAN_TEST_PERIOD_US / 1000000.0 *
+                             KALMAN_TEST_PERIOD_US / 1000000.0, 2.0);
+        error = 0.0;
+        for (j = 0; j < KALMAN_TEST_SAMPLES; j++)
+        {
+            uint32_t temperature_raw;
+            uint32_t pressure_raw;
+            float temperature_c;
+            float pressure_mbar;
+            int32_t temperature;
+            int32_t pressure;
+            uint64_t time_us;
+            uint64_t step_us;
+            double seconds;
+            double z;
+            
+            /* dive on a sine with a jittered period and one gap that restarts the filter */
+            step_us = (j == KALMAN_TEST_GAP) ? (5ULL * KALMAN_TEST_PERIOD_US) :
+                      (KALMAN_TEST_PERIOD_US - 2000ULL + a_kalman_test_random() % 4001U);
+            seconds = (double)(gs_sim.now_us + step_us) / 1000000.0;
+            truth = 4.0 + amplitude * sin(2.0 * 3.14159265358979 * seconds / cycle + phase);
+            (void)ms5837_sim_set_environment(&gs_sim, 0, 15.0f,
+                                             (float)(1013.25 + truth * (double)rho_g / 100000.0));
+            (void)ms5837_sim_advance(&gs_sim, step_us);
+            res = ms5837_read_temperature_pressure(&gs_handle, &temperature_raw, &temperature_c,
+                                                   &pressure_raw, &pressure_mbar);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: read temperature pressure failed.\n");
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            (void)ms5837_compensate(&gs_handle, temperature_raw, &temperature, pressure_raw, &pressure);
+            time_us = gs_sim.now_us;
+            
+            /* update both filters with the same depth */
+            z = ((double)pressure * pa - (double)surface * pa) * 1000000000.0 / (double)rho_g;
+            res = ms5837_kalman_update(&gs_kalman, time_us, pressure);
+            if ((res != 0) || (ms5837_kalman_update(&gs_kalman, time_us, pressure) != 4))
+            {
+                ms5837_interface_debug_print("ms5837: kalman update %d returned %d.\n", j, res);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            a_kalman_test_reference_update(time_us, z);
+            
+            /* the state at the update, between two updates and past the extrapolation limit */
+            if ((ms5837_kalman_get(&gs_kalman, time_us, &state) != 0) || (a_kalman_test_check(&state, 0.0) == 0) ||
+                (ms5837_kalman_get(&gs_kalman, time_us + KALMAN_TEST_PERIOD_US / 2, &state) != 0) ||
+                (a_kalman_test_check(&state, 0.5) == 0) ||
+                (ms5837_kalman_get(&gs_kalman, time_us + 10ULL * KALMAN_TEST_PERIOD_US, &state) != 0) ||
+                (a_kalman_test_check(&state, 4.0) == 0))
+            {
+                ms5837_interface_debug_print("ms5837: kalman state at sample %d is different.\n", j);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            
+            /* a restart begins at the measured depth without velocity */
+            if (((j == 0) || (j == KALMAN_TEST_GAP)) &&
+                ((ms5837_kalman_get(&gs_kalman, time_us, &state) != 0) || (state.velocity_um_s != 0) ||
+                 (fabs((double)state.depth_um - z) > 1.0)))
+            {
+                ms5837_interface_debug_print("ms5837: kalman restart at sample %d is different.\n", j);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            
+            /* track the true depth once the filter settles */
+            if ((j % KALMAN_TEST_GAP) >= 100)
+            {
+                (void)ms5837_kalman_get(&gs_kalman, time_us, &state);
+                error = fmax(error, fabs((double)state.depth_um - truth * 1000000.0));
+            }
+        }
+        if (error > 5.0 * KALMAN_TEST_NOISE_UM)
+        {
+            ms5837_interface_debug_print("ms5837: kalman depth error %0.0fum is too large.\n", error);
+            (void)ms5837_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ms5837_interface_debug_print("ms5837: round %d amplitude %0.2fm cycle %0.2fs max depth error %0.0fum ok.\n",
+                                     i + 1, amplitude, cycle, error);
+    }
+    
+    /* finish kalman test */
+    ms5837_interface_debug_print("ms5837: finish kalman test.\n");
+    (void)ms5837_deinit(&gs_handle);
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}
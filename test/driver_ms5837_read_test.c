@@ -62,6 +62,7 @@ uint8_t ms5837_read_test(ms5837_type_t type, uint32_t times)
     DRIVER_MS5837_LINK_IIC_WRITE(&gs_handle, ms5837_interface_iic_write);
     DRIVER_MS5837_LINK_DELAY_MS(&gs_handle, ms5837_interface_delay_ms);
     DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    DRIVER_MS5837_LINK_TIMESTAMP_US(&gs_handle, ms5837_interface_timestamp_us);
     
     /* get chip information */
     res = ms5837_info(&info);
@@ -0,0 +1,316 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_rollup_test.c
+ * @brief     driver ms5837 rollup test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#include "driver_ms5837_rollup_test.h"
+
+#define ROLLUP_TEST_SAMPLES        3000        /**< samples of one round */
+#define ROLLUP_TEST_QUERIES        200         /**< queries of one round */
+#define ROLLUP_TEST_BINS           4096        /**< max bins of a query */
+
+static ms5837_sim_t gs_sim;                                           /**< simulator */
+static ms5837_handle_t gs_handle;                                     /**< ms5837 handle */
+static ms5837_rollup_t gs_rollup;                                     /**< rollup */
+static ms5837_rollup_bucket_t gs_second[4096];                        /**< 1s buckets */
+static ms5837_rollup_bucket_t gs_minute[256];                         /**< 1min buckets */
+static ms5837_rollup_bucket_t gs_hour[16];                            /**< 1h buckets */
+static ms5837_rollup_bucket_t gs_bin[ROLLUP_TEST_BINS];               /**< query bins */
+static ms5837_rollup_bucket_t gs_check[ROLLUP_TEST_BINS];             /**< brute force bins */
+static uint64_t gs_time_us[ROLLUP_TEST_SAMPLES];                      /**< kept sample times */
+static int32_t gs_temperature[ROLLUP_TEST_SAMPLES];                   /**< kept temperatures */
+static int32_t gs_pressure[ROLLUP_TEST_SAMPLES];                      /**< kept pressures */
+static uint32_t gs_seed;                                              /**< random seed */
+
+/**
+ * @brief  get a pseudo random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_rollup_test_random(void)
+{
+    gs_seed ^= gs_seed << 13;
+    gs_seed ^= gs_seed >> 17;
+    gs_seed ^= gs_seed << 5;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief      raw signal model
+ * @param[in]  index chip slot index
+ * @param[in]  time_us conversion end time
+ * @param[out] *d1 pointer to a raw pressure buffer
+ * @param[out] *d2 pointer to a raw temperature buffer
+ * @note       a random walk
+ */
+static void a_rollup_test_signal(uint8_t index, uint64_t time_us, uint32_t *d1, uint32_t *d2)
+{
+    (void)index;
+    (void)time_us;
+    
+    *d1 = *d1 + (a_rollup_test_random() % 2001) - 1000;
+    *d2 = *d2 + (a_rollup_test_random() % 201) - 100;
+}
+
+/**
+ * @brief     pick a random query time
+ * @param[in] end_us last sample time
+ * @return    time in us
+ * @note      it is aligned to an hour, a minute, a second or not at all
+ */
+static uint64_t a_rollup_test_time(uint64_t end_us)
+{
+    static const uint64_t align[4] = {3600000000ULL, 60000000ULL, 1000000ULL, 1ULL};
+    uint64_t t;
+    
+    t = (((uint64_t)a_rollup_test_random() << 32) | a_rollup_test_random()) % (end_us + 120000000ULL);
+    
+    return t - t % align[a_rollup_test_random() % 4];
+}
+
+/**
+ * @brief     rollup test
+ * @param[in] type device type
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it checks random queries of simulated samples against a brute force summary
+ */
+uint8_t ms5837_rollup_test(ms5837_type_t type, uint32_t times)
+{
+    static const uint64_t step[7] = {1000000ULL, 7000000ULL, 60000000ULL, 300000000ULL,
+                                     3600000000ULL, 7200000000ULL, 0};
+    uint8_t res;
+    uint8_t level;
+    uint8_t expect;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t n;
+    uint32_t num;
+    uint32_t late;
+    uint32_t checked;
+    uint64_t last;
+    
+    /* link the simulated chip */
+    (void)ms5837_sim_init(&gs_sim);
+    (void)ms5837_sim_set_prom(&gs_sim, 0, type, NULL);
+    (void)ms5837_sim_set_environment(&gs_sim, 0, 15.0f, 1500.0f);
+    (void)ms5837_sim_set_signal(&gs_sim, 0, a_rollup_test_signal);
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    (void)ms5837_sim_link(&gs_handle, 0);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    
+    /* ms5837 init */
+    res = ms5837_init(&gs_handle);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    (void)ms5837_set_type(&gs_handle, type);
+    
+    /* start rollup test */
+    ms5837_interface_debug_print("ms5837: start rollup test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_seed = i + 1;
+        (void)ms5837_rollup_init(&gs_rollup, gs_second, 4096, gs_minute, 256, gs_hour, 16);
+        
+        /* add about 3 hours of samples, some of them come late */
+        n = 0;
+        late = 0;
+        last = 0;
+        for (j = 0; j < ROLLUP_TEST_SAMPLES; j++)
+        {
+            uint32_t temperature_raw;
+            uint32_t pressure_raw;
+            float temperature_c;
+            float pressure_mbar;
+            int32_t temperature;
+            int32_t pressure;
+            uint64_t t;
+            
+            (void)ms5837_sim_advance(&gs_sim, 1000000ULL + a_rollup_test_random() % 6000000U);
+            res = ms5837_read_temperature_pressure(&gs_handle, &temperature_raw, &temperature_c,
+                                                   &pressure_raw, &pressure_mbar);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: read temperature pressure failed.\n");
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            (void)ms5837_compensate(&gs_handle, temperature_raw, &temperature, pressure_raw, &pressure);
+            t = gs_sim.now_us;
+            if ((last > 3000000ULL) && ((a_rollup_test_random() % 8) == 0))
+            {
+                t = last - a_rollup_test_random() % 3000000U;
+            }
+            
+            /* a sample before the open 1s bucket is dropped from all levels */
+            expect = ((t / 1000000ULL) < (last / 1000000ULL)) ? 1 : 0;
+            res = ms5837_rollup_add(&gs_rollup, t, temperature, pressure);
+            if (res != expect)
+            {
+                ms5837_interface_debug_print("ms5837: add at %lluus returned %d.\n", (unsigned long long)t, res);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            if (res != 0)
+            {
+                late++;
+                
+                continue;
+            }
+            gs_time_us[n] = t;
+            gs_temperature[n] = temperature;
+            gs_pressure[n] = pressure;
+            n++;
+            last = (t > last) ? t : last;
+        }
+        ms5837_interface_debug_print("ms5837: round %d added %d samples and dropped %d late ones.\n", i + 1, n, late);
+        
+        /* random queries against a brute force summary */
+        checked = 0;
+        for (j = 0; j < ROLLUP_TEST_QUERIES; j++)
+        {
+            uint64_t start;
+            uint64_t end;
+            uint64_t width;
+            uint64_t first;
+            uint64_t stop;
+            
+            start = a_rollup_test_time(last);
+            end = a_rollup_test_time(last);
+            if (end == start)
+            {
+                continue;
+            }
+            if (end < start)
+            {
+                uint64_t swap = start;
+                
+                start = end;
+                end = swap;
+            }
+            width = step[a_rollup_test_random() % 7];
+            width = (width == 0) ? (end - start) : width;
+            res = ms5837_rollup_query(&gs_rollup, start, end, width, gs_bin, ROLLUP_TEST_BINS, &num, &level);
+            if (res == 5)
+            {
+                continue;
+            }
+            
+            /* the coarsest aligned level, only whole seconds inside the range */
+            for (expect = 2; expect > 0; expect--)
+            {
+                uint64_t span = (expect == 2) ? 3600000000ULL : 60000000ULL;
+                
+                if (((width % span) == 0) && ((start % span) == 0))
+                {
+                    break;
+                }
+            }
+            if ((res != 0) || (level != expect) || (num != (end - start + width - 1) / width))
+            {
+                ms5837_interface_debug_print("ms5837: query returned %d level %d bins %d.\n", res, level, num);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            memset(gs_check, 0, sizeof(ms5837_rollup_bucket_t) * num);
+            first = (start + 999999ULL) / 1000000ULL * 1000000ULL;
+            stop = end / 1000000ULL * 1000000ULL;
+            for (k = 0; k < n; k++)
+            {
+                ms5837_rollup_bucket_t *check;
+                uint64_t t = gs_time_us[k];
+                
+                if ((t < first) || (t >= stop))
+                {
+                    continue;
+                }
+                check = &gs_check[(t / 1000000ULL * 1000000ULL - start) / width];
+                if (check->count == 0)
+                {
+                    check->temperature_min = INT32_MAX;
+                    check->temperature_max = INT32_MIN;
+                    check->pressure_min = INT32_MAX;
+                    check->pressure_max = INT32_MIN;
+                }
+                check->temperature_min = (gs_temperature[k] < check->temperature_min) ? gs_temperature[k] : check->temperature_min;
+                check->temperature_max = (gs_temperature[k] > check->temperature_max) ? gs_temperature[k] : check->temperature_max;
+                check->temperature_sum += gs_temperature[k];
+                check->pressure_min = (gs_pressure[k] < check->pressure_min) ? gs_pressure[k] : check->pressure_min;
+                check->pressure_max = (gs_pressure[k] > check->pressure_max) ? gs_pressure[k] : check->pressure_max;
+                check->pressure_sum += gs_pressure[k];
+                check->count++;
+            }
+            for (k = 0; k < num; k++)
+            {
+                ms5837_rollup_bucket_t *a = &gs_bin[k];
+                ms5837_rollup_bucket_t *b = &gs_check[k];
+                
+                if ((a->start_us != start + k * width) || (a->count != b->count) ||
+                    ((a->count != 0) &&
+                     ((a->temperature_min != b->temperature_min) || (a->temperature_max != b->temperature_max) ||
+                      (a->temperature_sum != b->temperature_sum) || (a->pressure_min != b->pressure_min) ||
+                      (a->pressure_max != b->pressure_max) || (a->pressure_sum != b->pressure_sum))))
+                {
+                    ms5837_interface_debug_print("ms5837: query %llu - %llu step %llu bin %d is different.\n",
+                                                 (unsigned long long)start, (unsigned long long)end,
+                                                 (unsigned long long)width, k);
+                    (void)ms5837_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+            checked++;
+        }
+        ms5837_interface_debug_print("ms5837: round %d checked %d queries ok.\n", i + 1, checked);
+    }
+    
+    /* finish rollup test */
+    ms5837_interface_debug_print("ms5837: finish rollup test.\n");
+    (void)ms5837_deinit(&gs_handle);
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}
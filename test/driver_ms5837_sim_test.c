@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_sim_test.c
+ * @brief     driver ms5837 sim test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#include "driver_ms5837_sim_test.h"
+#include <math.h>
+
+static ms5837_sim_t gs_sim;              /**< simulator */
+static ms5837_handle_t gs_handle;        /**< ms5837 handle */
+
+/**
+ * @brief datasheet convert command table definition
+ */
+static const uint8_t gs_d1_cmd[6] = {0x40, 0x42, 0x44, 0x46, 0x48, 0x4A};        /**< d1 command of each osr */
+static const uint8_t gs_d2_cmd[6] = {0x50, 0x52, 0x54, 0x56, 0x58, 0x5A};        /**< d2 command of each osr */
+
+/**
+ * @brief      convert once and read the adc after a wait
+ * @param[in]  osr adc osr
+ * @param[in]  pressure 1 for d1 and 0 for d2
+ * @param[in]  wait_us virtual wait time after the command
+ * @param[out] *raw pointer to a raw data buffer
+ * @return     status code of ms5837_read_adc
+ * @note       none
+ */
+static uint8_t a_sim_test_convert(ms5837_osr_t osr, uint8_t pressure, uint32_t wait_us, uint32_t *raw)
+{
+    if (pressure != 0)
+    {
+        (void)ms5837_set_pressure_osr(&gs_handle, osr);
+        (void)ms5837_start_pressure_convert(&gs_handle);
+    }
+    else
+    {
+        (void)ms5837_set_temperature_osr(&gs_handle, osr);
+        (void)ms5837_start_temperature_convert(&gs_handle);
+    }
+    (void)ms5837_sim_advance(&gs_sim, wait_us);
+    
+    return ms5837_read_adc(&gs_handle, raw);
+}
+
+/**
+ * @brief     sim test
+ * @param[in] type device type
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it checks the conversion timing of every osr on the simulator
+ */
+uint8_t ms5837_sim_test(ms5837_type_t type, uint32_t times)
+{
+    uint8_t res;
+    uint8_t pressure;
+    uint32_t i;
+    uint32_t us;
+    uint32_t raw;
+    uint32_t ticket;
+    ms5837_osr_t osr;
+    ms5837_osr_t max_osr;
+    ms5837_config_t config;
+    
+    /* link the simulated chip, a transfer takes no virtual time */
+    (void)ms5837_sim_init(&gs_sim);
+    gs_sim.transfer_us = 0;
+    (void)ms5837_sim_set_prom(&gs_sim, 0, type, NULL);
+    (void)ms5837_sim_set_environment(&gs_sim, 0, 25.0f, 1013.25f);
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    (void)ms5837_sim_link(&gs_handle, 0);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    
+    /* ms5837 init */
+    res = ms5837_init(&gs_handle);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    res = ms5837_set_type(&gs_handle, type);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: set type failed.\n");
+        (void)ms5837_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* start sim test */
+    ms5837_interface_debug_print("ms5837: start sim test.\n");
+    
+    /* the chip must get the datasheet command and still be converting 1us before the max time of every osr */
+    max_osr = (type == MS5837_TYPE_30BA26) ? MS5837_OSR_4096 : MS5837_OSR_8192;
+    for (osr = MS5837_OSR_256; osr <= max_osr; osr++)
+    {
+        (void)ms5837_get_convert_time(&gs_handle, osr, &us);
+        for (pressure = 0; pressure < 2; pressure++)
+        {
+            raw = 0xFFFFFFFFU;
+            res = a_sim_test_convert(osr, pressure, us - 1, &raw);
+            if (gs_sim.chip[0].cmd != ((pressure != 0) ? gs_d1_cmd[osr] : gs_d2_cmd[osr]))
+            {
+                ms5837_interface_debug_print("ms5837: %s osr %d sent command 0x%02X.\n",
+                                             (pressure != 0) ? "pressure" : "temperature", osr, gs_sim.chip[0].cmd);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            if ((res == 0) || (raw != 0))
+            {
+                ms5837_interface_debug_print("ms5837: %s osr %d read %d raw %d before %dus.\n",
+                                             (pressure != 0) ? "pressure" : "temperature", osr, res, raw, us);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            res = a_sim_test_convert(osr, pressure, us, &raw);
+            if ((res != 0) || (raw == 0))
+            {
+                ms5837_interface_debug_print("ms5837: %s osr %d read failed after %dus.\n",
+                                             (pressure != 0) ? "pressure" : "temperature", osr, us);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+        }
+        ms5837_interface_debug_print("ms5837: check osr %d timing %dus ok.\n", osr, us);
+    }
+    
+    /* the blocking reads give the environment back */
+    (void)ms5837_set_temperature_osr(&gs_handle, MS5837_OSR_4096);
+    (void)ms5837_set_pressure_osr(&gs_handle, MS5837_OSR_4096);
+    for (i = 0; i < times; i++)
+    {
+        uint32_t temperature_raw;
+        uint32_t pressure_raw;
+        float temperature_c;
+        float pressure_mbar;
+        
+        res = ms5837_read_temperature_pressure(&gs_handle, &temperature_raw, &temperature_c, &pressure_raw, &pressure_mbar);
+        if ((res != 0) || (fabsf(temperature_c - 25.0f) > 0.1f) || (fabsf(pressure_mbar - 1013.25f) > 0.5f))
+        {
+            ms5837_interface_debug_print("ms5837: read %d temperature %0.2fC pressure %0.2fmbar.\n",
+                                         res, temperature_c, pressure_mbar);
+            (void)ms5837_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ms5837_interface_debug_print("ms5837: temperature is %0.2fC.\n", temperature_c);
+        ms5837_interface_debug_print("ms5837: pressure is %0.2fmbar.\n", pressure_mbar);
+    }
+    
+    /* a configuration staged before a deinit is dropped by the next init */
+    config.type = type;
+    config.temperature_osr = MS5837_OSR_256;
+    config.pressure_osr = MS5837_OSR_256;
+    (void)ms5837_stage_config(&gs_handle, &config, &ticket);
+    (void)ms5837_deinit(&gs_handle);
+    res = ms5837_init(&gs_handle);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    (void)ms5837_set_type(&gs_handle, type);
+    (void)ms5837_set_temperature_osr(&gs_handle, MS5837_OSR_4096);
+    res = a_sim_test_convert(MS5837_OSR_4096, 0, 9040, &raw);
+    if ((res != 0) || (gs_sim.chip[0].cmd != gs_d2_cmd[MS5837_OSR_4096]))
+    {
+        ms5837_interface_debug_print("ms5837: staged config survived the init, command 0x%02X.\n", gs_sim.chip[0].cmd);
+        (void)ms5837_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ms5837_interface_debug_print("ms5837: check staged config drop ok.\n");
+    
+    /* finish sim test */
+    ms5837_interface_debug_print("ms5837: finish sim test.\n");
+    (void)ms5837_deinit(&gs_handle);
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}
@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_sync_test.c
+ * @brief     driver ms5837 sync test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "driver_ms5837_sync_test.h"
+#include <stdio.h>
+#include <sys/resource.h>
+
+#define SYNC_TEST_NUM             2                     /**< sensor number */
+#define SYNC_TEST_STACK           (256UL << 20)         /**< thread stack size of the failing start */
+
+static ms5837_sim_t gs_sim;                             /**< simulator */
+static ms5837_handle_t gs_handle[SYNC_TEST_NUM];        /**< ms5837 handles */
+static ms5837_sync_t gs_sync;                           /**< sync */
+static ms5837_fusion_t gs_fusion;                       /**< fusion of the sets */
+
+/**
+ * @brief  get the mapped address space of the process
+ * @return address space in bytes, 0 if unknown
+ * @note   none
+ */
+static unsigned long a_sync_test_vm_size(void)
+{
+    FILE *fp;
+    char line[128];
+    unsigned long kb = 0;
+    
+    fp = fopen("/proc/self/status", "r");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (sscanf(line, "VmSize: %lu kB", &kb) == 1)
+        {
+            break;
+        }
+    }
+    (void)fclose(fp);
+    
+    return kb * 1024UL;
+}
+
+/**
+ * @brief     sync test
+ * @param[in] type device type
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it runs on the simulator, a failed thread creation must return instead of hanging
+ *            and a fusion given to the start votes every set, the second sensor is of another type
+ */
+uint8_t ms5837_sync_test(ms5837_type_t type, uint32_t times)
+{
+    uint8_t res;
+    uint8_t i;
+    ms5837_type_t sensor_type;
+    ms5837_handle_t *handle[SYNC_TEST_NUM];
+    ms5837_sync_stats_t stats;
+    ms5837_fusion_config_t config;
+    ms5837_fusion_result_t result;
+    pthread_attr_t attr;
+    pthread_attr_t old_attr;
+    struct rlimit old_limit;
+    struct rlimit limit;
+    unsigned long vm;
+    
+    /* init the simulated sensors, the fusion takes the pressure unit of each one from its handle */
+    (void)ms5837_sim_init(&gs_sim);
+    gs_sim.transfer_us = 10000;
+    for (i = 0; i < SYNC_TEST_NUM; i++)
+    {
+        sensor_type = type;
+        if (i == 1)
+        {
+            sensor_type = (type == MS5837_TYPE_30BA26) ? MS5837_TYPE_02BA01 : MS5837_TYPE_30BA26;
+        }
+        (void)ms5837_sim_set_prom(&gs_sim, i, sensor_type, NULL);
+        (void)ms5837_sim_set_environment(&gs_sim, i, 20.0f, 1013.25f);
+        DRIVER_MS5837_LINK_INIT(&gs_handle[i], ms5837_handle_t);
+        (void)ms5837_sim_link(&gs_handle[i], i);
+        DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle[i], ms5837_interface_debug_print);
+        res = ms5837_init(&gs_handle[i]);
+        if (res != 0)
+        {
+            ms5837_interface_debug_print("ms5837: init failed.\n");
+            
+            return 1;
+        }
+        (void)ms5837_set_type(&gs_handle[i], sensor_type);
+        (void)ms5837_set_temperature_osr(&gs_handle[i], MS5837_OSR_256);
+        (void)ms5837_set_pressure_osr(&gs_handle[i], MS5837_OSR_256);
+        handle[i] = &gs_handle[i];
+    }
+    
+    /* start sync test */
+    ms5837_interface_debug_print("ms5837: start sync test.\n");
+    
+    /* the first worker fits the address space limit, the second one can't */
+    ms5837_interface_debug_print("ms5837: second worker creation fails.\n");
+    vm = a_sync_test_vm_size();
+    if ((vm == 0) || (getrlimit(RLIMIT_AS, &old_limit) != 0) ||
+        (pthread_getattr_default_np(&old_attr) != 0))
+    {
+        ms5837_interface_debug_print("ms5837: get the process limits failed.\n");
+        
+        return 1;
+    }
+    (void)pthread_attr_init(&attr);
+    (void)pthread_attr_setstacksize(&attr, SYNC_TEST_STACK);
+    (void)pthread_setattr_default_np(&attr);
+    limit = old_limit;
+    limit.rlim_cur = vm + SYNC_TEST_STACK + SYNC_TEST_STACK / 2;
+    if (setrlimit(RLIMIT_AS, &limit) != 0)
+    {
+        ms5837_interface_debug_print("ms5837: set the address space limit failed.\n");
+        (void)pthread_setattr_default_np(&old_attr);
+        
+        return 1;
+    }
+    res = ms5837_sync_start(&gs_sync, handle, SYNC_TEST_NUM, 20000, times, NULL, NULL);
+    (void)setrlimit(RLIMIT_AS, &old_limit);
+    (void)pthread_setattr_default_np(&old_attr);
+    (void)pthread_attr_destroy(&attr);
+    (void)pthread_attr_destroy(&old_attr);
+    if (res != 4)
+    {
+        ms5837_interface_debug_print("ms5837: sync start returned %d, not 4.\n", res);
+        if (res == 0)
+        {
+            (void)ms5837_sync_stop(&gs_sync);
+        }
+        
+        return 1;
+    }
+    ms5837_interface_debug_print("ms5837: check the failed start %s.\n", "ok");
+    
+    /* a fusion of another sensor number is refused */
+    memset(&config, 0, sizeof(ms5837_fusion_config_t));
+    config.num = SYNC_TEST_NUM - 1;
+    config.mode = MS5837_FUSION_MODE_TRIMMED_MEAN;
+    config.surface_pa = 101325;
+    config.density = 1025;
+    config.tolerance_pa = 1000;
+    config.fault_count = 3;
+    (void)ms5837_fusion_init(&gs_fusion, &config);
+    res = ms5837_sync_start(&gs_sync, handle, SYNC_TEST_NUM, 20000, times, &gs_fusion, NULL);
+    ms5837_interface_debug_print("ms5837: check the fusion number %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        if (res == 0)
+        {
+            (void)ms5837_sync_stop(&gs_sync);
+        }
+        
+        return 1;
+    }
+    
+    /* a normal start afterwards with the fusion of the sensors */
+    config.num = SYNC_TEST_NUM;
+    (void)ms5837_fusion_init(&gs_fusion, &config);
+    ms5837_interface_debug_print("ms5837: run %d sets.\n", times);
+    res = ms5837_sync_start(&gs_sync, handle, SYNC_TEST_NUM, 20000, times, &gs_fusion, NULL);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: sync start failed.\n");
+        
+        return 1;
+    }
+    (void)ms5837_sync_wait(&gs_sync);
+    (void)ms5837_sync_get_stats(&gs_sync, &stats);
+    ms5837_interface_debug_print("ms5837: check the sets %s.\n", (stats.sets == times) ? "ok" : "error");
+    if (stats.sets != times)
+    {
+        return 1;
+    }
+    res = ms5837_fusion_get(&gs_fusion, &result);
+    ms5837_interface_debug_print("ms5837: check the fusion %s.\n",
+                                 ((res == 0) && (result.count == times) && (result.used == 0x03) &&
+                                 (result.pressure_pa > 101225) && (result.pressure_pa < 101425)) ? "ok" : "error");
+    if ((res != 0) || (result.count != times) || (result.used != 0x03) ||
+        (result.pressure_pa <= 101225) || (result.pressure_pa >= 101425))
+    {
+        return 1;
+    }
+    
+    /* finish sync test */
+    ms5837_interface_debug_print("ms5837: finish sync test.\n");
+    for (i = 0; i < SYNC_TEST_NUM; i++)
+    {
+        (void)ms5837_deinit(&gs_handle[i]);
+    }
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}
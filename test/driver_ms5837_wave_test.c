@@ -0,0 +1,456 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_wave_test.c
+ * @brief     driver ms5837 wave test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#include "driver_ms5837_wave_test.h"
+#include <math.h>
+
+#define WAVE_TEST_SAMPLES      6000             /**< samples of one round */
+#define WAVE_TEST_GAP          3000             /**< sample after a gap */
+#define WAVE_TEST_LENGTH       512              /**< segment length */
+#define WAVE_TEST_SEGMENTS     8                /**< segments of one summary */
+#define WAVE_TEST_PERIOD_US    250000           /**< sampling period */
+#define WAVE_TEST_DENSITY      1025.0f          /**< sea water */
+#define WAVE_TEST_G            9.80665          /**< standard gravity */
+#define WAVE_TEST_PI           3.14159265358979 /**< pi */
+
+/**
+ * @brief wave test reference structure definition
+ */
+typedef struct wave_test_reference_s
+{
+    double psd[WAVE_TEST_LENGTH / 2 + 1];        /**< summed periodograms */
+    double depth_sum;                            /**< summed segment mean depths */
+    double depth_m;                              /**< mean sensor depth */
+    double hs_m;                                 /**< significant wave height */
+    double tp_s;                                 /**< peak period */
+    double tz_s;                                 /**< mean zero crossing period */
+    double band_m2[MS5837_WAVE_BAND_MAX];        /**< elevation variance of each band */
+    uint32_t fill;                               /**< valid segment samples */
+    uint32_t step;                               /**< samples since the last segment */
+    uint32_t count;                              /**< summary count */
+    uint16_t segments;                           /**< summed segments */
+    uint16_t gaps;                               /**< restarted segments */
+    uint16_t summary_segments;                   /**< averaged segments of the last summary */
+    uint16_t summary_gaps;                       /**< restarted segments of the last summary */
+} wave_test_reference_t;
+
+static ms5837_sim_t gs_sim;                            /**< simulator */
+static ms5837_handle_t gs_handle;                      /**< ms5837 handle */
+static ms5837_wave_t gs_wave;                          /**< wave analyser */
+static wave_test_reference_t gs_reference;             /**< brute force welch spectrum */
+static float gs_depth[WAVE_TEST_SAMPLES];              /**< depths of the samples */
+static uint64_t gs_time_us[WAVE_TEST_SAMPLES];         /**< sample times */
+static uint32_t gs_seed;                               /**< random seed */
+
+/**
+ * @brief  get a pseudo random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_wave_test_random(void)
+{
+    gs_seed ^= gs_seed << 13;
+    gs_seed ^= gs_seed >> 17;
+    gs_seed ^= gs_seed << 5;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief     get the pressure response of a frequency
+ * @param[in] f frequency in Hz
+ * @param[in] h sensor depth
+ * @param[in] d water depth
+ * @return    pressure response
+ * @note      the wave number is solved with newton steps until it converges
+ */
+static double a_wave_test_response(double f, double h, double d)
+{
+    double omega;
+    double k;
+    double t;
+    uint8_t i;
+    
+    omega = 2.0 * WAVE_TEST_PI * f;
+    k = omega * omega / WAVE_TEST_G / sqrt(tanh(omega * omega * d / WAVE_TEST_G));
+    for (i = 0; i < 20; i++)
+    {
+        t = tanh(k * d);
+        k -= (WAVE_TEST_G * k * t - omega * omega) / (WAVE_TEST_G * t + WAVE_TEST_G * k * d * (1.0 - t * t));
+    }
+    
+    return cosh(k * (d - h)) / cosh(k * d);
+}
+
+/**
+ * @brief     sum the brute force periodogram of the segment ending at a sample
+ * @param[in] last last sample of the segment
+ * @note      a direct dft of the hann windowed segment without its mean
+ */
+static void a_wave_test_segment(uint32_t last)
+{
+    double x[WAVE_TEST_LENGTH];
+    double mean;
+    double re;
+    double im;
+    uint32_t first;
+    uint32_t i;
+    uint32_t k;
+    
+    first = last + 1 - WAVE_TEST_LENGTH;
+    mean = 0.0;
+    for (i = 0; i < WAVE_TEST_LENGTH; i++)
+    {
+        mean += (double)gs_depth[first + i];
+    }
+    mean /= WAVE_TEST_LENGTH;
+    for (i = 0; i < WAVE_TEST_LENGTH; i++)
+    {
+        x[i] = ((double)gs_depth[first + i] - mean) * (0.5 - 0.5 * cos(2.0 * WAVE_TEST_PI * i / WAVE_TEST_LENGTH));
+    }
+    for (k = 0; k <= WAVE_TEST_LENGTH / 2; k++)
+    {
+        re = 0.0;
+        im = 0.0;
+        for (i = 0; i < WAVE_TEST_LENGTH; i++)
+        {
+            re += x[i] * cos(2.0 * WAVE_TEST_PI * (double)((i * k) % WAVE_TEST_LENGTH) / WAVE_TEST_LENGTH);
+            im -= x[i] * sin(2.0 * WAVE_TEST_PI * (double)((i * k) % WAVE_TEST_LENGTH) / WAVE_TEST_LENGTH);
+        }
+        gs_reference.psd[k] += re * re + im * im;
+    }
+    gs_reference.depth_sum += mean;
+    gs_reference.segments++;
+}
+
+/**
+ * @brief     make the brute force summary
+ * @param[in] *config pointer to the wave config
+ * @note      none
+ */
+static void a_wave_test_summary(const ms5837_wave_config_t *config)
+{
+    wave_test_reference_t *ref = &gs_reference;
+    double fs;
+    double df;
+    double power;
+    double scale;
+    double h;
+    double d;
+    double f;
+    double kp;
+    double s;
+    double e;
+    double m0;
+    double m2;
+    double peak;
+    double fp;
+    uint32_t i;
+    uint8_t b;
+    
+    fs = 1000000.0 / WAVE_TEST_PERIOD_US;
+    df = fs / WAVE_TEST_LENGTH;
+    for (i = 0, power = 0.0; i < WAVE_TEST_LENGTH; i++)
+    {
+        power += pow(0.5 - 0.5 * cos(2.0 * WAVE_TEST_PI * i / WAVE_TEST_LENGTH), 2.0);
+    }
+    scale = 2.0 / (fs * power * ref->segments);
+    h = ref->depth_sum / ref->segments;
+    h = (h < 0.0) ? 0.0 : h;
+    d = h + config->height_m;
+    memset(ref->band_m2, 0, sizeof(ref->band_m2));
+    m0 = 0.0;
+    m2 = 0.0;
+    peak = 0.0;
+    fp = 0.0;
+    for (i = 1; i < WAVE_TEST_LENGTH / 2; i++)
+    {
+        f = i * df;
+        if ((f < config->band_hz[0]) || (f >= config->band_hz[config->band_num]))
+        {
+            continue;
+        }
+        kp = a_wave_test_response(f, h, d);
+        s = ref->psd[i] * scale / (kp * kp);
+        e = s * df;
+        m0 += e;
+        m2 += e * f * f;
+        if (s > peak)
+        {
+            peak = s;
+            fp = f;
+        }
+        for (b = 0; b < config->band_num; b++)
+        {
+            if (f < config->band_hz[b + 1])
+            {
+                ref->band_m2[b] += e;
+                
+                break;
+            }
+        }
+    }
+    ref->depth_m = h;
+    ref->hs_m = 4.0 * sqrt(m0);
+    ref->tp_s = (fp > 0.0) ? (1.0 / fp) : 0.0;
+    ref->tz_s = (m2 > 0.0) ? sqrt(m0 / m2) : 0.0;
+    ref->summary_segments = ref->segments;
+    ref->summary_gaps = ref->gaps;
+    ref->count++;
+    memset(ref->psd, 0, sizeof(ref->psd));
+    ref->depth_sum = 0.0;
+    ref->segments = 0;
+    ref->gaps = 0;
+}
+
+/**
+ * @brief     add a sample to the brute force welch spectrum
+ * @param[in] *config pointer to the wave config
+ * @param[in] j sample index
+ * @note      the same segment hops and gap restarts as the analyser
+ */
+static void a_wave_test_reference_add(const ms5837_wave_config_t *config, uint32_t j)
+{
+    wave_test_reference_t *ref = &gs_reference;
+    
+    if ((j != 0) && ((gs_time_us[j] - gs_time_us[j - 1]) * 2 > (uint64_t)WAVE_TEST_PERIOD_US * 3))
+    {
+        ref->fill = 0;
+        ref->step = 0;
+        ref->gaps++;
+    }
+    ref->fill = (ref->fill < WAVE_TEST_LENGTH) ? (ref->fill + 1) : ref->fill;
+    ref->step++;
+    if ((ref->fill == WAVE_TEST_LENGTH) && (ref->step >= WAVE_TEST_LENGTH / 2))
+    {
+        a_wave_test_segment(j);
+        ref->step = 0;
+        if (ref->segments >= config->segments)
+        {
+            a_wave_test_summary(config);
+        }
+    }
+}
+
+/**
+ * @brief     wave test
+ * @param[in] type device type
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it checks the summaries of simulated sine waves against a brute force welch spectrum
+ */
+uint8_t ms5837_wave_test(ms5837_type_t type, uint32_t times)
+{
+    uint8_t res;
+    uint8_t b;
+    uint32_t i;
+    uint32_t j;
+    uint32_t pa;
+    int32_t surface;
+    ms5837_wave_config_t config;
+    ms5837_wave_summary_t summary;
+    
+    /* link the simulated chip */
+    (void)ms5837_sim_init(&gs_sim);
+    (void)ms5837_sim_set_prom(&gs_sim, 0, type, NULL);
+    (void)ms5837_sim_set_environment(&gs_sim, 0, 15.0f, 1013.25f);
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    (void)ms5837_sim_link(&gs_handle, 0);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    
+    /* ms5837 init */
+    res = ms5837_init(&gs_handle);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    (void)ms5837_set_type(&gs_handle, type);
+    pa = (type == MS5837_TYPE_30BA26) ? 10 : 1;
+    surface = (int32_t)(101325 / pa);
+    
+    /* start wave test */
+    ms5837_interface_debug_print("ms5837: start wave test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        double amplitude;
+        double frequency;
+        double h;
+        double kp;
+        double hs;
+        uint64_t start_us;
+        
+        /* a bin centred sine in the bands over a random depth and height */
+        gs_seed = i + 1;
+        memset(&config, 0, sizeof(ms5837_wave_config_t));
+        config.type = type;
+        config.period_us = WAVE_TEST_PERIOD_US;
+        config.length = WAVE_TEST_LENGTH;
+        config.segments = WAVE_TEST_SEGMENTS;
+        config.surface = surface;
+        config.density = WAVE_TEST_DENSITY;
+        config.height_m = (float)(a_wave_test_random() % 5000) / 1000.0f;
+        config.band_num = 3;
+        config.band_hz[0] = 0.04f;
+        config.band_hz[1] = 0.1f;
+        config.band_hz[2] = 0.15f;
+        config.band_hz[3] = 0.25f;
+        amplitude = 0.2 + (double)(a_wave_test_random() % 1000) / 1000.0;
+        frequency = (double)(8 + a_wave_test_random() % 21) * 1000000.0 / WAVE_TEST_PERIOD_US / WAVE_TEST_LENGTH;
+        h = 2.0 + (double)(a_wave_test_random() % 4000) / 1000.0;
+        kp = a_wave_test_response(frequency, h, h + config.height_m);
+        hs = 4.0 * sqrt(amplitude * amplitude / 2.0);
+        res = ms5837_wave_init(&gs_wave, &config);
+        if ((res != 0) || (ms5837_wave_get_summary(&gs_wave, &summary) != 1))
+        {
+            ms5837_interface_debug_print("ms5837: wave init failed.\n");
+            (void)ms5837_deinit(&gs_handle);
+            
+            return 1;
+        }
+        memset(&gs_reference, 0, sizeof(wave_test_reference_t));
+        start_us = gs_sim.now_us;
+        for (j = 0; j < WAVE_TEST_SAMPLES; j++)
+        {
+            uint32_t temperature_raw;
+            uint32_t pressure_raw;
+            float temperature_c;
+            float pressure_mbar;
+            int32_t temperature;
+            int32_t pressure;
+            uint64_t time_us;
+            double depth;
+            
+            /* sample on the period grid, one gap restarts the segment */
+            time_us = start_us + (uint64_t)(j + ((j >= WAVE_TEST_GAP) ? 2 : 0)) * WAVE_TEST_PERIOD_US;
+            depth = h + kp * amplitude * cos(2.0 * WAVE_TEST_PI * frequency * (double)(time_us - start_us) / 1000000.0);
+            (void)ms5837_sim_set_environment(&gs_sim, 0, 15.0f,
+                                             (float)(1013.25 + depth * WAVE_TEST_DENSITY * WAVE_TEST_G / 100.0));
+            (void)ms5837_sim_advance(&gs_sim, time_us - gs_sim.now_us);
+            res = ms5837_read_temperature_pressure(&gs_handle, &temperature_raw, &temperature_c,
+                                                   &pressure_raw, &pressure_mbar);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: read temperature pressure failed.\n");
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            (void)ms5837_compensate(&gs_handle, temperature_raw, &temperature, pressure_raw, &pressure);
+            gs_time_us[j] = gs_sim.now_us;
+            gs_depth[j] = (float)(pressure - surface) * (float)pa / (WAVE_TEST_DENSITY * 9.80665f);
+            
+            /* add to both and compare every new summary */
+            res = ms5837_wave_add(&gs_wave, gs_time_us[j], pressure);
+            if ((res != 0) || (ms5837_wave_add(&gs_wave, gs_time_us[j], pressure) != 4))
+            {
+                ms5837_interface_debug_print("ms5837: wave add %d returned %d.\n", j, res);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            a_wave_test_reference_add(&config, j);
+            res = ms5837_wave_get_summary(&gs_wave, &summary);
+            if (((gs_reference.count == 0) && (res != 1)) || ((gs_reference.count != 0) && (res != 0)) ||
+                ((res == 0) && (summary.count != gs_reference.count)))
+            {
+                ms5837_interface_debug_print("ms5837: wave summary count at sample %d is different.\n", j);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            if ((res != 0) || (summary.time_us != gs_time_us[j]))
+            {
+                continue;
+            }
+            if ((summary.segments != gs_reference.summary_segments) || (summary.gaps != gs_reference.summary_gaps) ||
+                (fabs(summary.depth_m - gs_reference.depth_m) > 1e-4) ||
+                (fabs(summary.hs_m - gs_reference.hs_m) > 1e-3 * gs_reference.hs_m + 1e-6) ||
+                (fabs(summary.tp_s - gs_reference.tp_s) > 1e-4 * gs_reference.tp_s) ||
+                (fabs(summary.tz_s - gs_reference.tz_s) > 1e-3 * gs_reference.tz_s))
+            {
+                ms5837_interface_debug_print("ms5837: depth %0.4fm %0.4fm hs %0.4fm %0.4fm tp %0.2fs %0.2fs tz %0.2fs %0.2fs.\n",
+                                             summary.depth_m, gs_reference.depth_m, summary.hs_m, gs_reference.hs_m,
+                                             summary.tp_s, gs_reference.tp_s, summary.tz_s, gs_reference.tz_s);
+                ms5837_interface_debug_print("ms5837: wave summary %d is different.\n", summary.count);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            for (b = 0; b < config.band_num; b++)
+            {
+                if (fabs(summary.band_m2[b] - gs_reference.band_m2[b]) > 1e-3 * gs_reference.hs_m * gs_reference.hs_m / 16.0)
+                {
+                    ms5837_interface_debug_print("ms5837: wave summary %d band %d is different.\n", summary.count, b);
+                    (void)ms5837_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+            
+            /* the summary finds the simulated sine */
+            if ((fabs(summary.depth_m - h) > 0.01) || (fabs(summary.hs_m - hs) > 0.05 * hs) ||
+                (fabs(summary.tp_s * frequency - 1.0) > 1e-4))
+            {
+                ms5837_interface_debug_print("ms5837: wave summary %d depth %0.3fm hs %0.3fm tp %0.2fs misses the sine.\n",
+                                             summary.count, summary.depth_m, summary.hs_m, summary.tp_s);
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+        }
+        if ((gs_reference.count < 2) || (ms5837_wave_get_summary(&gs_wave, &summary) != 0) || (summary.gaps != 1))
+        {
+            ms5837_interface_debug_print("ms5837: wave round %d made %d summaries.\n", i + 1, gs_reference.count);
+            (void)ms5837_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ms5837_interface_debug_print("ms5837: round %d hs %0.2fm tp %0.2fs depth %0.2fm %d summaries ok.\n",
+                                     i + 1, hs, 1.0 / frequency, h, gs_reference.count);
+    }
+    
+    /* finish wave test */
+    ms5837_interface_debug_print("ms5837: finish wave test.\n");
+    (void)ms5837_deinit(&gs_handle);
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}
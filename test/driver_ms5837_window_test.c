@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ms5837_window_test.c
+ * @brief     driver ms5837 window test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+ 
+#include "driver_ms5837_window_test.h"
+#include <math.h>
+
+#define WINDOW_TEST_SAMPLES        4000        /**< samples of one round */
+
+static ms5837_sim_t gs_sim;                                         /**< simulator */
+static ms5837_handle_t gs_handle;                                   /**< ms5837 handle */
+static ms5837_window_t gs_window[2];                                /**< tumbling and sliding windows */
+static ms5837_window_slot_t gs_slot[1000];                          /**< sliding slots */
+static uint64_t gs_time_us[WINDOW_TEST_SAMPLES];                    /**< sample times */
+static int32_t gs_value[2][WINDOW_TEST_SAMPLES];                    /**< temperatures and pressures */
+static uint32_t gs_seed;                                            /**< random seed */
+
+/**
+ * @brief  get a pseudo random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_window_test_random(void)
+{
+    gs_seed ^= gs_seed << 13;
+    gs_seed ^= gs_seed >> 17;
+    gs_seed ^= gs_seed << 5;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief      raw signal model
+ * @param[in]  index chip slot index
+ * @param[in]  time_us conversion end time
+ * @param[out] *d1 pointer to a raw pressure buffer
+ * @param[out] *d2 pointer to a raw temperature buffer
+ * @note       a random walk with ramps and steps, so the min and max queues see long runs
+ */
+static void a_window_test_signal(uint8_t index, uint64_t time_us, uint32_t *d1, uint32_t *d2)
+{
+    (void)index;
+    
+    switch ((time_us / 50000000ULL) % 4)
+    {
+        case 0 :
+        {
+            *d1 = *d1 + 300;
+            *d2 = *d2 - 20;
+            
+            break;
+        }
+        case 1 :
+        {
+            *d1 = *d1 - 300;
+            *d2 = *d2 + 20;
+            
+            break;
+        }
+        case 2 :
+        {
+            *d1 = *d1 + (a_window_test_random() % 40001) - 20000;
+            *d2 = *d2 + (a_window_test_random() % 2001) - 1000;
+            
+            break;
+        }
+        default :
+        {
+            *d1 = *d1 + (a_window_test_random() % 201) - 100;
+            *d2 = *d2 + (a_window_test_random() % 21) - 10;
+            
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     check a summary value against brute force
+ * @param[in] *value pointer to a summary value
+ * @param[in] *data pointer to the values
+ * @param[in] *time_us pointer to the times
+ * @param[in] first first sample
+ * @param[in] count sample count
+ * @return    1 if it matches, 0 if not
+ * @note      min and max are exact, the float results are checked with a relative tolerance
+ */
+static uint8_t a_window_test_check(const ms5837_window_value_t *value, const int32_t *data, const uint64_t *time_us,
+                                   uint32_t first, uint32_t count)
+{
+    int32_t min = data[first];
+    int32_t max = data[first];
+    double mean = 0.0;
+    double variance = 0.0;
+    double rate = 0.0;
+    double seconds;
+    uint32_t i;
+    
+    for (i = first; i < first + count; i++)
+    {
+        min = (data[i] < min) ? data[i] : min;
+        max = (data[i] > max) ? data[i] : max;
+        mean += (double)data[i];
+    }
+    mean /= (double)count;
+    for (i = first; i < first + count; i++)
+    {
+        variance += ((double)data[i] - mean) * ((double)data[i] - mean);
+    }
+    variance = (count > 1) ? (variance / (double)(count - 1)) : 0.0;
+    seconds = (double)(time_us[first + count - 1] - time_us[first]) / 1000000.0;
+    rate = (seconds > 0.0) ? ((double)(data[first + count - 1] - data[first]) / seconds) : 0.0;
+    if ((value->min != min) || (value->max != max) ||
+        (fabs((double)value->mean - mean) > 1e-6 * fabs(mean) + 1e-3) ||
+        (fabs((double)value->variance - variance) > 1e-4 * variance + 1e-3) ||
+        (fabs((double)value->rate - rate) > 1e-5 * fabs(rate) + 1e-3))
+    {
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     window test
+ * @param[in] type device type
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      it checks the tumbling and sliding summaries of simulated samples against brute force
+ */
+uint8_t ms5837_window_test(ms5837_type_t type, uint32_t times)
+{
+    static const uint32_t size[5] = {7, 64, 1000, 1, 2};
+    uint8_t res;
+    uint8_t mode;
+    uint32_t i;
+    uint32_t j;
+    uint32_t closed;
+    ms5837_window_summary_t summary;
+    
+    /* link the simulated chip */
+    (void)ms5837_sim_init(&gs_sim);
+    (void)ms5837_sim_set_prom(&gs_sim, 0, type, NULL);
+    (void)ms5837_sim_set_environment(&gs_sim, 0, 15.0f, 1500.0f);
+    (void)ms5837_sim_set_signal(&gs_sim, 0, a_window_test_signal);
+    DRIVER_MS5837_LINK_INIT(&gs_handle, ms5837_handle_t);
+    (void)ms5837_sim_link(&gs_handle, 0);
+    DRIVER_MS5837_LINK_DEBUG_PRINT(&gs_handle, ms5837_interface_debug_print);
+    
+    /* ms5837 init */
+    res = ms5837_init(&gs_handle);
+    if (res != 0)
+    {
+        ms5837_interface_debug_print("ms5837: init failed.\n");
+        
+        return 1;
+    }
+    (void)ms5837_set_type(&gs_handle, type);
+    
+    /* start window test */
+    ms5837_interface_debug_print("ms5837: start window test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        uint32_t n = size[i % 5];
+        
+        gs_seed = i + 1;
+        (void)ms5837_window_init(&gs_window[0], MS5837_WINDOW_MODE_TUMBLING, n, NULL);
+        (void)ms5837_window_init(&gs_window[1], MS5837_WINDOW_MODE_SLIDING, n, gs_slot);
+        closed = 0;
+        for (j = 0; j < WINDOW_TEST_SAMPLES; j++)
+        {
+            uint32_t temperature_raw;
+            uint32_t pressure_raw;
+            float temperature_c;
+            float pressure_mbar;
+            uint32_t first;
+            uint32_t count;
+            
+            /* sample with a jittered period */
+            (void)ms5837_sim_advance(&gs_sim, 100000ULL + a_window_test_random() % 20000U);
+            res = ms5837_read_temperature_pressure(&gs_handle, &temperature_raw, &temperature_c,
+                                                   &pressure_raw, &pressure_mbar);
+            if (res != 0)
+            {
+                ms5837_interface_debug_print("ms5837: read temperature pressure failed.\n");
+                (void)ms5837_deinit(&gs_handle);
+                
+                return 1;
+            }
+            gs_time_us[j] = gs_sim.now_us;
+            (void)ms5837_compensate(&gs_handle, temperature_raw, &gs_value[0][j], pressure_raw, &gs_value[1][j]);
+            
+            /* both modes against brute force */
+            for (mode = 0; mode < 2; mode++)
+            {
+                res = ms5837_window_add(&gs_window[mode], gs_time_us[j], gs_value[0][j], gs_value[1][j]);
+                if ((mode == 0) && (res != (((j + 1) % n) == 0 ? 1 : 0)))
+                {
+                    ms5837_interface_debug_print("ms5837: tumbling add %d returned %d.\n", j, res);
+                    (void)ms5837_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                if ((mode == 0) && (res == 0))
+                {
+                    continue;
+                }
+                count = (mode == 0) ? n : (((j + 1) < n) ? (j + 1) : n);
+                first = j + 1 - count;
+                if ((ms5837_window_get(&gs_window[mode], &summary) != 0) || (summary.count != count) ||
+                    (summary.start_us != gs_time_us[first]) || (summary.end_us != gs_time_us[j]) ||
+                    ((mode == 0) && (summary.index != closed)) ||
+                    (a_window_test_check(&summary.temperature, gs_value[0], gs_time_us, first, count) == 0) ||
+                    (a_window_test_check(&summary.pressure, gs_value[1], gs_time_us, first, count) == 0))
+                {
+                    ms5837_interface_debug_print("ms5837: %s window of size %d at sample %d is different.\n",
+                                                 (mode == 0) ? "tumbling" : "sliding", n, j);
+                    (void)ms5837_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                closed += (mode == 0) ? 1 : 0;
+            }
+        }
+        ms5837_interface_debug_print("ms5837: round %d size %d %d samples %d tumbling windows ok.\n",
+                                     i + 1, n, WINDOW_TEST_SAMPLES, closed);
+    }
+    
+    /* finish window test */
+    ms5837_interface_debug_print("ms5837: finish window test.\n");
+    (void)ms5837_deinit(&gs_handle);
+    (void)ms5837_sim_deinit(&gs_sim);
+    
+    return 0;
+}